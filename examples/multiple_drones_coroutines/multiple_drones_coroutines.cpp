@@ -0,0 +1,143 @@
+//
+// Example to connect multiple vehicles and make them take off and land in parallel
+// using C++20 coroutines instead of one thread per vehicle.
+//./multiple_drones_coroutines udp://:14540 udp://:14541
+//
+
+#include <mavsdk/mavsdk.h>
+#include <mavsdk/plugins/action/action.h>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifndef MAVSDK_HAS_COROUTINES
+#error "This example needs a compiler with C++20 coroutine support."
+#endif
+
+using namespace mavsdk;
+using namespace std::this_thread;
+using namespace std::chrono;
+
+// Minimal fire-and-forget coroutine type. A real application would typically
+// use the task type of its own executor or library instead.
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+static Task arm_and_takeoff(Action& action, std::atomic<unsigned>& num_done);
+static Task land(Action& action, std::atomic<unsigned>& num_done);
+
+void usage(const std::string& bin_name)
+{
+    std::cerr << "Usage : " << bin_name << " <connection_url_1> [<connection_url_2> ...]\n"
+              << "Connection URL format should be :\n"
+              << " For TCP : tcp://[server_host][:server_port]\n"
+              << " For UDP : udp://[bind_host][:bind_port]\n"
+              << " For Serial : serial:///path/to/serial/dev[:baudrate]\n"
+              << "For example, to connect to the simulator use URL: udp://:14540\n";
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Please specify connection\n";
+        usage(argv[0]);
+        return 1;
+    }
+
+    Mavsdk mavsdk;
+
+    const size_t total_udp_ports = argc - 1;
+
+    for (int i = 1; i < argc; ++i) {
+        ConnectionResult connection_result = mavsdk.add_any_connection(argv[i]);
+        if (connection_result != ConnectionResult::Success) {
+            std::cerr << "Connection error: " << connection_result << '\n';
+            return 1;
+        }
+    }
+
+    // We usually receive heartbeats at 1Hz, therefore we should find all systems after around
+    // 2 seconds.
+    std::cout << "Waiting to discover systems...\n";
+    sleep_for(seconds(2));
+
+    if (mavsdk.systems().size() != total_udp_ports) {
+        std::cerr << "Not all systems found, exiting.\n";
+        return 1;
+    }
+
+    // The plugins need to stay alive while the coroutines are using them.
+    std::vector<std::unique_ptr<Action>> actions;
+    for (auto system : mavsdk.systems()) {
+        actions.push_back(std::make_unique<Action>(system));
+    }
+
+    // All the commands are in flight at the same time, without a thread
+    // blocked for any of them.
+    std::atomic<unsigned> num_done{0};
+    for (auto& action : actions) {
+        arm_and_takeoff(*action, num_done);
+    }
+    while (num_done < actions.size()) {
+        sleep_for(milliseconds(100));
+    }
+
+    // Let them hover for a bit before landing again.
+    sleep_for(seconds(20));
+
+    num_done = 0;
+    for (auto& action : actions) {
+        land(*action, num_done);
+    }
+    while (num_done < actions.size()) {
+        sleep_for(milliseconds(100));
+    }
+
+    // We are relying on auto-disarming, so let's give them some time to land.
+    sleep_for(seconds(20));
+    std::cout << "Finished...\n";
+
+    return 0;
+}
+
+Task arm_and_takeoff(Action& action, std::atomic<unsigned>& num_done)
+{
+    // The coroutine continues on the thread MAVSDK calls callbacks on, so
+    // don't block in here.
+    std::cout << "Arming...\n";
+    const Action::Result arm_result = co_await action.arm_awaitable();
+    if (arm_result != Action::Result::Success) {
+        std::cerr << "Arming failed:" << arm_result << '\n';
+    } else {
+        std::cout << "Taking off...\n";
+        const Action::Result takeoff_result = co_await action.takeoff_awaitable();
+        if (takeoff_result != Action::Result::Success) {
+            std::cerr << "Takeoff failed:" << takeoff_result << '\n';
+        }
+    }
+
+    ++num_done;
+}
+
+Task land(Action& action, std::atomic<unsigned>& num_done)
+{
+    std::cout << "Landing...\n";
+    const Action::Result land_result = co_await action.land_awaitable();
+    if (land_result != Action::Result::Success) {
+        std::cerr << "Land failed:" << land_result << '\n';
+    }
+
+    ++num_done;
+}
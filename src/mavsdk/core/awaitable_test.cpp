@@ -0,0 +1,191 @@
+#include "awaitable.h"
+
+// Only built as C++20 where the compiler supports it, see
+// src/unit_tests/CMakeLists.txt.
+#ifdef MAVSDK_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+enum class Result { Success, Timeout };
+
+// Coroutine that starts straightaway and can be destroyed while suspended.
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object()
+        {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+    ~Task() { destroy(); }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    [[nodiscard]] bool done() const { return _handle && _handle.done(); }
+
+    void destroy()
+    {
+        if (_handle) {
+            _handle.destroy();
+            _handle = nullptr;
+        }
+    }
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+};
+
+// Stands in for the asynchronous call of a plugin.
+template<typename... Args> class FakeCall {
+public:
+    Awaitable<Args...> awaitable()
+    {
+        return Awaitable<Args...>([this](std::function<void(Args...)> callback) {
+            ++num_started;
+            _callback = std::move(callback);
+        });
+    }
+
+    void call_back(Args... args) { _callback(std::move(args)...); }
+
+    unsigned num_started{0};
+
+private:
+    std::function<void(Args...)> _callback;
+};
+
+Task await_result(FakeCall<Result>& call, std::vector<Result>& results)
+{
+    results.push_back(co_await call.awaitable());
+}
+
+Task await_pair(FakeCall<Result, std::string>& call, std::pair<Result, std::string>& result)
+{
+    result = co_await call.awaitable();
+}
+
+Task await_result_on(
+    FakeCall<Result>& call,
+    std::vector<std::function<void()>>& executor_queue,
+    std::vector<Result>& results)
+{
+    results.push_back(co_await call.awaitable().resume_on(
+        [&executor_queue](std::function<void()> func) {
+            executor_queue.push_back(std::move(func));
+        }));
+}
+
+} // namespace
+
+TEST(Awaitable, ResumesOnceWhenCalledBack)
+{
+    FakeCall<Result> call;
+    std::vector<Result> results;
+
+    Task task = await_result(call, results);
+    EXPECT_EQ(call.num_started, 1u);
+    EXPECT_FALSE(task.done());
+    EXPECT_TRUE(results.empty());
+
+    call.call_back(Result::Success);
+    EXPECT_TRUE(task.done());
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], Result::Success);
+
+    // Calling back again must not resume the finished coroutine.
+    call.call_back(Result::Timeout);
+    EXPECT_EQ(results.size(), 1u);
+}
+
+TEST(Awaitable, DoesNotSuspendIfCalledBackRightAway)
+{
+    std::vector<Result> results;
+    auto immediate = [&results]() -> Task {
+        results.push_back(co_await Awaitable<Result>(
+            [](std::function<void(Result)> callback) { callback(Result::Timeout); }));
+    };
+
+    Task task = immediate();
+    EXPECT_TRUE(task.done());
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], Result::Timeout);
+}
+
+TEST(Awaitable, ReturnsResultAndValueAsPair)
+{
+    FakeCall<Result, std::string> call;
+    std::pair<Result, std::string> result{Result::Timeout, ""};
+
+    Task task = await_pair(call, result);
+    call.call_back(Result::Success, "value");
+
+    EXPECT_TRUE(task.done());
+    EXPECT_EQ(result.first, Result::Success);
+    EXPECT_EQ(result.second, "value");
+}
+
+TEST(Awaitable, ResumesOnExecutor)
+{
+    FakeCall<Result> call;
+    std::vector<std::function<void()>> executor_queue;
+    std::vector<Result> results;
+
+    Task task = await_result_on(call, executor_queue, results);
+    call.call_back(Result::Success);
+
+    // Only resumed once the executor runs the continuation.
+    EXPECT_FALSE(task.done());
+    ASSERT_EQ(executor_queue.size(), 1u);
+    executor_queue[0]();
+
+    EXPECT_TRUE(task.done());
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], Result::Success);
+}
+
+TEST(Awaitable, DestroyedBeforeCallback)
+{
+    FakeCall<Result> call;
+    std::vector<Result> results;
+
+    Task task = await_result(call, results);
+    task.destroy();
+
+    // The coroutine is gone, so there is nothing to resume.
+    call.call_back(Result::Success);
+    EXPECT_TRUE(results.empty());
+}
+
+TEST(Awaitable, DestroyedBeforeExecutorRuns)
+{
+    FakeCall<Result> call;
+    std::vector<std::function<void()>> executor_queue;
+    std::vector<Result> results;
+
+    Task task = await_result_on(call, executor_queue, results);
+    call.call_back(Result::Success);
+    task.destroy();
+
+    ASSERT_EQ(executor_queue.size(), 1u);
+    executor_queue[0]();
+    EXPECT_TRUE(results.empty());
+}
+
+#endif
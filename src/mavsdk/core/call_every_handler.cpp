@@ -8,7 +8,7 @@ CallEveryHandler::CallEveryHandler(Time& time) : _time(time) {}
 
 void CallEveryHandler::add(std::function<void()> callback, double interval_s, void** cookie)
 {
-    auto new_entry = std::make_shared<Entry>();
+    auto new_entry = std::make_unique<Entry>();
     new_entry->callback = std::move(callback);
     auto before = _time.steady_time();
     // Make sure it gets run straightaway. The epsilon seemed not enough, so
@@ -19,23 +19,35 @@ void CallEveryHandler::add(std::function<void()> callback, double interval_s, vo
 
     void* new_cookie = static_cast<void*>(new_entry.get());
 
+    SteadyTimePoint due_time;
     {
         std::lock_guard<std::mutex> lock(_entries_mutex);
-        _entries.insert(std::pair<void*, std::shared_ptr<Entry>>(new_cookie, new_entry));
+        due_time = schedule(*new_entry);
+        _entries.emplace(new_cookie, std::move(new_entry));
     }
 
     if (cookie != nullptr) {
         *cookie = new_cookie;
     }
+
+    notify_wakeup(due_time);
 }
 
 void CallEveryHandler::change(double interval_s, const void* cookie)
 {
-    std::lock_guard<std::mutex> lock(_entries_mutex);
+    std::optional<SteadyTimePoint> due_time;
+    {
+        std::lock_guard<std::mutex> lock(_entries_mutex);
 
-    auto it = _entries.find(const_cast<void*>(cookie));
-    if (it != _entries.end()) {
-        it->second->interval_s = interval_s;
+        auto it = _entries.find(const_cast<void*>(cookie));
+        if (it != _entries.end()) {
+            it->second->interval_s = interval_s;
+            due_time = schedule(*it->second);
+        }
+    }
+
+    if (due_time) {
+        notify_wakeup(due_time.value());
     }
 }
 
@@ -46,6 +58,7 @@ void CallEveryHandler::reset(const void* cookie)
     auto it = _entries.find(const_cast<void*>(cookie));
     if (it != _entries.end()) {
         it->second->last_time = _time.steady_time();
+        schedule(*it->second);
     }
 }
 
@@ -55,38 +68,85 @@ void CallEveryHandler::remove(const void* cookie)
 
     auto it = _entries.find(const_cast<void*>(cookie));
     if (it != _entries.end()) {
-        _entries.erase(const_cast<void*>(cookie));
-        _iterator_invalidated = true;
+        _timer_wheel.cancel(*it->second);
+        _entries.erase(it);
     }
 }
 
 void CallEveryHandler::run_once()
 {
-    _entries_mutex.lock();
+    std::unique_lock<std::mutex> lock(_entries_mutex);
+
+    const auto now = _time.steady_time();
+
+    // Entries are only put back into the wheel once we're done, so that each
+    // one is called at most once per run, even if it is behind.
+    _called.clear();
+
+    while (auto* timer = _timer_wheel.pop_expired(now)) {
+        auto* entry = static_cast<Entry*>(timer);
+        _time.shift_steady_time_by(entry->last_time, entry->interval_s);
+        _called.push_back(static_cast<void*>(entry));
+
+        if (entry->callback) {
+            // Get a copy for the callback because we unlock.
+            std::function<void()> callback = entry->callback;
+
+            // Unlock while we call back because it might in turn want to add timeouts.
+            _calling = true;
+            _calling_thread_id = std::this_thread::get_id();
+            lock.unlock();
+            callback();
+            lock.lock();
+            _calling = false;
+            _callback_done_cv.notify_all();
+        }
+    }
 
-    for (auto& entry : _entries) {
-        if (_time.elapsed_since_s(entry.second->last_time) > double(entry.second->interval_s)) {
-            _time.shift_steady_time_by(entry.second->last_time, double(entry.second->interval_s));
+    for (void* cookie : _called) {
+        // The entry might have been removed or changed during the callback.
+        auto it = _entries.find(cookie);
+        if (it != _entries.end() && !TimerWheel::is_scheduled(*it->second)) {
+            schedule(*it->second);
+        }
+    }
+}
 
-            if (entry.second->callback) {
-                // Get a copy for the callback because we unlock.
-                std::function<void()> callback = entry.second->callback;
+void CallEveryHandler::wait_for_callback()
+{
+    std::unique_lock<std::mutex> lock(_entries_mutex);
+    if (_calling && _calling_thread_id == std::this_thread::get_id()) {
+        return;
+    }
+    _callback_done_cv.wait(lock, [this]() { return !_calling; });
+}
 
-                // Unlock while we call back because it might in turn want to add timeouts.
-                _entries_mutex.unlock();
-                callback();
-                _entries_mutex.lock();
-            }
-        }
+std::optional<SteadyTimePoint> CallEveryHandler::next_wakeup()
+{
+    std::lock_guard<std::mutex> lock(_entries_mutex);
+    return _timer_wheel.next_wakeup();
+}
 
-        // We leave the loop.
-        // FIXME: there should be a nicer way to do this.
-        if (_iterator_invalidated) {
-            _iterator_invalidated = false;
-            break;
-        }
+void CallEveryHandler::set_wakeup_callback(std::function<void(SteadyTimePoint)> callback)
+{
+    std::lock_guard<std::mutex> lock(_wakeup_callback_mutex);
+    _wakeup_callback = std::move(callback);
+}
+
+SteadyTimePoint CallEveryHandler::schedule(Entry& entry)
+{
+    auto due_time = entry.last_time;
+    _time.shift_steady_time_by(due_time, entry.interval_s);
+    _timer_wheel.schedule(entry, due_time);
+    return due_time;
+}
+
+void CallEveryHandler::notify_wakeup(SteadyTimePoint due_time)
+{
+    std::lock_guard<std::mutex> lock(_wakeup_callback_mutex);
+    if (_wakeup_callback) {
+        _wakeup_callback(due_time);
     }
-    _entries_mutex.unlock();
 }
 
 } // namespace mavsdk
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <condition_variable>
 #include <mutex>
 #include <memory>
 #include <functional>
+#include <optional>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 #include "mavsdk_time.h"
+#include "timer_wheel.h"
 
 namespace mavsdk {
 
@@ -26,18 +31,42 @@ public:
 
     void run_once();
 
+    // Blocks until the callback being called by run_once(), if any, has
+    // returned. A callback that has been removed might still be running,
+    // so this is needed before what it uses goes away. Returns straightaway
+    // when called from a callback.
+    void wait_for_callback();
+
+    // Earliest time at which run_once() has something to do.
+    std::optional<SteadyTimePoint> next_wakeup();
+
+    // Called with the new due time whenever an entry is added or changed,
+    // so that whoever calls run_once() can wake up earlier if needed.
+    void set_wakeup_callback(std::function<void(SteadyTimePoint)> callback);
+
 private:
-    struct Entry {
+    struct Entry : public TimerWheel::Timer {
         std::function<void()> callback{nullptr};
         SteadyTimePoint last_time{};
         double interval_s{0.0};
     };
 
-    std::unordered_map<void*, std::shared_ptr<Entry>> _entries{};
+    SteadyTimePoint schedule(Entry& entry);
+    void notify_wakeup(SteadyTimePoint due_time);
+
+    std::unordered_map<void*, std::unique_ptr<Entry>> _entries{};
     std::mutex _entries_mutex{};
-    bool _iterator_invalidated{false};
+    std::vector<void*> _called{};
+
+    std::condition_variable _callback_done_cv{};
+    bool _calling{false};
+    std::thread::id _calling_thread_id{};
 
     Time& _time;
+    TimerWheel _timer_wheel{};
+
+    std::mutex _wakeup_callback_mutex{};
+    std::function<void(SteadyTimePoint)> _wakeup_callback{nullptr};
 };
 
 } // namespace mavsdk
@@ -1,5 +1,7 @@
 #include "call_every_handler.h"
 #include "unused.h"
+#include <atomic>
+#include <thread>
 #include <gtest/gtest.h>
 
 #ifdef FAKE_TIME
@@ -143,3 +145,66 @@ TEST(CallEveryHandler, CallImmediately)
     }
     EXPECT_EQ(num_called, 1);
 }
+
+TEST(CallEveryHandler, WaitForRemovedCallbackStillRunning)
+{
+    Time time{};
+    CallEveryHandler ceh(time);
+
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    std::atomic<bool> returned{false};
+
+    void* cookie = nullptr;
+    ceh.add(
+        [&]() {
+            started = true;
+            while (!release) {
+                std::this_thread::yield();
+            }
+            returned = true;
+        },
+        0.1,
+        &cookie);
+
+    std::thread run_thread([&ceh]() { ceh.run_once(); });
+    while (!started) {
+        std::this_thread::yield();
+    }
+
+    // Removing does not wait, so that a callback can be removed while holding
+    // a lock the callback needs.
+    ceh.remove(cookie);
+    EXPECT_FALSE(returned);
+
+    std::thread release_thread([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        release = true;
+    });
+    ceh.wait_for_callback();
+    EXPECT_TRUE(returned);
+
+    release_thread.join();
+    run_thread.join();
+}
+
+TEST(CallEveryHandler, WaitForCallbackFromCallback)
+{
+    Time time{};
+    CallEveryHandler ceh(time);
+
+    int num_called = 0;
+
+    void* cookie = nullptr;
+    ceh.add(
+        [&]() {
+            ceh.remove(cookie);
+            ceh.wait_for_callback();
+            ++num_called;
+        },
+        0.1,
+        &cookie);
+
+    ceh.run_once();
+    EXPECT_EQ(num_called, 1);
+}
@@ -0,0 +1,101 @@
+#include "log.h"
+#include "mavsdk_impl.h"
+#include "unittests_allocation_counter.h"
+#include "plugins/telemetry/telemetry.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+// A telemetry message is received by MavsdkImpl and dispatched through the
+// message handler to TelemetryImpl, which stores the value and queues the
+// user callbacks. These are then run on the user callback thread.
+TEST(CallbackAllocation, SteadyStateMessageDispatchDoesNotAllocate)
+{
+    MavsdkImpl mavsdk_impl;
+
+    auto receive = [&mavsdk_impl](mavlink_message_t message) {
+        mavsdk_impl.receive_message(message, nullptr);
+    };
+
+    auto wait_until = [](const auto& condition) {
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (!condition() && std::chrono::steady_clock::now() < timeout) {
+            std::this_thread::yield();
+        }
+        return condition();
+    };
+
+    // Count what is done on the user callback thread as well.
+    auto set_counting_on_callback_thread = [&](bool enabled) {
+        std::atomic<bool> done{false};
+        mavsdk_impl.call_user_callback([&done, enabled]() {
+            AllocationCounter::set_enabled_on_this_thread(enabled);
+            done = true;
+        });
+        return wait_until([&done]() { return done.load(); });
+    };
+
+    mavlink_message_t heartbeat;
+    mavlink_msg_heartbeat_pack(
+        1,
+        MAV_COMP_ID_AUTOPILOT1,
+        &heartbeat,
+        MAV_TYPE_QUADROTOR,
+        MAV_AUTOPILOT_PX4,
+        0,
+        0,
+        MAV_STATE_ACTIVE);
+    receive(heartbeat);
+    ASSERT_EQ(mavsdk_impl.systems().size(), 1u);
+
+    auto telemetry = Telemetry{mavsdk_impl.systems().front()};
+
+    std::atomic<unsigned> num_every_called{0};
+    std::atomic<unsigned> num_latest_called{0};
+
+    telemetry.subscribe_attitude_euler([&](Telemetry::EulerAngle) { ++num_every_called; });
+    Telemetry::SubscriptionOptions conflated;
+    conflated.conflate = true;
+    ASSERT_EQ(
+        telemetry
+            .subscribe_attitude_euler(
+                [&](Telemetry::EulerAngle) { ++num_latest_called; }, conflated)
+            .first,
+        Telemetry::Result::Success);
+
+    // Each message is let through before the next one is received, as the
+    // user callback queue drops callbacks, and logs, once it is backed up.
+    auto receive_attitude = [&](unsigned i) {
+        mavlink_message_t message;
+        mavlink_msg_attitude_pack(
+            1, MAV_COMP_ID_AUTOPILOT1, &message, i, 0.001f * i, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        receive(message);
+        return wait_until([&]() { return num_every_called == i + 1; });
+    };
+
+    // Let queues and lookup tables settle first.
+    for (unsigned i = 0; i < 100; ++i) {
+        ASSERT_TRUE(receive_attitude(i));
+    }
+
+    AllocationCounter::reset();
+    ASSERT_TRUE(set_counting_on_callback_thread(true));
+    AllocationCounter::set_enabled_on_this_thread(true);
+    bool all_received = true;
+    for (unsigned i = 100; i < 1100 && all_received; ++i) {
+        all_received = receive_attitude(i);
+    }
+    AllocationCounter::set_enabled_on_this_thread(false);
+    ASSERT_TRUE(all_received);
+    ASSERT_TRUE(set_counting_on_callback_thread(false));
+
+    EXPECT_EQ(AllocationCounter::num_allocations(), 0u);
+    EXPECT_EQ(num_every_called, 1100u);
+
+    // Conflated callbacks may skip values.
+    EXPECT_GT(num_latest_called, 0u);
+    EXPECT_LE(num_latest_called, 1100u);
+}
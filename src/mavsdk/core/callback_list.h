@@ -7,20 +7,44 @@
 #include <utility>
 #include <vector>
 #include "handle.h"
+#include "inplace_function.h"
 
 namespace mavsdk {
 
+// How CallbackList::queue() hands emissions to a subscriber.
+enum class CallbackQueueMode {
+    // Every emission is queued for the subscriber.
+    Every,
+    // At most one invocation is pending per subscriber, and it is called
+    // with the newest value once it runs. Intermediate values are dropped.
+    Latest,
+};
+
+// A call handed out by CallbackList::queue() to be run later. It is stored
+// inline, so queueing a callback does not need to allocate.
+using QueuedCallback = InplaceFunction<void(), 64>;
+
+// Rate limits below this are raised to it. More than about 17 minutes between
+// callbacks is hardly meant, and much lower rates overflow the interval.
+constexpr double CALLBACK_MIN_RATE_HZ = 0.001;
+
 template<typename... Args> class CallbackList {
 public:
     CallbackList();
     ~CallbackList();
 
-    Handle<Args...> subscribe(const std::function<void(Args...)>& callback);
+    // A max_rate_hz above 0 limits how often the callback is called or
+    // queued, emissions in between are dropped for this subscriber. It is at
+    // least CALLBACK_MIN_RATE_HZ.
+    Handle<Args...> subscribe(
+        const std::function<void(Args...)>& callback,
+        CallbackQueueMode queue_mode = CallbackQueueMode::Every,
+        double max_rate_hz = 0.0);
     void unsubscribe(Handle<Args...> handle);
     void operator()(Args... args);
     [[nodiscard]] bool empty();
     void clear();
-    void queue(Args... args, const std::function<void(const std::function<void()>&)>& queue_func);
+    void queue(Args... args, const std::function<void(const QueuedCallback&)>& queue_func);
 
 private:
     std::unique_ptr<CallbackListImpl<Args...>> _impl;
@@ -15,9 +15,10 @@ template<typename... Args>
 CallbackList<Args...>::~CallbackList() = default;
 
 template<typename... Args>
-Handle<Args...> CallbackList<Args...>::subscribe(const std::function<void(Args...)>& callback)
+Handle<Args...> CallbackList<Args...>::subscribe(
+    const std::function<void(Args...)>& callback, CallbackQueueMode queue_mode, double max_rate_hz)
 {
-    return _impl->subscribe(callback);
+    return _impl->subscribe(callback, queue_mode, max_rate_hz);
 }
 
 template<typename... Args> void CallbackList<Args...>::unsubscribe(Handle<Args...> handle)
@@ -40,7 +41,9 @@ template<typename... Args> void CallbackList<Args...>::clear()
     _impl->clear();
 }
 
-template<typename... Args> void CallbackList<Args...>::queue(Args... args, const std::function<void(const std::function<void()>&)>& queue_func)
+template<typename... Args>
+void CallbackList<Args...>::queue(
+    Args... args, const std::function<void(const QueuedCallback&)>& queue_func)
 {
     _impl->queue(args..., queue_func);
 }
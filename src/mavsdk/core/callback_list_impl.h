@@ -1,9 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include "log.h"
@@ -11,11 +19,19 @@
 
 namespace mavsdk {
 
+// The subscriptions are kept in an immutable list which is replaced as a
+// whole on subscribe and unsubscribe. Calling the callbacks therefore only
+// needs to grab the current list, and no lock is held while iterating over it.
+// This also means that subscribing or unsubscribing from within a callback is
+// fine, the change just takes effect for the next call.
 template<typename... Args> class CallbackListImpl {
 public:
-    Handle<Args...> subscribe(const std::function<void(Args...)>& callback)
+    Handle<Args...> subscribe(
+        const std::function<void(Args...)>& callback,
+        CallbackQueueMode queue_mode,
+        double max_rate_hz)
     {
-        check_removals();
+        std::lock_guard<std::mutex> lock(_write_mutex);
 
         // We need to return a handle, even if the callback is nullptr to
         // unsubscribe. That's fine, the handle just won't remove anything
@@ -23,12 +39,18 @@ public:
         auto handle = Handle<Args...>(_last_id++);
 
         if (callback != nullptr) {
-            std::lock_guard<std::mutex> lock(_mutex);
-            _list.emplace_back(handle, callback);
+            auto new_list = std::make_shared<SubscriptionList>(*subscriptions());
+            new_list->push_back(Subscription{
+                handle,
+                callback,
+                queue_mode == CallbackQueueMode::Latest ? std::make_shared<Pending>() :
+                                                          nullptr,
+                max_rate_hz > 0.0 ? std::make_shared<RateLimit>(max_rate_hz) : nullptr});
+            set_subscriptions(std::move(new_list));
         } else {
             LogErr() << "Use new unsubscribe methods instead of subscribe(nullptr)\n"
                      << "See: https://mavsdk.mavlink.io/main/en/cpp/api_changes.html#unsubscribe";
-            try_clear();
+            set_subscriptions(std::make_shared<SubscriptionList>());
         }
 
         return handle;
@@ -42,103 +64,194 @@ public:
             return;
         }
 
-        // We want to allow unsubscribing while in a callback. This would
-        // normally lead to a deadlock. Therefore, we just try to grab the
-        // lock here, and if it's already taken, we schedule the removal
-        // for later.
-        std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
-        if (lock.owns_lock()) {
-            _list.erase(
-                std::remove_if(
-                    _list.begin(),
-                    _list.end(),
-                    [&](auto& pair) { return pair.first._id == handle._id; }),
-                _list.end());
-        } else {
-            std::lock_guard<std::mutex> remove_later_lock(_remove_later_mutex);
-            _remove_later.push_back(handle._id);
+        std::lock_guard<std::mutex> lock(_write_mutex);
+
+        const auto current = subscriptions();
+        auto new_list = std::make_shared<SubscriptionList>();
+        new_list->reserve(current->size());
+        std::copy_if(
+            current->begin(),
+            current->end(),
+            std::back_inserter(*new_list),
+            [&](const auto& subscription) { return subscription.handle._id != handle._id; });
+
+        if (new_list->size() != current->size()) {
+            set_subscriptions(std::move(new_list));
         }
     }
 
     void exec(Args... args)
     {
-        check_removals();
-
-        std::lock_guard<std::mutex> lock(_mutex);
-        for (const auto& pair : _list) {
-            pair.second(args...);
+        const auto current = subscriptions();
+        for (const auto& subscription : *current) {
+            if (is_due(subscription)) {
+                subscription.callback(args...);
+            }
         }
     }
 
-    void queue(Args... args, const std::function<void(const std::function<void()>&)>& queue_func)
+    void queue(Args... args, const std::function<void(const QueuedCallback&)>& queue_func)
     {
-        check_removals();
+        const auto current = subscriptions();
 
-        std::lock_guard<std::mutex> lock(_mutex);
+        // Small, trivially copyable arguments are copied into each queued
+        // call, which is cheaper than allocating a payload to share. Anything
+        // else is copied once per emission, and all subscribers share it.
+        std::shared_ptr<const Emission> emission;
 
-        for (const auto& pair : _list) {
-            queue_func([callback = pair.second, args...]() { callback(args...); });
-        }
-    }
+        for (const auto& subscription : *current) {
+            // Rate limited subscriptions are skipped before anything is
+            // queued, so they don't add load to the callback queue.
+            if (!is_due(subscription)) {
+                continue;
+            }
 
-    bool empty()
-    {
-        check_removals();
+            if (subscription.pending == nullptr) {
+                if constexpr (ARGS_FIT_INLINE) {
+                    queue_func(QueuedCallback([current, subscription = &subscription, args...]() {
+                        subscription->callback(args...);
+                    }));
+                } else {
+                    if (emission == nullptr) {
+                        emission = std::make_shared<const Emission>(
+                            Emission{current, ArgsTuple(args...)});
+                    }
+                    queue_func(QueuedCallback([emission, subscription = &subscription]() {
+                        std::apply(subscription->callback, emission->args);
+                    }));
+                }
+                continue;
+            }
+
+            // Conflated subscription: if an invocation is already waiting in
+            // the queue we only replace the value it is going to be called with.
+            bool already_queued;
+            {
+                std::lock_guard<std::mutex> pending_lock(subscription.pending->mutex);
+                already_queued = subscription.pending->args.has_value();
+                subscription.pending->args.emplace(args...);
+            }
 
-        std::lock_guard<std::mutex> lock(_mutex);
-        return _list.empty();
+            if (!already_queued) {
+                queue_func(QueuedCallback([current, subscription = &subscription]() {
+                    std::optional<ArgsTuple> latest_args;
+                    {
+                        std::lock_guard<std::mutex> pending_lock(subscription->pending->mutex);
+                        latest_args.swap(subscription->pending->args);
+                    }
+                    if (latest_args) {
+                        std::apply(subscription->callback, std::move(latest_args.value()));
+                    }
+                }));
+            }
+        }
     }
 
+    bool empty() { return subscriptions()->empty(); }
+
     void clear()
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        return _list.clear();
+        std::lock_guard<std::mutex> lock(_write_mutex);
+        set_subscriptions(std::make_shared<SubscriptionList>());
     }
 
 private:
-    void check_removals()
+    using ArgsTuple = std::tuple<std::decay_t<Args>...>;
+
+    // Room left in a queued call next to the subscription list and the
+    // subscription, minus some slack for padding between the arguments.
+    static constexpr size_t INLINE_ARGS_CAPACITY = QueuedCallback::capacity -
+                                                   sizeof(std::shared_ptr<const void>) -
+                                                   sizeof(void*) - alignof(std::max_align_t);
+
+    static constexpr bool ARGS_FIT_INLINE =
+        (std::is_trivially_copyable_v<std::decay_t<Args>> && ...) &&
+        (sizeof(std::decay_t<Args>) + ... + 0) <= INLINE_ARGS_CAPACITY;
+
+    // Newest arguments of a conflated subscription, set while an invocation
+    // is waiting in the queue.
+    struct Pending {
+        std::mutex mutex{};
+        std::optional<ArgsTuple> args{};
+    };
+
+    // Earliest time the next emission is passed on to a rate limited
+    // subscription.
+    struct RateLimit {
+        explicit RateLimit(double max_rate_hz) :
+            interval_ns(static_cast<int64_t>(1e9 / std::max(max_rate_hz, CALLBACK_MIN_RATE_HZ)))
+        {}
+
+        const int64_t interval_ns;
+        std::atomic<int64_t> next_ns{0};
+    };
+
+    struct Subscription {
+        Handle<Args...> handle;
+        std::function<void(Args...)> callback;
+        std::shared_ptr<Pending> pending; // nullptr unless CallbackQueueMode::Latest
+        std::shared_ptr<RateLimit> rate_limit; // nullptr unless rate limited
+    };
+
+    static bool is_due(const Subscription& subscription)
     {
-        std::lock_guard<std::mutex> remove_later_lock(_remove_later_mutex);
-
-        // We could probably just grab the lock here but it's safer not to
-        // acquire both locks to avoid deadlocks.
-        if (_mutex.try_lock()) {
-            if (_remove_all_later) {
-                _remove_all_later = false;
-                _list.clear();
-                _remove_later.clear();
-            }
+        if (subscription.rate_limit == nullptr) {
+            return true;
+        }
+
+        auto& rate_limit = *subscription.rate_limit;
+        const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count();
 
-            for (auto& id : _remove_later) {
-                _list.erase(
-                    std::remove_if(
-                        _list.begin(),
-                        _list.end(),
-                        [&](auto& pair) { return pair.first._id == id; }),
-                    _list.end());
+        int64_t next_ns = rate_limit.next_ns.load(std::memory_order_relaxed);
+        int64_t new_next_ns;
+        do {
+            if (now_ns < next_ns) {
+                return false;
             }
-            _mutex.unlock();
-        }
+            // Step from the previous deadline rather than from now, so jitter
+            // of the incoming messages doesn't lower the rate, unless we are
+            // behind by more than an interval.
+            new_next_ns = now_ns - next_ns < rate_limit.interval_ns ?
+                              next_ns + rate_limit.interval_ns :
+                              now_ns + rate_limit.interval_ns;
+        } while (!rate_limit.next_ns.compare_exchange_weak(
+            next_ns, new_next_ns, std::memory_order_relaxed));
+
+        return true;
     }
 
-    void try_clear()
+    using SubscriptionList = std::vector<Subscription>;
+
+    // Arguments of one call to queue(), together with the subscriptions they
+    // are for, so the queued calls can refer to both without copying them.
+    struct Emission {
+        std::shared_ptr<const SubscriptionList> subscriptions;
+        ArgsTuple args;
+    };
+
+    [[nodiscard]] std::shared_ptr<const SubscriptionList> subscriptions() const
     {
-        std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
-        if (lock.owns_lock()) {
-            _list.clear();
-        } else {
-            std::lock_guard<std::mutex> remove_later_lock(_remove_later_mutex);
-            _remove_all_later = true;
-        }
+        std::lock_guard<std::mutex> lock(_subscriptions_mutex);
+        return _subscriptions;
     }
 
-    mutable std::mutex _mutex{};
-    uint64_t _last_id{1}; // Start at 1 because 0 is the "null handle"
-    std::vector<std::pair<Handle<Args...>, std::function<void(Args...)>>> _list{};
+    // Requires _write_mutex to be held.
+    void set_subscriptions(std::shared_ptr<const SubscriptionList> new_list)
+    {
+        std::lock_guard<std::mutex> lock(_subscriptions_mutex);
+        _subscriptions.swap(new_list);
+    }
 
-    mutable std::mutex _remove_later_mutex{};
-    std::vector<uint64_t> _remove_later{};
-    bool _remove_all_later{false};
+    // Only held to swap or copy the pointer, never while calling callbacks.
+    mutable std::mutex _subscriptions_mutex{};
+    std::shared_ptr<const SubscriptionList> _subscriptions{
+        std::make_shared<const SubscriptionList>()};
+
+    // Serializes changes to the subscriptions.
+    std::mutex _write_mutex{};
+    uint64_t _last_id{1}; // Start at 1 because 0 is the "null handle"
 };
 
 } // namespace mavsdk
@@ -1,6 +1,9 @@
 #include "callback_list.h"
 #include "callback_list.tpp"
 #include "log.h"
+#include <chrono>
+#include <thread>
+#include <limits>
 #include <gtest/gtest.h>
 
 namespace mavsdk {
@@ -98,3 +101,187 @@ TEST(CallbackList, UnsubscribeAllWithNullptr)
     // It should only be called once.
     EXPECT_EQ(num_called, 1);
 }
+
+TEST(CallbackList, QueueEveryAndLatest)
+{
+    std::vector<std::function<void()>> queued;
+    auto queue_func = [&](const std::function<void()>& func) { queued.push_back(func); };
+
+    std::vector<int> every_received;
+    std::vector<int> latest_received;
+
+    CallbackList<int, double> cl;
+    cl.subscribe([&](int i, double) { every_received.push_back(i); });
+    cl.subscribe(
+        [&](int i, double) { latest_received.push_back(i); }, CallbackQueueMode::Latest);
+
+    // Nothing is run yet, so the conflated subscription only has one pending call.
+    cl.queue(1, 1.1, queue_func);
+    cl.queue(2, 2.2, queue_func);
+    cl.queue(3, 3.3, queue_func);
+    EXPECT_EQ(queued.size(), 4);
+
+    for (auto& func : queued) {
+        func();
+    }
+    queued.clear();
+
+    EXPECT_EQ(every_received, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(latest_received, (std::vector<int>{3}));
+
+    // Once the pending call has run, the next value is queued again.
+    cl.queue(4, 4.4, queue_func);
+    EXPECT_EQ(queued.size(), 2);
+
+    for (auto& func : queued) {
+        func();
+    }
+
+    EXPECT_EQ(every_received, (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_EQ(latest_received, (std::vector<int>{3, 4}));
+}
+
+struct CopyCounter {
+    CopyCounter() = default;
+    CopyCounter(const CopyCounter& other) : payload(other.payload) { ++num_copies; }
+    CopyCounter& operator=(const CopyCounter& other)
+    {
+        payload = other.payload;
+        ++num_copies;
+        return *this;
+    }
+
+    std::vector<float> payload{};
+    static inline unsigned num_copies{0};
+};
+
+namespace mavsdk {
+template class CallbackList<CopyCounter>;
+} // namespace mavsdk
+
+TEST(CallbackList, QueueSharesArgumentsBetweenSubscribers)
+{
+    std::vector<std::function<void()>> queued;
+    auto queue_func = [&](const std::function<void()>& func) { queued.push_back(func); };
+
+    auto copies_for_subscribers = [&](unsigned num_subscribers) {
+        CallbackList<CopyCounter> cl;
+        unsigned num_called = 0;
+        for (unsigned i = 0; i < num_subscribers; ++i) {
+            cl.subscribe([&](const CopyCounter& value) {
+                EXPECT_EQ(value.payload.size(), 21);
+                ++num_called;
+            });
+        }
+
+        CopyCounter value;
+        value.payload.resize(21);
+
+        CopyCounter::num_copies = 0;
+        cl.queue(value, queue_func);
+        const unsigned num_copies = CopyCounter::num_copies;
+
+        EXPECT_EQ(queued.size(), num_subscribers);
+        for (auto& func : queued) {
+            func();
+        }
+        queued.clear();
+        EXPECT_EQ(num_called, num_subscribers);
+
+        return num_copies;
+    };
+
+    // The arguments are copied once per emission, not once per subscriber.
+    EXPECT_EQ(copies_for_subscribers(1), copies_for_subscribers(10));
+}
+
+TEST(CallbackList, SubscribeFromCallback)
+{
+    unsigned outer_called = 0;
+    unsigned inner_called = 0;
+
+    CallbackList<> cl;
+    cl.subscribe([&]() {
+        if (outer_called++ == 0) {
+            cl.subscribe([&]() { ++inner_called; });
+        }
+    });
+
+    // The new subscription only takes effect for the next call.
+    cl();
+    EXPECT_EQ(inner_called, 0);
+    cl();
+    EXPECT_EQ(outer_called, 2);
+    EXPECT_EQ(inner_called, 1);
+}
+
+TEST(CallbackList, QueueRateLimited)
+{
+    std::vector<std::function<void()>> queued;
+    auto queue_func = [&](const std::function<void()>& func) { queued.push_back(func); };
+
+    unsigned num_every_received = 0;
+    std::vector<int> limited_received;
+
+    CallbackList<int, double> cl;
+    cl.subscribe([&](int, double) { ++num_every_received; });
+    cl.subscribe(
+        [&](int i, double) { limited_received.push_back(i); }, CallbackQueueMode::Every, 10.0);
+
+    // A burst only gets the first value through to the limited subscription,
+    // the rest is not even queued.
+    for (int i = 1; i <= 100; ++i) {
+        cl.queue(i, 0.0, queue_func);
+    }
+    EXPECT_EQ(queued.size(), 101);
+
+    // After the interval has passed, the next value is let through again.
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    cl.queue(101, 0.0, queue_func);
+    EXPECT_EQ(queued.size(), 103);
+
+    for (auto& func : queued) {
+        func();
+    }
+
+    EXPECT_EQ(num_every_received, 101u);
+    EXPECT_EQ(limited_received, (std::vector<int>{1, 101}));
+}
+
+TEST(CallbackList, TinyRateLimitIsRaisedToMinimum)
+{
+    std::vector<std::function<void()>> queued;
+    auto queue_func = [&](const std::function<void()>& func) { queued.push_back(func); };
+
+    std::vector<int> received;
+
+    CallbackList<int> cl;
+    // 1e9 / rate would not fit the interval.
+    cl.subscribe(
+        [&](int i) { received.push_back(i); },
+        CallbackQueueMode::Every,
+        std::numeric_limits<double>::denorm_min());
+    cl.subscribe([&](int i) { received.push_back(i); }, CallbackQueueMode::Every, 1e-12);
+
+    cl.queue(1, queue_func);
+    cl.queue(2, queue_func);
+    for (auto& func : queued) {
+        func();
+    }
+
+    // Both are limited to one callback every 1000 s.
+    EXPECT_EQ(received, (std::vector<int>{1, 1}));
+}
+
+TEST(CallbackList, EmptyQueuedCallbackDoesNothing)
+{
+    QueuedCallback empty;
+    EXPECT_FALSE(empty);
+    empty();
+
+    QueuedCallback reset{[]() {}};
+    EXPECT_TRUE(reset);
+    reset = nullptr;
+    EXPECT_FALSE(reset);
+    reset();
+}
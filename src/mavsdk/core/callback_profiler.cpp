@@ -0,0 +1,126 @@
+#include "callback_profiler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mavsdk {
+
+CallbackProfiler::Site& CallbackProfiler::site(const char* filename, int linenumber)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto location_it = _sites_by_location.find(Location{filename, linenumber});
+    if (location_it != _sites_by_location.end()) {
+        return *location_it->second;
+    }
+
+    auto file_it = _sites.find(filename);
+    if (file_it == _sites.end()) {
+        file_it = _sites.emplace(filename, std::unordered_map<int, std::unique_ptr<Site>>{}).first;
+    }
+
+    auto& site_ptr = file_it->second[linenumber];
+    if (!site_ptr) {
+        site_ptr = std::make_unique<Site>(filename, linenumber);
+    }
+    _sites_by_location.emplace(Location{filename, linenumber}, site_ptr.get());
+    return *site_ptr;
+}
+
+void CallbackProfiler::record(
+    Site& site, std::chrono::nanoseconds queue_time, std::chrono::nanoseconds run_time)
+{
+    site.count.fetch_add(1, std::memory_order_relaxed);
+    add(site.queue_time, queue_time);
+    add(site.run_time, run_time);
+}
+
+std::vector<Mavsdk::CallbackStatistics> CallbackProfiler::statistics() const
+{
+    auto to_s = [](const std::atomic<uint64_t>& ns) {
+        return static_cast<double>(ns.load(std::memory_order_relaxed)) * 1e-9;
+    };
+    auto to_vector = [](const Histogram& histogram) {
+        std::vector<uint64_t> buckets;
+        buckets.reserve(histogram.buckets.size());
+        for (const auto& bucket : histogram.buckets) {
+            buckets.push_back(bucket.load(std::memory_order_relaxed));
+        }
+        return buckets;
+    };
+
+    std::vector<Mavsdk::CallbackStatistics> result;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& file : _sites) {
+        for (const auto& line : file.second) {
+            const Site& site = *line.second;
+
+            Mavsdk::CallbackStatistics statistics;
+            statistics.filename = site.filename;
+            statistics.linenumber = site.linenumber;
+            statistics.count = site.count.load(std::memory_order_relaxed);
+            statistics.run_time_total_s = to_s(site.run_time.total_ns);
+            statistics.run_time_max_s = to_s(site.run_time.max_ns);
+            statistics.run_time_histogram = to_vector(site.run_time);
+            statistics.queue_time_total_s = to_s(site.queue_time.total_ns);
+            statistics.queue_time_max_s = to_s(site.queue_time.max_ns);
+            statistics.queue_time_histogram = to_vector(site.queue_time);
+            result.push_back(std::move(statistics));
+        }
+    }
+
+    // Worst offenders first.
+    std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.run_time_total_s > rhs.run_time_total_s;
+    });
+
+    return result;
+}
+
+void CallbackProfiler::reset()
+{
+    auto clear = [](Histogram& histogram) {
+        for (auto& bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.total_ns.store(0, std::memory_order_relaxed);
+        histogram.max_ns.store(0, std::memory_order_relaxed);
+    };
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& file : _sites) {
+        for (auto& line : file.second) {
+            line.second->count.store(0, std::memory_order_relaxed);
+            clear(line.second->run_time);
+            clear(line.second->queue_time);
+        }
+    }
+}
+
+size_t CallbackProfiler::bucket_index(std::chrono::nanoseconds duration)
+{
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+    // Bucket i > 0 holds [2^(i-1), 2^i) us, which is the number of bits needed for us.
+    size_t index = 0;
+    for (auto remaining = us; remaining > 0 && index < NUM_BUCKETS - 1; remaining >>= 1) {
+        ++index;
+    }
+    return index;
+}
+
+void CallbackProfiler::add(Histogram& histogram, std::chrono::nanoseconds duration)
+{
+    const auto ns =
+        static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+
+    histogram.buckets[bucket_index(duration)].fetch_add(1, std::memory_order_relaxed);
+    histogram.total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    auto max_ns = histogram.max_ns.load(std::memory_order_relaxed);
+    while (ns > max_ns &&
+           !histogram.max_ns.compare_exchange_weak(max_ns, ns, std::memory_order_relaxed)) {}
+}
+
+} // namespace mavsdk
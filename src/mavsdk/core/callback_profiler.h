@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "mavsdk.h"
+
+namespace mavsdk {
+
+// Collects how long user callbacks wait in the queue and how long they take to
+// run, per place in the code where they were queued.
+//
+// Looking up a site takes a lock, recording into it afterwards does not, so a
+// site is looked up when a callback is queued and the timing recorded once it
+// has run. Sites are found by the address of the filename first, which is
+// expected to be a string literal, so a lookup does not allocate.
+class CallbackProfiler {
+public:
+    static constexpr size_t NUM_BUCKETS = Mavsdk::NUM_CALLBACK_HISTOGRAM_BUCKETS;
+
+    struct Histogram {
+        std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets{};
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+    };
+
+    struct Site {
+        Site(std::string filename_, int linenumber_) :
+            filename(std::move(filename_)),
+            linenumber(linenumber_)
+        {}
+
+        const std::string filename;
+        const int linenumber;
+        std::atomic<uint64_t> count{0};
+        Histogram run_time{};
+        Histogram queue_time{};
+    };
+
+    CallbackProfiler() = default;
+    ~CallbackProfiler() = default;
+
+    // delete copy and move constructors and assign operators
+    CallbackProfiler(CallbackProfiler const&) = delete; // Copy construct
+    CallbackProfiler(CallbackProfiler&&) = delete; // Move construct
+    CallbackProfiler& operator=(CallbackProfiler const&) = delete; // Copy assign
+    CallbackProfiler& operator=(CallbackProfiler&&) = delete; // Move assign
+
+    // The site stays valid for the lifetime of the profiler. The filename
+    // needs to outlive the profiler as well.
+    Site& site(const char* filename, int linenumber);
+
+    static void
+    record(Site& site, std::chrono::nanoseconds queue_time, std::chrono::nanoseconds run_time);
+
+    std::vector<Mavsdk::CallbackStatistics> statistics() const;
+    void reset();
+
+    static size_t bucket_index(std::chrono::nanoseconds duration);
+
+private:
+    static void add(Histogram& histogram, std::chrono::nanoseconds duration);
+
+    using Location = std::pair<const char*, int>;
+
+    struct LocationHash {
+        size_t operator()(const Location& location) const
+        {
+            return std::hash<const char*>{}(location.first) ^
+                   (std::hash<int>{}(location.second) << 1);
+        }
+    };
+
+    mutable std::mutex _mutex{};
+    std::unordered_map<std::string, std::unordered_map<int, std::unique_ptr<Site>>> _sites{};
+    // The same file can show up with different addresses, e.g. from headers
+    // included in several places, which all map to the same site.
+    std::unordered_map<Location, Site*, LocationHash> _sites_by_location{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,76 @@
+#include "callback_profiler.h"
+#include <chrono>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+
+TEST(CallbackProfiler, BucketIndex)
+{
+    EXPECT_EQ(CallbackProfiler::bucket_index(nanoseconds(-5)), 0u);
+    EXPECT_EQ(CallbackProfiler::bucket_index(nanoseconds(999)), 0u);
+    EXPECT_EQ(CallbackProfiler::bucket_index(microseconds(1)), 1u);
+    EXPECT_EQ(CallbackProfiler::bucket_index(microseconds(2)), 2u);
+    EXPECT_EQ(CallbackProfiler::bucket_index(microseconds(3)), 2u);
+    EXPECT_EQ(CallbackProfiler::bucket_index(microseconds(4)), 3u);
+    EXPECT_EQ(CallbackProfiler::bucket_index(milliseconds(1)), 10u);
+    EXPECT_EQ(
+        CallbackProfiler::bucket_index(std::chrono::hours(1)), CallbackProfiler::NUM_BUCKETS - 1);
+}
+
+TEST(CallbackProfiler, SameSiteForSameLocation)
+{
+    CallbackProfiler profiler;
+
+    auto& site1 = profiler.site("telemetry_impl.cpp", 42);
+    auto& site2 = profiler.site("telemetry_impl.cpp", 43);
+    auto& site3 = profiler.site("action_impl.cpp", 42);
+
+    EXPECT_EQ(&site1, &profiler.site("telemetry_impl.cpp", 42));
+    EXPECT_NE(&site1, &site2);
+    EXPECT_NE(&site1, &site3);
+}
+
+TEST(CallbackProfiler, Statistics)
+{
+    CallbackProfiler profiler;
+
+    auto& fast = profiler.site("fast.cpp", 1);
+    auto& slow = profiler.site("slow.cpp", 2);
+
+    CallbackProfiler::record(fast, microseconds(10), microseconds(3));
+    CallbackProfiler::record(fast, microseconds(20), microseconds(5));
+    CallbackProfiler::record(slow, milliseconds(2), milliseconds(1));
+
+    const auto statistics = profiler.statistics();
+    ASSERT_EQ(statistics.size(), 2u);
+
+    // Sorted by time spent.
+    EXPECT_EQ(statistics[0].filename, "slow.cpp");
+    EXPECT_EQ(statistics[0].linenumber, 2);
+    EXPECT_EQ(statistics[0].count, 1u);
+    EXPECT_DOUBLE_EQ(statistics[0].run_time_total_s, 0.001);
+    EXPECT_DOUBLE_EQ(statistics[0].queue_time_max_s, 0.002);
+    EXPECT_EQ(statistics[0].run_time_histogram[10], 1u);
+
+    EXPECT_EQ(statistics[1].filename, "fast.cpp");
+    EXPECT_EQ(statistics[1].count, 2u);
+    EXPECT_DOUBLE_EQ(statistics[1].run_time_total_s, 8e-6);
+    EXPECT_DOUBLE_EQ(statistics[1].run_time_max_s, 5e-6);
+    EXPECT_DOUBLE_EQ(statistics[1].queue_time_total_s, 30e-6);
+    ASSERT_EQ(statistics[1].run_time_histogram.size(), CallbackProfiler::NUM_BUCKETS);
+    EXPECT_EQ(statistics[1].run_time_histogram[2], 1u);
+    EXPECT_EQ(statistics[1].run_time_histogram[3], 1u);
+    EXPECT_EQ(statistics[1].queue_time_histogram[4], 1u);
+    EXPECT_EQ(statistics[1].queue_time_histogram[5], 1u);
+
+    profiler.reset();
+
+    for (const auto& entry : profiler.statistics()) {
+        EXPECT_EQ(entry.count, 0u);
+        EXPECT_EQ(entry.run_time_total_s, 0.0);
+        EXPECT_EQ(entry.queue_time_max_s, 0.0);
+    }
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+// The awaitable API is only available if the code using MAVSDK is compiled
+// with C++20 coroutine support. MAVSDK itself does not need it.
+#if !defined(MAVSDK_DISABLE_COROUTINES) && defined(__cpp_impl_coroutine) && \
+    defined(__has_include)
+#if __has_include(<coroutine>)
+#define MAVSDK_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifdef MAVSDK_HAS_COROUTINES
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace mavsdk {
+
+namespace detail {
+template<typename... Args> struct AwaitableValue {
+    using type = std::tuple<std::decay_t<Args>...>;
+};
+template<typename Arg> struct AwaitableValue<Arg> {
+    using type = std::decay_t<Arg>;
+};
+template<typename First, typename Second> struct AwaitableValue<First, Second> {
+    using type = std::pair<std::decay_t<First>, std::decay_t<Second>>;
+};
+} // namespace detail
+
+/**
+ * @brief Result of an asynchronous call which can be awaited with co_await.
+ *
+ * The call is started when the awaitable is awaited, and the coroutine is
+ * resumed once the result callback is called. No thread is blocked while
+ * waiting, so many calls can be in flight at the same time.
+ *
+ * By default, the coroutine is resumed on the thread calling the callback,
+ * which is the same thread that all other MAVSDK callbacks are called on.
+ * Use `resume_on` to continue on an executor of your own instead.
+ *
+ * The result is the same as for the blocking counterpart of the call, so
+ * `Result` for calls with only a result, or `std::pair<Result, T>` for calls
+ * returning a value as well.
+ */
+template<typename... Args> class Awaitable {
+public:
+    /**
+     * @brief Callback type of the underlying asynchronous call.
+     */
+    using Callback = std::function<void(Args...)>;
+
+    /**
+     * @brief Type of the result of co_await.
+     */
+    using ValueType = typename detail::AwaitableValue<Args...>::type;
+
+    /**
+     * @brief Function posting work to an executor.
+     */
+    using Executor = std::function<void(std::function<void()>)>;
+
+    /**
+     * @brief Create awaitable (internal use only).
+     *
+     * @param start Function starting the asynchronous call with the callback given.
+     */
+    explicit Awaitable(std::function<void(Callback)> start) : _start(std::move(start)) {}
+
+    /**
+     * @brief Destructor.
+     *
+     * If the awaiting coroutine is destroyed while waiting, the result is
+     * dropped when it arrives.
+     */
+    ~Awaitable()
+    {
+        if (_state) {
+            _state->abandoned = true;
+        }
+    }
+
+    /** @private */
+    Awaitable(const Awaitable&) = default;
+    /** @private */
+    Awaitable(Awaitable&&) noexcept = default;
+    /** @private */
+    Awaitable& operator=(const Awaitable&) = default;
+    /** @private */
+    Awaitable& operator=(Awaitable&&) noexcept = default;
+
+    /**
+     * @brief Resume the awaiting coroutine through the executor given.
+     *
+     * @param executor Function to post the continuation to.
+     * @return The awaitable itself.
+     */
+    Awaitable& resume_on(Executor executor) &
+    {
+        _executor = std::move(executor);
+        return *this;
+    }
+
+    /**
+     * @brief Resume the awaiting coroutine through the executor given.
+     *
+     * @param executor Function to post the continuation to.
+     * @return The awaitable itself.
+     */
+    Awaitable&& resume_on(Executor executor) &&
+    {
+        _executor = std::move(executor);
+        return std::move(*this);
+    }
+
+    /** @private */
+    bool await_ready() const noexcept { return false; }
+
+    /** @private */
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        _state = std::make_shared<State>();
+        _state->handle = handle;
+        _state->executor = std::move(_executor);
+
+        _start([state = _state](Args... args) {
+            // The coroutine can only be resumed once.
+            if (state->called.exchange(true)) {
+                return;
+            }
+            state->value.emplace(std::forward<Args>(args)...);
+            // Whoever comes second continues, this way it does not matter
+            // whether the callback is called before or after we suspend.
+            if (state->done.exchange(true)) {
+                if (state->executor) {
+                    state->executor([state]() {
+                        if (!state->abandoned) {
+                            state->handle.resume();
+                        }
+                    });
+                } else if (!state->abandoned) {
+                    state->handle.resume();
+                }
+            }
+        });
+
+        return !_state->done.exchange(true);
+    }
+
+    /** @private */
+    ValueType await_resume()
+    {
+        auto& value = _state->value.value();
+        if constexpr (sizeof...(Args) == 1) {
+            return std::move(std::get<0>(value));
+        } else if constexpr (sizeof...(Args) == 2) {
+            return {std::move(std::get<0>(value)), std::move(std::get<1>(value))};
+        } else {
+            return std::move(value);
+        }
+    }
+
+private:
+    struct State {
+        std::coroutine_handle<> handle{};
+        Executor executor{};
+        std::optional<std::tuple<std::decay_t<Args>...>> value{};
+        std::atomic<bool> called{false};
+        std::atomic<bool> done{false};
+        std::atomic<bool> abandoned{false};
+    };
+
+    std::function<void(Callback)> _start;
+    Executor _executor{};
+    std::shared_ptr<State> _state{};
+};
+
+} // namespace mavsdk
+
+#endif
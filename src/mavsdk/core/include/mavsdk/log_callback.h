@@ -10,6 +10,9 @@ enum class Level : int { Debug = 0, Info = 1, Warn = 2, Err = 3 };
 
 /** @brief User-defined callback for logging. Returning true from this callback
  * prevents default mavsdk`s logging to stdout. Returning false keeps it.
+ *
+ * The callback is called from MAVSDK's logging thread, not from the thread
+ * which logged the message.
  */
 using Callback =
     std::function<bool(Level level, const std::string& message, const std::string& file, int line)>;
@@ -17,4 +20,14 @@ using Callback =
 extern Callback& get_callback();
 extern void subscribe(const Callback& callback);
 
+/** @brief Set the lowest level of messages to log, the default is Debug.
+ *
+ * Messages below this level are dropped before they are formatted.
+ */
+extern void set_level(Level level);
+
+/** @brief Wait until all messages logged so far have been written out.
+ */
+extern void flush();
+
 } // namespace mavsdk::log
@@ -287,13 +287,82 @@ public:
     /**
      * @brief Set timeout of MAVLink transfers.
      *
-     * The default timeout used is generally DEFAULT_SERIAL_BAUDRATE (0.5 seconds) seconds.
-     * If MAVSDK is used on the same host this timeout can be reduced, while
-     * if MAVSDK has to communicate over links with high latency it might
-     * need to be increased to prevent timeouts.
+     * By default, the timeout is derived from the round trip time measured
+     * for each system, starting with DEFAULT_TIMEOUT_S (0.5 seconds) until
+     * the first measurement is available. This adapts to both local links
+     * and links with high latency.
+     *
+     * Setting a timeout disables this and uses the given timeout for all
+     * systems and transfers instead, including FTP and log file downloads.
      */
     void set_timeout_s(double timeout_s);
 
+    /**
+     * @brief Set number of threads doing the background work of all systems.
+     *
+     * The background work such as sending commands and parameter requests,
+     * retransmissions, and pings is shared by all systems, so the number of
+     * threads does not grow with the number of systems. The work of a system
+     * always runs on the same thread. By default, there is one thread per core.
+     *
+     * @param num_threads Number of threads, at least 1.
+     */
+    void set_num_system_worker_threads(unsigned num_threads);
+
+    /**
+     * @brief Set directory to cache parameters of systems in.
+     *
+     * Downloading all parameters can take a while. If a directory is set,
+     * they are stored there per system and component, and used instead of
+     * downloading them again as long as the autopilot advertises the same
+     * hash for them (PX4 does this). Systems are identified by the uid of
+     * their autopilot, so nothing is cached until that is known.
+     *
+     * By default, no parameters are cached.
+     *
+     * @param path Existing directory to store the cache files in, or an empty
+     *             string to stop caching.
+     */
+    void set_param_cache_directory(const std::string& path);
+
+    /**
+     * @brief Timing of the user callbacks queued from one place in the code.
+     *
+     * The histograms have NUM_CALLBACK_HISTOGRAM_BUCKETS buckets. Bucket 0 counts
+     * durations below 1 us, bucket i durations from 2^(i-1) us up to 2^i us, and
+     * the last bucket everything longer than that.
+     */
+    struct CallbackStatistics {
+        std::string filename{}; /**< @brief File where the callback was queued. */
+        int linenumber{}; /**< @brief Line where the callback was queued. */
+        uint64_t count{}; /**< @brief Number of callbacks that have been run. */
+        double run_time_total_s{}; /**< @brief Time spent in callbacks. */
+        double run_time_max_s{}; /**< @brief Longest time spent in one callback. */
+        std::vector<uint64_t> run_time_histogram{}; /**< @brief Time spent in callbacks. */
+        double queue_time_total_s{}; /**< @brief Time callbacks waited in the queue. */
+        double queue_time_max_s{}; /**< @brief Longest time a callback waited in the queue. */
+        std::vector<uint64_t>
+            queue_time_histogram{}; /**< @brief Time callbacks waited in the queue. */
+    };
+
+    /** @brief Number of buckets in CallbackStatistics histograms. */
+    static constexpr unsigned NUM_CALLBACK_HISTOGRAM_BUCKETS = 24;
+
+    /**
+     * @brief Get timing statistics of the user callbacks run so far.
+     *
+     * All user callbacks are called one after the other from one thread. This
+     * can be used to find out which of them are slowing down the others.
+     *
+     * @return One entry for each place in the code callbacks were queued from.
+     */
+    std::vector<CallbackStatistics> get_callback_statistics() const;
+
+    /**
+     * @brief Reset the statistics returned by get_callback_statistics().
+     */
+    void reset_callback_statistics();
+
     /**
      * @brief Set system status of this MAVLink entity.
      *
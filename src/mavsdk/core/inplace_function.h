@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mavsdk {
+
+template<typename Signature, size_t Capacity> class InplaceFunction;
+
+// Like std::function, except that the callable is always stored inside the
+// object itself. Creating, copying and calling it therefore never allocates,
+// and a callable which does not fit is a compile error.
+//
+// Construction from a callable is explicit so that functions which are
+// overloaded for std::function and InplaceFunction are not ambiguous.
+template<typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+public:
+    static constexpr size_t capacity = Capacity;
+
+    InplaceFunction() = default;
+    InplaceFunction(std::nullptr_t) {}
+
+    template<
+        typename F,
+        typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunction>>>
+    explicit InplaceFunction(F&& func)
+    {
+        using Callable = std::decay_t<F>;
+        static_assert(sizeof(Callable) <= Capacity, "Callable too big for InplaceFunction");
+        static_assert(
+            alignof(Callable) <= alignof(std::max_align_t), "Callable alignment not supported");
+        static_assert(std::is_copy_constructible_v<Callable>, "Callable needs to be copyable");
+        static_assert(
+            std::is_nothrow_move_constructible_v<Callable>,
+            "Callable needs to be nothrow movable");
+
+        new (&_storage) Callable(std::forward<F>(func));
+        _ops = &ops_for<Callable>;
+    }
+
+    InplaceFunction(const InplaceFunction& other)
+    {
+        if (other._ops != nullptr) {
+            other._ops->copy(&_storage, &other._storage);
+            _ops = other._ops;
+        }
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept
+    {
+        if (other._ops != nullptr) {
+            other._ops->move(&_storage, &other._storage);
+            _ops = other._ops;
+            other.reset();
+        }
+    }
+
+    ~InplaceFunction() { reset(); }
+
+    InplaceFunction& operator=(const InplaceFunction& other)
+    {
+        if (this != &other) {
+            reset();
+            if (other._ops != nullptr) {
+                other._ops->copy(&_storage, &other._storage);
+                _ops = other._ops;
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            if (other._ops != nullptr) {
+                other._ops->move(&_storage, &other._storage);
+                _ops = other._ops;
+                other.reset();
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t)
+    {
+        reset();
+        return *this;
+    }
+
+    // Calling an empty function does nothing if there is nothing to return,
+    // like for queued callbacks, and is a bug otherwise.
+    R operator()(Args... args) const
+    {
+        if constexpr (std::is_void_v<R>) {
+            if (_ops == nullptr) {
+                return;
+            }
+        } else {
+            assert(_ops != nullptr);
+        }
+        return _ops->invoke(&_storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return _ops != nullptr; }
+
+private:
+    struct Ops {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*copy)(void* destination, const void* source);
+        void (*move)(void* destination, void* source);
+        void (*destroy)(void* storage);
+    };
+
+    template<typename Callable>
+    static constexpr Ops ops_for{
+        [](void* storage, Args&&... args) -> R {
+            return (*static_cast<Callable*>(storage))(std::forward<Args>(args)...);
+        },
+        [](void* destination, const void* source) {
+            new (destination) Callable(*static_cast<const Callable*>(source));
+        },
+        [](void* destination, void* source) {
+            new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+        },
+        [](void* storage) { static_cast<Callable*>(storage)->~Callable(); }};
+
+    void reset()
+    {
+        if (_ops != nullptr) {
+            _ops->destroy(&_storage);
+            _ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) mutable unsigned char _storage[Capacity]{};
+    const Ops* _ops{nullptr};
+};
+
+} // namespace mavsdk
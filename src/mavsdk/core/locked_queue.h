@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <queue>
 #include <mutex>
 #include <memory>
@@ -11,10 +12,26 @@ public:
     LockedQueue() = default;
     ~LockedQueue() = default;
 
-    void push_back(std::shared_ptr<T> item_ptr)
+    // The callback is called whenever an item is added or removed, so that
+    // whoever works on the queue can be woken up. It must not access the queue
+    // itself as it might be called with the queue locked.
+    void set_changed_callback(std::function<void()> callback)
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        _queue.push_back(item_ptr);
+        _changed_callback = std::move(callback);
+    }
+
+    void push_back(std::shared_ptr<T> item_ptr)
+    {
+        std::function<void()> changed_callback;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back(item_ptr);
+            changed_callback = _changed_callback;
+        }
+        if (changed_callback) {
+            changed_callback();
+        }
     }
 
     size_t size()
@@ -28,7 +45,12 @@ public:
 
     iterator end() { return _queue.end(); }
 
-    iterator erase(iterator it) { return _queue.erase(it); }
+    iterator erase(iterator it)
+    {
+        auto next = _queue.erase(it);
+        notify_changed();
+        return next;
+    }
 
     // This guard serves the purpose to combine a get_front with a pop_front.
     // Thus, no one can interfere between the two steps.
@@ -56,15 +78,27 @@ public:
             return _locked_queue._queue.front();
         }
 
-        void pop_front() { _locked_queue._queue.pop_front(); }
+        void pop_front()
+        {
+            _locked_queue._queue.pop_front();
+            _locked_queue.notify_changed();
+        }
 
     private:
         LockedQueue<T>& _locked_queue;
     };
 
 private:
+    void notify_changed()
+    {
+        if (_changed_callback) {
+            _changed_callback();
+        }
+    }
+
     std::deque<std::shared_ptr<T>> _queue{};
     std::mutex _mutex{};
+    std::function<void()> _changed_callback{};
 };
 
 } // namespace mavsdk
@@ -1,6 +1,21 @@
 #include "log.h"
 #include "unused.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(ANDROID)
+#include <android/log.h>
+#endif
+
 #if defined(WINDOWS)
 #include "windows_include.h"
 #define WIN_COLOR_RED 4
@@ -21,6 +36,259 @@
 namespace mavsdk {
 
 static log::Callback callback_{nullptr};
+static std::mutex callback_mutex_{};
+static std::atomic<int> min_level_{static_cast<int>(log::Level::Debug)};
+
+namespace {
+
+struct LogEntry {
+    log::Level level{log::Level::Debug};
+    std::string message{};
+    const char* filename{nullptr};
+    int linenumber{0};
+    time_t time{0};
+};
+
+void write_entry(const LogEntry& entry)
+{
+    log::Callback callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = callback_;
+    }
+
+    if (callback && callback(entry.level, entry.message, entry.filename, entry.linenumber)) {
+        return;
+    }
+
+#if ANDROID
+    switch (entry.level) {
+        case log::Level::Debug:
+            __android_log_print(ANDROID_LOG_DEBUG, "Mavsdk", "%s", entry.message.c_str());
+            break;
+        case log::Level::Info:
+            __android_log_print(ANDROID_LOG_INFO, "Mavsdk", "%s", entry.message.c_str());
+            break;
+        case log::Level::Warn:
+            __android_log_print(ANDROID_LOG_WARN, "Mavsdk", "%s", entry.message.c_str());
+            break;
+        case log::Level::Err:
+            __android_log_print(ANDROID_LOG_ERROR, "Mavsdk", "%s", entry.message.c_str());
+            break;
+    }
+#else
+
+    switch (entry.level) {
+        case log::Level::Debug:
+            set_color(Color::Green);
+            break;
+        case log::Level::Info:
+            set_color(Color::Blue);
+            break;
+        case log::Level::Warn:
+            set_color(Color::Yellow);
+            break;
+        case log::Level::Err:
+            set_color(Color::Red);
+            break;
+    }
+
+    // Time output taken from:
+    // https://stackoverflow.com/questions/16357999#answer-16358264
+    struct tm* timeinfo = localtime(&entry.time);
+    char time_buffer[10]{}; // We need 8 characters + \0
+    strftime(time_buffer, sizeof(time_buffer), "%I:%M:%S", timeinfo);
+    std::cout << "[" << time_buffer;
+
+    switch (entry.level) {
+        case log::Level::Debug:
+            std::cout << "|Debug] ";
+            break;
+        case log::Level::Info:
+            std::cout << "|Info ] ";
+            break;
+        case log::Level::Warn:
+            std::cout << "|Warn ] ";
+            break;
+        case log::Level::Err:
+            std::cout << "|Error] ";
+            break;
+    }
+
+    set_color(Color::Reset);
+
+    std::cout << entry.message;
+    std::cout << " (" << entry.filename << ":" << std::dec << entry.linenumber << ")";
+
+    std::cout << '\n';
+#endif
+}
+
+// Writes the log messages out on its own thread.
+//
+// The messages are passed through a bounded lock-free queue (the one by
+// Dmitry Vyukov), so a thread logging never waits for another one, nor for
+// stdout or the log callback. If the queue is full, messages are dropped and
+// the number of dropped messages is logged instead.
+class LogWriter {
+public:
+    // This is never destroyed, so it can still be used while other static
+    // objects are destructed. The thread is stopped at exit instead.
+    static LogWriter& get()
+    {
+        static LogWriter* writer = new LogWriter();
+        return *writer;
+    }
+
+    void write(LogEntry&& entry)
+    {
+        if (_stopped) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            write_entry(entry);
+            return;
+        }
+
+        if (!try_push(std::move(entry))) {
+            ++_num_dropped;
+            return;
+        }
+
+        if (_waiting) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cv.notify_one();
+        }
+    }
+
+    void flush()
+    {
+        if (_stopped || std::this_thread::get_id() == _thread.get_id()) {
+            return;
+        }
+
+        const size_t target = _enqueue_pos.load();
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.notify_one();
+        _flushed_cv.wait(lock, [&]() { return _num_written >= target; });
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _should_exit = true;
+        }
+        _cv.notify_one();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+        _stopped = true;
+    }
+
+private:
+    LogWriter() : _slots(std::make_unique<Slot[]>(QUEUE_SIZE))
+    {
+        for (size_t i = 0; i < QUEUE_SIZE; ++i) {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        _thread = std::thread(&LogWriter::run, this);
+        std::atexit([]() { LogWriter::get().stop(); });
+    }
+
+    bool try_push(LogEntry&& entry)
+    {
+        size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = _slots[pos & (QUEUE_SIZE - 1)];
+            const auto diff = static_cast<intptr_t>(slot.sequence.load(std::memory_order_acquire)) -
+                              static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.entry = std::move(entry);
+                    // Sequentially consistent, so either we see the writer
+                    // waiting, or the writer sees this entry.
+                    slot.sequence.store(pos + 1);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // Full.
+                return false;
+            } else {
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(LogEntry& entry)
+    {
+        Slot& slot = _slots[_dequeue_pos & (QUEUE_SIZE - 1)];
+        if (slot.sequence.load() != _dequeue_pos + 1) {
+            return false;
+        }
+        entry = std::move(slot.entry);
+        slot.entry = {};
+        slot.sequence.store(_dequeue_pos + QUEUE_SIZE, std::memory_order_release);
+        ++_dequeue_pos;
+        return true;
+    }
+
+    bool empty() const
+    {
+        return _slots[_dequeue_pos & (QUEUE_SIZE - 1)].sequence.load() != _dequeue_pos + 1;
+    }
+
+    void run()
+    {
+        LogEntry entry;
+        while (true) {
+            while (try_pop(entry)) {
+                write_entry(entry);
+                ++_num_written;
+            }
+
+            const unsigned num_dropped = _num_dropped.exchange(0);
+            if (num_dropped > 0) {
+                write_entry(LogEntry{
+                    log::Level::Warn,
+                    "Dropped " + std::to_string(num_dropped) + " log messages",
+                    FILENAME,
+                    __LINE__,
+                    time(nullptr)});
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _flushed_cv.notify_all();
+            if (_should_exit && empty()) {
+                return;
+            }
+            _waiting = true;
+            _cv.wait(lock, [this]() { return _should_exit || !empty(); });
+            _waiting = false;
+        }
+    }
+
+    static constexpr size_t QUEUE_SIZE = 1024; // Needs to be a power of two.
+
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        LogEntry entry{};
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<size_t> _enqueue_pos{0};
+    size_t _dequeue_pos{0}; // Only used by the writer thread.
+    std::atomic<size_t> _num_written{0};
+    std::atomic<unsigned> _num_dropped{0};
+
+    std::mutex _mutex{};
+    std::condition_variable _cv{};
+    std::condition_variable _flushed_cv{};
+    std::atomic<bool> _waiting{false};
+    bool _should_exit{false};
+    std::atomic<bool> _stopped{false};
+    std::thread _thread{};
+};
+
+} // namespace
 
 log::Callback& log::get_callback()
 {
@@ -29,9 +297,57 @@ log::Callback& log::get_callback()
 
 void log::subscribe(const log::Callback& callback)
 {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
     callback_ = callback;
 }
 
+void log::set_level(Level level)
+{
+    min_level_ = static_cast<int>(level);
+}
+
+void log::flush()
+{
+    LogWriter::get().flush();
+}
+
+bool log::is_enabled(Level level)
+{
+    return static_cast<int>(level) >= min_level_.load(std::memory_order_relaxed);
+}
+
+void log::write(Level level, std::string message, const char* filename, int linenumber)
+{
+    LogWriter::get().write(
+        LogEntry{level, std::move(message), filename, linenumber, time(nullptr)});
+}
+
+bool LogSite::should_log(int64_t now_ms, unsigned& num_suppressed)
+{
+    // This is not exact when several threads log at the same time, which is
+    // fine for this purpose.
+    int64_t window_start_ms = _window_start_ms.load(std::memory_order_relaxed);
+    if (now_ms - window_start_ms >= WINDOW_MS &&
+        _window_start_ms.compare_exchange_strong(window_start_ms, now_ms)) {
+        _num_in_window = 0;
+    }
+
+    if (_num_in_window.fetch_add(1) < MAX_MESSAGES_PER_WINDOW) {
+        num_suppressed = _num_suppressed.exchange(0);
+        return true;
+    }
+
+    ++_num_suppressed;
+    return false;
+}
+
+int64_t LogDetailed::now_ms()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
 void set_color(Color color)
 {
 #if defined(WINDOWS)
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <optional>
 #include <sstream>
+#include <string>
 #include "log_callback.h"
 
-#if defined(ANDROID)
-#include <android/log.h>
-#else
+#if !defined(ANDROID)
 #include <iostream>
 #include <ctime>
 #endif
@@ -20,10 +22,42 @@
 
 #define call_user_callback(...) call_user_callback_located(FILENAME, __LINE__, __VA_ARGS__)
 
+// Levels below this are compiled out entirely, e.g. set it to 1 to remove all
+// debug messages from a build.
+#ifndef MAVSDK_MIN_LOG_LEVEL
+#define MAVSDK_MIN_LOG_LEVEL 0
+#endif
+
+// Every place which logs warnings or errors gets its own rate limit.
+#define MAVSDK_LOG_SITE \
+    []() -> mavsdk::LogSite* { \
+        static mavsdk::LogSite mavsdk_log_site; \
+        return &mavsdk_log_site; \
+    }()
+
+#if MAVSDK_MIN_LOG_LEVEL <= 0
 #define LogDebug() LogDebugDetailed(FILENAME, __LINE__)
+#else
+#define LogDebug() LogDisabled()
+#endif
+
+#if MAVSDK_MIN_LOG_LEVEL <= 1
 #define LogInfo() LogInfoDetailed(FILENAME, __LINE__)
-#define LogWarn() LogWarnDetailed(FILENAME, __LINE__)
-#define LogErr() LogErrDetailed(FILENAME, __LINE__)
+#else
+#define LogInfo() LogDisabled()
+#endif
+
+#if MAVSDK_MIN_LOG_LEVEL <= 2
+#define LogWarn() LogWarnDetailed(FILENAME, __LINE__, MAVSDK_LOG_SITE)
+#else
+#define LogWarn() LogDisabled()
+#endif
+
+#if MAVSDK_MIN_LOG_LEVEL <= 3
+#define LogErr() LogErrDetailed(FILENAME, __LINE__, MAVSDK_LOG_SITE)
+#else
+#define LogErr() LogDisabled()
+#endif
 
 namespace mavsdk {
 
@@ -31,137 +65,122 @@ enum class Color { Red, Green, Yellow, Blue, Gray, Reset };
 
 void set_color(Color color);
 
+namespace log {
+
+// Whether messages of this level are currently logged at all.
+bool is_enabled(Level level);
+
+// Hands a finished message to the log thread which writes it out.
+void write(Level level, std::string message, const char* filename, int linenumber);
+
+} // namespace log
+
+// Rate limit for repeated messages from one place in the code, so a message
+// which fires for every MAVLink message, e.g. on a broken link, does not end up
+// flooding the log.
+class LogSite {
+public:
+    static constexpr unsigned MAX_MESSAGES_PER_WINDOW = 10;
+    static constexpr int64_t WINDOW_MS = 1000;
+
+    constexpr LogSite() = default;
+
+    // Returns false if the message should be suppressed. Otherwise
+    // num_suppressed is set to how many messages were suppressed since the
+    // last one that was let through.
+    bool should_log(int64_t now_ms, unsigned& num_suppressed);
+
+private:
+    std::atomic<int64_t> _window_start_ms{0};
+    std::atomic<unsigned> _num_in_window{0};
+    std::atomic<unsigned> _num_suppressed{0};
+};
+
+// Messages are only formatted if they are actually going to be logged, and are
+// then written out from a separate thread, so logging does not block the
+// thread that is logging.
 class LogDetailed {
 public:
-    LogDetailed(const char* filename, int filenumber) :
-        _s(),
+    LogDetailed(log::Level level, const char* filename, int filenumber, LogSite* site) :
+        _log_level(level),
         _caller_filename(filename),
         _caller_filenumber(filenumber)
-    {}
+    {
+        if (!log::is_enabled(level)) {
+            return;
+        }
+        if (site != nullptr && !site->should_log(now_ms(), _num_suppressed)) {
+            return;
+        }
+        _s.emplace();
+    }
 
     template<typename T> LogDetailed& operator<<(const T& x)
     {
-        _s << x;
+        if (_s) {
+            *_s << x;
+        }
         return *this;
     }
 
     virtual ~LogDetailed()
     {
-        if (log::get_callback() &&
-            log::get_callback()(_log_level, _s.str(), _caller_filename, _caller_filenumber)) {
+        if (!_s) {
             return;
         }
 
-#if ANDROID
-        switch (_log_level) {
-            case log::Level::Debug:
-                __android_log_print(ANDROID_LOG_DEBUG, "Mavsdk", "%s", _s.str().c_str());
-                break;
-            case log::Level::Info:
-                __android_log_print(ANDROID_LOG_INFO, "Mavsdk", "%s", _s.str().c_str());
-                break;
-            case log::Level::Warn:
-                __android_log_print(ANDROID_LOG_WARN, "Mavsdk", "%s", _s.str().c_str());
-                break;
-            case log::Level::Err:
-                __android_log_print(ANDROID_LOG_ERROR, "Mavsdk", "%s", _s.str().c_str());
-                break;
-        }
-        // Unused:
-        (void)_caller_filename;
-        (void)_caller_filenumber;
-#else
-
-        switch (_log_level) {
-            case log::Level::Debug:
-                set_color(Color::Green);
-                break;
-            case log::Level::Info:
-                set_color(Color::Blue);
-                break;
-            case log::Level::Warn:
-                set_color(Color::Yellow);
-                break;
-            case log::Level::Err:
-                set_color(Color::Red);
-                break;
+        if (_num_suppressed > 0) {
+            *_s << " (suppressed " << _num_suppressed << " similar messages)";
         }
 
-        // Time output taken from:
-        // https://stackoverflow.com/questions/16357999#answer-16358264
-        time_t rawtime;
-        time(&rawtime);
-        struct tm* timeinfo = localtime(&rawtime);
-        char time_buffer[10]{}; // We need 8 characters + \0
-        strftime(time_buffer, sizeof(time_buffer), "%I:%M:%S", timeinfo);
-        std::cout << "[" << time_buffer;
-
-        switch (_log_level) {
-            case log::Level::Debug:
-                std::cout << "|Debug] ";
-                break;
-            case log::Level::Info:
-                std::cout << "|Info ] ";
-                break;
-            case log::Level::Warn:
-                std::cout << "|Warn ] ";
-                break;
-            case log::Level::Err:
-                std::cout << "|Error] ";
-                break;
-        }
-
-        set_color(Color::Reset);
-
-        std::cout << _s.str();
-        std::cout << " (" << _caller_filename << ":" << std::dec << _caller_filenumber << ")";
-
-        std::cout << '\n';
-#endif
+        log::write(_log_level, _s->str(), _caller_filename, _caller_filenumber);
     }
 
     LogDetailed(const mavsdk::LogDetailed&) = delete;
     void operator=(const mavsdk::LogDetailed&) = delete;
 
-protected:
-    log::Level _log_level = log::Level::Debug;
-
 private:
-    std::stringstream _s;
+    static int64_t now_ms();
+
+    const log::Level _log_level;
+    std::optional<std::ostringstream> _s{};
     const char* _caller_filename;
     int _caller_filenumber;
+    unsigned _num_suppressed{0};
 };
 
 class LogDebugDetailed : public LogDetailed {
 public:
-    LogDebugDetailed(const char* filename, int filenumber) : LogDetailed(filename, filenumber)
-    {
-        _log_level = log::Level::Debug;
-    }
+    LogDebugDetailed(const char* filename, int filenumber, LogSite* site = nullptr) :
+        LogDetailed(log::Level::Debug, filename, filenumber, site)
+    {}
 };
 
 class LogInfoDetailed : public LogDetailed {
 public:
-    LogInfoDetailed(const char* filename, int filenumber) : LogDetailed(filename, filenumber)
-    {
-        _log_level = log::Level::Info;
-    }
+    LogInfoDetailed(const char* filename, int filenumber, LogSite* site = nullptr) :
+        LogDetailed(log::Level::Info, filename, filenumber, site)
+    {}
 };
 
 class LogWarnDetailed : public LogDetailed {
 public:
-    LogWarnDetailed(const char* filename, int filenumber) : LogDetailed(filename, filenumber)
-    {
-        _log_level = log::Level::Warn;
-    }
+    LogWarnDetailed(const char* filename, int filenumber, LogSite* site = nullptr) :
+        LogDetailed(log::Level::Warn, filename, filenumber, site)
+    {}
 };
 
 class LogErrDetailed : public LogDetailed {
 public:
-    LogErrDetailed(const char* filename, int filenumber) : LogDetailed(filename, filenumber)
-    {
-        _log_level = log::Level::Err;
-    }
+    LogErrDetailed(const char* filename, int filenumber, LogSite* site = nullptr) :
+        LogDetailed(log::Level::Err, filename, filenumber, site)
+    {}
+};
+
+// Used for levels which are compiled out, so nothing is formatted.
+class LogDisabled {
+public:
+    template<typename T> LogDisabled& operator<<(const T&) { return *this; }
 };
 
 } // namespace mavsdk
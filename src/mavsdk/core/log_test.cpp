@@ -0,0 +1,90 @@
+#include "log.h"
+#include <mutex>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(Log, RateLimitPerSite)
+{
+    LogSite site;
+    unsigned num_suppressed = 0;
+
+    for (unsigned i = 0; i < LogSite::MAX_MESSAGES_PER_WINDOW; ++i) {
+        EXPECT_TRUE(site.should_log(1000, num_suppressed));
+        EXPECT_EQ(num_suppressed, 0);
+    }
+
+    // Everything else in the same window is dropped.
+    for (unsigned i = 0; i < 5; ++i) {
+        EXPECT_FALSE(site.should_log(1500, num_suppressed));
+    }
+
+    // The first one in the next window tells how many were dropped.
+    EXPECT_TRUE(site.should_log(1000 + LogSite::WINDOW_MS, num_suppressed));
+    EXPECT_EQ(num_suppressed, 5);
+
+    EXPECT_TRUE(site.should_log(1000 + LogSite::WINDOW_MS, num_suppressed));
+    EXPECT_EQ(num_suppressed, 0);
+}
+
+TEST(Log, LevelAndCallback)
+{
+    std::mutex mutex;
+    std::vector<std::string> messages;
+
+    log::subscribe([&](log::Level, const std::string& message, const std::string&, int) {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.push_back(message);
+        return true;
+    });
+
+    unsigned num_formatted = 0;
+    auto count_formatting = [&]() {
+        ++num_formatted;
+        return "formatted";
+    };
+
+    log::set_level(log::Level::Warn);
+    LogInfo() << "info " << count_formatting();
+    LogWarn() << "warn " << count_formatting();
+    log::set_level(log::Level::Debug);
+
+    log::flush();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(messages, std::vector<std::string>{"warn formatted"});
+    }
+
+    // Arguments are evaluated either way, but only streamed when logged.
+    EXPECT_EQ(num_formatted, 2);
+
+    log::subscribe(nullptr);
+}
+
+TEST(Log, RepeatedMessagesAreSuppressed)
+{
+    std::mutex mutex;
+    std::vector<std::string> messages;
+
+    log::subscribe([&](log::Level, const std::string& message, const std::string&, int) {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.push_back(message);
+        return true;
+    });
+
+    for (unsigned i = 0; i < 100; ++i) {
+        LogErr() << "Sending message failed";
+    }
+
+    log::flush();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(messages.size(), LogSite::MAX_MESSAGES_PER_WINDOW);
+    }
+
+    log::subscribe(nullptr);
+}
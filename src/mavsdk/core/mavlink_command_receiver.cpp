@@ -1,5 +1,6 @@
 #include "mavlink_command_receiver.h"
 #include "mavsdk_impl.h"
+#include "server_component_impl.h"
 #include "log.h"
 #include <cmath>
 #include <future>
@@ -7,7 +8,10 @@
 
 namespace mavsdk {
 
-MavlinkCommandReceiver::MavlinkCommandReceiver(MavsdkImpl& mavsdk_impl) : _mavsdk_impl(mavsdk_impl)
+MavlinkCommandReceiver::MavlinkCommandReceiver(
+    MavsdkImpl& mavsdk_impl, ServerComponentImpl& server_component_impl) :
+    _mavsdk_impl(mavsdk_impl),
+    _server_component_impl(server_component_impl)
 {
     _mavsdk_impl.mavlink_message_handler.register_one(
         MAVLINK_MSG_ID_COMMAND_LONG,
@@ -31,6 +35,10 @@ void MavlinkCommandReceiver::receive_command_int(const mavlink_message_t& messag
 {
     MavlinkCommandReceiver::CommandInt cmd(message);
 
+    if (!is_for_us(cmd.target_component_id)) {
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(_mavlink_command_handler_table_mutex);
 
     for (auto& handler : _mavlink_command_int_handler_table) {
@@ -48,6 +56,10 @@ void MavlinkCommandReceiver::receive_command_long(const mavlink_message_t& messa
 {
     MavlinkCommandReceiver::CommandLong cmd(message);
 
+    if (!is_for_us(cmd.target_component_id)) {
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(_mavlink_command_handler_table_mutex);
 
     for (auto& handler : _mavlink_command_long_handler_table) {
@@ -61,6 +73,15 @@ void MavlinkCommandReceiver::receive_command_long(const mavlink_message_t& messa
     }
 }
 
+bool MavlinkCommandReceiver::is_for_us(uint8_t target_component_id) const
+{
+    // Every server component sees all commands, but only the one addressed
+    // should act on and ack it, otherwise the sender gets acks from
+    // components it didn't send the command to.
+    return target_component_id == MAV_COMP_ID_ALL ||
+           target_component_id == _server_component_impl.get_own_component_id();
+}
+
 void MavlinkCommandReceiver::register_mavlink_command_handler(
     uint16_t cmd_id, const MavlinkCommandIntHandler& callback, const void* cookie)
 {
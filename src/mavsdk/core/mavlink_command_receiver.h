@@ -14,10 +14,11 @@
 namespace mavsdk {
 
 class MavsdkImpl;
+class ServerComponentImpl;
 
 class MavlinkCommandReceiver {
 public:
-    explicit MavlinkCommandReceiver(MavsdkImpl& mavsdk_impl);
+    MavlinkCommandReceiver(MavsdkImpl& mavsdk_impl, ServerComponentImpl& server_component_impl);
     ~MavlinkCommandReceiver();
 
     struct CommandInt {
@@ -118,6 +119,9 @@ public:
 
 private:
     MavsdkImpl& _mavsdk_impl;
+    ServerComponentImpl& _server_component_impl;
+
+    [[nodiscard]] bool is_for_us(uint8_t target_component_id) const;
 
     void receive_command_int(const mavlink_message_t& message);
     void receive_command_long(const mavlink_message_t& message);
@@ -78,18 +78,20 @@ void MavlinkCommandSender::queue_command_async(
 
     CommandIdentification identification = identification_from_command(command);
 
-    for (const auto& work : _work_queue) {
-        if (work->identification == identification && callback == nullptr) {
+    {
+        LockedQueue<Work>::Guard work_queue_guard(_work_queue);
+        auto& num_queued = _queued[identification];
+        if (num_queued > 0 && callback == nullptr) {
             if (_command_debugging) {
                 LogDebug() << "Dropping command " << static_cast<int>(identification.command)
                            << " that is already being sent";
             }
             return;
         }
+        ++num_queued;
     }
 
     auto new_work = std::make_shared<Work>();
-    new_work->timeout_s = _system_impl.timeout_s();
     new_work->command = command;
     new_work->identification = identification;
     new_work->callback = callback;
@@ -106,18 +108,20 @@ void MavlinkCommandSender::queue_command_async(
 
     CommandIdentification identification = identification_from_command(command);
 
-    for (const auto& work : _work_queue) {
-        if (work->identification == identification && callback == nullptr) {
+    {
+        LockedQueue<Work>::Guard work_queue_guard(_work_queue);
+        auto& num_queued = _queued[identification];
+        if (num_queued > 0 && callback == nullptr) {
             if (_command_debugging) {
                 LogDebug() << "Dropping command " << static_cast<int>(identification.command)
                            << " that is already being sent";
             }
             return;
         }
+        ++num_queued;
     }
 
     auto new_work = std::make_shared<Work>();
-    new_work->timeout_s = _system_impl.timeout_s();
     new_work->command = command;
     new_work->identification = identification;
     new_work->callback = callback;
@@ -146,6 +150,7 @@ void MavlinkCommandSender::receive_command_ack(mavlink_message_t message)
 
     LockedQueue<Work>::Guard work_queue_guard(_work_queue);
 
+    auto match = _work_queue.end();
     for (auto it = _work_queue.begin(); it != _work_queue.end(); ++it) {
         auto work = *it;
 
@@ -154,6 +159,11 @@ void MavlinkCommandSender::receive_command_ack(mavlink_message_t message)
             return;
         }
 
+        // An ack can't be for something we have not sent yet.
+        if (!work->already_sent) {
+            continue;
+        }
+
         if (work->identification.command != command_ack.command ||
             (work->identification.target_system_id != 0 &&
              work->identification.target_system_id != message.sysid) ||
@@ -172,112 +182,128 @@ void MavlinkCommandSender::receive_command_ack(mavlink_message_t message)
             continue;
         }
 
+        // Acks come back in the order the commands were sent, so the oldest
+        // one sent is the one acked.
+        if (match == _work_queue.end() || work->sent_sequence < (*match)->sent_sequence) {
+            match = it;
+        }
+    }
+
+    if (match == _work_queue.end()) {
         if (_command_debugging) {
-            LogDebug() << "Received command ack for " << command_ack.command << " with result "
-                       << static_cast<int>(command_ack.result) << " after "
-                       << _system_impl.get_time().elapsed_since_s(work->time_started) << " s";
+            LogDebug() << "Received ack from " << static_cast<int>(message.sysid) << '/'
+                       << static_cast<int>(message.compid)
+                       << " for not-existing command: " << static_cast<int>(command_ack.command)
+                       << "! Ignoring...";
+        } else {
+            LogWarn() << "Received ack for not-existing command: "
+                      << static_cast<int>(command_ack.command) << "! Ignoring...";
         }
+        return;
+    }
 
-        CommandResultCallback temp_callback = work->callback;
-        std::pair<Result, float> temp_result{Result::UnknownError, NAN};
+    auto it = match;
+    auto work = *it;
 
-        switch (command_ack.result) {
-            case MAV_RESULT_ACCEPTED:
-                _system_impl.unregister_timeout_handler(work->timeout_cookie);
-                temp_result = {Result::Success, 1.0f};
-                _work_queue.erase(it);
-                break;
+    if (_command_debugging) {
+        LogDebug() << "Received command ack for " << command_ack.command << " with result "
+                   << static_cast<int>(command_ack.result) << " after "
+                   << _system_impl.get_time().elapsed_since_s(work->time_started) << " s";
+    }
 
-            case MAV_RESULT_DENIED:
-                if (_command_debugging) {
-                    LogDebug() << "command denied (" << work->identification.command << ").";
-                }
-                _system_impl.unregister_timeout_handler(work->timeout_cookie);
-                temp_result = {Result::Denied, NAN};
-                _work_queue.erase(it);
-                break;
+    if (work->rtt_measurable) {
+        _system_impl.rtt_estimator().add_sample(
+            _system_impl.get_time().elapsed_since_s(work->time_started));
+        work->rtt_measurable = false;
+    }
 
-            case MAV_RESULT_UNSUPPORTED:
-                if (_command_debugging) {
-                    LogDebug() << "command unsupported (" << work->identification.command << ").";
-                }
-                _system_impl.unregister_timeout_handler(work->timeout_cookie);
-                temp_result = {Result::Unsupported, NAN};
-                _work_queue.erase(it);
-                break;
+    CommandResultCallback temp_callback = work->callback;
+    std::pair<Result, float> temp_result{Result::UnknownError, NAN};
 
-            case MAV_RESULT_TEMPORARILY_REJECTED:
-                if (_command_debugging) {
-                    LogDebug() << "command temporarily rejected (" << work->identification.command
-                               << ").";
-                }
-                _system_impl.unregister_timeout_handler(work->timeout_cookie);
-                temp_result = {Result::TemporarilyRejected, NAN};
-                _work_queue.erase(it);
-                break;
+    switch (command_ack.result) {
+        case MAV_RESULT_ACCEPTED:
+            _system_impl.unregister_timeout_handler(work->timeout_cookie);
+            temp_result = {Result::Success, 1.0f};
+            remove_work(it);
+            break;
 
-            case MAV_RESULT_FAILED:
-                if (_command_debugging) {
-                    LogDebug() << "command failed (" << work->identification.command << ").";
-                }
-                _system_impl.unregister_timeout_handler(work->timeout_cookie);
-                temp_result = {Result::Failed, NAN};
-                _work_queue.erase(it);
-                break;
+        case MAV_RESULT_DENIED:
+            if (_command_debugging) {
+                LogDebug() << "command denied (" << work->identification.command << ").";
+            }
+            _system_impl.unregister_timeout_handler(work->timeout_cookie);
+            temp_result = {Result::Denied, NAN};
+            remove_work(it);
+            break;
 
-            case MAV_RESULT_IN_PROGRESS:
-                if (_command_debugging) {
-                    if (static_cast<int>(command_ack.progress) != 255) {
-                        LogDebug() << "progress: " << static_cast<int>(command_ack.progress)
-                                   << " % (" << work->identification.command << ").";
-                    }
-                }
-                // If we get a progress update, we can raise the timeout
-                // to something higher because we know the initial command
-                // has arrived. A possible timeout for this case is the initial
-                // timeout * the possible retries because this should match the
-                // case where there is no progress update, and we keep trying.
-                _system_impl.unregister_timeout_handler(work->timeout_cookie);
-                _system_impl.register_timeout_handler(
-                    [this, identification = work->identification] {
-                        receive_timeout(identification);
-                    },
-                    work->retries_to_do * work->timeout_s,
-                    &work->timeout_cookie);
+        case MAV_RESULT_UNSUPPORTED:
+            if (_command_debugging) {
+                LogDebug() << "command unsupported (" << work->identification.command << ").";
+            }
+            _system_impl.unregister_timeout_handler(work->timeout_cookie);
+            temp_result = {Result::Unsupported, NAN};
+            remove_work(it);
+            break;
 
-                temp_result = {
-                    Result::InProgress, static_cast<float>(command_ack.progress) / 100.0f};
-                break;
+        case MAV_RESULT_TEMPORARILY_REJECTED:
+            if (_command_debugging) {
+                LogDebug() << "command temporarily rejected (" << work->identification.command
+                           << ").";
+            }
+            _system_impl.unregister_timeout_handler(work->timeout_cookie);
+            temp_result = {Result::TemporarilyRejected, NAN};
+            remove_work(it);
+            break;
 
-            case MAV_RESULT_CANCELLED:
-                if (_command_debugging) {
-                    LogDebug() << "command cancelled (" << work->identification.command << ").";
-                }
-                _system_impl.unregister_timeout_handler(work->timeout_cookie);
-                temp_result = {Result::Cancelled, NAN};
-                _work_queue.erase(it);
-                break;
+        case MAV_RESULT_FAILED:
+            if (_command_debugging) {
+                LogDebug() << "command failed (" << work->identification.command << ").";
+            }
+            _system_impl.unregister_timeout_handler(work->timeout_cookie);
+            temp_result = {Result::Failed, NAN};
+            remove_work(it);
+            break;
 
-            default:
-                LogWarn() << "Received unknown ack.";
-                break;
-        }
+        case MAV_RESULT_IN_PROGRESS:
+            if (_command_debugging) {
+                if (static_cast<int>(command_ack.progress) != 255) {
+                    LogDebug() << "progress: " << static_cast<int>(command_ack.progress)
+                               << " % (" << work->identification.command << ").";
+                }
+            }
+            // If we get a progress update, we can raise the timeout
+            // to something higher because we know the initial command
+            // has arrived. A possible timeout for this case is the initial
+            // timeout * the possible retries because this should match the
+            // case where there is no progress update, and we keep trying.
+            _system_impl.unregister_timeout_handler(work->timeout_cookie);
+            _system_impl.register_timeout_handler(
+                [this, identification = work->identification] {
+                    receive_timeout(identification);
+                },
+                work->retries_to_do * work->timeout_s,
+                &work->timeout_cookie);
+
+            temp_result = {
+                Result::InProgress, static_cast<float>(command_ack.progress) / 100.0f};
+            break;
 
-        if (temp_callback != nullptr) {
-            call_callback(temp_callback, temp_result.first, temp_result.second);
-        }
+        case MAV_RESULT_CANCELLED:
+            if (_command_debugging) {
+                LogDebug() << "command cancelled (" << work->identification.command << ").";
+            }
+            _system_impl.unregister_timeout_handler(work->timeout_cookie);
+            temp_result = {Result::Cancelled, NAN};
+            remove_work(it);
+            break;
 
-        return;
+        default:
+            LogWarn() << "Received unknown ack.";
+            break;
     }
 
-    if (_command_debugging) {
-        LogDebug() << "Received ack from " << static_cast<int>(message.sysid) << '/'
-                   << static_cast<int>(message.compid)
-                   << " for not-existing command: " << static_cast<int>(command_ack.command)
-                   << "! Ignoring...";
-    } else {
-        LogWarn() << "Received ack for not-existing command: "
-                  << static_cast<int>(command_ack.command) << "! Ignoring...";
+    if (temp_callback != nullptr) {
+        call_callback(temp_callback, temp_result.first, temp_result.second);
     }
 }
 
@@ -320,10 +346,13 @@ void MavlinkCommandSender::receive_timeout(const CommandIdentification& identifi
                          << ").";
                 temp_callback = work->callback;
                 temp_result = {Result::ConnectionError, NAN};
-                _work_queue.erase(it);
+                remove_work(it);
                 break;
             } else {
                 --work->retries_to_do;
+                work->rtt_measurable = false;
+                _system_impl.rtt_estimator().backoff();
+                work->timeout_s = _system_impl.timeout_s();
                 _system_impl.register_timeout_handler(
                     [this, identification = work->identification] {
                         receive_timeout(identification);
@@ -337,7 +366,7 @@ void MavlinkCommandSender::receive_timeout(const CommandIdentification& identifi
 
             temp_callback = work->callback;
             temp_result = {Result::Timeout, NAN};
-            _work_queue.erase(it);
+            remove_work(it);
             break;
         }
     }
@@ -352,6 +381,12 @@ void MavlinkCommandSender::receive_timeout(const CommandIdentification& identifi
     }
 }
 
+void MavlinkCommandSender::set_work_available_callback(std::function<void()> callback)
+{
+    // Commands are sent when queued, and held back ones can go once another is removed.
+    _work_queue.set_changed_callback(std::move(callback));
+}
+
 void MavlinkCommandSender::do_work()
 {
     LockedQueue<Work>::Guard work_queue_guard(_work_queue);
@@ -361,31 +396,17 @@ void MavlinkCommandSender::do_work()
             continue;
         }
 
-        bool already_being_sent = false;
-        for (const auto& other_work : _work_queue) {
-            // Ignore itself:
-            if (other_work == work) {
-                continue;
-            }
-
-            // Check if command with same command ID is already being sent.
-            if (other_work->already_sent &&
-                other_work->identification.command == work->identification.command) {
-                if (_command_debugging) {
-                    LogDebug() << "Command " << static_cast<int>(work->identification.command)
-                               << " is already being sent, waiting...";
-                }
-                already_being_sent = true;
-                break;
+        if (is_held_back(work->identification)) {
+            if (_command_debugging) {
+                LogDebug() << "Command " << static_cast<int>(work->identification.command)
+                           << " is already being sent, waiting...";
             }
-        }
-
-        if (already_being_sent) {
             continue;
         }
 
         // LogDebug() << "sending it the first time (" << work->mavlink_command << ")";
         work->time_started = _system_impl.get_time().steady_time();
+        work->timeout_s = _system_impl.timeout_s();
 
         {
             mavlink_message_t message = create_mavlink_message(work->command);
@@ -400,7 +421,7 @@ void MavlinkCommandSender::do_work()
             }
         }
 
-        work->already_sent = true;
+        set_in_flight(*work);
 
         _system_impl.register_timeout_handler(
             [this, identification = work->identification] { receive_timeout(identification); },
@@ -409,6 +430,109 @@ void MavlinkCommandSender::do_work()
     }
 }
 
+MavlinkCommandSender::CommandIdentification
+MavlinkCommandSender::in_flight_key(const CommandIdentification& identification)
+{
+    // The ack only carries the command ID besides who it is from, so two
+    // commands with the same ID to the same component can't be told apart,
+    // and only one of them can be in flight at a time.
+    //
+    // The exception is setting message intervals: this is idempotent and acks
+    // come back in order, so intervals for different messages are sent
+    // back-to-back anyway and each ack is matched to the oldest one sent.
+    // This is what makes configuring many streams at once fast on high
+    // latency links.
+    CommandIdentification key = identification;
+    if (identification.command != MAV_CMD_SET_MESSAGE_INTERVAL) {
+        key.maybe_param1 = 0;
+    }
+    key.maybe_param2 = 0;
+    return key;
+}
+
+MavlinkCommandSender::CommandIdentification
+MavlinkCommandSender::ack_key(const CommandIdentification& identification)
+{
+    // What an ack can be matched against.
+    CommandIdentification key = identification;
+    key.maybe_param1 = 0;
+    key.maybe_param2 = 0;
+    return key;
+}
+
+bool MavlinkCommandSender::is_held_back(const CommandIdentification& identification) const
+{
+    auto count = [](const IdentificationCounts& counts, const CommandIdentification& k) {
+        const auto it = counts.find(k);
+        return it != counts.end() ? it->second : 0u;
+    };
+
+    if (count(_in_flight, in_flight_key(identification)) > 0) {
+        return true;
+    }
+
+    // A command to all components clashes with the same command to any one
+    // component, as the acks could come from either.
+    auto any_component_key = ack_key(identification);
+    any_component_key.target_component_id = 0;
+
+    if (identification.target_component_id == 0) {
+        return count(_awaiting_ack_any_component, any_component_key) > 0;
+    }
+    return count(_awaiting_ack, any_component_key) > 0;
+}
+
+void MavlinkCommandSender::set_in_flight(Work& work)
+{
+    work.already_sent = true;
+    work.sent_sequence = ++_last_sent_sequence;
+
+    const auto key = ack_key(work.identification);
+    auto any_component_key = key;
+    any_component_key.target_component_id = 0;
+
+    ++_in_flight[in_flight_key(work.identification)];
+    ++_awaiting_ack_any_component[any_component_key];
+
+    if (++_awaiting_ack[key] > 1) {
+        // With more than one waiting for an ack, a lost ack or a
+        // retransmission would match a reply to the wrong command, so none
+        // of them gives a round trip time we can trust.
+        for (const auto& other : _work_queue) {
+            if (other->already_sent && ack_key(other->identification) == key) {
+                other->rtt_measurable = false;
+            }
+        }
+    }
+}
+
+LockedQueue<MavlinkCommandSender::Work>::iterator
+MavlinkCommandSender::remove_work(LockedQueue<Work>::iterator it)
+{
+    const auto& work = **it;
+
+    auto decrement = [](IdentificationCounts& counts, const CommandIdentification& key) {
+        auto count_it = counts.find(key);
+        if (count_it != counts.end() && --count_it->second == 0) {
+            counts.erase(count_it);
+        }
+    };
+
+    decrement(_queued, work.identification);
+
+    if (work.already_sent) {
+        const auto key = ack_key(work.identification);
+        auto any_component_key = key;
+        any_component_key.target_component_id = 0;
+
+        decrement(_in_flight, in_flight_key(work.identification));
+        decrement(_awaiting_ack, key);
+        decrement(_awaiting_ack_any_component, any_component_key);
+    }
+
+    return _work_queue.erase(it);
+}
+
 void MavlinkCommandSender::call_callback(
     const CommandResultCallback& callback, Result result, float progress)
 {
@@ -81,6 +81,9 @@ public:
 
     void do_work();
 
+    // Called whenever there might be work for do_work().
+    void set_work_available_callback(std::function<void()> callback);
+
     static const int DEFAULT_COMPONENT_ID_AUTOPILOT = MAV_COMP_ID_AUTOPILOT1;
 
     // Non-copyable
@@ -109,6 +112,21 @@ private:
         bool operator!=(const CommandIdentification& other) const { return !(*this == other); }
     };
 
+    struct CommandIdentificationHash {
+        size_t operator()(const CommandIdentification& identification) const
+        {
+            const uint64_t low = (uint64_t(identification.command) << 16) |
+                                 (uint64_t(identification.target_system_id) << 8) |
+                                 identification.target_component_id;
+            const uint64_t high =
+                (uint64_t(identification.maybe_param2) << 32) | identification.maybe_param1;
+            return std::hash<uint64_t>()(low ^ (high * 0x9e3779b97f4a7c15ull));
+        }
+    };
+
+    using IdentificationCounts =
+        std::unordered_map<CommandIdentification, unsigned, CommandIdentificationHash>;
+
     struct Work {
         Command command;
         CommandIdentification identification{};
@@ -118,6 +136,11 @@ private:
         double timeout_s{0.5};
         int retries_to_do{3};
         bool already_sent{false};
+        // Only the first reply to a command that has not been retransmitted
+        // tells us the round trip time.
+        bool rtt_measurable{true};
+        // Order in which commands were first sent, to match acks in order.
+        uint64_t sent_sequence{0};
     };
 
     template<typename CommandType>
@@ -146,6 +169,14 @@ private:
         return identification;
     }
 
+    static CommandIdentification in_flight_key(const CommandIdentification& identification);
+    static CommandIdentification ack_key(const CommandIdentification& identification);
+
+    // These require the work queue to be locked.
+    bool is_held_back(const CommandIdentification& identification) const;
+    void set_in_flight(Work& work);
+    LockedQueue<Work>::iterator remove_work(LockedQueue<Work>::iterator it);
+
     void receive_command_ack(mavlink_message_t message);
     void receive_timeout(const CommandIdentification& identification);
 
@@ -158,6 +189,17 @@ private:
     SystemImpl& _system_impl;
     LockedQueue<Work> _work_queue{};
 
+    // Indexes of the work queue, protected by its lock: how many commands
+    // are queued per identification, how many are sent per key of
+    // in_flight_key(), and how many are waiting for an ack per key of
+    // ack_key(), both for the exact target component and for all components
+    // together.
+    IdentificationCounts _queued{};
+    IdentificationCounts _in_flight{};
+    IdentificationCounts _awaiting_ack{};
+    IdentificationCounts _awaiting_ack_any_component{};
+    uint64_t _last_sent_sequence{0};
+
     bool _command_debugging{false};
 };
 
@@ -884,7 +884,7 @@ void MavlinkFtp::_send_mavlink_ftp_message(const PayloadHeader& payload)
         _last_command_timer_running = true;
         _system_impl.register_timeout_handler(
             [this]() { _command_timeout(); },
-            static_cast<double>(_last_command_timeout) / 1000.0,
+            _system_impl.timeout_s(_last_command_initial_timeout_s),
             &_last_command_timeout_cookie);
     }
 }
@@ -903,10 +903,11 @@ void MavlinkFtp::_command_timeout()
     } else {
         _last_command_retries++;
         LogWarn() << "Response timeout. Retry: " << _last_command_retries;
+        _system_impl.rtt_estimator().backoff();
         _system_impl.send_message(_last_command);
         _system_impl.register_timeout_handler(
             [this]() { _command_timeout(); },
-            static_cast<double>(_last_command_timeout) / 1000.0,
+            _system_impl.timeout_s(_last_command_initial_timeout_s),
             &_last_command_timeout_cookie);
     }
 }
@@ -200,7 +200,8 @@ private:
     void* _last_command_timeout_cookie = nullptr;
     bool _last_command_timer_running{false};
     std::mutex _timer_mutex{};
-    static constexpr uint32_t _last_command_timeout{200};
+    // Used until the round trip time to the system has been measured.
+    static constexpr double _last_command_initial_timeout_s{0.2};
     uint32_t _max_last_command_retries{5};
     uint32_t _last_command_retries = 0;
     std::string _last_path{};
@@ -1,10 +1,36 @@
 #include <algorithm>
+#include <optional>
 #include "mavlink_mission_transfer.h"
 #include "log.h"
 #include "unused.h"
 
 namespace mavsdk {
 
+namespace {
+
+// Wire offsets of the opaque id extension fields.
+constexpr unsigned mission_count_opaque_id_offset = 5;
+constexpr unsigned mission_ack_opaque_id_offset = 4;
+constexpr unsigned mission_current_mission_id_offset = 6;
+constexpr unsigned mission_current_fence_id_offset = 10;
+constexpr unsigned mission_current_rally_points_id_offset = 14;
+
+uint32_t read_uint32_extension(const mavlink_message_t& message, unsigned offset)
+{
+    // Trailing zero bytes are cut off by MAVLink 2, and MAVLink 1 doesn't
+    // have extensions at all, so anything missing counts as 0.
+    uint32_t value = 0;
+    for (unsigned i = 0; i < sizeof(value); ++i) {
+        if (offset + i < message.len) {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(_MAV_PAYLOAD(&message)[offset + i]))
+                     << (8 * i);
+        }
+    }
+    return value;
+}
+
+} // namespace
+
 MavlinkMissionTransfer::MavlinkMissionTransfer(
     Sender& sender,
     MavlinkMessageHandler& message_handler,
@@ -21,6 +47,16 @@ MavlinkMissionTransfer::MavlinkMissionTransfer(
             _debugging = true;
         }
     }
+
+    _message_handler.register_one(
+        MAVLINK_MSG_ID_MISSION_CURRENT,
+        [this](const mavlink_message_t& message) { process_mission_current(message); },
+        this);
+}
+
+MavlinkMissionTransfer::~MavlinkMissionTransfer()
+{
+    _message_handler.unregister_all(this);
 }
 
 std::weak_ptr<MavlinkMissionTransfer::WorkItem> MavlinkMissionTransfer::upload_items_async(
@@ -37,18 +73,129 @@ std::weak_ptr<MavlinkMissionTransfer::WorkItem> MavlinkMissionTransfer::upload_i
         return {};
     }
 
+    return queue_upload(type, items, {}, callback, progress_callback);
+}
+
+std::weak_ptr<MavlinkMissionTransfer::WorkItem> MavlinkMissionTransfer::upload_changed_items_async(
+    uint8_t type,
+    const std::vector<ItemInt>& items,
+    const ResultCallback& callback,
+    const ProgressCallback& progress_callback)
+{
+    if (!_int_messages_supported) {
+        if (callback) {
+            LogErr() << "Int messages are not supported.";
+            callback(Result::IntMessagesNotSupported);
+        }
+        return {};
+    }
+
+    std::vector<ItemRange> ranges;
+    bool unchanged = false;
+    {
+        std::lock_guard<std::mutex> lock(_known_missions_mutex);
+        auto it = _known_missions.find(type);
+        if (it != _known_missions.end() && !items.empty() &&
+            it->second.items.size() == items.size()) {
+            // If the vehicle tells us that its mission is a different one
+            // now, someone else must have changed it.
+            const auto reported = _reported_opaque_ids.find(type);
+            const bool changed_elsewhere = it->second.opaque_id != 0 &&
+                                           reported != _reported_opaque_ids.end() &&
+                                           reported->second != it->second.opaque_id;
+            if (!changed_elsewhere) {
+                ranges = changed_ranges(it->second.items, items);
+                unchanged = ranges.empty();
+            }
+        }
+    }
+
+    if (unchanged) {
+        if (_debugging) {
+            LogDebug() << "Mission unchanged, nothing to upload";
+        }
+        if (progress_callback) {
+            progress_callback(1.0f);
+        }
+        if (callback) {
+            callback(Result::Success);
+        }
+        return {};
+    }
+
+    // If everything changed, there is nothing to gain from a partial upload.
+    if (ranges.size() == 1 && ranges[0].first == 0 && ranges[0].last + 1u == items.size()) {
+        ranges.clear();
+    }
+
+    if (_debugging && !ranges.empty()) {
+        LogDebug() << "Uploading " << ranges.size() << " changed ranges of mission items";
+    }
+
+    return queue_upload(type, items, std::move(ranges), callback, progress_callback);
+}
+
+std::vector<MavlinkMissionTransfer::ItemRange> MavlinkMissionTransfer::changed_ranges(
+    const std::vector<ItemInt>& before, const std::vector<ItemInt>& after)
+{
+    std::vector<ItemRange> ranges;
+
+    if (before.size() != after.size()) {
+        LogErr() << "Can't compare missions of different size";
+        return ranges;
+    }
+
+    for (std::size_t i = 0; i < after.size(); ++i) {
+        // The seq is not compared because ArduPilot missions are offset by
+        // one when uploaded compared to downloaded.
+        auto item = after[i];
+        item.seq = before[i].seq;
+        if (item == before[i]) {
+            continue;
+        }
+
+        const auto index = static_cast<uint16_t>(i);
+        if (!ranges.empty() &&
+            static_cast<unsigned>(index - ranges.back().last) <= max_unchanged_items_in_range + 1) {
+            ranges.back().last = index;
+        } else {
+            ranges.push_back(ItemRange{index, index});
+        }
+    }
+
+    return ranges;
+}
+
+std::weak_ptr<MavlinkMissionTransfer::WorkItem> MavlinkMissionTransfer::queue_upload(
+    uint8_t type,
+    const std::vector<ItemInt>& items,
+    std::vector<ItemRange> ranges,
+    const ResultCallback& callback,
+    const ProgressCallback& progress_callback)
+{
     auto ptr = std::make_shared<UploadWorkItem>(
         _sender,
         _message_handler,
         _timeout_handler,
         type,
         items,
+        std::move(ranges),
         _timeout_s_callback(),
-        callback,
+        [this, type, items, callback](Result result, uint32_t opaque_id) {
+            if (result == Result::Success) {
+                set_known_mission(type, items, opaque_id);
+            } else {
+                // We don't know how much of it made it to the vehicle.
+                forget_known_mission(type);
+            }
+            if (callback) {
+                callback(result);
+            }
+        },
         progress_callback,
         _debugging);
 
-    _work_queue.push_back(ptr);
+    queue_work(ptr);
 
     return std::weak_ptr<WorkItem>(ptr);
 }
@@ -64,17 +211,82 @@ std::weak_ptr<MavlinkMissionTransfer::WorkItem> MavlinkMissionTransfer::download
         return {};
     }
 
+    return queue_download(type, std::move(callback), std::move(progress_callback), false);
+}
+
+std::weak_ptr<MavlinkMissionTransfer::WorkItem> MavlinkMissionTransfer::download_items_cached_async(
+    uint8_t type, ResultAndItemsCallback callback, ProgressCallback progress_callback)
+{
+    if (!_int_messages_supported) {
+        if (callback) {
+            LogErr() << "Int messages are not supported.";
+            callback(Result::IntMessagesNotSupported, {});
+        }
+        return {};
+    }
+
+    std::optional<std::vector<ItemInt>> cached_items;
+    {
+        std::lock_guard<std::mutex> lock(_known_missions_mutex);
+        auto known = _known_missions.find(type);
+        auto reported = _reported_opaque_ids.find(type);
+        if (known != _known_missions.end() && known->second.opaque_id != 0 &&
+            reported != _reported_opaque_ids.end() &&
+            reported->second == known->second.opaque_id) {
+            cached_items = known->second.items;
+        }
+    }
+
+    if (cached_items) {
+        if (_debugging) {
+            LogDebug() << "Mission unchanged according to mission_current, not downloading";
+        }
+        if (progress_callback) {
+            progress_callback(1.0f);
+        }
+        if (callback) {
+            callback(Result::Unchanged, std::move(*cached_items));
+        }
+        return {};
+    }
+
+    return queue_download(type, std::move(callback), std::move(progress_callback), true);
+}
+
+std::weak_ptr<MavlinkMissionTransfer::WorkItem> MavlinkMissionTransfer::queue_download(
+    uint8_t type,
+    ResultAndItemsCallback callback,
+    ProgressCallback progress_callback,
+    bool use_cache)
+{
+    KnownMission cached;
+    if (use_cache) {
+        std::lock_guard<std::mutex> lock(_known_missions_mutex);
+        auto it = _known_missions.find(type);
+        if (it != _known_missions.end()) {
+            cached = it->second;
+        }
+    }
+
     auto ptr = std::make_shared<DownloadWorkItem>(
         _sender,
         _message_handler,
         _timeout_handler,
         type,
         _timeout_s_callback(),
-        callback,
+        [this, type, callback](Result result, std::vector<ItemInt> items, uint32_t opaque_id) {
+            if (result == Result::Success || result == Result::Unchanged) {
+                set_known_mission(type, items, opaque_id);
+            }
+            if (callback) {
+                callback(result, std::move(items));
+            }
+        },
         progress_callback,
+        std::move(cached),
         _debugging);
 
-    _work_queue.push_back(ptr);
+    queue_work(ptr);
 
     return std::weak_ptr<WorkItem>(ptr);
 }
@@ -102,7 +314,7 @@ MavlinkMissionTransfer::receive_incoming_items_async(
         target_component,
         _debugging);
 
-    _work_queue.push_back(ptr);
+    queue_work(ptr);
 
     return std::weak_ptr<WorkItem>(ptr);
 }
@@ -115,10 +327,19 @@ void MavlinkMissionTransfer::clear_items_async(uint8_t type, ResultCallback call
         _timeout_handler,
         type,
         _timeout_s_callback(),
-        callback,
+        [this, type, callback](Result result) {
+            if (result == Result::Success) {
+                set_known_mission(type, {}, 0);
+            } else {
+                forget_known_mission(type);
+            }
+            if (callback) {
+                callback(result);
+            }
+        },
         _debugging);
 
-    _work_queue.push_back(ptr);
+    queue_work(ptr);
 }
 
 void MavlinkMissionTransfer::set_current_item_async(int current, ResultCallback callback)
@@ -132,7 +353,7 @@ void MavlinkMissionTransfer::set_current_item_async(int current, ResultCallback
         callback,
         _debugging);
 
-    _work_queue.push_back(ptr);
+    queue_work(ptr);
 }
 
 void MavlinkMissionTransfer::do_work()
@@ -152,6 +373,77 @@ void MavlinkMissionTransfer::do_work()
     }
 }
 
+void MavlinkMissionTransfer::set_work_available_callback(std::function<void()> callback)
+{
+    _work_available_callback = callback;
+    _work_queue.set_changed_callback(std::move(callback));
+}
+
+void MavlinkMissionTransfer::queue_work(std::shared_ptr<WorkItem> work)
+{
+    work->set_done_callback(_work_available_callback);
+    _work_queue.push_back(std::move(work));
+}
+
+void MavlinkMissionTransfer::set_known_mission(
+    uint8_t type, const std::vector<ItemInt>& items, uint32_t opaque_id)
+{
+    std::lock_guard<std::mutex> lock(_known_missions_mutex);
+    _known_missions[type] = KnownMission{items, opaque_id};
+    // Whatever mission_current said before is older than this, so we wait
+    // for it to confirm the id again.
+    _reported_opaque_ids.erase(type);
+}
+
+void MavlinkMissionTransfer::forget_known_mission(uint8_t type)
+{
+    std::lock_guard<std::mutex> lock(_known_missions_mutex);
+    _known_missions.erase(type);
+}
+
+void MavlinkMissionTransfer::process_mission_current(const mavlink_message_t& message)
+{
+    // The message handler is shared by all systems.
+    if (message.sysid != _sender.get_system_id()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_known_missions_mutex);
+
+    for (const uint8_t type :
+         {MAV_MISSION_TYPE_MISSION, MAV_MISSION_TYPE_FENCE, MAV_MISSION_TYPE_RALLY}) {
+        const auto opaque_id = opaque_id_from_mission_current(message, type);
+        if (opaque_id != 0) {
+            _reported_opaque_ids[type] = opaque_id;
+        }
+    }
+}
+
+uint32_t MavlinkMissionTransfer::opaque_id_from_mission_count(const mavlink_message_t& message)
+{
+    return read_uint32_extension(message, mission_count_opaque_id_offset);
+}
+
+uint32_t MavlinkMissionTransfer::opaque_id_from_mission_ack(const mavlink_message_t& message)
+{
+    return read_uint32_extension(message, mission_ack_opaque_id_offset);
+}
+
+uint32_t MavlinkMissionTransfer::opaque_id_from_mission_current(
+    const mavlink_message_t& message, uint8_t type)
+{
+    switch (type) {
+        case MAV_MISSION_TYPE_MISSION:
+            return read_uint32_extension(message, mission_current_mission_id_offset);
+        case MAV_MISSION_TYPE_FENCE:
+            return read_uint32_extension(message, mission_current_fence_id_offset);
+        case MAV_MISSION_TYPE_RALLY:
+            return read_uint32_extension(message, mission_current_rally_points_id_offset);
+        default:
+            return 0;
+    }
+}
+
 bool MavlinkMissionTransfer::is_idle()
 {
     LockedQueue<WorkItem>::Guard work_queue_guard(_work_queue);
@@ -187,20 +479,36 @@ bool MavlinkMissionTransfer::WorkItem::is_done()
     return _done;
 }
 
+void MavlinkMissionTransfer::WorkItem::set_done_callback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _done_callback = std::move(callback);
+}
+
+void MavlinkMissionTransfer::WorkItem::set_done()
+{
+    _done = true;
+    if (_done_callback) {
+        _done_callback();
+    }
+}
+
 MavlinkMissionTransfer::UploadWorkItem::UploadWorkItem(
     Sender& sender,
     MavlinkMessageHandler& message_handler,
     TimeoutHandler& timeout_handler,
     uint8_t type,
     const std::vector<ItemInt>& items,
+    std::vector<ItemRange> ranges,
     double timeout_s,
-    ResultCallback callback,
+    ResultAndOpaqueIdCallback callback,
     ProgressCallback progress_callback,
     bool debugging) :
     WorkItem(sender, message_handler, timeout_handler, type, timeout_s, debugging),
     _items(items),
     _callback(callback),
-    _progress_callback(progress_callback)
+    _progress_callback(progress_callback),
+    _ranges(std::move(ranges))
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
@@ -277,8 +585,31 @@ void MavlinkMissionTransfer::UploadWorkItem::start()
         return;
     }
 
+    if (std::any_of(_ranges.cbegin(), _ranges.cend(), [this](const ItemRange& range) {
+            return range.first > range.last || range.last >= _items.size();
+        })) {
+        LogErr() << "Invalid range of items to upload";
+        callback_and_reset(Result::InvalidSequence);
+        return;
+    }
+
     update_progress(0.0f);
 
+    if (_ranges.empty()) {
+        upload_whole_mission();
+        return;
+    }
+
+    for (const auto& range : _ranges) {
+        _items_in_ranges += range.last - range.first + 1;
+    }
+    _range_index = 0;
+    start_range();
+}
+
+void MavlinkMissionTransfer::UploadWorkItem::upload_whole_mission()
+{
+    _ranges.clear();
     _retries_done = 0;
     _step = Step::SendCount;
     _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
@@ -288,6 +619,17 @@ void MavlinkMissionTransfer::UploadWorkItem::start()
     send_count();
 }
 
+void MavlinkMissionTransfer::UploadWorkItem::start_range()
+{
+    _retries_done = 0;
+    _step = Step::SendPartialList;
+    _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
+
+    _next_sequence = _ranges[_range_index].first;
+
+    send_partial_list();
+}
+
 void MavlinkMissionTransfer::UploadWorkItem::cancel()
 {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -322,6 +664,35 @@ void MavlinkMissionTransfer::UploadWorkItem::send_count()
     ++_retries_done;
 }
 
+void MavlinkMissionTransfer::UploadWorkItem::send_partial_list()
+{
+    const auto& range = _ranges[_range_index];
+
+    mavlink_message_t message;
+    mavlink_msg_mission_write_partial_list_pack(
+        _sender.get_own_system_id(),
+        _sender.get_own_component_id(),
+        &message,
+        _sender.get_system_id(),
+        MAV_COMP_ID_AUTOPILOT1,
+        range.first,
+        range.last,
+        _type);
+
+    if (!_sender.send_message(message)) {
+        _timeout_handler.remove(_cookie);
+        callback_and_reset(Result::ConnectionError);
+        return;
+    }
+
+    if (_debugging) {
+        LogDebug() << "Sending send_partial_list, first: " << range.first
+                   << ", last: " << range.last << ", retries: " << _retries_done;
+    }
+
+    ++_retries_done;
+}
+
 void MavlinkMissionTransfer::UploadWorkItem::send_cancel_and_finish()
 {
     mavlink_message_t message;
@@ -396,13 +767,19 @@ void MavlinkMissionTransfer::UploadWorkItem::process_mission_request_int(
     mavlink_mission_request_int_t request_int;
     mavlink_msg_mission_request_int_decode(&message, &request_int);
 
-    _step = Step::SendItems;
-
     if (_debugging) {
         LogDebug() << "Process mission_request_int, seq: " << request_int.seq
                    << ", next expected sequence: " << _next_sequence;
     }
 
+    if (!_ranges.empty() && (request_int.seq < _ranges[_range_index].first ||
+                             request_int.seq > _ranges[_range_index].last)) {
+        LogWarn() << "mission_request_int: sequence outside of range";
+        return;
+    }
+
+    _step = Step::SendItems;
+
     if (_next_sequence < request_int.seq) {
         // We should not go back to a previous one.
         // TODO: figure out if we should error here.
@@ -428,7 +805,15 @@ void MavlinkMissionTransfer::UploadWorkItem::process_mission_request_int(
     _next_sequence = request_int.seq;
 
     // We add in a step for the final ack, so plus one.
-    update_progress(static_cast<float>(_next_sequence + 1) / static_cast<float>(_items.size() + 1));
+    if (_ranges.empty()) {
+        update_progress(
+            static_cast<float>(_next_sequence + 1) / static_cast<float>(_items.size() + 1));
+    } else {
+        const auto items_done =
+            _items_in_earlier_ranges + _next_sequence - _ranges[_range_index].first + 1;
+        update_progress(
+            static_cast<float>(items_done) / static_cast<float>(_items_in_ranges + 1));
+    }
 
     send_mission_item();
 }
@@ -483,13 +868,20 @@ void MavlinkMissionTransfer::UploadWorkItem::process_mission_ack(const mavlink_m
 
     mavlink_mission_ack_t mission_ack;
     mavlink_msg_mission_ack_decode(&message, &mission_ack);
+    _opaque_id = opaque_id_from_mission_ack(message);
 
     if (_debugging) {
-        LogDebug() << "Received mission_ack type: " << static_cast<int>(mission_ack.type);
+        LogDebug() << "Received mission_ack type: " << static_cast<int>(mission_ack.type)
+                   << ", opaque_id: " << _opaque_id;
     }
 
     _timeout_handler.remove(_cookie);
 
+    if (!_ranges.empty()) {
+        process_partial_mission_ack(mission_ack.type);
+        return;
+    }
+
     switch (mission_ack.type) {
         case MAV_MISSION_ERROR:
             callback_and_reset(Result::ProtocolError);
@@ -539,6 +931,34 @@ void MavlinkMissionTransfer::UploadWorkItem::process_mission_ack(const mavlink_m
     }
 }
 
+void MavlinkMissionTransfer::UploadWorkItem::process_partial_mission_ack(uint8_t type)
+{
+    if (type == MAV_MISSION_OPERATION_CANCELLED) {
+        callback_and_reset(Result::Cancelled);
+        return;
+    }
+
+    if (type != MAV_MISSION_ACCEPTED || _next_sequence != _ranges[_range_index].last + 1u) {
+        // Whatever went wrong, the vehicle's mission is now in an unknown
+        // state, so we start over and send everything.
+        LogWarn() << "Partial mission upload failed (" << static_cast<int>(type)
+                  << "), uploading whole mission";
+        upload_whole_mission();
+        return;
+    }
+
+    const auto& range = _ranges[_range_index];
+    _items_in_earlier_ranges += range.last - range.first + 1;
+
+    if (++_range_index < _ranges.size()) {
+        start_range();
+        return;
+    }
+
+    update_progress(1.0f);
+    callback_and_reset(Result::Success);
+}
+
 void MavlinkMissionTransfer::UploadWorkItem::process_timeout()
 {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -559,6 +979,18 @@ void MavlinkMissionTransfer::UploadWorkItem::process_timeout()
             send_count();
             break;
 
+        case Step::SendPartialList:
+            if (_range_index == 0) {
+                // Not all autopilots support MISSION_WRITE_PARTIAL_LIST and
+                // they don't necessarily tell us, so we don't wait any longer.
+                LogWarn() << "No answer to partial mission upload, uploading whole mission";
+                upload_whole_mission();
+            } else {
+                _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
+                send_partial_list();
+            }
+            break;
+
         case Step::SendItems:
             // When waiting for items requested we should wait longer than
             // just our timeout, otherwise we give up too quickly.
@@ -571,10 +1003,10 @@ void MavlinkMissionTransfer::UploadWorkItem::process_timeout()
 void MavlinkMissionTransfer::UploadWorkItem::callback_and_reset(Result result)
 {
     if (_callback) {
-        _callback(result);
+        _callback(result, _opaque_id);
     }
     _callback = nullptr;
-    _done = true;
+    set_done();
 }
 
 void MavlinkMissionTransfer::UploadWorkItem::update_progress(float progress)
@@ -590,12 +1022,14 @@ MavlinkMissionTransfer::DownloadWorkItem::DownloadWorkItem(
     TimeoutHandler& timeout_handler,
     uint8_t type,
     double timeout_s,
-    ResultAndItemsCallback callback,
+    ResultItemsAndOpaqueIdCallback callback,
     ProgressCallback progress_callback,
+    KnownMission cached,
     bool debugging) :
     WorkItem(sender, message_handler, timeout_handler, type, timeout_s, debugging),
     _callback(callback),
-    _progress_callback(progress_callback)
+    _progress_callback(progress_callback),
+    _cached(std::move(cached))
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
@@ -680,7 +1114,7 @@ void MavlinkMissionTransfer::DownloadWorkItem::request_item()
     ++_retries_done;
 }
 
-void MavlinkMissionTransfer::DownloadWorkItem::send_ack_and_finish()
+void MavlinkMissionTransfer::DownloadWorkItem::send_ack_and_finish(Result result)
 {
     mavlink_message_t message;
     mavlink_msg_mission_ack_pack(
@@ -698,7 +1132,7 @@ void MavlinkMissionTransfer::DownloadWorkItem::send_ack_and_finish()
     }
 
     // We do not wait on anything coming back after this.
-    callback_and_reset(Result::Success);
+    callback_and_reset(result);
 }
 
 void MavlinkMissionTransfer::DownloadWorkItem::send_cancel_and_finish()
@@ -729,9 +1163,24 @@ void MavlinkMissionTransfer::DownloadWorkItem::process_mission_count(
 
     mavlink_mission_count_t count;
     mavlink_msg_mission_count_decode(&message, &count);
+    _opaque_id = opaque_id_from_mission_count(message);
+
+    if (_debugging) {
+        LogDebug() << "Received mission_count: " << count.count << ", opaque_id: " << _opaque_id;
+    }
+
+    if (_opaque_id != 0 && _opaque_id == _cached.opaque_id &&
+        count.count == _cached.items.size()) {
+        // We already have this mission, no need to download it again.
+        _timeout_handler.remove(_cookie);
+        _items = std::move(_cached.items);
+        update_progress(1.0f);
+        send_ack_and_finish(Result::Unchanged);
+        return;
+    }
 
     if (count.count == 0) {
-        send_ack_and_finish();
+        send_ack_and_finish(Result::Success);
         _timeout_handler.remove(_cookie);
         return;
     }
@@ -774,7 +1223,7 @@ void MavlinkMissionTransfer::DownloadWorkItem::process_mission_item_int(
         if (_next_sequence + 1 == _expected_count) {
             _timeout_handler.remove(_cookie);
             update_progress(1.0f);
-            send_ack_and_finish();
+            send_ack_and_finish(Result::Success);
 
         } else {
             _next_sequence = item_int.seq + 1;
@@ -811,10 +1260,10 @@ void MavlinkMissionTransfer::DownloadWorkItem::process_timeout()
 void MavlinkMissionTransfer::DownloadWorkItem::callback_and_reset(Result result)
 {
     if (_callback) {
-        _callback(result, _items);
+        _callback(result, _items, _opaque_id);
     }
     _callback = nullptr;
-    _done = true;
+    set_done();
 }
 
 void MavlinkMissionTransfer::DownloadWorkItem::update_progress(float progress)
@@ -1006,7 +1455,7 @@ void MavlinkMissionTransfer::ReceiveIncomingMission::callback_and_reset(Result r
         _callback(result, _items);
     }
     _callback = nullptr;
-    _done = true;
+    set_done();
 }
 
 MavlinkMissionTransfer::ClearWorkItem::ClearWorkItem(
@@ -1147,7 +1596,7 @@ void MavlinkMissionTransfer::ClearWorkItem::callback_and_reset(Result result)
         _callback(result);
     }
     _callback = nullptr;
-    _done = true;
+    set_done();
 }
 
 void MavlinkMissionTransfer::set_int_messages_supported(bool supported)
@@ -1268,6 +1717,6 @@ void MavlinkMissionTransfer::SetCurrentWorkItem::callback_and_reset(Result resul
         _callback(result);
     }
     _callback = nullptr;
-    _done = true;
+    set_done();
 }
 } // namespace mavsdk
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -33,7 +34,8 @@ public:
         CurrentInvalid,
         ProtocolError,
         InvalidParam,
-        IntMessagesNotSupported
+        IntMessagesNotSupported,
+        Unchanged
     };
 
     struct ItemInt {
@@ -62,10 +64,33 @@ public:
         }
     };
 
+    // Range of mission items, including first and last.
+    struct ItemRange {
+        uint16_t first;
+        uint16_t last;
+
+        bool operator==(const ItemRange& other) const
+        {
+            return first == other.first && last == other.last;
+        }
+    };
+
     using ResultCallback = std::function<void(Result result)>;
     using ResultAndItemsCallback = std::function<void(Result result, std::vector<ItemInt> items)>;
     using ProgressCallback = std::function<void(float progress)>;
 
+    // With the opaque id the vehicle reported for the mission, 0 if none.
+    using ResultAndOpaqueIdCallback = std::function<void(Result result, uint32_t opaque_id)>;
+    using ResultItemsAndOpaqueIdCallback =
+        std::function<void(Result result, std::vector<ItemInt> items, uint32_t opaque_id)>;
+
+    // A mission as we last saw it on the vehicle.
+    struct KnownMission {
+        std::vector<ItemInt> items{};
+        // As reported by the vehicle, 0 if it doesn't support opaque ids.
+        uint32_t opaque_id{0};
+    };
+
     class WorkItem {
     public:
         explicit WorkItem(
@@ -81,12 +106,18 @@ public:
         bool has_started();
         bool is_done();
 
+        // Called once the item is done and the next one can be started.
+        void set_done_callback(std::function<void()> callback);
+
         WorkItem(const WorkItem&) = delete;
         WorkItem(WorkItem&&) = delete;
         WorkItem& operator=(const WorkItem&) = delete;
         WorkItem& operator=(WorkItem&&) = delete;
 
     protected:
+        // Needs to be called with _mutex locked.
+        void set_done();
+
         Sender& _sender;
         MavlinkMessageHandler& _message_handler;
         TimeoutHandler& _timeout_handler;
@@ -94,6 +125,7 @@ public:
         double _timeout_s;
         bool _started{false};
         bool _done{false};
+        std::function<void()> _done_callback{};
         std::mutex _mutex{};
         bool _debugging;
     };
@@ -106,8 +138,9 @@ public:
             TimeoutHandler& timeout_handler,
             uint8_t type,
             const std::vector<ItemInt>& items,
+            std::vector<ItemRange> ranges,
             double timeout_s,
-            ResultCallback callback,
+            ResultAndOpaqueIdCallback callback,
             ProgressCallback progress_callback,
             bool debugging);
 
@@ -121,13 +154,17 @@ public:
         UploadWorkItem& operator=(UploadWorkItem&&) = delete;
 
     private:
+        void upload_whole_mission();
+        void start_range();
         void send_count();
+        void send_partial_list();
         void send_mission_item();
         void send_cancel_and_finish();
 
         void process_mission_request(const mavlink_message_t& message);
         void process_mission_request_int(const mavlink_message_t& message);
         void process_mission_ack(const mavlink_message_t& message);
+        void process_partial_mission_ack(uint8_t type);
         void process_timeout();
         void callback_and_reset(Result result);
 
@@ -135,13 +172,20 @@ public:
 
         enum class Step {
             SendCount,
+            SendPartialList,
             SendItems,
         } _step{Step::SendCount};
 
         std::vector<ItemInt> _items{};
-        ResultCallback _callback{nullptr};
+        ResultAndOpaqueIdCallback _callback{nullptr};
         ProgressCallback _progress_callback{nullptr};
         std::size_t _next_sequence{0};
+        uint32_t _opaque_id{0};
+        // Only these items are sent if not empty, one range after the other.
+        std::vector<ItemRange> _ranges{};
+        std::size_t _range_index{0};
+        std::size_t _items_in_earlier_ranges{0};
+        std::size_t _items_in_ranges{0};
         void* _cookie{nullptr};
         unsigned _retries_done{0};
     };
@@ -200,8 +244,9 @@ public:
             TimeoutHandler& timeout_handler,
             uint8_t type,
             double timeout_s,
-            ResultAndItemsCallback callback,
+            ResultItemsAndOpaqueIdCallback callback,
             ProgressCallback progress_callback,
+            KnownMission cached,
             bool debugging);
 
         ~DownloadWorkItem() override;
@@ -216,7 +261,7 @@ public:
     private:
         void request_list();
         void request_item();
-        void send_ack_and_finish();
+        void send_ack_and_finish(Result result);
         void send_cancel_and_finish();
         void process_mission_count(const mavlink_message_t& message);
         void process_mission_item_int(const mavlink_message_t& message);
@@ -231,11 +276,15 @@ public:
         } _step{Step::RequestList};
 
         std::vector<ItemInt> _items{};
-        ResultAndItemsCallback _callback{nullptr};
+        ResultItemsAndOpaqueIdCallback _callback{nullptr};
         ProgressCallback _progress_callback{nullptr};
+        // Returned instead of downloading if the vehicle reports the same
+        // opaque id for its mission.
+        KnownMission _cached{};
         void* _cookie{nullptr};
         std::size_t _next_sequence{0};
         std::size_t _expected_count{0};
+        uint32_t _opaque_id{0};
         unsigned _retries_done{0};
     };
 
@@ -305,13 +354,17 @@ public:
 
     static constexpr unsigned retries = 5;
 
+    // Unchanged items between two changed ones are sent again rather than
+    // starting a new range if there are at most this many.
+    static constexpr unsigned max_unchanged_items_in_range = 2;
+
     explicit MavlinkMissionTransfer(
         Sender& sender,
         MavlinkMessageHandler& message_handler,
         TimeoutHandler& timeout_handler,
         TimeoutSCallback get_timeout_s_callback);
 
-    ~MavlinkMissionTransfer() = default;
+    ~MavlinkMissionTransfer();
 
     std::weak_ptr<WorkItem> upload_items_async(
         uint8_t type,
@@ -319,11 +372,44 @@ public:
         const ResultCallback& callback,
         const ProgressCallback& progress_callback = nullptr);
 
+    // Like upload_items_async but only sends the items which changed compared
+    // to the mission last uploaded or downloaded, using
+    // MISSION_WRITE_PARTIAL_LIST. This assumes that nobody else changed the
+    // mission on the vehicle in the meantime.
+    // Falls back to uploading all items if the number of items changed, the
+    // mission is not known, or the vehicle doesn't accept the partial list.
+    std::weak_ptr<WorkItem> upload_changed_items_async(
+        uint8_t type,
+        const std::vector<ItemInt>& items,
+        const ResultCallback& callback,
+        const ProgressCallback& progress_callback = nullptr);
+
+    // Ranges of items which are different in after, ignoring seq.
+    // Both need to have the same size.
+    static std::vector<ItemRange>
+    changed_ranges(const std::vector<ItemInt>& before, const std::vector<ItemInt>& after);
+
     std::weak_ptr<WorkItem> download_items_async(
         uint8_t type,
         ResultAndItemsCallback callback,
         ProgressCallback progress_callback = nullptr);
 
+    // Like download_items_async but returns the mission last transferred with
+    // Result::Unchanged if the vehicle reports the same opaque id for it, either
+    // in MISSION_CURRENT, which avoids any traffic, or in MISSION_COUNT.
+    // Vehicles not supporting opaque ids always get the whole mission downloaded.
+    std::weak_ptr<WorkItem> download_items_cached_async(
+        uint8_t type,
+        ResultAndItemsCallback callback,
+        ProgressCallback progress_callback = nullptr);
+
+    // The opaque ids are extension fields which the MAVLink headers we build
+    // against don't know about yet, so they are read from the payload
+    // directly. 0 means not sent.
+    static uint32_t opaque_id_from_mission_count(const mavlink_message_t& message);
+    static uint32_t opaque_id_from_mission_ack(const mavlink_message_t& message);
+    static uint32_t opaque_id_from_mission_current(const mavlink_message_t& message, uint8_t type);
+
     // Server-side
     std::weak_ptr<WorkItem> receive_incoming_items_async(
         uint8_t type,
@@ -338,6 +424,9 @@ public:
     void do_work();
     bool is_idle();
 
+    // Called whenever there might be work for do_work().
+    void set_work_available_callback(std::function<void()> callback);
+
     void set_int_messages_supported(bool supported);
 
     // Non-copyable
@@ -345,12 +434,39 @@ public:
     const MavlinkMissionTransfer& operator=(const MavlinkMissionTransfer&) = delete;
 
 private:
+    std::weak_ptr<WorkItem> queue_download(
+        uint8_t type,
+        ResultAndItemsCallback callback,
+        ProgressCallback progress_callback,
+        bool use_cache);
+
+    std::weak_ptr<WorkItem> queue_upload(
+        uint8_t type,
+        const std::vector<ItemInt>& items,
+        std::vector<ItemRange> ranges,
+        const ResultCallback& callback,
+        const ProgressCallback& progress_callback);
+
+    void queue_work(std::shared_ptr<WorkItem> work);
+
+    void set_known_mission(uint8_t type, const std::vector<ItemInt>& items, uint32_t opaque_id);
+    void forget_known_mission(uint8_t type);
+
+    void process_mission_current(const mavlink_message_t& message);
+
     Sender& _sender;
     MavlinkMessageHandler& _message_handler;
     TimeoutHandler& _timeout_handler;
     TimeoutSCallback _timeout_s_callback;
 
     LockedQueue<WorkItem> _work_queue{};
+    std::function<void()> _work_available_callback{};
+
+    // What we think is on the vehicle, by mission type, after the last
+    // successful transfer, and the opaque ids the vehicle last reported.
+    std::mutex _known_missions_mutex{};
+    std::map<uint8_t, KnownMission> _known_missions{};
+    std::map<uint8_t, uint32_t> _reported_opaque_ids{};
 
     bool _int_messages_supported{true};
     bool _debugging{false};
@@ -1996,3 +1996,480 @@ TEST_F(MavlinkMissionTransferTest, IntMessagesNotSupported)
     mmt.do_work();
     EXPECT_TRUE(mmt.is_idle());
 }
+
+TEST(MavlinkMissionTransfer, ChangedRanges)
+{
+    std::vector<ItemInt> before;
+    for (uint16_t i = 0; i < 12; ++i) {
+        before.push_back(make_item(MAV_MISSION_TYPE_MISSION, i));
+    }
+
+    EXPECT_TRUE(MavlinkMissionTransfer::changed_ranges(before, before).empty());
+
+    auto after = before;
+    after[1].x = 42;
+    // Close enough to be merged with the one before.
+    after[3].y = 42;
+    after[4].z = 42.0f;
+    // Too many unchanged items in between.
+    after[8].command = MAV_CMD_NAV_LAND;
+    // Just close enough again.
+    after[11].param1 = 42.0f;
+
+    const std::vector<MavlinkMissionTransfer::ItemRange> expected{{1, 4}, {8, 11}};
+    EXPECT_EQ(MavlinkMissionTransfer::changed_ranges(before, after), expected);
+
+    // The seq alone doesn't make an item different.
+    auto shifted = before;
+    for (auto& item : shifted) {
+        ++item.seq;
+    }
+    EXPECT_TRUE(MavlinkMissionTransfer::changed_ranges(before, shifted).empty());
+}
+
+bool is_correct_mission_write_partial_list(
+    uint8_t type, uint16_t first, uint16_t last, const mavlink_message_t& message)
+{
+    if (message.msgid != MAVLINK_MSG_ID_MISSION_WRITE_PARTIAL_LIST) {
+        return false;
+    }
+
+    mavlink_mission_write_partial_list_t partial_list;
+    mavlink_msg_mission_write_partial_list_decode(&message, &partial_list);
+    return (
+        message.sysid == own_address.system_id && message.compid == own_address.component_id &&
+        partial_list.target_system == target_address.system_id &&
+        partial_list.target_component == target_address.component_id &&
+        partial_list.start_index == first && partial_list.end_index == last &&
+        partial_list.mission_type == type);
+}
+
+void upload_all_items(
+    MavlinkMissionTransfer& mmt,
+    MavlinkMessageHandler& message_handler,
+    const std::vector<ItemInt>& items)
+{
+    bool succeeded = false;
+    mmt.upload_items_async(MAV_MISSION_TYPE_MISSION, items, [&succeeded](Result result) {
+        succeeded = (result == Result::Success);
+    });
+    mmt.do_work();
+
+    for (uint16_t i = 0; i < items.size(); ++i) {
+        message_handler.process_message(make_mission_request_int(MAV_MISSION_TYPE_MISSION, i));
+    }
+    message_handler.process_message(
+        make_mission_ack(MAV_MISSION_TYPE_MISSION, MAV_MISSION_ACCEPTED));
+
+    EXPECT_TRUE(succeeded);
+    mmt.do_work();
+}
+
+TEST_F(MavlinkMissionTransferTest, UploadChangedItemsSendsOnlyChangedItems)
+{
+    std::vector<ItemInt> items;
+    for (uint16_t i = 0; i < 8; ++i) {
+        items.push_back(make_item(MAV_MISSION_TYPE_MISSION, i));
+    }
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+    upload_all_items(mmt, message_handler, items);
+
+    items[2].x = 42;
+    items[6].y = 42;
+
+    std::vector<mavlink_message_t> sent;
+    EXPECT_CALL(mock_sender, send_message(_))
+        .WillRepeatedly([&sent](const mavlink_message_t& message) {
+            sent.push_back(message);
+            return true;
+        });
+
+    std::promise<void> prom;
+    auto fut = prom.get_future();
+
+    float last_progress_received = NAN;
+
+    mmt.upload_changed_items_async(
+        MAV_MISSION_TYPE_MISSION,
+        items,
+        [&prom](Result result) {
+            EXPECT_EQ(result, Result::Success);
+            ONCE_ONLY;
+            prom.set_value();
+        },
+        [&last_progress_received](float progress) { last_progress_received = progress; });
+    mmt.do_work();
+
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_TRUE(is_correct_mission_write_partial_list(MAV_MISSION_TYPE_MISSION, 2, 2, sent[0]));
+
+    // Requests outside of the range are ignored.
+    message_handler.process_message(make_mission_request_int(MAV_MISSION_TYPE_MISSION, 0));
+    ASSERT_EQ(sent.size(), 1u);
+
+    message_handler.process_message(make_mission_request_int(MAV_MISSION_TYPE_MISSION, 2));
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_TRUE(is_the_same_mission_item_int(items[2], sent[1]));
+
+    message_handler.process_message(
+        make_mission_ack(MAV_MISSION_TYPE_MISSION, MAV_MISSION_ACCEPTED));
+    ASSERT_EQ(sent.size(), 3u);
+    EXPECT_TRUE(is_correct_mission_write_partial_list(MAV_MISSION_TYPE_MISSION, 6, 6, sent[2]));
+
+    message_handler.process_message(make_mission_request_int(MAV_MISSION_TYPE_MISSION, 6));
+    ASSERT_EQ(sent.size(), 4u);
+    EXPECT_TRUE(is_the_same_mission_item_int(items[6], sent[3]));
+
+    message_handler.process_message(
+        make_mission_ack(MAV_MISSION_TYPE_MISSION, MAV_MISSION_ACCEPTED));
+
+    EXPECT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(last_progress_received, 1.0f);
+
+    // We do not expect a timeout later though.
+    time.sleep_for(std::chrono::milliseconds(static_cast<int>(timeout_s * 1.1 * 1000.)));
+    timeout_handler.run_once();
+    EXPECT_EQ(sent.size(), 4u);
+
+    mmt.do_work();
+    EXPECT_TRUE(mmt.is_idle());
+}
+
+TEST_F(MavlinkMissionTransferTest, UploadChangedItemsWithoutChangesIsDoneRightAway)
+{
+    std::vector<ItemInt> items;
+    items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 0));
+    items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 1));
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+    upload_all_items(mmt, message_handler, items);
+
+    EXPECT_CALL(mock_sender, send_message(_)).Times(0);
+
+    std::promise<void> prom;
+    auto fut = prom.get_future();
+
+    mmt.upload_changed_items_async(MAV_MISSION_TYPE_MISSION, items, [&prom](Result result) {
+        EXPECT_EQ(result, Result::Success);
+        ONCE_ONLY;
+        prom.set_value();
+    });
+    mmt.do_work();
+
+    EXPECT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_TRUE(mmt.is_idle());
+}
+
+TEST_F(MavlinkMissionTransferTest, UploadChangedItemsUploadsAllIfMissionUnknown)
+{
+    std::vector<ItemInt> items;
+    items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 0));
+    items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 1));
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+
+    EXPECT_CALL(mock_sender, send_message(Truly([&items](const mavlink_message_t& message) {
+                    return is_correct_mission_send_count(
+                        MAV_MISSION_TYPE_MISSION, items.size(), message);
+                })));
+
+    mmt.upload_changed_items_async(MAV_MISSION_TYPE_MISSION, items, [](Result result) {
+        UNUSED(result);
+        EXPECT_TRUE(false);
+    });
+    mmt.do_work();
+}
+
+TEST_F(MavlinkMissionTransferTest, UploadChangedItemsFallsBackIfPartialListIsNotAnswered)
+{
+    std::vector<ItemInt> items;
+    for (uint16_t i = 0; i < 4; ++i) {
+        items.push_back(make_item(MAV_MISSION_TYPE_MISSION, i));
+    }
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+    upload_all_items(mmt, message_handler, items);
+
+    items[1].x = 42;
+
+    EXPECT_CALL(mock_sender, send_message(Truly([](const mavlink_message_t& message) {
+                    return is_correct_mission_write_partial_list(
+                        MAV_MISSION_TYPE_MISSION, 1, 1, message);
+                })));
+
+    mmt.upload_changed_items_async(MAV_MISSION_TYPE_MISSION, items, [](Result result) {
+        UNUSED(result);
+        EXPECT_TRUE(false);
+    });
+    mmt.do_work();
+
+    EXPECT_CALL(mock_sender, send_message(Truly([&items](const mavlink_message_t& message) {
+                    return is_correct_mission_send_count(
+                        MAV_MISSION_TYPE_MISSION, items.size(), message);
+                })));
+
+    time.sleep_for(std::chrono::milliseconds(static_cast<int>(timeout_s * 1.1 * 1000.)));
+    timeout_handler.run_once();
+}
+
+TEST_F(MavlinkMissionTransferTest, UploadChangedItemsFallsBackIfPartialListIsNacked)
+{
+    std::vector<ItemInt> items;
+    for (uint16_t i = 0; i < 4; ++i) {
+        items.push_back(make_item(MAV_MISSION_TYPE_MISSION, i));
+    }
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+    upload_all_items(mmt, message_handler, items);
+
+    items[1].x = 42;
+
+    std::vector<mavlink_message_t> sent;
+    EXPECT_CALL(mock_sender, send_message(_))
+        .WillRepeatedly([&sent](const mavlink_message_t& message) {
+            sent.push_back(message);
+            return true;
+        });
+
+    std::promise<void> prom;
+    auto fut = prom.get_future();
+
+    mmt.upload_changed_items_async(MAV_MISSION_TYPE_MISSION, items, [&prom](Result result) {
+        EXPECT_EQ(result, Result::Success);
+        ONCE_ONLY;
+        prom.set_value();
+    });
+    mmt.do_work();
+
+    message_handler.process_message(
+        make_mission_ack(MAV_MISSION_TYPE_MISSION, MAV_MISSION_UNSUPPORTED));
+
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_TRUE(is_correct_mission_write_partial_list(MAV_MISSION_TYPE_MISSION, 1, 1, sent[0]));
+    EXPECT_TRUE(is_correct_mission_send_count(MAV_MISSION_TYPE_MISSION, items.size(), sent[1]));
+
+    for (uint16_t i = 0; i < items.size(); ++i) {
+        message_handler.process_message(make_mission_request_int(MAV_MISSION_TYPE_MISSION, i));
+    }
+    message_handler.process_message(
+        make_mission_ack(MAV_MISSION_TYPE_MISSION, MAV_MISSION_ACCEPTED));
+
+    EXPECT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    mmt.do_work();
+    EXPECT_TRUE(mmt.is_idle());
+}
+
+// Adds an opaque id extension field which the MAVLink headers might not know about yet.
+void add_opaque_id(mavlink_message_t& message, unsigned offset, uint32_t opaque_id)
+{
+    auto* payload = reinterpret_cast<uint8_t*>(_MAV_PAYLOAD_NON_CONST(&message));
+    if (message.len < offset) {
+        std::fill(payload + message.len, payload + offset, 0);
+    }
+    for (unsigned i = 0; i < sizeof(opaque_id); ++i) {
+        payload[offset + i] = static_cast<uint8_t>(opaque_id >> (8 * i));
+    }
+    message.len = static_cast<uint8_t>(std::max<unsigned>(message.len, offset + sizeof(opaque_id)));
+}
+
+mavlink_message_t make_mission_count_with_opaque_id(unsigned count, uint32_t opaque_id)
+{
+    auto message = make_mission_count(count);
+    add_opaque_id(message, 5, opaque_id);
+    return message;
+}
+
+mavlink_message_t make_vehicle_mission_current(uint32_t mission_id)
+{
+    mavlink_message_t message;
+    mavlink_msg_mission_current_pack(
+        target_address.system_id, target_address.component_id, &message, 0, 0, 0, 0);
+    add_opaque_id(message, 6, mission_id);
+    return message;
+}
+
+TEST(MavlinkMissionTransfer, OpaqueIdsAreReadFromPayload)
+{
+    EXPECT_EQ(MavlinkMissionTransfer::opaque_id_from_mission_count(make_mission_count(3)), 0u);
+    EXPECT_EQ(
+        MavlinkMissionTransfer::opaque_id_from_mission_count(
+            make_mission_count_with_opaque_id(3, 0x12345678)),
+        0x12345678u);
+
+    auto ack = make_mission_ack(MAV_MISSION_TYPE_MISSION, MAV_MISSION_ACCEPTED);
+    add_opaque_id(ack, 4, 0xcafe);
+    EXPECT_EQ(MavlinkMissionTransfer::opaque_id_from_mission_ack(ack), 0xcafeu);
+
+    // Trailing zero bytes are cut off on the wire.
+    ack.len = 6;
+    EXPECT_EQ(MavlinkMissionTransfer::opaque_id_from_mission_ack(ack), 0xcafeu);
+
+    auto current = make_mission_current(1);
+    add_opaque_id(current, 6, 11);
+    add_opaque_id(current, 10, 22);
+    add_opaque_id(current, 14, 33);
+    EXPECT_EQ(
+        MavlinkMissionTransfer::opaque_id_from_mission_current(current, MAV_MISSION_TYPE_MISSION),
+        11u);
+    EXPECT_EQ(
+        MavlinkMissionTransfer::opaque_id_from_mission_current(current, MAV_MISSION_TYPE_FENCE),
+        22u);
+    EXPECT_EQ(
+        MavlinkMissionTransfer::opaque_id_from_mission_current(current, MAV_MISSION_TYPE_RALLY),
+        33u);
+}
+
+void download_all_items(
+    MavlinkMissionTransfer& mmt,
+    MavlinkMessageHandler& message_handler,
+    const std::vector<ItemInt>& items,
+    uint32_t opaque_id)
+{
+    bool succeeded = false;
+    mmt.download_items_cached_async(
+        MAV_MISSION_TYPE_MISSION,
+        [&succeeded, &items](Result result, const std::vector<ItemInt>& downloaded_items) {
+            EXPECT_EQ(downloaded_items, items);
+            succeeded = (result == Result::Success);
+        });
+    mmt.do_work();
+
+    message_handler.process_message(make_mission_count_with_opaque_id(items.size(), opaque_id));
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        message_handler.process_message(make_mission_item(items, i));
+    }
+
+    EXPECT_TRUE(succeeded);
+    mmt.do_work();
+}
+
+TEST_F(MavlinkMissionTransferTest, DownloadCachedSkipsItemsIfOpaqueIdIsTheSame)
+{
+    std::vector<ItemInt> real_items;
+    real_items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 0));
+    real_items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 1));
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+    download_all_items(mmt, message_handler, real_items, 1234);
+
+    std::vector<mavlink_message_t> sent;
+    EXPECT_CALL(mock_sender, send_message(_))
+        .WillRepeatedly([&sent](const mavlink_message_t& message) {
+            sent.push_back(message);
+            return true;
+        });
+
+    std::promise<void> prom;
+    auto fut = prom.get_future();
+    mmt.download_items_cached_async(
+        MAV_MISSION_TYPE_MISSION,
+        [&prom, &real_items](Result result, const std::vector<ItemInt>& items) {
+            EXPECT_EQ(result, Result::Unchanged);
+            EXPECT_EQ(items, real_items);
+            ONCE_ONLY;
+            prom.set_value();
+        });
+    mmt.do_work();
+
+    message_handler.process_message(make_mission_count_with_opaque_id(real_items.size(), 1234));
+
+    EXPECT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    // Only the list is requested and then acknowledged, no items.
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_TRUE(is_correct_mission_request_list(MAV_MISSION_TYPE_MISSION, sent[0]));
+    EXPECT_TRUE(is_correct_mission_ack(MAV_MISSION_TYPE_MISSION, MAV_MISSION_ACCEPTED, sent[1]));
+
+    mmt.do_work();
+    EXPECT_TRUE(mmt.is_idle());
+}
+
+TEST_F(MavlinkMissionTransferTest, DownloadCachedSkipsDownloadIfMissionCurrentMatches)
+{
+    std::vector<ItemInt> real_items;
+    real_items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 0));
+    real_items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 1));
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+    download_all_items(mmt, message_handler, real_items, 1234);
+
+    message_handler.process_message(make_vehicle_mission_current(1234));
+
+    EXPECT_CALL(mock_sender, send_message(_)).Times(0);
+
+    std::promise<void> prom;
+    auto fut = prom.get_future();
+    mmt.download_items_cached_async(
+        MAV_MISSION_TYPE_MISSION,
+        [&prom, &real_items](Result result, const std::vector<ItemInt>& items) {
+            EXPECT_EQ(result, Result::Unchanged);
+            EXPECT_EQ(items, real_items);
+            ONCE_ONLY;
+            prom.set_value();
+        });
+    mmt.do_work();
+
+    EXPECT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_TRUE(mmt.is_idle());
+}
+
+TEST_F(MavlinkMissionTransferTest, DownloadCachedDownloadsIfOpaqueIdChanged)
+{
+    std::vector<ItemInt> real_items;
+    real_items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 0));
+    real_items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 1));
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+    download_all_items(mmt, message_handler, real_items, 1234);
+
+    // The mission changed on the vehicle.
+    message_handler.process_message(make_vehicle_mission_current(5678));
+
+    real_items[1].x = 42;
+    download_all_items(mmt, message_handler, real_items, 5678);
+}
+
+TEST_F(MavlinkMissionTransferTest, DownloadWithoutCacheIgnoresOpaqueId)
+{
+    std::vector<ItemInt> real_items;
+    real_items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 0));
+    real_items.push_back(make_item(MAV_MISSION_TYPE_MISSION, 1));
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+    download_all_items(mmt, message_handler, real_items, 1234);
+
+    std::promise<void> prom;
+    auto fut = prom.get_future();
+    mmt.download_items_async(
+        MAV_MISSION_TYPE_MISSION,
+        [&prom, &real_items](Result result, const std::vector<ItemInt>& items) {
+            EXPECT_EQ(result, Result::Success);
+            EXPECT_EQ(items, real_items);
+            ONCE_ONLY;
+            prom.set_value();
+        });
+    mmt.do_work();
+
+    EXPECT_CALL(mock_sender, send_message(Truly([](const mavlink_message_t& message) {
+                    return is_correct_mission_request_int(MAV_MISSION_TYPE_MISSION, 0, message);
+                })));
+
+    message_handler.process_message(make_mission_count_with_opaque_id(real_items.size(), 1234));
+
+    EXPECT_CALL(mock_sender, send_message(Truly([](const mavlink_message_t& message) {
+                    return is_correct_mission_request_int(MAV_MISSION_TYPE_MISSION, 1, message);
+                })));
+
+    message_handler.process_message(make_mission_item(real_items, 0));
+
+    EXPECT_CALL(mock_sender, send_message(Truly([](const mavlink_message_t& message) {
+                    return is_correct_mission_ack(
+                        MAV_MISSION_TYPE_MISSION, MAV_MISSION_ACCEPTED, message);
+                })));
+
+    message_handler.process_message(make_mission_item(real_items, 1));
+
+    EXPECT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+}
@@ -5,9 +5,9 @@
 namespace mavsdk {
 
 MavlinkParameterCache::AddNewParamResult
-MavlinkParameterCache::add_new_param(const std::string& param_id, ParamValue value, int16_t index)
+MavlinkParameterCache::add_new_param(const ParamId& param_id, ParamValue value, int16_t index)
 {
-    if (exists(param_id)) {
+    if (position_of(param_id)) {
         return AddNewParamResult::AlreadyExists;
     }
 
@@ -15,28 +15,39 @@ MavlinkParameterCache::add_new_param(const std::string& param_id, ParamValue val
         return AddNewParamResult::TooManyParams;
     }
 
-    _all_params.push_back(Param{
-        param_id,
-        std::move(value),
-        (index != -1 ? static_cast<uint16_t>(index) : static_cast<uint16_t>(_all_params.size()))});
+    const auto position = static_cast<uint16_t>(_all_params.size());
+    const auto new_index = index != -1 ? static_cast<uint16_t>(index) : position;
+    if (!_all_params.empty() && new_index < _all_params.back().index) {
+        _sorted_by_index = false;
+    }
+    if (!value.needs_extended()) {
+        _non_extended_positions.push_back(position);
+    }
+
+    _all_params.push_back(Param{param_id, std::move(value), new_index});
+    if (2 * _all_params.size() > _position_by_id.size()) {
+        rebuild_id_index(_all_params.size());
+    } else {
+        add_to_id_index(position);
+    }
     return MavlinkParameterCache::AddNewParamResult::Ok;
 }
 
 MavlinkParameterCache::UpdateExistingParamResult
-MavlinkParameterCache::update_existing_param(const std::string& param_id, ParamValue value)
+MavlinkParameterCache::update_existing_param(const ParamId& param_id, ParamValue value)
 {
-    auto it = std::find_if(_all_params.begin(), _all_params.end(), [&](const auto& param) {
-        return (param_id == param.id);
-    });
-
-    if (it == _all_params.end()) {
+    const auto position = position_of(param_id);
+    if (!position) {
         return UpdateExistingParamResult::MissingParam;
     }
 
-    if (!it->value.is_same_type(value)) {
+    // The type can't change, so whether it needs the extended protocol stays
+    // the same as well.
+    auto& param = _all_params[position.value()];
+    if (!param.value.is_same_type(value)) {
         return MavlinkParameterCache::UpdateExistingParamResult::WrongType;
     } else {
-        it->value.update_value_typesafe(value);
+        param.value.update_value_typesafe(value);
         return MavlinkParameterCache::UpdateExistingParamResult::Ok;
     }
 }
@@ -47,13 +58,11 @@ MavlinkParameterCache::all_parameters(bool including_extended) const
     if (including_extended) {
         return _all_params;
     } else {
-        // TODO: we might want to cache this
         std::vector<MavlinkParameterCache::Param> params_without_extended{};
-        std::copy_if(
-            _all_params.begin(),
-            _all_params.end(),
-            std::back_inserter(params_without_extended),
-            [](auto& entry) { return !entry.value.needs_extended(); });
+        params_without_extended.reserve(_non_extended_positions.size());
+        for (const auto position : _non_extended_positions) {
+            params_without_extended.push_back(_all_params[position]);
+        }
 
         return params_without_extended;
     }
@@ -65,7 +74,7 @@ MavlinkParameterCache::all_parameters_map(bool including_extended) const
     std::map<std::string, ParamValue> mp{};
     if (including_extended) {
         for (const auto& param : _all_params) {
-            mp.insert({param.id, param.value});
+            mp.insert({param.id.str(), param.value});
         }
 
     } else {
@@ -73,7 +82,7 @@ MavlinkParameterCache::all_parameters_map(bool including_extended) const
             if (param.value.needs_extended()) {
                 continue;
             }
-            mp.insert({param.id, param.value});
+            mp.insert({param.id.str(), param.value});
         }
     }
 
@@ -81,29 +90,32 @@ MavlinkParameterCache::all_parameters_map(bool including_extended) const
 }
 
 std::optional<MavlinkParameterCache::Param>
-MavlinkParameterCache::param_by_id(const std::string& param_id, bool including_extended) const
+MavlinkParameterCache::param_by_id(const ParamId& param_id, bool including_extended) const
 {
-    const auto& params = all_parameters(including_extended);
+    const auto position = position_of(param_id);
+    if (!position) {
+        return {};
+    }
 
-    for (const auto& param : params) {
-        if (param.id == param_id) {
-            return param;
-        }
+    const auto& param = _all_params[position.value()];
+    if (!including_extended && param.value.needs_extended()) {
+        return {};
     }
 
-    return {};
+    return param;
 }
 
 std::optional<MavlinkParameterCache::Param>
 MavlinkParameterCache::param_by_index(uint16_t param_index, bool including_extended) const
 {
-    const auto& params = all_parameters(including_extended);
-    if (param_index >= params.size()) {
-        LogErr() << "param at " << (int)param_index << " out of bounds (" << params.size() << ")";
+    const auto size = count(including_extended);
+    if (param_index >= size) {
+        LogErr() << "param at " << (int)param_index << " out of bounds (" << size << ")";
         return {};
     }
 
-    const auto& param = params[param_index];
+    const auto& param = including_extended ? _all_params[param_index] :
+                                             _all_params[_non_extended_positions[param_index]];
     // Check that the redundant index matches the actual vector index.
     assert(param.index == param_index);
     return {param};
@@ -111,43 +123,139 @@ MavlinkParameterCache::param_by_index(uint16_t param_index, bool including_exten
 
 uint16_t MavlinkParameterCache::count(bool including_extended) const
 {
-    const auto num = all_parameters(including_extended).size();
+    const auto num = including_extended ? _all_params.size() : _non_extended_positions.size();
     assert(num < std::numeric_limits<uint16_t>::max());
     return static_cast<uint16_t>(num);
 }
 
+void MavlinkParameterCache::reserve(uint16_t count)
+{
+    _all_params.reserve(count);
+    _non_extended_positions.reserve(count);
+    if (2 * static_cast<size_t>(count) > _position_by_id.size()) {
+        rebuild_id_index(count);
+    }
+}
+
 void MavlinkParameterCache::clear()
 {
+    // Keep the memory, the params are likely downloaded again.
     _all_params.clear();
+    std::fill(_position_by_id.begin(), _position_by_id.end(), NO_POSITION);
+    _non_extended_positions.clear();
+    _sorted_by_index = true;
 }
 
-bool MavlinkParameterCache::exists(const std::string& param_id) const
+std::optional<uint16_t> MavlinkParameterCache::position_of(const ParamId& param_id) const
 {
-    auto it = std::find_if(_all_params.begin(), _all_params.end(), [&](const auto& param) {
-        return (param_id == param.id);
-    });
-    return it != _all_params.end();
+    if (_position_by_id.empty()) {
+        return {};
+    }
+
+    const auto mask = _position_by_id.size() - 1;
+    for (auto slot = param_id.hash() & mask; _position_by_id[slot] != NO_POSITION;
+         slot = (slot + 1) & mask) {
+        const auto position = _position_by_id[slot];
+        if (_all_params[position].id == param_id) {
+            return position;
+        }
+    }
+    return {};
+}
+
+void MavlinkParameterCache::rebuild_indexes()
+{
+    rebuild_id_index(_all_params.size());
+
+    _non_extended_positions.clear();
+    for (uint16_t position = 0; position < _all_params.size(); ++position) {
+        if (!_all_params[position].value.needs_extended()) {
+            _non_extended_positions.push_back(position);
+        }
+    }
+}
+
+void MavlinkParameterCache::rebuild_id_index(size_t num_params)
+{
+    // A power of two, so we can mask instead of dividing.
+    size_t size = std::max(MIN_ID_INDEX_SIZE, _position_by_id.size());
+    while (size < 2 * num_params) {
+        size *= 2;
+    }
+
+    _position_by_id.assign(size, NO_POSITION);
+    for (uint16_t position = 0; position < _all_params.size(); ++position) {
+        add_to_id_index(position);
+    }
+}
+
+void MavlinkParameterCache::add_to_id_index(uint16_t position)
+{
+    const auto mask = _position_by_id.size() - 1;
+    auto slot = _all_params[position].id.hash() & mask;
+    while (_position_by_id[slot] != NO_POSITION) {
+        slot = (slot + 1) & mask;
+    }
+    _position_by_id[slot] = position;
 }
 
 std::optional<uint16_t> MavlinkParameterCache::next_missing_index(uint16_t count)
 {
     // Extended doesn't matter here because we use this function in the sender
     // which is always either all extended or not.
-    std::sort(_all_params.begin(), _all_params.end(), [](const auto& lhs, const auto& rhs) {
-        return lhs.index < rhs.index;
-    });
+    sort_by_index();
 
-    for (unsigned i = 0; i < count; ++i) {
-        if (_all_params.size() <= i) {
-            // We have reached the end but it's not complete yet.
-            return i;
-        }
-        if (_all_params[i].index > i) {
-            // We have found a hole to fill.
-            return i;
+    // Without holes, each param is at the position of its index. The first
+    // one that isn't comes after a hole, so we can bisect for it.
+    size_t low = 0;
+    size_t high = _all_params.size();
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        if (_all_params[middle].index > middle) {
+            high = middle;
+        } else {
+            low = middle + 1;
         }
     }
+
+    // Either a hole to fill, or the end if it's not complete yet.
+    if (low < count) {
+        return static_cast<uint16_t>(low);
+    }
     return {};
 }
 
+std::vector<uint16_t> MavlinkParameterCache::missing_indices(uint16_t count)
+{
+    sort_by_index();
+
+    std::vector<uint16_t> missing{};
+    unsigned expected = 0;
+    for (const auto& param : _all_params) {
+        for (; expected < param.index && expected < count; ++expected) {
+            missing.push_back(static_cast<uint16_t>(expected));
+        }
+        expected = std::max(expected, param.index + 1u);
+    }
+    for (; expected < count; ++expected) {
+        missing.push_back(static_cast<uint16_t>(expected));
+    }
+    return missing;
+}
+
+void MavlinkParameterCache::sort_by_index()
+{
+    // Params are looked up for every param received, and they mostly arrive
+    // in order, so we only sort (and rebuild the indexes) when needed.
+    if (_sorted_by_index) {
+        return;
+    }
+
+    std::sort(_all_params.begin(), _all_params.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.index < rhs.index;
+    });
+    rebuild_indexes();
+    _sorted_by_index = true;
+}
+
 } // namespace mavsdk
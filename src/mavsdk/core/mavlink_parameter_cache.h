@@ -1,9 +1,11 @@
 #pragma once
 
+#include "param_id.h"
 #include "param_value.h"
 
 #include <limits>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -12,7 +14,7 @@ namespace mavsdk {
 class MavlinkParameterCache {
 public:
     struct Param {
-        std::string id;
+        ParamId id;
         ParamValue value;
         uint16_t index; // matches the index when in a vector
     };
@@ -23,35 +25,58 @@ public:
         TooManyParams,
     };
     AddNewParamResult
-    add_new_param(const std::string& param_id, ParamValue value, int16_t index = -1);
+    add_new_param(const ParamId& param_id, ParamValue value, int16_t index = -1);
 
     enum class UpdateExistingParamResult {
         Ok,
         MissingParam,
         WrongType,
     };
-    UpdateExistingParamResult update_existing_param(const std::string& param_id, ParamValue value);
+    UpdateExistingParamResult update_existing_param(const ParamId& param_id, ParamValue value);
 
     [[nodiscard]] std::vector<Param> all_parameters(bool including_extended) const;
     [[nodiscard]] std::map<std::string, ParamValue>
     all_parameters_map(bool including_extended) const;
 
     [[nodiscard]] std::optional<Param>
-    param_by_id(const std::string& param_id, bool including_extended) const;
+    param_by_id(const ParamId& param_id, bool including_extended) const;
 
     [[nodiscard]] std::optional<Param>
     param_by_index(uint16_t param_index, bool including_extended) const;
 
     [[nodiscard]] uint16_t count(bool including_extended) const;
 
+    // Makes room for this many params, so adding them doesn't allocate.
+    void reserve(uint16_t count);
+
     [[nodiscard]] std::optional<uint16_t> next_missing_index(uint16_t count);
 
+    // All indices below count that haven't been added yet, in order.
+    [[nodiscard]] std::vector<uint16_t> missing_indices(uint16_t count);
+
     void clear();
 
 private:
-    [[nodiscard]] bool exists(const std::string& param_id) const;
+    [[nodiscard]] std::optional<uint16_t> position_of(const ParamId& param_id) const;
+    void sort_by_index();
+    void rebuild_indexes();
+    void rebuild_id_index(size_t num_params);
+    void add_to_id_index(uint16_t position);
 
     std::vector<Param> _all_params;
+
+    // Position in _all_params by param id, and the positions of all params
+    // that don't need the extended protocol, in order. These are kept up to
+    // date on every change, so lookups don't need to go through all params.
+    //
+    // The positions by id are a hash table with open addressing that is kept
+    // at most half full. Unlike std::unordered_map, it only allocates when it
+    // grows, not for every param.
+    static constexpr uint16_t NO_POSITION = std::numeric_limits<uint16_t>::max();
+    static constexpr size_t MIN_ID_INDEX_SIZE = 16;
+    std::vector<uint16_t> _position_by_id{};
+    std::vector<uint16_t> _non_extended_positions{};
+    bool _sorted_by_index{true};
 };
 
 } // namespace mavsdk
@@ -0,0 +1,283 @@
+#include "mavlink_parameter_cache_file.h"
+#include "crc32.h"
+#include "fs.h"
+#include "log.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace mavsdk {
+
+// All values are stored little endian:
+//
+// header: magic (3 bytes), version (1 byte), hash (4 bytes), param count (2 bytes)
+// each param: index (2 bytes), id length (1 byte), id, MAV_PARAM_EXT_TYPE (1 byte),
+//             value length (1 byte), value as in PARAM_EXT_VALUE
+// trailer: CRC32 of everything before (4 bytes)
+static constexpr std::array<uint8_t, 3> magic{'M', 'P', 'C'};
+static constexpr uint8_t version = 1;
+static constexpr size_t max_id_len = 16;
+static constexpr size_t max_value_len = 128;
+
+static std::optional<size_t> value_len(uint8_t type)
+{
+    switch (type) {
+        case MAV_PARAM_EXT_TYPE_UINT8:
+        case MAV_PARAM_EXT_TYPE_INT8:
+            return 1;
+        case MAV_PARAM_EXT_TYPE_UINT16:
+        case MAV_PARAM_EXT_TYPE_INT16:
+            return 2;
+        case MAV_PARAM_EXT_TYPE_UINT32:
+        case MAV_PARAM_EXT_TYPE_INT32:
+        case MAV_PARAM_EXT_TYPE_REAL32:
+            return 4;
+        case MAV_PARAM_EXT_TYPE_UINT64:
+        case MAV_PARAM_EXT_TYPE_INT64:
+        case MAV_PARAM_EXT_TYPE_REAL64:
+            return 8;
+        case MAV_PARAM_EXT_TYPE_CUSTOM:
+            // Up to this, the actual length is stored with it.
+            return max_value_len;
+        default:
+            return std::nullopt;
+    }
+}
+
+namespace {
+
+class Writer {
+public:
+    void add_u8(uint8_t value) { _bytes.push_back(value); }
+
+    void add_u16(uint16_t value)
+    {
+        add_u8(static_cast<uint8_t>(value & 0xff));
+        add_u8(static_cast<uint8_t>(value >> 8));
+    }
+
+    void add_u32(uint32_t value)
+    {
+        add_u16(static_cast<uint16_t>(value & 0xffff));
+        add_u16(static_cast<uint16_t>(value >> 16));
+    }
+
+    void add_bytes(const char* data, size_t len) { _bytes.insert(_bytes.end(), data, data + len); }
+
+    [[nodiscard]] const std::vector<uint8_t>& bytes() const { return _bytes; }
+
+private:
+    std::vector<uint8_t> _bytes{};
+};
+
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t len) : _data(data), _len(len) {}
+
+    std::optional<uint8_t> get_u8()
+    {
+        if (_pos + 1 > _len) {
+            return std::nullopt;
+        }
+        return _data[_pos++];
+    }
+
+    std::optional<uint16_t> get_u16()
+    {
+        const auto low = get_u8();
+        const auto high = get_u8();
+        if (!low || !high) {
+            return std::nullopt;
+        }
+        return static_cast<uint16_t>(low.value() | (high.value() << 8));
+    }
+
+    std::optional<uint32_t> get_u32()
+    {
+        const auto low = get_u16();
+        const auto high = get_u16();
+        if (!low || !high) {
+            return std::nullopt;
+        }
+        return static_cast<uint32_t>(low.value()) | (static_cast<uint32_t>(high.value()) << 16);
+    }
+
+    bool get_bytes(char* data, size_t len)
+    {
+        if (_pos + len > _len) {
+            return false;
+        }
+        std::memcpy(data, _data + _pos, len);
+        _pos += len;
+        return true;
+    }
+
+    [[nodiscard]] bool at_end() const { return _pos == _len; }
+
+private:
+    const uint8_t* _data;
+    const size_t _len;
+    size_t _pos{0};
+};
+
+} // namespace
+
+bool save_parameter_cache_file(const std::string& path, const MavlinkParameterCacheFile& content)
+{
+    if (content.params.size() > std::numeric_limits<uint16_t>::max()) {
+        LogErr() << "Too many params to cache: " << content.params.size();
+        return false;
+    }
+
+    Writer writer;
+    for (const auto byte : magic) {
+        writer.add_u8(byte);
+    }
+    writer.add_u8(version);
+    writer.add_u32(content.hash);
+    writer.add_u16(static_cast<uint16_t>(content.params.size()));
+
+    for (const auto& param : content.params) {
+        if (param.id.empty()) {
+            LogErr() << "Invalid param id to cache: " << param.id;
+            return false;
+        }
+
+        const auto type = static_cast<uint8_t>(param.value.get_mav_param_ext_type());
+        auto len = value_len(type);
+        if (!len) {
+            LogErr() << "Unknown type of param to cache: " << param.id;
+            return false;
+        }
+        if (type == MAV_PARAM_EXT_TYPE_CUSTOM) {
+            len = std::min(param.value.get_custom().value_or("").size(), max_value_len);
+        }
+
+        writer.add_u16(param.index);
+        writer.add_u8(static_cast<uint8_t>(param.id.size()));
+        writer.add_bytes(param.id.data(), param.id.size());
+        writer.add_u8(type);
+        writer.add_u8(static_cast<uint8_t>(len.value()));
+        writer.add_bytes(param.value.get_128_bytes().data(), len.value());
+    }
+
+    Crc32 crc;
+    crc.add(writer.bytes().data(), static_cast<uint32_t>(writer.bytes().size()));
+    writer.add_u32(crc.get());
+
+    const auto tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            LogErr() << "Could not open " << tmp_path << " to cache params";
+            return false;
+        }
+        file.write(
+            reinterpret_cast<const char*>(writer.bytes().data()),
+            static_cast<std::streamsize>(writer.bytes().size()));
+        if (!file) {
+            LogErr() << "Could not write " << tmp_path << " to cache params";
+            return false;
+        }
+    }
+
+    if (!fs_rename(tmp_path, path)) {
+        LogErr() << "Could not rename " << tmp_path << " to " << path;
+        fs_remove(tmp_path);
+        return false;
+    }
+    return true;
+}
+
+std::optional<MavlinkParameterCacheFile> load_parameter_cache_file(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    const std::vector<uint8_t> bytes{
+        std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    constexpr size_t crc_len = 4;
+    if (bytes.size() < crc_len) {
+        LogWarn() << "Param cache " << path << " is too short";
+        return std::nullopt;
+    }
+
+    const auto payload_len = bytes.size() - crc_len;
+    Crc32 crc;
+    crc.add(bytes.data(), static_cast<uint32_t>(payload_len));
+    Reader crc_reader{bytes.data() + payload_len, crc_len};
+    if (crc_reader.get_u32() != crc.get()) {
+        LogWarn() << "Param cache " << path << " is corrupted";
+        return std::nullopt;
+    }
+
+    Reader reader{bytes.data(), payload_len};
+    for (const auto byte : magic) {
+        if (reader.get_u8() != byte) {
+            LogWarn() << "Param cache " << path << " has wrong format";
+            return std::nullopt;
+        }
+    }
+    if (reader.get_u8() != version) {
+        LogWarn() << "Param cache " << path << " has unsupported version";
+        return std::nullopt;
+    }
+
+    const auto hash = reader.get_u32();
+    const auto count = reader.get_u16();
+    if (!hash || !count) {
+        LogWarn() << "Param cache " << path << " is truncated";
+        return std::nullopt;
+    }
+
+    MavlinkParameterCacheFile content;
+    content.hash = hash.value();
+    content.params.reserve(count.value());
+
+    for (uint16_t i = 0; i < count.value(); ++i) {
+        const auto index = reader.get_u16();
+        const auto id_len = reader.get_u8();
+        if (!index || !id_len || id_len.value() == 0 || id_len.value() > max_id_len) {
+            LogWarn() << "Param cache " << path << " has invalid param id";
+            return std::nullopt;
+        }
+
+        std::string id(id_len.value(), '\0');
+        const bool id_read = reader.get_bytes(id.data(), id.size());
+
+        const auto type = reader.get_u8();
+        const auto len = reader.get_u8();
+        if (!id_read || !type || !len || !value_len(type.value()) ||
+            (type.value() == MAV_PARAM_EXT_TYPE_CUSTOM ? len.value() > max_value_len :
+                                                         len.value() != value_len(type.value()))) {
+            LogWarn() << "Param cache " << path << " has invalid param value";
+            return std::nullopt;
+        }
+
+        mavlink_param_ext_value_t ext_value{};
+        ext_value.param_type = type.value();
+        if (!reader.get_bytes(ext_value.param_value, len.value())) {
+            LogWarn() << "Param cache " << path << " is truncated";
+            return std::nullopt;
+        }
+
+        ParamValue value;
+        value.set_from_mavlink_param_ext_value(ext_value);
+        content.params.push_back(MavlinkParameterCache::Param{id, value, index.value()});
+    }
+
+    if (!reader.at_end()) {
+        LogWarn() << "Param cache " << path << " has trailing data";
+        return std::nullopt;
+    }
+
+    return content;
+}
+
+} // namespace mavsdk
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "mavlink_parameter_cache.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mavsdk {
+
+// The params of one component as stored on disk, together with the hash the
+// component advertised for them. As long as the component still advertises
+// the same hash, the params don't need to be downloaded again.
+struct MavlinkParameterCacheFile {
+    uint32_t hash{0};
+    std::vector<MavlinkParameterCache::Param> params{};
+};
+
+// The file is replaced atomically, so a file that was only partially written
+// is never loaded.
+bool save_parameter_cache_file(const std::string& path, const MavlinkParameterCacheFile& content);
+
+// Returns nothing if the file doesn't exist, is from a different version, or
+// is corrupted.
+std::optional<MavlinkParameterCacheFile> load_parameter_cache_file(const std::string& path);
+
+} // namespace mavsdk
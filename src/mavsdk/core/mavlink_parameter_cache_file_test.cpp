@@ -0,0 +1,138 @@
+#include "mavlink_parameter_cache_file.h"
+#include "fs.h"
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+MavlinkParameterCacheFile make_content()
+{
+    MavlinkParameterCacheFile content;
+    content.hash = 0xdeadbeef;
+
+    ParamValue float_value;
+    float_value.set_float(42.5f);
+    content.params.push_back({"MY_FLOAT", float_value, 0});
+
+    ParamValue int_value;
+    int_value.set(int32_t{-7});
+    content.params.push_back({"MY_INT", int_value, 1});
+
+    ParamValue byte_value;
+    byte_value.set(uint8_t{200});
+    content.params.push_back({"MY_BYTE", byte_value, 2});
+
+    ParamValue double_value;
+    double_value.set(3.25);
+    content.params.push_back({"MY_DOUBLE", double_value, 3});
+
+    ParamValue custom_value;
+    custom_value.set_custom("some text");
+    content.params.push_back({"SIXTEEN_CHAR_ID_", custom_value, 4});
+
+    return content;
+}
+
+std::string cache_path()
+{
+    auto maybe_dir = create_tmp_directory("mavsdk-param-cache-file-test");
+    EXPECT_TRUE(maybe_dir);
+    return maybe_dir.value_or(".") + path_separator + "params.bin";
+}
+
+} // namespace
+
+TEST(MavlinkParameterCacheFile, SaveAndLoad)
+{
+    const auto path = cache_path();
+    const auto content = make_content();
+
+    ASSERT_TRUE(save_parameter_cache_file(path, content));
+    EXPECT_FALSE(fs_exists(path + ".tmp"));
+
+    const auto loaded = load_parameter_cache_file(path);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->hash, content.hash);
+    ASSERT_EQ(loaded->params.size(), content.params.size());
+    for (size_t i = 0; i < content.params.size(); ++i) {
+        EXPECT_EQ(loaded->params[i].id, content.params[i].id);
+        EXPECT_EQ(loaded->params[i].index, content.params[i].index);
+        EXPECT_EQ(loaded->params[i].value, content.params[i].value);
+    }
+
+    fs_remove(path);
+}
+
+TEST(MavlinkParameterCacheFile, Overwrite)
+{
+    const auto path = cache_path();
+    auto content = make_content();
+
+    ASSERT_TRUE(save_parameter_cache_file(path, content));
+
+    content.hash = 1234;
+    content.params.pop_back();
+    ASSERT_TRUE(save_parameter_cache_file(path, content));
+
+    const auto loaded = load_parameter_cache_file(path);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->hash, 1234u);
+    EXPECT_EQ(loaded->params.size(), content.params.size());
+
+    fs_remove(path);
+}
+
+TEST(MavlinkParameterCacheFile, Missing)
+{
+    EXPECT_FALSE(load_parameter_cache_file(cache_path()));
+}
+
+TEST(MavlinkParameterCacheFile, Corrupted)
+{
+    const auto path = cache_path();
+    ASSERT_TRUE(save_parameter_cache_file(path, make_content()));
+
+    std::vector<char> bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GT(bytes.size(), 20u);
+
+    // A single flipped bit anywhere must be noticed.
+    for (const size_t position : {size_t{0}, size_t{5}, bytes.size() / 2, bytes.size() - 1}) {
+        auto corrupted = bytes;
+        corrupted[position] ^= 0x01;
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(corrupted.data(), static_cast<std::streamsize>(corrupted.size()));
+        }
+        EXPECT_FALSE(load_parameter_cache_file(path)) << "at " << position;
+    }
+
+    // And so must a file that was cut short.
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+    }
+    EXPECT_FALSE(load_parameter_cache_file(path));
+
+    fs_remove(path);
+}
+
+TEST(MavlinkParameterCacheFile, RejectsInvalidId)
+{
+    const auto path = cache_path();
+    auto content = make_content();
+    // Ids that are too long are cut off by ParamId already, but empty ones
+    // are still rejected.
+    content.params.push_back({"", ParamValue{}, 5});
+
+    EXPECT_FALSE(save_parameter_cache_file(path, content));
+    EXPECT_FALSE(fs_exists(path));
+}
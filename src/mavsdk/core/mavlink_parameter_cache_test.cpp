@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include "param_value.h"
 #include "mavlink_parameter_cache.h"
+#include "log.h"
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
 
 using namespace mavsdk;
 
@@ -104,3 +109,172 @@ TEST(MavlinkParameterCache, MissingIndicesNotSorted)
     // It should still work when not sorted.
     EXPECT_EQ(cache.next_missing_index(3), 2);
 }
+
+TEST(MavlinkParameterCache, AllMissingIndices)
+{
+    MavlinkParameterCache cache;
+    ParamValue value;
+    value.set_int(42);
+
+    EXPECT_EQ(cache.missing_indices(3), (std::vector<uint16_t>{0, 1, 2}));
+
+    cache.add_new_param("PARAM4", value, 4);
+    cache.add_new_param("PARAM1", value, 1);
+    cache.add_new_param("PARAM2", value, 2);
+
+    EXPECT_EQ(cache.missing_indices(7), (std::vector<uint16_t>{0, 3, 5, 6}));
+    EXPECT_EQ(cache.missing_indices(4), (std::vector<uint16_t>{0, 3}));
+
+    cache.add_new_param("PARAM0", value, 0);
+    cache.add_new_param("PARAM3", value, 3);
+
+    EXPECT_TRUE(cache.missing_indices(5).empty());
+}
+
+TEST(MavlinkParameterCache, LoadAndQueryManyParams)
+{
+    // A full PX4 parameter set has around 1500 params, this is a few times
+    // more to make quadratic behaviour obvious.
+    constexpr uint16_t num_params = 5000;
+
+    std::vector<std::string> ids;
+    std::vector<ParamValue> values;
+    for (uint16_t i = 0; i < num_params; ++i) {
+        ids.push_back("PARAM_" + std::to_string(i));
+        ParamValue value;
+        // Every tenth param needs the extended protocol.
+        if (i % 10 == 0) {
+            value.set(static_cast<double>(i));
+        } else {
+            value.set(static_cast<float>(i));
+        }
+        values.push_back(value);
+    }
+
+    MavlinkParameterCache cache;
+
+    // Load the params the way they are received, checking what is missing
+    // after every one of them.
+    const auto load_start = std::chrono::steady_clock::now();
+    for (uint16_t i = 0; i < num_params; ++i) {
+        ASSERT_EQ(
+            cache.add_new_param(ids[i], values[i], static_cast<int16_t>(i)),
+            MavlinkParameterCache::AddNewParamResult::Ok);
+        const auto next_missing = cache.next_missing_index(num_params);
+        if (i + 1 < num_params) {
+            ASSERT_EQ(next_missing, i + 1);
+        } else {
+            ASSERT_FALSE(next_missing);
+        }
+    }
+    const auto load_end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(cache.count(true), num_params);
+    EXPECT_EQ(cache.count(false), num_params - num_params / 10);
+
+    // Query everything by id and index, as a server does.
+    const auto query_start = std::chrono::steady_clock::now();
+    for (uint16_t i = 0; i < num_params; ++i) {
+        const auto param = cache.param_by_id(ids[i], true);
+        ASSERT_TRUE(param);
+        EXPECT_EQ(param->index, i);
+        EXPECT_EQ(cache.param_by_id(ids[i], false).has_value(), i % 10 != 0);
+        ASSERT_EQ(
+            cache.update_existing_param(ids[i], values[i]),
+            MavlinkParameterCache::UpdateExistingParamResult::Ok);
+    }
+    for (uint16_t i = 0; i < num_params; ++i) {
+        const auto param = cache.param_by_index(i, true);
+        ASSERT_TRUE(param);
+        EXPECT_EQ(param->id, ids[i]);
+    }
+    EXPECT_EQ(cache.all_parameters(false).size(), cache.count(false));
+    const auto query_end = std::chrono::steady_clock::now();
+
+    const double load_ms = std::chrono::duration<double, std::milli>(load_end - load_start).count();
+    const double query_ms =
+        std::chrono::duration<double, std::milli>(query_end - query_start).count();
+
+    LogInfo() << "Loaded " << num_params << " params in " << load_ms << " ms, queried in "
+              << query_ms << " ms";
+
+    // This takes a few milliseconds with the indexes, and orders of magnitude
+    // longer when going through all params for every lookup. The bounds are
+    // generous to avoid flakiness on loaded machines.
+    EXPECT_LT(load_ms, 250.0);
+    EXPECT_LT(query_ms, 250.0);
+}
+
+TEST(ParamId, FromMessageBuffer)
+{
+    // Ids with 16 chars are not null terminated.
+    char full[16];
+    std::memcpy(full, "SIXTEEN_CHAR_ID_", sizeof(full));
+    const auto full_id = ParamId::from_message_buffer(full);
+    EXPECT_EQ(full_id.size(), 16u);
+    EXPECT_EQ(full_id.str(), "SIXTEEN_CHAR_ID_");
+    EXPECT_EQ(full_id, std::string("SIXTEEN_CHAR_ID_"));
+
+    const char short_buffer[16] = {'S', 'H', 'O', 'R', 'T'};
+    const auto short_id = ParamId::from_message_buffer(short_buffer);
+    EXPECT_EQ(short_id.size(), 5u);
+    EXPECT_EQ(short_id, "SHORT");
+    EXPECT_NE(short_id, full_id);
+
+    const char empty_buffer[16] = {};
+    EXPECT_TRUE(ParamId::from_message_buffer(empty_buffer).empty());
+}
+
+TEST(ParamId, ToMessageBuffer)
+{
+    const ParamId id{"SHORT"};
+    const auto& buffer = id.message_buffer();
+    EXPECT_EQ(std::string(buffer.data(), 5), "SHORT");
+    for (size_t i = 5; i < buffer.size(); ++i) {
+        EXPECT_EQ(buffer[i], '\0');
+    }
+
+    // Anything too long is cut off instead of written past the end.
+    EXPECT_EQ(ParamId{"SEVENTEEN_CHAR_ID"}.str(), "SEVENTEEN_CHAR_I");
+}
+
+TEST(ParamId, Hash)
+{
+    EXPECT_EQ(ParamId{"PARAM"}.hash(), ParamId{std::string("PARAM")}.hash());
+    EXPECT_NE(ParamId{"PARAM1"}.hash(), ParamId{"PARAM2"}.hash());
+    EXPECT_EQ(std::hash<ParamId>()(ParamId{"PARAM"}), ParamId{"PARAM"}.hash());
+}
+
+TEST(MavlinkParameterCache, LookupAfterSortAndClear)
+{
+    MavlinkParameterCache cache;
+    ParamValue value;
+    value.set_int(42);
+
+    // Out of order, and more than fit into the id index at first.
+    constexpr uint16_t num_params = 100;
+    for (uint16_t i = 0; i < num_params; ++i) {
+        const uint16_t index = num_params - 1 - i;
+        cache.add_new_param("PARAM" + std::to_string(index), value, static_cast<int16_t>(index));
+    }
+
+    // Sorts the params, which moves all of them.
+    EXPECT_TRUE(cache.missing_indices(num_params).empty());
+
+    for (uint16_t i = 0; i < num_params; ++i) {
+        const auto param = cache.param_by_id("PARAM" + std::to_string(i), true);
+        ASSERT_TRUE(param);
+        EXPECT_EQ(param->index, i);
+    }
+    EXPECT_FALSE(cache.param_by_id("PARAM100", true));
+
+    cache.clear();
+    EXPECT_FALSE(cache.param_by_id("PARAM0", true));
+
+    cache.reserve(2);
+    cache.add_new_param("PARAM0", value);
+    cache.add_new_param("PARAM1", value);
+    EXPECT_EQ(cache.count(true), 2);
+    EXPECT_EQ(cache.param_by_id("PARAM1", true)->index, 1);
+    EXPECT_FALSE(cache.param_by_id("PARAM2", true));
+}
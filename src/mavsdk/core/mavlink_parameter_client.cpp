@@ -1,10 +1,13 @@
 #include "mavlink_parameter_helper.h"
 #include "mavlink_parameter_client.h"
+#include "mavlink_parameter_cache_file.h"
+#include "mavlink_parameter_pack.h"
 #include "mavlink_message_handler.h"
 #include "timeout_handler.h"
 #include "system_impl.h"
 #include "plugin_base.h"
 #include <algorithm>
+#include <cmath>
 #include <future>
 #include <utility>
 
@@ -64,6 +67,7 @@ MavlinkParameterClient::~MavlinkParameterClient()
     }
 
     _message_handler.unregister_all(this);
+    _timeout_handler.remove(_gap_fill_timeout_cookie);
 }
 
 MavlinkParameterClient::Result
@@ -360,17 +364,37 @@ MavlinkParameterClient::get_param_custom(const std::string& name)
     return res.get();
 }
 
-void MavlinkParameterClient::get_all_params_async(GetAllParamsCallback callback, void* cookie)
+void MavlinkParameterClient::get_all_params_async(
+    GetAllParamsCallback callback,
+    void* cookie,
+    GetAllParamsProgressCallback progress_callback)
 {
     if (_parameter_debugging) {
         LogDebug() << "Getting all params, extended: " << (_use_extended ? "yes" : "no");
     }
 
-    auto new_work =
-        std::make_shared<WorkItem>(WorkItemGetAll{std::move(callback), 0, false}, cookie);
+    auto new_work = std::make_shared<WorkItem>(
+        WorkItemGetAll{std::move(callback), 0, false, std::move(progress_callback)}, cookie);
     _work_queue.push_back(new_work);
 }
 
+void MavlinkParameterClient::set_gap_fill_window(unsigned window)
+{
+    _gap_fill_window = std::max(1u, window);
+}
+
+void MavlinkParameterClient::set_cache_file_path_callback(CacheFilePathCallback callback)
+{
+    std::lock_guard<std::mutex> lock(_cache_file_path_callback_mutex);
+    _cache_file_path_callback = std::move(callback);
+}
+
+void MavlinkParameterClient::set_file_downloader(FileDownloader file_downloader)
+{
+    std::lock_guard<std::mutex> lock(_file_downloader_mutex);
+    _file_downloader = std::move(file_downloader);
+}
+
 std::pair<MavlinkParameterClient::Result, std::map<std::string, ParamValue>>
 MavlinkParameterClient::get_all_params()
 {
@@ -404,9 +428,21 @@ void MavlinkParameterClient::clear_cache()
     _param_cache.clear();
 }
 
+void MavlinkParameterClient::set_work_available_callback(std::function<void()> callback)
+{
+    // The next item is started as soon as the previous one is popped.
+    _work_queue.set_changed_callback(std::move(callback));
+}
+
+void MavlinkParameterClient::set_call_user_callback(CallUserCallback call_user_callback)
+{
+    std::lock_guard<std::mutex> lock(_call_user_callback_mutex);
+    _call_user_callback = std::move(call_user_callback);
+}
+
 void MavlinkParameterClient::do_work()
 {
-    auto work_queue_guard = std::make_unique<LockedQueue<WorkItem>::Guard>(_work_queue);
+    std::optional<LockedQueue<WorkItem>::Guard> work_queue_guard{std::in_place, _work_queue};
     auto work = work_queue_guard->get_front();
 
     if (!work) {
@@ -454,26 +490,125 @@ void MavlinkParameterClient::do_work()
                     [this] { receive_timeout(); }, _timeout_s_callback(), &_timeout_cookie);
             },
             [&](WorkItemGetAll& item) {
-                auto message = create_request_list_message();
+                if (item.param_pack_downloading) {
+                    return;
+                }
 
-                if (!_sender.send_message(message)) {
-                    LogErr() << "Send message failed";
-                    work_queue_guard->pop_front();
-                    if (item.callback) {
-                        auto callback = item.callback;
-                        work_queue_guard.reset();
-                        item.callback(Result::ConnectionError, {});
+                if (!item.param_pack_tried && !_use_extended && !_param_pack_unsupported) {
+                    item.param_pack_tried = true;
+                    item.param_pack_downloading = true;
+
+                    // The download might be done right away, and needs the
+                    // lock to finish the work item then.
+                    work_queue_guard.reset();
+                    if (start_param_pack_download()) {
+                        return;
                     }
-                    return;
+
+                    work_queue_guard.emplace(_work_queue);
+                    if (work_queue_guard->get_front() != work) {
+                        return;
+                    }
+                    item.param_pack_downloading = false;
                 }
-                work->already_requested = true;
-                // We want to get notified if a timeout happens
-                _timeout_handler.add(
-                    [this] { receive_timeout(); }, _timeout_s_callback(), &_timeout_cookie);
+
+                request_list(work_queue_guard, *work, item);
             }},
         work->work_item_variant);
 }
 
+void MavlinkParameterClient::request_list(
+    std::optional<LockedQueue<WorkItem>::Guard>& work_queue_guard,
+    WorkItem& work,
+    WorkItemGetAll& item)
+{
+    auto message = create_request_list_message();
+
+    if (!_sender.send_message(message)) {
+        LogErr() << "Send message failed";
+        work_queue_guard->pop_front();
+        if (item.callback) {
+            auto callback = item.callback;
+            work_queue_guard.reset();
+            callback(Result::ConnectionError, {});
+        }
+        return;
+    }
+    work.already_requested = true;
+    // We want to get notified if a timeout happens
+    _timeout_handler.add([this] { receive_timeout(); }, _timeout_s_callback(), &_timeout_cookie);
+}
+
+bool MavlinkParameterClient::start_param_pack_download()
+{
+    FileDownloader file_downloader;
+    {
+        std::lock_guard<std::mutex> lock(_file_downloader_mutex);
+        file_downloader = _file_downloader;
+    }
+
+    if (!file_downloader) {
+        return false;
+    }
+
+    if (_parameter_debugging) {
+        LogDebug() << "Downloading " << PARAMETER_PACK_FTP_PATH;
+    }
+
+    return file_downloader(
+        PARAMETER_PACK_FTP_PATH, [this](FileDownloadResult result, std::vector<uint8_t> content) {
+            process_param_pack(result, content);
+        });
+}
+
+void MavlinkParameterClient::process_param_pack(
+    FileDownloadResult result, const std::vector<uint8_t>& content)
+{
+    std::optional<LockedQueue<WorkItem>::Guard> work_queue_guard{std::in_place, _work_queue};
+    const auto work = work_queue_guard->get_front();
+    if (!work) {
+        return;
+    }
+
+    auto* item = std::get_if<WorkItemGetAll>(&work->work_item_variant);
+    if (item == nullptr || !item->param_pack_downloading) {
+        return;
+    }
+    item->param_pack_downloading = false;
+
+    if (result == FileDownloadResult::Success) {
+        if (auto maybe_params = decode_parameter_pack(content)) {
+            _param_cache.clear();
+            _param_cache.reserve(static_cast<uint16_t>(maybe_params->size()));
+            for (auto& param : maybe_params.value()) {
+                _param_cache.add_new_param(param.id, std::move(param.value), param.index);
+            }
+            if (_parameter_debugging) {
+                LogDebug() << "Got " << maybe_params->size() << " params from "
+                           << PARAMETER_PACK_FTP_PATH;
+            }
+
+            item->count = _param_cache.count(_use_extended);
+            report_progress(*item, item->count);
+            work_queue_guard->pop_front();
+            if (item->callback) {
+                auto callback = item->callback;
+                work_queue_guard.reset();
+                callback(Result::Success, _param_cache.all_parameters_map(_use_extended));
+            }
+            return;
+        }
+    } else if (result == FileDownloadResult::Unsupported) {
+        // No need to try again next time.
+        _param_pack_unsupported = true;
+    }
+
+    if (_parameter_debugging) {
+        LogDebug() << "Could not get " << PARAMETER_PACK_FTP_PATH << ", requesting params instead";
+    }
+    request_list(work_queue_guard, *work, *item);
+}
+
 mavlink_message_t MavlinkParameterClient::create_set_param_message(WorkItemSet& work_item)
 {
     auto param_id = param_id_to_message_buffer(work_item.param_name);
@@ -600,11 +735,33 @@ mavlink_message_t MavlinkParameterClient::create_request_list_message()
     return message;
 }
 
+mavlink_message_t MavlinkParameterClient::create_hash_check_message(uint32_t hash)
+{
+    // Setting the hash tells the server that we have the params already, so
+    // it stops sending the list.
+    auto param_id = param_id_to_message_buffer(HASH_CHECK_PARAM_ID);
+    float value;
+    static_assert(sizeof(value) == sizeof(hash));
+    memcpy(&value, &hash, sizeof(value));
+
+    mavlink_message_t message;
+    mavlink_msg_param_set_pack(
+        _sender.get_own_system_id(),
+        _sender.get_own_component_id(),
+        &message,
+        _sender.get_system_id(),
+        _target_component_id,
+        param_id.data(),
+        value,
+        MAV_PARAM_TYPE_UINT32);
+    return message;
+}
+
 void MavlinkParameterClient::process_param_value(const mavlink_message_t& message)
 {
     mavlink_param_value_t param_value;
     mavlink_msg_param_value_decode(&message, &param_value);
-    const std::string safe_param_id = extract_safe_param_id(param_value.param_id);
+    const auto safe_param_id = ParamId::from_message_buffer(param_value.param_id);
     if (safe_param_id.empty()) {
         LogWarn() << "Got ill-formed param_value message (param_id empty)";
         return;
@@ -625,12 +782,12 @@ void MavlinkParameterClient::process_param_value(const mavlink_message_t& messag
         LogDebug() << "process_param_value: " << safe_param_id << " " << received_value;
     }
 
-    // We need to use a unique pointer here to remove the lock from the work queue manually "early"
+    // We need to use an optional here to remove the lock from the work queue manually "early"
     // before calling the (perhaps user-provided) callback. Otherwise, we might end up in a deadlock
-    // if the callback wants to push another work item onto the queue. By using a unique ptr there
+    // if the callback wants to push another work item onto the queue. By using an optional there
     // is no risk of forgetting to remove the lock - it is destroyed (if still valid) after going
-    // out of scope.
-    auto work_queue_guard = std::make_unique<LockedQueue<WorkItem>::Guard>(_work_queue);
+    // out of scope. Unlike a unique ptr, it doesn't allocate for every message.
+    std::optional<LockedQueue<WorkItem>::Guard> work_queue_guard{std::in_place, _work_queue};
     const auto work = work_queue_guard->get_front();
     if (!work) {
         return;
@@ -723,83 +880,18 @@ void MavlinkParameterClient::process_param_value(const mavlink_message_t& messag
                 }
             },
             [&](WorkItemGetAll& item) {
-                switch (_param_cache.add_new_param(
-                    safe_param_id, received_value, param_value.param_index)) {
-                    case MavlinkParameterCache::AddNewParamResult::AlreadyExists:
-                        // FALLTHROUGH
-                        // We don't care if it already exists, just overwrite it and carry on.
-                        // The reason is that this can likely happen if the very first
-                        // request_list is sent twice and hence we get a bunch of duplicate
-                        // params.
-                    case MavlinkParameterCache::AddNewParamResult::Ok:
-
-                        item.count = param_value.param_count;
-                        if (_parameter_debugging) {
-                            LogDebug() << "Count is now " << item.count;
-                        }
-                        if (_param_cache.count(_use_extended) == param_value.param_count) {
-                            _timeout_handler.remove(_timeout_cookie);
-                            if (_parameter_debugging) {
-                                LogDebug() << "Param set complete: "
-                                           << (_use_extended ? "extended" : "not extended");
-                            }
-                            work_queue_guard->pop_front();
-                            if (item.callback) {
-                                auto callback = item.callback;
-                                work_queue_guard.reset();
-                                callback(
-                                    Result::Success,
-                                    _param_cache.all_parameters_map(_use_extended));
-                            }
-                        } else {
-                            if (_parameter_debugging) {
-                                LogDebug() << "Count expected " << _param_cache.count(_use_extended)
-                                           << " so far " << param_value.param_count;
-                            }
-                            if (item.rerequesting) {
-                                auto maybe_next_missing_index =
-                                    _param_cache.next_missing_index(item.count);
-                                if (!maybe_next_missing_index.has_value()) {
-                                    LogErr() << "logic error, there should a missing index";
-                                    assert(false);
-                                }
-
-                                if (_parameter_debugging) {
-                                    LogDebug() << "Requesting missing parameter "
-                                               << (int)maybe_next_missing_index.value();
-                                }
-
-                                std::array<char, PARAM_ID_LEN> param_id_buff{};
-                                auto get_message = create_get_param_message(
-                                    param_id_buff, maybe_next_missing_index.value());
-
-                                if (!_sender.send_message(get_message)) {
-                                    LogErr() << "Send message failed";
-                                    work_queue_guard->pop_front();
-                                    if (item.callback) {
-                                        auto callback = item.callback;
-                                        work_queue_guard.reset();
-                                        callback(Result::ConnectionError, {});
-                                    }
-                                    return;
-                                }
-                            } else {
-                                // update the timeout handler, messages are still coming in.
-                            }
-                            _timeout_handler.refresh(&_timeout_cookie);
-                        }
-                        break;
-                    case MavlinkParameterCache::AddNewParamResult::TooManyParams:
-                        // We shouldn't be able to get here as the incoming type is only an
-                        // uint16_t.
-                        LogErr() << "Too many params received";
-                        assert(false);
-                        break;
-                    default:
-                        LogErr() << "Unknown AddNewParamResult";
-                        assert(false);
-                        break;
+                if (safe_param_id == HASH_CHECK_PARAM_ID) {
+                    // This is not a param, just sent along with them.
+                    process_hash_check(work_queue_guard, item, received_value);
+                    return;
                 }
+                process_all_params_value(
+                    work_queue_guard,
+                    item,
+                    safe_param_id,
+                    received_value,
+                    param_value.param_index,
+                    param_value.param_count);
             }},
         work->work_item_variant);
 
@@ -810,7 +902,7 @@ void MavlinkParameterClient::process_param_ext_value(const mavlink_message_t& me
 {
     mavlink_param_ext_value_t param_ext_value;
     mavlink_msg_param_ext_value_decode(&message, &param_ext_value);
-    const auto safe_param_id = extract_safe_param_id(param_ext_value.param_id);
+    const auto safe_param_id = ParamId::from_message_buffer(param_ext_value.param_id);
     if (safe_param_id.empty()) {
         LogWarn() << "Got ill-formed param_ext_value message (param_id empty)";
         return;
@@ -825,8 +917,8 @@ void MavlinkParameterClient::process_param_ext_value(const mavlink_message_t& me
         LogDebug() << "process param_ext_value: " << safe_param_id << " " << received_value;
     }
 
-    // See comments on process_param_value for use of unique_ptr
-    auto work_queue_guard = std::make_unique<LockedQueue<WorkItem>::Guard>(_work_queue);
+    // See comments on process_param_value for use of optional
+    std::optional<LockedQueue<WorkItem>::Guard> work_queue_guard{std::in_place, _work_queue};
     auto work = work_queue_guard->get_front();
     if (!work) {
         return;
@@ -862,50 +954,13 @@ void MavlinkParameterClient::process_param_ext_value(const mavlink_message_t& me
                 }
             },
             [&](WorkItemGetAll& item) {
-                switch (_param_cache.add_new_param(
-                    safe_param_id, received_value, param_ext_value.param_index)) {
-                    case MavlinkParameterCache::AddNewParamResult::AlreadyExists:
-                        // PASSTHROUGH.
-                    case MavlinkParameterCache::AddNewParamResult::Ok:
-                        item.count = param_ext_value.param_count;
-                        if (_parameter_debugging) {
-                            LogDebug() << "Count is now " << item.count;
-                        }
-
-                        if (_param_cache.count(_use_extended) == param_ext_value.param_count) {
-                            _timeout_handler.remove(_timeout_cookie);
-                            if (_parameter_debugging) {
-                                LogDebug() << "Param set complete: "
-                                           << (_use_extended ? "extended" : "not extended");
-                            }
-                            work_queue_guard->pop_front();
-                            if (item.callback) {
-                                auto callback = item.callback;
-                                work_queue_guard.reset();
-                                callback(
-                                    Result::Success,
-                                    _param_cache.all_parameters_map(_use_extended));
-                            }
-                        } else {
-                            if (_parameter_debugging) {
-                                LogDebug() << "Count expected " << _param_cache.count(_use_extended)
-                                           << " but is " << param_ext_value.param_count;
-                            }
-                            // update the timeout handler, messages are still coming in.
-                            _timeout_handler.refresh(&_timeout_cookie);
-                        }
-                        break;
-                    case MavlinkParameterCache::AddNewParamResult::TooManyParams:
-                        // We shouldn't be able to get here as the incoming type is only an
-                        // uint16_t.
-                        LogErr() << "Too many params received";
-                        assert(false);
-                        break;
-                    default:
-                        LogErr() << "Unknown AddNewParamResult";
-                        assert(false);
-                        break;
-                }
+                process_all_params_value(
+                    work_queue_guard,
+                    item,
+                    safe_param_id,
+                    received_value,
+                    param_ext_value.param_index,
+                    param_ext_value.param_count);
             },
         },
         work->work_item_variant);
@@ -918,15 +973,15 @@ void MavlinkParameterClient::process_param_ext_ack(const mavlink_message_t& mess
 {
     mavlink_param_ext_ack_t param_ext_ack;
     mavlink_msg_param_ext_ack_decode(&message, &param_ext_ack);
-    const auto safe_param_id = extract_safe_param_id(param_ext_ack.param_id);
+    const auto safe_param_id = ParamId::from_message_buffer(param_ext_ack.param_id);
 
     if (_parameter_debugging) {
         LogDebug() << "process param_ext_ack: " << safe_param_id << " "
                    << (int)param_ext_ack.param_result;
     }
 
-    // See comments on process_param_value for use of unique_ptr
-    auto work_queue_guard = std::make_unique<LockedQueue<WorkItem>::Guard>(_work_queue);
+    // See comments on process_param_value for use of optional
+    std::optional<LockedQueue<WorkItem>::Guard> work_queue_guard{std::in_place, _work_queue};
     auto work = work_queue_guard->get_front();
     if (!work) {
         return;
@@ -987,10 +1042,334 @@ void MavlinkParameterClient::process_param_ext_ack(const mavlink_message_t& mess
         work->work_item_variant);
 }
 
+void MavlinkParameterClient::process_all_params_value(
+    std::optional<LockedQueue<WorkItem>::Guard>& work_queue_guard,
+    WorkItemGetAll& item,
+    const ParamId& param_id,
+    const ParamValue& value,
+    uint16_t param_index,
+    uint16_t param_count)
+{
+    // Once we know how many there are, adding them doesn't allocate anymore.
+    _param_cache.reserve(param_count);
+
+    switch (_param_cache.add_new_param(param_id, value, static_cast<int16_t>(param_index))) {
+        case MavlinkParameterCache::AddNewParamResult::AlreadyExists:
+            // FALLTHROUGH
+            // We don't care if it already exists, just overwrite it and carry on.
+            // The reason is that this can likely happen if the very first
+            // request_list is sent twice and hence we get a bunch of duplicate
+            // params.
+        case MavlinkParameterCache::AddNewParamResult::Ok:
+            break;
+        case MavlinkParameterCache::AddNewParamResult::TooManyParams:
+            // We shouldn't be able to get here as the incoming type is only an
+            // uint16_t.
+            LogErr() << "Too many params received";
+            assert(false);
+            return;
+        default:
+            LogErr() << "Unknown AddNewParamResult";
+            assert(false);
+            return;
+    }
+
+    item.count = param_count;
+    const auto num_received = _param_cache.count(_use_extended);
+    report_progress(item, num_received);
+
+    if (num_received == param_count) {
+        _timeout_handler.remove(_timeout_cookie);
+        _timeout_handler.remove(_gap_fill_timeout_cookie);
+        _gap_fill_timeout_cookie = nullptr;
+        if (_parameter_debugging) {
+            LogDebug() << "Param set complete: " << (_use_extended ? "extended" : "not extended");
+        }
+
+        if (item.hash) {
+            if (auto maybe_path = cache_file_path()) {
+                const bool saved = save_parameter_cache_file(
+                    maybe_path.value(),
+                    MavlinkParameterCacheFile{
+                        item.hash.value(), _param_cache.all_parameters(_use_extended)});
+                if (saved && _parameter_debugging) {
+                    LogDebug() << "Cached params in " << maybe_path.value();
+                }
+            }
+        }
+
+        work_queue_guard->pop_front();
+        if (item.callback) {
+            auto callback = item.callback;
+            work_queue_guard.reset();
+            callback(Result::Success, _param_cache.all_parameters_map(_use_extended));
+        }
+        return;
+    }
+
+    if (_parameter_debugging) {
+        LogDebug() << "Count expected " << param_count << " so far " << num_received;
+    }
+
+    if (item.rerequesting) {
+        // Keep the window full: every param that comes back makes room for
+        // the next request.
+        auto it = std::find_if(
+            item.outstanding.begin(),
+            item.outstanding.end(),
+            [param_index](const OutstandingRequest& request) {
+                return request.index == param_index;
+            });
+        if (it != item.outstanding.end()) {
+            const auto rtt_s = _timeout_handler.time().elapsed_since_s(it->sent_time);
+            if (item.rtt_s) {
+                item.rtt_variation_s =
+                    0.75 * item.rtt_variation_s + 0.25 * std::abs(item.rtt_s.value() - rtt_s);
+                item.rtt_s = 0.875 * item.rtt_s.value() + 0.125 * rtt_s;
+            } else {
+                item.rtt_s = rtt_s;
+                item.rtt_variation_s = rtt_s / 2.0;
+            }
+            item.outstanding.erase(it);
+            item.progress_in_round = true;
+        }
+
+        // Requests sent well before the ones coming back now are lost. If
+        // that leaves nothing to wait for, the next round starts right away.
+        expire_missing_param_requests(item);
+
+        if (!request_missing_params(item)) {
+            LogErr() << "Send message failed";
+            work_queue_guard->pop_front();
+            if (item.callback) {
+                auto callback = item.callback;
+                work_queue_guard.reset();
+                callback(Result::ConnectionError, {});
+            }
+            return;
+        }
+    }
+
+    // Messages are still coming in.
+    _timeout_handler.refresh(_timeout_cookie);
+}
+
+void MavlinkParameterClient::start_gap_fill_round(WorkItemGetAll& item)
+{
+    // Whatever is still outstanding at the end of a round is lost. If a lot
+    // gets lost, we are probably sending faster than the link can handle,
+    // otherwise it's just noise and we can go faster.
+    if (item.window == 0) {
+        item.window = _gap_fill_window;
+    } else if (item.sent_in_round > 0) {
+        const auto lost = item.lost_in_round + item.outstanding.size();
+        if (lost * 4 > item.sent_in_round) {
+            item.window = std::max(1u, item.window / 2);
+        } else {
+            item.window = std::min(_gap_fill_window.load(), item.window * 2);
+        }
+    }
+
+    item.missing = _param_cache.missing_indices(item.count);
+    item.next_missing = 0;
+    item.outstanding.clear();
+    item.sent_in_round = 0;
+    item.lost_in_round = 0;
+    item.progress_in_round = false;
+
+    if (_parameter_debugging) {
+        LogDebug() << "Requesting " << item.missing.size() << " missing params, "
+                   << item.window << " at a time";
+    }
+}
+
+bool MavlinkParameterClient::request_missing_params(WorkItemGetAll& item)
+{
+    while (item.outstanding.size() < item.window && item.next_missing < item.missing.size()) {
+        const auto index = item.missing[item.next_missing++];
+
+        std::array<char, PARAM_ID_LEN> param_id_buff{};
+        auto message = create_get_param_message(param_id_buff, static_cast<int16_t>(index));
+        if (!_sender.send_message(message)) {
+            return false;
+        }
+
+        item.outstanding.push_back({index, _timeout_handler.time().steady_time()});
+        ++item.sent_in_round;
+    }
+
+    // Check again once the oldest request would have expired, in case
+    // nothing comes back until then. Until we know the round trip time, that
+    // is when the round times out anyway.
+    if (item.rtt_s && !item.outstanding.empty() && _gap_fill_timeout_cookie == nullptr) {
+        const auto remaining_s =
+            missing_param_request_expiry_s(item) -
+            _timeout_handler.time().elapsed_since_s(item.outstanding.front().sent_time);
+        _timeout_handler.add(
+            [this] { gap_fill_timeout(); },
+            std::max(remaining_s, 0.001),
+            &_gap_fill_timeout_cookie);
+    }
+    return true;
+}
+
+double MavlinkParameterClient::missing_param_request_expiry_s(const WorkItemGetAll& item)
+{
+    // Until we know better, a request is only lost once the round times out.
+    const double timeout_s = _timeout_s_callback();
+    if (!item.rtt_s) {
+        return timeout_s;
+    }
+    return std::min(timeout_s, item.rtt_s.value() + 4.0 * item.rtt_variation_s);
+}
+
+void MavlinkParameterClient::expire_missing_param_requests(WorkItemGetAll& item)
+{
+    // Requests are sent and thus expire in order.
+    const auto expiry_s = missing_param_request_expiry_s(item);
+    auto& time = _timeout_handler.time();
+    auto it = item.outstanding.begin();
+    while (it != item.outstanding.end() && time.elapsed_since_s(it->sent_time) >= expiry_s) {
+        ++it;
+    }
+    item.lost_in_round += static_cast<size_t>(it - item.outstanding.begin());
+    item.outstanding.erase(item.outstanding.begin(), it);
+
+    if (item.outstanding.empty() && item.next_missing == item.missing.size()) {
+        // Everything requested either came back or is lost, but there are
+        // still params missing, so we start over right away instead of
+        // waiting for the timeout.
+        start_gap_fill_round(item);
+    }
+}
+
+void MavlinkParameterClient::gap_fill_timeout()
+{
+    std::optional<LockedQueue<WorkItem>::Guard> work_queue_guard{std::in_place, _work_queue};
+    _gap_fill_timeout_cookie = nullptr;
+
+    auto work = work_queue_guard->get_front();
+    if (!work) {
+        return;
+    }
+    auto* item = std::get_if<WorkItemGetAll>(&work->work_item_variant);
+    if (item == nullptr || !item->rerequesting || item->outstanding.empty()) {
+        return;
+    }
+
+    // Nothing came back for a while, so there is nothing else to expire the
+    // requests.
+    expire_missing_param_requests(*item);
+
+    if (!request_missing_params(*item)) {
+        LogErr() << "Send message failed";
+        work_queue_guard->pop_front();
+        _timeout_handler.remove(_timeout_cookie);
+        if (item->callback) {
+            auto callback = item->callback;
+            work_queue_guard.reset();
+            callback(Result::ConnectionError, {});
+        }
+        return;
+    }
+}
+
+void MavlinkParameterClient::report_progress(WorkItemGetAll& item, uint16_t num_received)
+{
+    if (!item.progress_callback || item.count == 0) {
+        return;
+    }
+
+    // Only report whole percents, there is no point in calling this for
+    // every single param.
+    const auto percent = static_cast<int>(100u * num_received / item.count);
+    if (percent == item.last_progress_percent) {
+        return;
+    }
+    item.last_progress_percent = percent;
+
+    // We are on the receive thread with the work queue locked, so the user
+    // gets called later from the user callback thread.
+    const auto progress = static_cast<float>(num_received) / static_cast<float>(item.count);
+    std::lock_guard<std::mutex> lock(_call_user_callback_mutex);
+    if (_call_user_callback) {
+        const auto& progress_callback = item.progress_callback;
+        _call_user_callback([progress_callback, progress]() { progress_callback(progress); });
+    } else {
+        item.progress_callback(progress);
+    }
+}
+
+void MavlinkParameterClient::process_hash_check(
+    std::optional<LockedQueue<WorkItem>::Guard>& work_queue_guard,
+    WorkItemGetAll& item,
+    const ParamValue& value)
+{
+    if (!value.is<uint32_t>()) {
+        LogWarn() << "Ignoring " << HASH_CHECK_PARAM_ID << " of type " << value.typestr();
+        return;
+    }
+    item.hash = value.get<uint32_t>();
+
+    auto maybe_path = cache_file_path();
+    if (!maybe_path) {
+        return;
+    }
+
+    auto maybe_cached = load_parameter_cache_file(maybe_path.value());
+    if (!maybe_cached || maybe_cached->hash != item.hash.value()) {
+        if (_parameter_debugging) {
+            LogDebug() << "Params changed since they were cached, downloading them";
+        }
+        _timeout_handler.refresh(_timeout_cookie);
+        return;
+    }
+
+    // Not much harm done if this gets lost, we would just ignore whatever
+    // else is sent.
+    auto message = create_hash_check_message(item.hash.value());
+    if (!_sender.send_message(message)) {
+        LogWarn() << "Send message failed";
+    }
+
+    _param_cache.clear();
+    _param_cache.reserve(static_cast<uint16_t>(maybe_cached->params.size()));
+    for (auto& param : maybe_cached->params) {
+        _param_cache.add_new_param(param.id, std::move(param.value), param.index);
+    }
+    if (_parameter_debugging) {
+        LogDebug() << "Using " << maybe_cached->params.size() << " params cached in "
+                   << maybe_path.value();
+    }
+
+    _timeout_handler.remove(_timeout_cookie);
+    report_progress(item, _param_cache.count(_use_extended));
+    work_queue_guard->pop_front();
+    if (item.callback) {
+        auto callback = item.callback;
+        work_queue_guard.reset();
+        callback(Result::Success, _param_cache.all_parameters_map(_use_extended));
+    }
+}
+
+std::optional<std::string> MavlinkParameterClient::cache_file_path()
+{
+    // Only PARAM_REQUEST_LIST is answered with a hash.
+    if (_use_extended) {
+        return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lock(_cache_file_path_callback_mutex);
+    if (!_cache_file_path_callback) {
+        return std::nullopt;
+    }
+    return _cache_file_path_callback();
+}
+
 void MavlinkParameterClient::receive_timeout()
 {
-    // See comments on process_param_value for use of unique_ptr
-    auto work_queue_guard = std::make_unique<LockedQueue<WorkItem>::Guard>(_work_queue);
+    // See comments on process_param_value for use of optional
+    std::optional<LockedQueue<WorkItem>::Guard> work_queue_guard{std::in_place, _work_queue};
 
     auto work = work_queue_guard->get_front();
     if (!work) {
@@ -1098,32 +1477,38 @@ void MavlinkParameterClient::receive_timeout()
                         _timeout_handler.add(
                             [this] { receive_timeout(); }, _timeout_s_callback(), &_timeout_cookie);
                     } else {
+                        work_queue_guard->pop_front();
                         if (item.callback) {
                             auto callback = item.callback;
                             work_queue_guard.reset();
-                            item.callback(Result::Timeout, {});
+                            callback(Result::Timeout, {});
                         }
                         return;
                     }
 
                 } else {
-                    item.rerequesting = true;
-                    auto maybe_next_missing_index = _param_cache.next_missing_index(item.count);
-                    if (!maybe_next_missing_index.has_value()) {
-                        LogErr() << "logic error, there should a missing index";
-                        assert(false);
-                    }
-
-                    if (_parameter_debugging) {
-                        LogDebug() << "Requesting missing parameter "
-                                   << (int)maybe_next_missing_index.value();
+                    // Either the list stopped coming in, or some of the
+                    // missing params we requested didn't come back.
+                    if (item.rerequesting && item.progress_in_round) {
+                        work->retries_to_do = WorkItem::max_retries;
+                    } else if (item.rerequesting) {
+                        if (work->retries_to_do == 0) {
+                            LogErr() << "Requesting missing params failed";
+                            work_queue_guard->pop_front();
+                            if (item.callback) {
+                                auto callback = item.callback;
+                                work_queue_guard.reset();
+                                callback(Result::Timeout, {});
+                            }
+                            return;
+                        }
+                        --work->retries_to_do;
                     }
 
-                    std::array<char, PARAM_ID_LEN> param_id_buff{};
-                    auto message =
-                        create_get_param_message(param_id_buff, maybe_next_missing_index.value());
+                    item.rerequesting = true;
+                    start_gap_fill_round(item);
 
-                    if (!_sender.send_message(message)) {
+                    if (!request_missing_params(item)) {
                         LogErr() << "Send message failed";
                         work_queue_guard->pop_front();
                         if (item.callback) {
@@ -1168,7 +1553,7 @@ std::ostream& operator<<(std::ostream& str, const MavlinkParameterClient::Result
 
 bool MavlinkParameterClient::validate_id_or_index(
     const std::variant<std::string, int16_t>& original,
-    const std::string& param_id,
+    const ParamId& param_id,
     const int16_t param_index)
 {
     if (const auto str = std::get_if<std::string>(&original)) {
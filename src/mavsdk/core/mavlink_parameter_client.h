@@ -4,12 +4,15 @@
 #include "mavlink_include.h"
 #include "timeout_s_callback.h"
 #include "locked_queue.h"
+#include "mavsdk_time.h"
+#include "param_id.h"
 #include "param_value.h"
 #include "mavlink_parameter_subscription.h"
 #include "mavlink_parameter_cache.h"
 #include "mavlink_parameter_helper.h"
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -17,6 +20,8 @@
 #include <utility>
 #include <vector>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <variant>
 
@@ -136,15 +141,59 @@ public:
     using GetAllParamsCallback =
         std::function<void(Result result, std::map<std::string, ParamValue> set)>;
 
-    void get_all_params_async(GetAllParamsCallback callback, void* cookie);
+    // Called with the share of params received so far, whenever another
+    // percent has come in. It is queued like other user callbacks, see
+    // set_call_user_callback().
+    using GetAllParamsProgressCallback = std::function<void(float progress)>;
+
+    void get_all_params_async(
+        GetAllParamsCallback callback,
+        void* cookie,
+        GetAllParamsProgressCallback progress_callback = nullptr);
     std::pair<Result, std::map<std::string, ParamValue>> get_all_params();
 
+    // Params missing after the list has been sent are requested one by one,
+    // with up to this many requests outstanding at a time. The window used
+    // shrinks when many of the requests get lost, and grows back up to this.
+    void set_gap_fill_window(unsigned window);
+
+    // Returns the file to cache the params in, if they should be cached at
+    // all. Params are only cached if the server advertises a hash of them
+    // (_HASH_CHECK), and the cache is only used while that hash matches.
+    using CacheFilePathCallback = std::function<std::optional<std::string>()>;
+    void set_cache_file_path_callback(CacheFilePathCallback callback);
+
+    enum class FileDownloadResult {
+        Success,
+        Unsupported,
+        Failed,
+    };
+    using FileDownloadResultCallback =
+        std::function<void(FileDownloadResult result, std::vector<uint8_t> content)>;
+
+    // Downloads a file from the server, e.g. over MAVLink FTP. Returns false
+    // if no download can be started at all.
+    using FileDownloader = std::function<bool(
+        const std::string& remote_path, const FileDownloadResultCallback& callback)>;
+
+    // If set, get_all_params first tries to download all params packed into
+    // one file, and only requests them with PARAM_REQUEST_LIST if that fails.
+    void set_file_downloader(FileDownloader file_downloader);
+
     void cancel_all_param(const void* cookie);
 
     void clear_cache();
 
     void do_work();
 
+    // Called whenever there might be work for do_work().
+    void set_work_available_callback(std::function<void()> callback);
+
+    // Queues a user callback to be called on the user callback thread. If
+    // not set, callbacks are called straightaway.
+    using CallUserCallback = std::function<void(const std::function<void()>& func)>;
+    void set_call_user_callback(CallUserCallback call_user_callback);
+
     friend std::ostream& operator<<(std::ostream&, const Result&);
     friend std::ostream& operator<<(std::ostream&, const Result&);
 
@@ -161,17 +210,48 @@ private:
         const GetParamAnyCallback callback;
     };
 
+    struct OutstandingRequest {
+        uint16_t index;
+        SteadyTimePoint sent_time;
+    };
+
     struct WorkItemGetAll {
         const GetAllParamsCallback callback;
         uint16_t count;
         bool rerequesting;
+        const GetAllParamsProgressCallback progress_callback{};
+        int last_progress_percent{-1};
+
+        // Requesting missing params happens in rounds, each over the params
+        // missing at its start. A round ends when it times out. Only rounds
+        // that bring nothing back use up retries.
+        std::vector<uint16_t> missing{};
+        size_t next_missing{0};
+        std::vector<OutstandingRequest> outstanding{};
+        // Set to the configured window when the first round starts.
+        unsigned window{0};
+        size_t sent_in_round{0};
+        size_t lost_in_round{0};
+        bool progress_in_round{false};
+
+        // Round trip time of the requests, smoothed like TCP does, to tell
+        // when a request is lost.
+        std::optional<double> rtt_s{};
+        double rtt_variation_s{0.0};
+
+        // Advertised by the server before the list, if it supports it.
+        std::optional<uint32_t> hash{};
+
+        bool param_pack_tried{false};
+        bool param_pack_downloading{false};
     };
 
     struct WorkItem {
         using WorkItemVariant = std::variant<WorkItemGet, WorkItemSet, WorkItemGetAll>;
         WorkItemVariant work_item_variant;
         const void* cookie{nullptr};
-        unsigned retries_to_do = 5;
+        static constexpr unsigned max_retries = 5;
+        unsigned retries_to_do = max_retries;
         bool already_requested{false};
 
         WorkItem() = delete;
@@ -184,11 +264,37 @@ private:
     void process_param_ext_ack(const mavlink_message_t& message);
     void receive_timeout();
 
+    void process_all_params_value(
+        std::optional<LockedQueue<WorkItem>::Guard>& work_queue_guard,
+        WorkItemGetAll& item,
+        const ParamId& param_id,
+        const ParamValue& value,
+        uint16_t param_index,
+        uint16_t param_count);
+    void start_gap_fill_round(WorkItemGetAll& item);
+    bool request_missing_params(WorkItemGetAll& item);
+    void expire_missing_param_requests(WorkItemGetAll& item);
+    double missing_param_request_expiry_s(const WorkItemGetAll& item);
+    void gap_fill_timeout();
+    void report_progress(WorkItemGetAll& item, uint16_t num_received);
+    void process_hash_check(
+        std::optional<LockedQueue<WorkItem>::Guard>& work_queue_guard,
+        WorkItemGetAll& item,
+        const ParamValue& value);
+    std::optional<std::string> cache_file_path();
+    void request_list(
+        std::optional<LockedQueue<WorkItem>::Guard>& work_queue_guard,
+        WorkItem& work,
+        WorkItemGetAll& item);
+    bool start_param_pack_download();
+    void process_param_pack(FileDownloadResult result, const std::vector<uint8_t>& content);
+
     mavlink_message_t create_set_param_message(WorkItemSet& work_item);
     mavlink_message_t create_get_param_message(WorkItemGet& work_item);
     mavlink_message_t create_get_param_message(
         const std::array<char, PARAM_ID_LEN>& param_id_buff, int16_t param_index);
     mavlink_message_t create_request_list_message();
+    mavlink_message_t create_hash_check_message(uint32_t hash);
 
     Sender& _sender;
     MavlinkMessageHandler& _message_handler;
@@ -200,15 +306,30 @@ private:
     // These are specific depending on the work item type
     LockedQueue<WorkItem> _work_queue{};
     void* _timeout_cookie = nullptr;
+    // Expires the requests for missing params when nothing comes back.
+    void* _gap_fill_timeout_cookie = nullptr;
 
     MavlinkParameterCache _param_cache{};
 
+    static constexpr unsigned DEFAULT_GAP_FILL_WINDOW = 16;
+    std::atomic<unsigned> _gap_fill_window{DEFAULT_GAP_FILL_WINDOW};
+
+    std::mutex _cache_file_path_callback_mutex{};
+    CacheFilePathCallback _cache_file_path_callback{};
+
+    std::mutex _file_downloader_mutex{};
+    FileDownloader _file_downloader{};
+    std::atomic<bool> _param_pack_unsupported{false};
+
+    std::mutex _call_user_callback_mutex{};
+    CallUserCallback _call_user_callback{};
+
     bool _parameter_debugging = false;
 
     // Validate if the response matches what was given in the work queue
     static bool validate_id_or_index(
         const std::variant<std::string, int16_t>& original,
-        const std::string& param_id,
+        const ParamId& param_id,
         int16_t param_index);
 };
 
@@ -0,0 +1,624 @@
+#include "mavlink_parameter_client.h"
+#include "mavlink_parameter_cache_file.h"
+#include "mavlink_parameter_helper.h"
+#include "mavlink_parameter_server.h"
+#include "mavlink_message_handler.h"
+#include "mavsdk_time.h"
+#include "fs.h"
+#include "sender.h"
+#include "timeout_handler.h"
+#include "unittests_allocation_counter.h"
+#include "log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+// One direction of a link that delays every message and drops some of them.
+class LossyLink : public Sender {
+public:
+    LossyLink(
+        Time& time,
+        MavlinkMessageHandler& receiver,
+        uint8_t own_system_id,
+        uint8_t own_component_id,
+        uint8_t target_system_id,
+        double loss,
+        std::chrono::milliseconds latency,
+        unsigned seed) :
+        _time(time),
+        _receiver(receiver),
+        _own_system_id(own_system_id),
+        _own_component_id(own_component_id),
+        _target_system_id(target_system_id),
+        _loss(loss),
+        _latency(latency),
+        _random_engine(seed)
+    {}
+
+    // Drops the messages for which this returns true, in addition to the
+    // random loss.
+    void set_drop_callback(std::function<bool(const mavlink_message_t&)> callback)
+    {
+        _drop_callback = std::move(callback);
+    }
+
+    bool send_message(mavlink_message_t& message) override
+    {
+        if (_drop_callback && _drop_callback(message)) {
+            return true;
+        }
+        if (_distribution(_random_engine) >= _loss) {
+            _in_flight.emplace_back(_time.steady_time() + _latency, message);
+        }
+        return true;
+    }
+
+    [[nodiscard]] uint8_t get_own_system_id() const override { return _own_system_id; }
+    [[nodiscard]] uint8_t get_own_component_id() const override { return _own_component_id; }
+    [[nodiscard]] uint8_t get_system_id() const override { return _target_system_id; }
+    [[nodiscard]] Autopilot autopilot() const override { return Autopilot::Px4; }
+
+    void deliver_due_messages()
+    {
+        // Processing a message can send more on this link, so take out
+        // whatever is due first.
+        std::vector<mavlink_message_t> due;
+        const auto now = _time.steady_time();
+        while (!_in_flight.empty() && _in_flight.front().first <= now) {
+            due.push_back(_in_flight.front().second);
+            _in_flight.pop_front();
+        }
+
+        for (const auto& message : due) {
+            _receiver.process_message(message);
+        }
+    }
+
+private:
+    Time& _time;
+    MavlinkMessageHandler& _receiver;
+    const uint8_t _own_system_id;
+    const uint8_t _own_component_id;
+    const uint8_t _target_system_id;
+    const double _loss;
+    const std::chrono::milliseconds _latency;
+    std::mt19937 _random_engine;
+    std::uniform_real_distribution<double> _distribution{0.0, 1.0};
+    std::deque<std::pair<SteadyTimePoint, mavlink_message_t>> _in_flight{};
+    std::function<bool(const mavlink_message_t&)> _drop_callback{};
+};
+
+// Counts the messages sent and drops them.
+class CountingSender : public Sender {
+public:
+    CountingSender(uint8_t own_system_id, uint8_t own_component_id, uint8_t system_id) :
+        _own_system_id(own_system_id),
+        _own_component_id(own_component_id),
+        _system_id(system_id)
+    {}
+
+    bool send_message(mavlink_message_t&) override
+    {
+        ++num_sent;
+        return true;
+    }
+
+    [[nodiscard]] uint8_t get_own_system_id() const override { return _own_system_id; }
+    [[nodiscard]] uint8_t get_own_component_id() const override { return _own_component_id; }
+    [[nodiscard]] uint8_t get_system_id() const override { return _system_id; }
+    [[nodiscard]] Autopilot autopilot() const override { return Autopilot::Px4; }
+
+    unsigned num_sent{0};
+
+private:
+    const uint8_t _own_system_id;
+    const uint8_t _own_component_id;
+    const uint8_t _system_id;
+};
+
+constexpr uint8_t server_system_id = 1;
+constexpr uint8_t client_system_id = 245;
+
+std::map<std::string, ParamValue> make_params(unsigned num_params)
+{
+    std::map<std::string, ParamValue> params;
+    for (unsigned i = 0; i < num_params; ++i) {
+        char name[17];
+        snprintf(name, sizeof(name), "PARAM_%04u", i);
+        ParamValue value;
+        value.set(static_cast<float>(i));
+        params[name] = value;
+    }
+    return params;
+}
+
+// A param server and client talking to each other over lossy links in fake
+// time. The server sends at most one message every 4 ms, similar to an
+// autopilot that limits the rate on its link.
+struct ParamTransfer {
+    ParamTransfer(unsigned num_params, double loss, std::chrono::milliseconds latency) :
+        to_server{
+            time,
+            server_message_handler,
+            client_system_id,
+            MAV_COMP_ID_MISSIONPLANNER,
+            server_system_id,
+            loss,
+            latency,
+            42},
+        to_client{
+            time,
+            client_message_handler,
+            server_system_id,
+            MAV_COMP_ID_AUTOPILOT1,
+            client_system_id,
+            loss,
+            latency,
+            43},
+        params(make_params(num_params)),
+        server{to_client, server_message_handler, time, params},
+        client{to_server, client_message_handler, timeout_handler, []() { return 0.5; }}
+    {
+        server.set_max_message_rate(250.0);
+
+        // Like the user callback thread, these are only run between messages.
+        client.set_call_user_callback(
+            [this](const std::function<void()>& func) { user_callbacks.push_back(func); });
+    }
+
+    // Runs everything in steps of 1 ms until done is set, for at most 10 minutes.
+    void run_until(const bool& done, const std::function<void()>& on_step = nullptr)
+    {
+        for (unsigned step = 0; !done && step < 600000; ++step) {
+            to_server.deliver_due_messages();
+            to_client.deliver_due_messages();
+            if (on_step) {
+                on_step();
+            }
+            server.do_work();
+            client.do_work();
+            timeout_handler.run_once();
+            for (const auto& func : user_callbacks) {
+                func();
+            }
+            user_callbacks.clear();
+            time.sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    FakeTime time{};
+    TimeoutHandler timeout_handler{time};
+    MavlinkMessageHandler server_message_handler{};
+    MavlinkMessageHandler client_message_handler{};
+    LossyLink to_server;
+    LossyLink to_client;
+    const std::map<std::string, ParamValue> params;
+    MavlinkParameterServer server;
+    MavlinkParameterClient client;
+    std::vector<std::function<void()>> user_callbacks{};
+};
+
+struct DownloadOutcome {
+    MavlinkParameterClient::Result result{MavlinkParameterClient::Result::Timeout};
+    size_t num_params{0};
+    double duration_s{0.0};
+    std::vector<float> progress{};
+};
+
+DownloadOutcome download_over_lossy_link(unsigned num_params, unsigned gap_fill_window)
+{
+    ParamTransfer transfer{num_params, 0.1, std::chrono::milliseconds(25)};
+    transfer.client.set_gap_fill_window(gap_fill_window);
+
+    DownloadOutcome outcome;
+    bool done = false;
+    const auto start = transfer.time.steady_time();
+
+    transfer.client.get_all_params_async(
+        [&](MavlinkParameterClient::Result result, std::map<std::string, ParamValue> received) {
+            outcome.result = result;
+            outcome.num_params = received.size();
+            outcome.duration_s = transfer.time.elapsed_since_s(start);
+            done = true;
+        },
+        nullptr,
+        [&](float progress) { outcome.progress.push_back(progress); });
+
+    transfer.run_until(done);
+    return outcome;
+}
+
+// Packs params the way ArduPilot serves them over MAVLink FTP, but without
+// sharing name prefixes between params.
+std::vector<uint8_t> pack_params(const std::map<std::string, ParamValue>& params)
+{
+    std::vector<uint8_t> data;
+    const auto add_u16 = [&](uint16_t value) {
+        data.push_back(static_cast<uint8_t>(value & 0xff));
+        data.push_back(static_cast<uint8_t>(value >> 8));
+    };
+    add_u16(0x671b);
+    add_u16(static_cast<uint16_t>(params.size()));
+    add_u16(static_cast<uint16_t>(params.size()));
+
+    for (const auto& [name, value] : params) {
+        const auto float_value = value.get<float>();
+        uint8_t bytes[sizeof(float_value)];
+        std::memcpy(bytes, &float_value, sizeof(float_value));
+
+        data.push_back(4); // float
+        data.push_back(static_cast<uint8_t>((name.size() - 1) << 4));
+        data.insert(data.end(), name.begin(), name.end());
+        data.insert(data.end(), std::begin(bytes), std::end(bytes));
+    }
+    return data;
+}
+
+struct ParamPackOutcome {
+    DownloadOutcome download{};
+    unsigned num_pack_downloads{0};
+    unsigned num_list_requests{0};
+};
+
+// Without a pack result, the client has no way to download files. Otherwise
+// the download finishes with that result after a few round trips.
+ParamPackOutcome download_with_param_pack(
+    unsigned num_params, std::optional<MavlinkParameterClient::FileDownloadResult> pack_result)
+{
+    using FileDownloadResult = MavlinkParameterClient::FileDownloadResult;
+
+    constexpr auto latency = std::chrono::milliseconds(25);
+    ParamTransfer transfer{num_params, 0.0, latency};
+
+    ParamPackOutcome outcome;
+
+    transfer.server_message_handler.register_one(
+        MAVLINK_MSG_ID_PARAM_REQUEST_LIST,
+        [&](const mavlink_message_t&) { ++outcome.num_list_requests; },
+        &outcome);
+
+    std::optional<SteadyTimePoint> pack_done_time;
+    MavlinkParameterClient::FileDownloadResultCallback pack_callback;
+    const auto pack = pack_params(transfer.params);
+    if (pack_result) {
+        transfer.client.set_file_downloader(
+            [&](const std::string& remote_path,
+                const MavlinkParameterClient::FileDownloadResultCallback& callback) {
+                EXPECT_EQ(remote_path, "@PARAM/param.pck");
+                ++outcome.num_pack_downloads;
+                pack_done_time = transfer.time.steady_time() + 4 * latency;
+                pack_callback = callback;
+                return true;
+            });
+    }
+
+    bool done = false;
+    const auto start = transfer.time.steady_time();
+
+    transfer.client.get_all_params_async(
+        [&](MavlinkParameterClient::Result result, std::map<std::string, ParamValue> received) {
+            outcome.download.result = result;
+            outcome.download.num_params = received.size();
+            outcome.download.duration_s = transfer.time.elapsed_since_s(start);
+            EXPECT_EQ(received, transfer.params);
+            done = true;
+        },
+        nullptr);
+
+    transfer.run_until(done, [&]() {
+        if (pack_done_time && pack_done_time.value() <= transfer.time.steady_time()) {
+            pack_done_time.reset();
+            pack_callback(
+                pack_result.value(),
+                pack_result.value() == FileDownloadResult::Success ? pack :
+                                                                     std::vector<uint8_t>{});
+        }
+    });
+
+    transfer.server_message_handler.unregister_all(&outcome);
+    return outcome;
+}
+
+} // namespace
+
+// Receiving the params streamed after PARAM_REQUEST_LIST is the hot path of
+// get_all_params.
+TEST(MavlinkParameterClient, ProcessingParamValuesDoesNotAllocate)
+{
+    constexpr uint16_t num_params = 1000;
+
+    FakeTime time;
+    TimeoutHandler timeout_handler{time};
+    MavlinkMessageHandler message_handler;
+    CountingSender sender{client_system_id, MAV_COMP_ID_MISSIONPLANNER, server_system_id};
+    MavlinkParameterClient client{sender, message_handler, timeout_handler, []() { return 0.5; }};
+
+    bool done = false;
+    client.get_all_params_async(
+        [&](MavlinkParameterClient::Result result, std::map<std::string, ParamValue> params) {
+            EXPECT_EQ(result, MavlinkParameterClient::Result::Success);
+            EXPECT_EQ(params.size(), num_params);
+            done = true;
+        },
+        nullptr);
+    client.do_work();
+    ASSERT_EQ(sender.num_sent, 1u);
+
+    auto receive_param = [&](uint16_t index) {
+        char name[17];
+        snprintf(name, sizeof(name), "PARAM_%04u", index);
+        char param_id[16];
+        std::memcpy(param_id, name, sizeof(param_id));
+        mavlink_message_t message;
+        mavlink_msg_param_value_pack(
+            server_system_id,
+            MAV_COMP_ID_AUTOPILOT1,
+            &message,
+            param_id,
+            static_cast<float>(index),
+            MAV_PARAM_TYPE_REAL32,
+            num_params,
+            index);
+        message_handler.process_message(message);
+    };
+
+    // The first param tells how many there are, so the cache can make room.
+    receive_param(0);
+
+    AllocationCounter::reset();
+    AllocationCounter::set_enabled_on_this_thread(true);
+    for (uint16_t index = 1; index < num_params - 1; ++index) {
+        receive_param(index);
+    }
+    AllocationCounter::set_enabled_on_this_thread(false);
+
+    EXPECT_EQ(AllocationCounter::num_allocations(), 0u);
+
+    // Handing all params to the user does allocate.
+    EXPECT_FALSE(done);
+    receive_param(num_params - 1);
+    EXPECT_TRUE(done);
+}
+
+TEST(MavlinkParameterClient, GetAllParamsOverLossyLink)
+{
+    constexpr unsigned num_params = 1500;
+
+    const auto one_by_one = download_over_lossy_link(num_params, 1);
+    const auto windowed = download_over_lossy_link(num_params, 16);
+
+    LogInfo() << "Downloading " << num_params << " params with 10% loss took "
+              << one_by_one.duration_s << " s one by one, " << windowed.duration_s
+              << " s with a window of 16";
+
+    ASSERT_EQ(one_by_one.result, MavlinkParameterClient::Result::Success);
+    ASSERT_EQ(windowed.result, MavlinkParameterClient::Result::Success);
+    EXPECT_EQ(one_by_one.num_params, num_params);
+    EXPECT_EQ(windowed.num_params, num_params);
+
+    // Streaming the list takes as long either way, limited by the rate of the
+    // server. The window speeds up requesting what got lost.
+    const double list_duration_s = num_params / 250.0;
+    EXPECT_LT(
+        (windowed.duration_s - list_duration_s) * 4, one_by_one.duration_s - list_duration_s);
+
+    ASSERT_FALSE(windowed.progress.empty());
+    EXPECT_LE(windowed.progress.size(), 101u);
+    EXPECT_FLOAT_EQ(windowed.progress.back(), 1.0f);
+    for (size_t i = 1; i < windowed.progress.size(); ++i) {
+        EXPECT_GT(windowed.progress[i], windowed.progress[i - 1]);
+    }
+}
+
+TEST(MavlinkParameterClient, LostParamRequestsAreSentAgainAfterAboutOneRoundTrip)
+{
+    constexpr unsigned num_params = 100;
+    constexpr uint16_t lost_twice = 29;
+
+    ParamTransfer transfer{num_params, 0.0, std::chrono::milliseconds(25)};
+
+    // Some params of the list get lost, and one of them again when it is
+    // requested.
+    std::set<uint16_t> lost_once;
+    transfer.to_client.set_drop_callback([&](const mavlink_message_t& message) {
+        if (message.msgid != MAVLINK_MSG_ID_PARAM_VALUE) {
+            return false;
+        }
+        const auto index = mavlink_msg_param_value_get_param_index(&message);
+        if (index < 10 || index > lost_twice) {
+            return false;
+        }
+        if (lost_once.insert(index).second) {
+            return true;
+        }
+        if (index == lost_twice && lost_once.count(num_params + index) == 0) {
+            lost_once.insert(num_params + index);
+            return true;
+        }
+        return false;
+    });
+
+    std::vector<SteadyTimePoint> request_times;
+    transfer.server_message_handler.register_one(
+        MAVLINK_MSG_ID_PARAM_REQUEST_READ,
+        [&](const mavlink_message_t& message) {
+            if (mavlink_msg_param_request_read_get_param_index(&message) == lost_twice) {
+                request_times.push_back(transfer.time.steady_time());
+            }
+        },
+        &request_times);
+
+    std::optional<MavlinkParameterClient::Result> result;
+    transfer.client.get_all_params_async(
+        [&](MavlinkParameterClient::Result new_result, std::map<std::string, ParamValue>) {
+            result = new_result;
+        },
+        nullptr);
+
+    bool done = false;
+    transfer.run_until(done, [&]() { done = result.has_value(); });
+    transfer.server_message_handler.unregister_all(&request_times);
+
+    ASSERT_EQ(result, MavlinkParameterClient::Result::Success);
+    ASSERT_EQ(request_times.size(), 2u);
+
+    // Well before the round times out after 0.5 s.
+    const auto resent_after = request_times[1] - request_times[0];
+    LogInfo() << "Lost request sent again after "
+              << std::chrono::duration<double>(resent_after).count() << " s";
+    EXPECT_LT(resent_after, std::chrono::milliseconds(250));
+}
+
+TEST(MavlinkParameterClient, GetAllParamsFromCacheIfHashMatches)
+{
+    constexpr uint32_t hash = 0x12345678;
+
+    auto maybe_directory = create_tmp_directory("mavsdk-param-client-test");
+    ASSERT_TRUE(maybe_directory);
+    const auto cache_path = maybe_directory.value() + path_separator + "params.bin";
+
+    MavlinkParameterCacheFile cached;
+    cached.hash = hash;
+    for (uint16_t i = 0; i < 3; ++i) {
+        ParamValue value;
+        value.set_float(static_cast<float>(i));
+        cached.params.push_back({"CACHED_" + std::to_string(i), value, i});
+    }
+    ASSERT_TRUE(save_parameter_cache_file(cache_path, cached));
+
+    FakeTime time;
+    TimeoutHandler timeout_handler{time};
+    MavlinkMessageHandler server_message_handler;
+    MavlinkMessageHandler client_message_handler;
+
+    LossyLink to_server{
+        time,
+        server_message_handler,
+        client_system_id,
+        MAV_COMP_ID_MISSIONPLANNER,
+        server_system_id,
+        0.0,
+        std::chrono::milliseconds(1),
+        42};
+    LossyLink to_client{
+        time,
+        client_message_handler,
+        server_system_id,
+        MAV_COMP_ID_AUTOPILOT1,
+        client_system_id,
+        0.0,
+        std::chrono::milliseconds(1),
+        43};
+
+    // Answer the list request with the hash only, like PX4 does first.
+    server_message_handler.register_one(
+        MAVLINK_MSG_ID_PARAM_REQUEST_LIST,
+        [&](const mavlink_message_t&) {
+            float value;
+            std::memcpy(&value, &hash, sizeof(value));
+            const auto param_id = param_id_to_message_buffer(HASH_CHECK_PARAM_ID);
+            mavlink_message_t message;
+            mavlink_msg_param_value_pack(
+                server_system_id,
+                MAV_COMP_ID_AUTOPILOT1,
+                &message,
+                param_id.data(),
+                value,
+                MAV_PARAM_TYPE_UINT32,
+                1000,
+                std::numeric_limits<uint16_t>::max());
+            to_client.send_message(message);
+        },
+        nullptr);
+
+    bool hash_check_set = false;
+    server_message_handler.register_one(
+        MAVLINK_MSG_ID_PARAM_SET,
+        [&](const mavlink_message_t& message) {
+            mavlink_param_set_t param_set;
+            mavlink_msg_param_set_decode(&message, &param_set);
+            hash_check_set = extract_safe_param_id(param_set.param_id) == HASH_CHECK_PARAM_ID;
+        },
+        nullptr);
+
+    MavlinkParameterClient client{
+        to_server, client_message_handler, timeout_handler, []() { return 0.5; }};
+    client.set_cache_file_path_callback([&]() { return std::optional<std::string>{cache_path}; });
+
+    std::optional<MavlinkParameterClient::Result> result;
+    std::map<std::string, ParamValue> params;
+    client.get_all_params_async(
+        [&](MavlinkParameterClient::Result new_result,
+            std::map<std::string, ParamValue> new_params) {
+            result = new_result;
+            params = std::move(new_params);
+        },
+        nullptr);
+
+    for (unsigned tick = 0; !result && tick < 100; ++tick) {
+        to_server.deliver_due_messages();
+        to_client.deliver_due_messages();
+        client.do_work();
+        timeout_handler.run_once();
+        time.sleep_for(std::chrono::milliseconds(1));
+    }
+    to_server.deliver_due_messages();
+    time.sleep_for(std::chrono::milliseconds(1));
+    to_server.deliver_due_messages();
+
+    ASSERT_EQ(result, MavlinkParameterClient::Result::Success);
+    ASSERT_EQ(params.size(), 3u);
+    EXPECT_EQ(params["CACHED_2"].get<float>(), 2.0f);
+    EXPECT_TRUE(hash_check_set);
+
+    server_message_handler.unregister_all(nullptr);
+    fs_remove(cache_path);
+}
+
+TEST(MavlinkParameterClient, GetAllParamsFromParamPack)
+{
+    constexpr unsigned num_params = 1500;
+
+    const auto classic = download_with_param_pack(num_params, std::nullopt);
+    const auto packed =
+        download_with_param_pack(num_params, MavlinkParameterClient::FileDownloadResult::Success);
+
+    ASSERT_EQ(classic.download.result, MavlinkParameterClient::Result::Success);
+    ASSERT_EQ(packed.download.result, MavlinkParameterClient::Result::Success);
+    EXPECT_EQ(classic.num_pack_downloads, 0u);
+    EXPECT_EQ(classic.num_list_requests, 1u);
+    EXPECT_EQ(packed.num_pack_downloads, 1u);
+    EXPECT_EQ(packed.num_list_requests, 0u);
+    EXPECT_EQ(packed.download.num_params, num_params);
+}
+
+TEST(MavlinkParameterClient, GetAllParamsFallsBackWithoutParamPack)
+{
+    constexpr unsigned num_params = 100;
+
+    for (const auto pack_result :
+         {MavlinkParameterClient::FileDownloadResult::Unsupported,
+          MavlinkParameterClient::FileDownloadResult::Failed}) {
+        const auto outcome = download_with_param_pack(num_params, pack_result);
+
+        ASSERT_EQ(outcome.download.result, MavlinkParameterClient::Result::Success);
+        EXPECT_EQ(outcome.download.num_params, num_params);
+        EXPECT_EQ(outcome.num_pack_downloads, 1u);
+        EXPECT_EQ(outcome.num_list_requests, 1u);
+    }
+}
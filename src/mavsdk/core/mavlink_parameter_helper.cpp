@@ -14,9 +14,7 @@ std::string extract_safe_param_id(const char* param_id)
 
 std::array<char, PARAM_ID_LEN> param_id_to_message_buffer(const std::string& param_id)
 {
-    std::array<char, PARAM_ID_LEN> ret = {};
-    std::memcpy(ret.data(), param_id.c_str(), param_id.length());
-    return ret;
+    return ParamId{param_id}.message_buffer();
 }
 
 } // namespace mavsdk
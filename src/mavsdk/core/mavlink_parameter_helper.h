@@ -3,10 +3,15 @@
 #include <array>
 #include <string>
 #include "mavlink_include.h"
+#include "param_id.h"
 
 namespace mavsdk {
 
-static constexpr size_t PARAM_ID_LEN = 16;
+static constexpr size_t PARAM_ID_LEN = ParamId::MAX_LEN;
+
+// Sent by PX4 before the params when they are requested, with a hash over
+// all of them as value.
+static constexpr const char* HASH_CHECK_PARAM_ID = "_HASH_CHECK";
 
 [[nodiscard]] std::string extract_safe_param_id(const char* param_id);
 
@@ -0,0 +1,133 @@
+#include "mavlink_parameter_pack.h"
+#include "log.h"
+
+#include <cstring>
+#include <string>
+
+namespace mavsdk {
+
+// The file starts with a header of three uint16: magic, number of params in
+// the file, and total number of params. Each param then consists of:
+// - type (low nibble) and flags (high nibble)
+// - length of the name prefix shared with the previous param (low nibble),
+//   and length of the rest of the name minus one (high nibble)
+// - the rest of the name
+// - the value, followed by the default value if the flag is set
+// Zero bytes may be inserted between params as padding.
+static constexpr uint16_t magic_without_defaults = 0x671b;
+static constexpr uint16_t magic_with_defaults = 0x671c;
+static constexpr uint8_t flag_with_default = 0x01;
+
+enum PackedType : uint8_t {
+    PACKED_TYPE_INT8 = 1,
+    PACKED_TYPE_INT16 = 2,
+    PACKED_TYPE_INT32 = 3,
+    PACKED_TYPE_FLOAT = 4,
+};
+
+static size_t packed_type_size(uint8_t type)
+{
+    switch (type) {
+        case PACKED_TYPE_INT8:
+            return 1;
+        case PACKED_TYPE_INT16:
+            return 2;
+        case PACKED_TYPE_INT32:
+        case PACKED_TYPE_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+template<typename T> static T read_value(const uint8_t* data)
+{
+    // Little endian, like everything in MAVLink.
+    T value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+std::optional<std::vector<MavlinkParameterCache::Param>>
+decode_parameter_pack(const std::vector<uint8_t>& data)
+{
+    constexpr size_t header_len = 6;
+    if (data.size() < header_len) {
+        LogWarn() << "Param pack too short";
+        return std::nullopt;
+    }
+
+    const auto magic = read_value<uint16_t>(&data[0]);
+    const auto num_params = read_value<uint16_t>(&data[2]);
+    const auto total_params = read_value<uint16_t>(&data[4]);
+
+    if (magic != magic_without_defaults && magic != magic_with_defaults) {
+        LogWarn() << "Param pack has unknown magic " << magic;
+        return std::nullopt;
+    }
+
+    if (num_params != total_params) {
+        LogWarn() << "Param pack only contains " << num_params << " of " << total_params
+                  << " params";
+        return std::nullopt;
+    }
+
+    std::vector<MavlinkParameterCache::Param> params;
+    params.reserve(num_params);
+
+    std::string name;
+    size_t pos = header_len;
+
+    while (params.size() < num_params) {
+        while (pos < data.size() && data[pos] == 0) {
+            ++pos;
+        }
+        if (pos + 2 > data.size()) {
+            LogWarn() << "Param pack truncated after " << params.size() << " params";
+            return std::nullopt;
+        }
+
+        const uint8_t type = data[pos] & 0x0f;
+        const uint8_t flags = data[pos] >> 4;
+        const size_t common_len = data[pos + 1] & 0x0f;
+        const size_t name_len = (data[pos + 1] >> 4) + 1;
+        pos += 2;
+
+        const auto value_len = packed_type_size(type);
+        const auto default_len = (flags & flag_with_default) ? value_len : 0;
+        if (value_len == 0 || common_len > name.size() || common_len + name_len > 16 ||
+            pos + name_len + value_len + default_len > data.size()) {
+            LogWarn() << "Param pack malformed after " << params.size() << " params";
+            return std::nullopt;
+        }
+
+        name.resize(common_len);
+        name.append(reinterpret_cast<const char*>(&data[pos]), name_len);
+        pos += name_len;
+
+        ParamValue value;
+        switch (type) {
+            case PACKED_TYPE_INT8:
+                value.set(read_value<int8_t>(&data[pos]));
+                break;
+            case PACKED_TYPE_INT16:
+                value.set(read_value<int16_t>(&data[pos]));
+                break;
+            case PACKED_TYPE_INT32:
+                value.set(read_value<int32_t>(&data[pos]));
+                break;
+            case PACKED_TYPE_FLOAT:
+                value.set(read_value<float>(&data[pos]));
+                break;
+        }
+        // We have no use for the default value.
+        pos += value_len + default_len;
+
+        params.push_back(MavlinkParameterCache::Param{
+            name, std::move(value), static_cast<uint16_t>(params.size())});
+    }
+
+    return params;
+}
+
+} // namespace mavsdk
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "mavlink_parameter_cache.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace mavsdk {
+
+// All params packed into one file, as served by ArduPilot over MAVLink FTP.
+// Downloading this is a lot faster than receiving a PARAM_VALUE per param.
+//
+// See https://ardupilot.org/dev/docs/mavlink-get-set-params.html
+static constexpr const char* PARAMETER_PACK_FTP_PATH = "@PARAM/param.pck";
+
+// Returns nothing if the data is malformed or doesn't contain all params.
+std::optional<std::vector<MavlinkParameterCache::Param>>
+decode_parameter_pack(const std::vector<uint8_t>& data);
+
+} // namespace mavsdk
@@ -0,0 +1,157 @@
+#include "mavlink_parameter_pack.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+struct PackedParam {
+    std::string name;
+    uint8_t type;
+    std::vector<uint8_t> value;
+};
+
+template<typename T> std::vector<uint8_t> bytes_of(T value)
+{
+    std::vector<uint8_t> bytes(sizeof(value));
+    std::memcpy(bytes.data(), &value, sizeof(value));
+    return bytes;
+}
+
+// Packs params the way ArduPilot does, including padding so no param
+// crosses a 256 byte boundary.
+std::vector<uint8_t> encode(
+    const std::vector<PackedParam>& params, bool with_defaults = false, int total_params = -1)
+{
+    std::vector<uint8_t> data;
+    const auto add_u16 = [&](uint16_t value) {
+        data.push_back(static_cast<uint8_t>(value & 0xff));
+        data.push_back(static_cast<uint8_t>(value >> 8));
+    };
+    add_u16(with_defaults ? 0x671c : 0x671b);
+    add_u16(static_cast<uint16_t>(params.size()));
+    add_u16(static_cast<uint16_t>(total_params >= 0 ? total_params : params.size()));
+
+    std::string last_name;
+    for (const auto& param : params) {
+        size_t common_len = 0;
+        while (common_len < 15 && common_len + 1 < param.name.size() &&
+               common_len < last_name.size() && last_name[common_len] == param.name[common_len]) {
+            ++common_len;
+        }
+        const auto rest = param.name.substr(common_len);
+
+        const size_t len = 2 + rest.size() + param.value.size() * (with_defaults ? 2 : 1);
+        if (data.size() / 256 != (data.size() + len - 1) / 256) {
+            data.resize((data.size() / 256 + 1) * 256, 0);
+        }
+
+        data.push_back(static_cast<uint8_t>(param.type | (with_defaults ? 0x10 : 0x00)));
+        data.push_back(static_cast<uint8_t>(common_len | ((rest.size() - 1) << 4)));
+        data.insert(data.end(), rest.begin(), rest.end());
+        data.insert(data.end(), param.value.begin(), param.value.end());
+        if (with_defaults) {
+            data.insert(data.end(), param.value.size(), 0);
+        }
+        last_name = param.name;
+    }
+    return data;
+}
+
+std::vector<PackedParam> example_params()
+{
+    return {
+        {"ARMING_CHECK", 3, bytes_of<int32_t>(1)},
+        {"ARMING_RUDDER", 1, bytes_of<int8_t>(-2)},
+        {"BATT_CAPACITY", 2, bytes_of<int16_t>(3300)},
+        {"BATT_LOW_VOLT", 4, bytes_of<float>(10.5f)},
+        {"SIXTEEN_CHAR_ID_", 4, bytes_of<float>(-1.25f)},
+    };
+}
+
+} // namespace
+
+TEST(MavlinkParameterPack, Decode)
+{
+    for (const bool with_defaults : {false, true}) {
+        const auto params = decode_parameter_pack(encode(example_params(), with_defaults));
+        ASSERT_TRUE(params);
+        ASSERT_EQ(params->size(), 5u);
+
+        EXPECT_EQ(params->at(0).id, "ARMING_CHECK");
+        EXPECT_EQ(params->at(0).value.get<int32_t>(), 1);
+        EXPECT_EQ(params->at(1).id, "ARMING_RUDDER");
+        EXPECT_EQ(params->at(1).value.get<int8_t>(), -2);
+        EXPECT_EQ(params->at(2).id, "BATT_CAPACITY");
+        EXPECT_EQ(params->at(2).value.get<int16_t>(), 3300);
+        EXPECT_EQ(params->at(3).id, "BATT_LOW_VOLT");
+        EXPECT_EQ(params->at(3).value.get<float>(), 10.5f);
+        EXPECT_EQ(params->at(4).id, "SIXTEEN_CHAR_ID_");
+        EXPECT_EQ(params->at(4).value.get<float>(), -1.25f);
+
+        for (uint16_t i = 0; i < params->size(); ++i) {
+            EXPECT_EQ(params->at(i).index, i);
+        }
+    }
+}
+
+TEST(MavlinkParameterPack, RejectsMalformed)
+{
+    const auto data = encode(example_params());
+
+    // Truncated anywhere.
+    for (size_t len = 0; len < data.size(); ++len) {
+        EXPECT_FALSE(decode_parameter_pack({data.begin(), data.begin() + len})) << len;
+    }
+
+    auto wrong_magic = data;
+    wrong_magic[0] = 0x00;
+    EXPECT_FALSE(decode_parameter_pack(wrong_magic));
+
+    auto unknown_type = data;
+    unknown_type[6] = 0x07;
+    EXPECT_FALSE(decode_parameter_pack(unknown_type));
+
+    // The first param can't share a prefix with anything.
+    auto invalid_prefix = data;
+    invalid_prefix[7] |= 0x01;
+    EXPECT_FALSE(decode_parameter_pack(invalid_prefix));
+}
+
+TEST(MavlinkParameterPack, RejectsSubset)
+{
+    EXPECT_FALSE(decode_parameter_pack(encode(example_params(), false, 1000)));
+}
+
+TEST(MavlinkParameterPack, DecodeMany)
+{
+    std::vector<PackedParam> packed;
+    for (int i = 0; i < 1500; ++i) {
+        char name[17];
+        snprintf(name, sizeof(name), "GROUP%02d_PARAM%03d", i / 100, i % 100);
+        packed.push_back({name, 4, bytes_of<float>(static_cast<float>(i))});
+    }
+    const auto data = encode(packed);
+
+    // Shared prefixes keep this well below 10 bytes per param, where each
+    // PARAM_VALUE is 37 bytes of payload.
+    EXPECT_LT(data.size(), packed.size() * 10);
+
+    const auto before = std::chrono::steady_clock::now();
+    const auto params = decode_parameter_pack(data);
+    const auto after = std::chrono::steady_clock::now();
+
+    ASSERT_TRUE(params);
+    ASSERT_EQ(params->size(), packed.size());
+    for (size_t i = 0; i < packed.size(); ++i) {
+        EXPECT_EQ(params->at(i).id, packed[i].name);
+        EXPECT_EQ(params->at(i).value.get<float>(), static_cast<float>(i));
+    }
+    EXPECT_LT(after - before, std::chrono::milliseconds(100));
+}
@@ -1,16 +1,22 @@
 #include "mavlink_parameter_server.h"
 #include "mavlink_parameter_helper.h"
 #include "plugin_base.h"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 
 namespace mavsdk {
 
 MavlinkParameterServer::MavlinkParameterServer(
     Sender& sender,
     MavlinkMessageHandler& message_handler,
+    Time& time,
     std::optional<std::map<std::string, ParamValue>> optional_param_values) :
     _sender(sender),
-    _message_handler(message_handler)
+    _message_handler(message_handler),
+    _time(time),
+    _last_budget_update(time.steady_time())
 {
     if (const char* env_p = std::getenv("MAVSDK_PARAMETER_DEBUGGING")) {
         if (std::string(env_p) == "1") {
@@ -139,7 +145,7 @@ std::map<std::string, ParamValue> MavlinkParameterServer::retrieve_all_server_pa
     std::lock_guard<std::mutex> lock(_all_params_mutex);
     std::map<std::string, ParamValue> map_copy;
     for (auto entry : _param_cache.all_parameters(true)) {
-        map_copy[entry.id] = entry.value;
+        map_copy[entry.id.str()] = entry.value;
     }
     return map_copy;
 }
@@ -180,7 +186,7 @@ MavlinkParameterServer::retrieve_server_param_int(const std::string& name)
 }
 
 void MavlinkParameterServer::process_param_set_internally(
-    const std::string& param_id, const ParamValue& value_to_set, bool extended)
+    const ParamId& param_id, const ParamValue& value_to_set, bool extended)
 {
     // TODO: add debugging env
     LogDebug() << "Param set request" << (extended ? " extended" : "") << ": " << param_id
@@ -231,7 +237,7 @@ void MavlinkParameterServer::process_param_set_internally(
             } else {
                 LogDebug() << "Updated param to :" << updated_parameter.value;
                 find_and_call_subscriptions_value_changed(
-                    updated_parameter.id, updated_parameter.value);
+                    updated_parameter.id.str(), updated_parameter.value);
             }
             if (extended) {
                 auto new_work = std::make_shared<WorkItem>(
@@ -256,7 +262,7 @@ void MavlinkParameterServer::process_param_set(const mavlink_message_t& message)
         log_target_mismatch(set_request.target_system, set_request.target_component);
         return;
     }
-    const std::string safe_param_id = extract_safe_param_id(set_request.param_id);
+    const auto safe_param_id = ParamId::from_message_buffer(set_request.param_id);
 
     if (safe_param_id.empty()) {
         LogWarn() << "Got ill-formed param_set message (param_id empty)";
@@ -280,7 +286,7 @@ void MavlinkParameterServer::process_param_ext_set(const mavlink_message_t& mess
         log_target_mismatch(set_request.target_system, set_request.target_component);
         return;
     }
-    const std::string safe_param_id = extract_safe_param_id(set_request.param_id);
+    const auto safe_param_id = ParamId::from_message_buffer(set_request.param_id);
 
     if (safe_param_id.empty()) {
         LogWarn() << "Got ill-formed param_ext_set message (param_id empty)";
@@ -320,7 +326,7 @@ void MavlinkParameterServer::process_param_request_read(const mavlink_message_t&
                 }
                 internal_process_param_request_read_by_index(index, false);
             },
-            [&](const std::string& id) {
+            [&](const ParamId& id) {
                 if (_parameter_debugging) {
                     LogDebug() << "found id: " << id;
                 }
@@ -350,7 +356,7 @@ void MavlinkParameterServer::process_param_ext_request_read(const mavlink_messag
                 }
                 internal_process_param_request_read_by_index(index, true);
             },
-            [&](const std::string& id) {
+            [&](const ParamId& id) {
                 if (_parameter_debugging) {
                     LogDebug() << "found id: " << id;
                 }
@@ -360,7 +366,7 @@ void MavlinkParameterServer::process_param_ext_request_read(const mavlink_messag
 }
 
 void MavlinkParameterServer::internal_process_param_request_read_by_id(
-    const std::string& id, const bool extended)
+    const ParamId& id, const bool extended)
 {
     std::lock_guard<std::mutex> lock(_all_params_mutex);
     const auto param_opt = _param_cache.param_by_id(id, extended);
@@ -426,71 +432,188 @@ void MavlinkParameterServer::process_param_ext_request_list(const mavlink_messag
 
 void MavlinkParameterServer::broadcast_all_parameters(const bool extended)
 {
-    std::lock_guard<std::mutex> lock(_all_params_mutex);
-    const auto all_params = _param_cache.all_parameters(extended);
+    std::unique_lock<std::mutex> lock(_all_params_mutex);
+    const auto param_count = _param_cache.count(extended);
     if (_parameter_debugging) {
         LogDebug() << "broadcast_all_parameters " << (extended ? "extended" : "") << ": "
-                   << all_params.size();
+                   << param_count;
     }
-    for (const auto& parameter : all_params) {
-        if (_parameter_debugging) {
-            LogDebug() << "sending param:" << parameter.id;
-        }
-        auto new_work = std::make_shared<WorkItem>(
-            parameter.id,
-            parameter.value,
-            WorkItemValue{parameter.index, static_cast<uint16_t>(all_params.size()), extended});
-        _work_queue.push_back(new_work);
+
+    // If all params are requested again, we start over. Whatever was sent
+    // already might not have arrived.
+    if (param_count == 0) {
+        _broadcast.reset();
+        return;
+    }
+    _broadcast = Broadcast{0, extended};
+
+    auto work_available_callback = _work_available_callback;
+    lock.unlock();
+    if (work_available_callback) {
+        work_available_callback();
+    }
+}
+
+bool MavlinkParameterServer::set_max_message_rate(double messages_per_s)
+{
+    // With no rate at all, nothing would ever be sent again.
+    if (!std::isfinite(messages_per_s) || messages_per_s <= 0.0) {
+        LogWarn() << "Ignoring invalid max message rate: " << messages_per_s;
+        return false;
     }
+    _max_message_rate = messages_per_s;
+
+    // Whatever is left to send is now due at a different time.
+    std::unique_lock<std::mutex> lock(_all_params_mutex);
+    auto work_available_callback = _work_available_callback;
+    lock.unlock();
+    if (work_available_callback) {
+        work_available_callback();
+    }
+    return true;
 }
 
 void MavlinkParameterServer::do_work()
+{
+    const auto now = _time.steady_time();
+    const double rate = _max_message_rate;
+    const double elapsed_s = std::chrono::duration<double>(now - _last_budget_update).count();
+    _last_budget_update = now;
+    _message_budget =
+        std::min(std::max(1.0, rate * MAX_BURST_S), _message_budget + rate * elapsed_s);
+
+    while (_message_budget >= 1.0) {
+        if (!send_next_queued() && !send_next_broadcast()) {
+            break;
+        }
+        _message_budget -= 1.0;
+    }
+}
+
+SteadyTimePoint MavlinkParameterServer::next_work_time()
+{
+    {
+        std::lock_guard<std::mutex> lock(_all_params_mutex);
+        if (!_broadcast && _work_queue.size() == 0) {
+            return SteadyTimePoint::max();
+        }
+    }
+
+    // As soon as there is budget for the next message.
+    const double wait_s = std::max(0.0, (1.0 - _message_budget) / _max_message_rate);
+    return _last_budget_update +
+           std::chrono::ceil<SteadyTimePoint::duration>(std::chrono::duration<double>(wait_s));
+}
+
+void MavlinkParameterServer::set_work_available_callback(std::function<void()> callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(_all_params_mutex);
+        _work_available_callback = callback;
+    }
+    _work_queue.set_changed_callback(std::move(callback));
+}
+
+bool MavlinkParameterServer::send_next_broadcast()
+{
+    std::unique_lock<std::mutex> lock(_all_params_mutex);
+    if (!_broadcast) {
+        return false;
+    }
+
+    const auto extended = _broadcast->extended;
+    const auto param_count = _param_cache.count(extended);
+    if (_broadcast->next >= param_count) {
+        _broadcast.reset();
+        return false;
+    }
+
+    // This is the current value, even if it was set after all params were
+    // requested.
+    const auto maybe_param = _param_cache.param_by_index(_broadcast->next, extended);
+    if (++_broadcast->next == param_count) {
+        _broadcast.reset();
+    }
+    lock.unlock();
+
+    if (!maybe_param) {
+        return false;
+    }
+    const auto& param = maybe_param.value();
+
+    if (_parameter_debugging) {
+        LogDebug() << "sending param:" << param.id;
+    }
+    send_param_value(param.id, param.value, param.index, param_count, extended);
+    return true;
+}
+
+bool MavlinkParameterServer::send_param_value(
+    const ParamId& param_id,
+    const ParamValue& value,
+    uint16_t param_index,
+    uint16_t param_count,
+    bool extended)
+{
+    const auto& param_id_message_buffer = param_id.message_buffer();
+
+    mavlink_message_t mavlink_message;
+    if (extended) {
+        const auto buf = value.get_128_bytes();
+        mavlink_msg_param_ext_value_pack(
+            _sender.get_own_system_id(),
+            _sender.get_own_component_id(),
+            &mavlink_message,
+            param_id_message_buffer.data(),
+            buf.data(),
+            value.get_mav_param_ext_type(),
+            param_count,
+            param_index);
+    } else {
+        float param_value;
+        if (_sender.autopilot() == Sender::Autopilot::ArduPilot) {
+            param_value = value.get_4_float_bytes_cast();
+        } else {
+            param_value = value.get_4_float_bytes_bytewise();
+        }
+        mavlink_msg_param_value_pack(
+            _sender.get_own_system_id(),
+            _sender.get_own_component_id(),
+            &mavlink_message,
+            param_id_message_buffer.data(),
+            param_value,
+            value.get_mav_param_type(),
+            param_count,
+            param_index);
+    }
+
+    if (!_sender.send_message(mavlink_message)) {
+        LogErr() << "Error: Send message failed";
+        return false;
+    }
+    return true;
+}
+
+bool MavlinkParameterServer::send_next_queued()
 {
     LockedQueue<WorkItem>::Guard work_queue_guard(_work_queue);
     auto work = work_queue_guard.get_front();
     if (!work) {
-        return;
+        return false;
     }
-    const auto param_id_message_buffer = param_id_to_message_buffer(work->param_id);
+    const auto& param_id_message_buffer = work->param_id.message_buffer();
 
     mavlink_message_t mavlink_message;
 
     std::visit(
         overloaded{
             [&](const WorkItemValue& specific) {
-                if (specific.extended) {
-                    const auto buf = work->param_value.get_128_bytes();
-                    mavlink_msg_param_ext_value_pack(
-                        _sender.get_own_system_id(),
-                        _sender.get_own_component_id(),
-                        &mavlink_message,
-                        param_id_message_buffer.data(),
-                        buf.data(),
-                        work->param_value.get_mav_param_ext_type(),
-                        specific.param_count,
-                        specific.param_index);
-                } else {
-                    float param_value;
-                    if (_sender.autopilot() == Sender::Autopilot::ArduPilot) {
-                        param_value = work->param_value.get_4_float_bytes_cast();
-                    } else {
-                        param_value = work->param_value.get_4_float_bytes_bytewise();
-                    }
-                    mavlink_msg_param_value_pack(
-                        _sender.get_own_system_id(),
-                        _sender.get_own_component_id(),
-                        &mavlink_message,
-                        param_id_message_buffer.data(),
-                        param_value,
-                        work->param_value.get_mav_param_type(),
-                        specific.param_count,
-                        specific.param_index);
-                }
-                if (!_sender.send_message(mavlink_message)) {
-                    LogErr() << "Error: Send message failed";
-                    work_queue_guard.pop_front();
-                    return;
-                }
+                send_param_value(
+                    work->param_id,
+                    work->param_value,
+                    specific.param_index,
+                    specific.param_count,
+                    specific.extended);
                 work_queue_guard.pop_front();
             },
             [&](const WorkItemAck& specific) {
@@ -511,6 +634,7 @@ void MavlinkParameterServer::do_work()
                 work_queue_guard.pop_front();
             }},
         work->work_item_variant);
+    return true;
 }
 
 std::ostream& operator<<(std::ostream& str, const MavlinkParameterServer::Result& result)
@@ -557,7 +681,7 @@ void MavlinkParameterServer::log_target_mismatch(uint16_t target_sys_id, uint16_
                << (int)_sender.get_own_component_id();
 }
 
-std::variant<std::monostate, std::string, std::uint16_t>
+std::variant<std::monostate, ParamId, std::uint16_t>
 MavlinkParameterServer::extract_request_read_param_identifier(
     int16_t param_index, const char* param_id)
 {
@@ -568,7 +692,7 @@ MavlinkParameterServer::extract_request_read_param_identifier(
 
     if (param_index == -1) {
         // use param_id if index == -1
-        const auto safe_param_id = extract_safe_param_id(param_id);
+        const auto safe_param_id = ParamId::from_message_buffer(param_id);
         if (safe_param_id.empty()) {
             LogErr() << "Message with param_index=-1 but no empty param id";
             return std::monostate{};
@@ -4,15 +4,22 @@
 #include "mavlink_message_handler.h"
 #include "timeout_handler.h"
 #include "timeout_s_callback.h"
+#include "param_id.h"
 #include "param_value.h"
 #include "locked_queue.h"
 #include "mavlink_parameter_subscription.h"
 #include "mavlink_parameter_cache.h"
+#include "mavsdk_time.h"
 
+#include <atomic>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <list>
 #include <utility>
+#include <vector>
 
 namespace mavsdk {
 
@@ -24,6 +31,7 @@ public:
     explicit MavlinkParameterServer(
         Sender& parent,
         MavlinkMessageHandler& message_handler,
+        Time& time,
         // By providing all the parameters on construction you can populate the
         // parameter set before the server starts reacting to clients.
         //
@@ -57,6 +65,21 @@ public:
 
     void do_work();
 
+    // When do_work() needs to run again to send what is left at the max
+    // message rate, or max() if there is nothing to send.
+    SteadyTimePoint next_work_time();
+
+    // Called whenever there might be work for do_work().
+    void set_work_available_callback(std::function<void()> callback);
+
+    // Limits how many messages are sent per second, so that sending all
+    // params doesn't flood slow links. Replies to requests for single params
+    // and acks are sent first, and sending all params continues after them.
+    // Returns false and keeps the previous rate unless the rate is positive
+    // and finite.
+    bool set_max_message_rate(double messages_per_s);
+    static constexpr double DEFAULT_MAX_MESSAGE_RATE = 100.0;
+
     friend std::ostream& operator<<(std::ostream&, const Result&);
 
     // Non-copyable
@@ -65,24 +88,32 @@ public:
 
 private:
     void process_param_set_internally(
-        const std::string& param_id, const ParamValue& value_to_set, bool extended);
+        const ParamId& param_id, const ParamValue& value_to_set, bool extended);
     void process_param_set(const mavlink_message_t& message);
     void process_param_ext_set(const mavlink_message_t& message);
 
     void process_param_request_read(const mavlink_message_t& message);
     void process_param_ext_request_read(const mavlink_message_t& message);
 
-    void internal_process_param_request_read_by_id(const std::string& id, bool extended);
+    void internal_process_param_request_read_by_id(const ParamId& id, bool extended);
     void internal_process_param_request_read_by_index(std::uint16_t index, bool extended);
 
     void process_param_request_list(const mavlink_message_t& message);
     void process_param_ext_request_list(const mavlink_message_t& message);
     void broadcast_all_parameters(bool extended);
+    bool send_next_queued();
+    bool send_next_broadcast();
+    bool send_param_value(
+        const ParamId& param_id,
+        const ParamValue& value,
+        uint16_t param_index,
+        uint16_t param_count,
+        bool extended);
 
     bool target_matches(uint16_t target_sys_id, uint16_t target_comp_id, bool is_request);
     void log_target_mismatch(uint16_t target_sys_id, uint16_t target_comp_id);
 
-    static std::variant<std::monostate, std::string, std::uint16_t>
+    static std::variant<std::monostate, ParamId, std::uint16_t>
     extract_request_read_param_identifier(int16_t param_index, const char* param_id);
 
     struct WorkItemValue {
@@ -97,26 +128,43 @@ private:
 
     struct WorkItem {
         // A response always has a valid param id
-        const std::string param_id;
+        const ParamId param_id;
         // as well as a valid param value
         const ParamValue param_value;
         using WorkItemVariant = std::variant<WorkItemValue, WorkItemAck>;
         const WorkItemVariant work_item_variant;
         explicit WorkItem(
-            std::string param_id1, ParamValue param_value1, WorkItemVariant work_item_variant1) :
-            param_id(std::move(param_id1)),
+            ParamId param_id1, ParamValue param_value1, WorkItemVariant work_item_variant1) :
+            param_id(param_id1),
             param_value(std::move(param_value1)),
             work_item_variant(std::move(work_item_variant1)){};
     };
 
+    // How far sending all params has got. The params are taken from the
+    // cache as they are sent, so they are not copied for every request.
+    struct Broadcast {
+        uint16_t next;
+        bool extended;
+    };
+
     Sender& _sender;
     MavlinkMessageHandler& _message_handler;
+    Time& _time;
 
     std::mutex _all_params_mutex{};
     MavlinkParameterCache _param_cache{};
+    std::optional<Broadcast> _broadcast{};
+    std::function<void()> _work_available_callback{};
 
     LockedQueue<WorkItem> _work_queue{};
 
+    // Only used by do_work(). Up to this much of the rate can be sent at
+    // once, so not every message has to wait for the next call.
+    static constexpr double MAX_BURST_S = 0.05;
+    std::atomic<double> _max_message_rate{DEFAULT_MAX_MESSAGE_RATE};
+    double _message_budget{0.0};
+    SteadyTimePoint _last_budget_update{};
+
     bool _parameter_debugging = false;
 };
 
@@ -0,0 +1,247 @@
+#include "mavlink_parameter_server.h"
+#include "mavlink_message_handler.h"
+#include "mavsdk_time.h"
+#include "sender.h"
+#include "unittests_allocation_counter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+constexpr uint8_t server_system_id = 1;
+constexpr uint8_t client_system_id = 245;
+
+// Remembers the ids of all params sent, in order.
+class RecordingSender : public Sender {
+public:
+    bool send_message(mavlink_message_t& message) override
+    {
+        if (message.msgid == MAVLINK_MSG_ID_PARAM_VALUE) {
+            mavlink_param_value_t value;
+            mavlink_msg_param_value_decode(&message, &value);
+            char id[sizeof(value.param_id) + 1]{};
+            std::memcpy(id, value.param_id, sizeof(value.param_id));
+            sent.emplace_back(id);
+        }
+        return true;
+    }
+
+    [[nodiscard]] uint8_t get_own_system_id() const override { return server_system_id; }
+    [[nodiscard]] uint8_t get_own_component_id() const override { return MAV_COMP_ID_AUTOPILOT1; }
+    [[nodiscard]] uint8_t get_system_id() const override { return client_system_id; }
+    [[nodiscard]] Autopilot autopilot() const override { return Autopilot::Px4; }
+
+    std::vector<std::string> sent{};
+};
+
+std::map<std::string, ParamValue> make_params(unsigned num_params)
+{
+    std::map<std::string, ParamValue> params;
+    for (unsigned i = 0; i < num_params; ++i) {
+        char name[17];
+        snprintf(name, sizeof(name), "PARAM_%04u", i);
+        ParamValue value;
+        value.set(static_cast<float>(i));
+        params[name] = value;
+    }
+    return params;
+}
+
+void request_list(MavlinkMessageHandler& message_handler)
+{
+    mavlink_message_t message;
+    mavlink_msg_param_request_list_pack(
+        client_system_id,
+        MAV_COMP_ID_MISSIONPLANNER,
+        &message,
+        server_system_id,
+        MAV_COMP_ID_AUTOPILOT1);
+    message_handler.process_message(message);
+}
+
+void request_read(MavlinkMessageHandler& message_handler, const std::string& id)
+{
+    char param_id[16]{};
+    std::strncpy(param_id, id.c_str(), sizeof(param_id));
+
+    mavlink_message_t message;
+    mavlink_msg_param_request_read_pack(
+        client_system_id,
+        MAV_COMP_ID_MISSIONPLANNER,
+        &message,
+        server_system_id,
+        MAV_COMP_ID_AUTOPILOT1,
+        param_id,
+        -1);
+    message_handler.process_message(message);
+}
+
+} // namespace
+
+TEST(MavlinkParameterServer, BroadcastIsPaced)
+{
+    constexpr unsigned num_params = 500;
+    constexpr double rate = 200.0;
+
+    FakeTime time;
+    MavlinkMessageHandler message_handler;
+    RecordingSender sender;
+    MavlinkParameterServer server{sender, message_handler, time, make_params(num_params)};
+    server.set_max_message_rate(rate);
+
+    request_list(message_handler);
+
+    const auto start = time.steady_time();
+    for (unsigned tick = 0; sender.sent.size() < num_params && tick < 10000; ++tick) {
+        time.sleep_for(std::chrono::milliseconds(10));
+        server.do_work();
+
+        // Never more than the rate allows, apart from a short burst.
+        EXPECT_LE(sender.sent.size(), rate * time.elapsed_since_s(start) + rate * 0.05 + 1);
+    }
+
+    ASSERT_EQ(sender.sent.size(), num_params);
+    EXPECT_EQ(sender.sent.front(), "PARAM_0000");
+    EXPECT_EQ(sender.sent.back(), "PARAM_0499");
+
+    // And not much less either.
+    EXPECT_NEAR(time.elapsed_since_s(start), num_params / rate, 0.1);
+}
+
+TEST(MavlinkParameterServer, BroadcastOnlyNeedsWorkWhenDue)
+{
+    constexpr unsigned num_params = 100;
+    constexpr double rate = 100.0;
+
+    FakeTime time;
+    MavlinkMessageHandler message_handler;
+    RecordingSender sender;
+    MavlinkParameterServer server{sender, message_handler, time, make_params(num_params)};
+    server.set_max_message_rate(rate);
+
+    unsigned num_work_available = 0;
+    server.set_work_available_callback([&num_work_available]() { ++num_work_available; });
+
+    // With nothing to send, there is nothing to wake up for.
+    server.do_work();
+    EXPECT_EQ(server.next_work_time(), SteadyTimePoint::max());
+
+    request_list(message_handler);
+    EXPECT_GT(num_work_available, 0u);
+
+    // Running only when signalled and at the next work time is enough to
+    // send all params at the rate.
+    const auto start = time.steady_time();
+    unsigned num_do_work = 0;
+    while (sender.sent.size() < num_params && num_do_work < 10 * num_params) {
+        const auto next_work_time = server.next_work_time();
+        ASSERT_NE(next_work_time, SteadyTimePoint::max());
+        const auto now = time.steady_time();
+        if (next_work_time > now) {
+            time.sleep_for(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(next_work_time - now));
+        }
+        server.do_work();
+        ++num_do_work;
+    }
+
+    ASSERT_EQ(sender.sent.size(), num_params);
+    EXPECT_NEAR(time.elapsed_since_s(start), num_params / rate, 0.1);
+    EXPECT_EQ(server.next_work_time(), SteadyTimePoint::max());
+}
+
+TEST(MavlinkParameterServer, InvalidMaxMessageRateIsRejected)
+{
+    constexpr unsigned num_params = 10;
+
+    FakeTime time;
+    MavlinkMessageHandler message_handler;
+    RecordingSender sender;
+    MavlinkParameterServer server{sender, message_handler, time, make_params(num_params)};
+
+    EXPECT_TRUE(server.set_max_message_rate(100.0));
+    EXPECT_FALSE(server.set_max_message_rate(0.0));
+    EXPECT_FALSE(server.set_max_message_rate(-10.0));
+    EXPECT_FALSE(server.set_max_message_rate(std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_FALSE(server.set_max_message_rate(std::numeric_limits<double>::infinity()));
+
+    // Sending all params still works at the last valid rate.
+    request_list(message_handler);
+    for (unsigned tick = 0; sender.sent.size() < num_params && tick < 1000; ++tick) {
+        time.sleep_for(std::chrono::milliseconds(10));
+        server.do_work();
+    }
+
+    EXPECT_EQ(sender.sent.size(), num_params);
+}
+
+TEST(MavlinkParameterServer, ReadIsAnsweredDuringBroadcast)
+{
+    constexpr unsigned num_params = 100;
+
+    FakeTime time;
+    MavlinkMessageHandler message_handler;
+    RecordingSender sender;
+    MavlinkParameterServer server{sender, message_handler, time, make_params(num_params)};
+    server.set_max_message_rate(100.0);
+
+    request_list(message_handler);
+    for (unsigned tick = 0; tick < 10; ++tick) {
+        time.sleep_for(std::chrono::milliseconds(10));
+        server.do_work();
+    }
+    const auto sent_before_read = sender.sent.size();
+    ASSERT_GT(sent_before_read, 0u);
+    ASSERT_LT(sent_before_read, num_params);
+
+    request_read(message_handler, "PARAM_0090");
+    for (unsigned tick = 0; sender.sent.size() < num_params + 1 && tick < 1000; ++tick) {
+        time.sleep_for(std::chrono::milliseconds(10));
+        server.do_work();
+    }
+
+    // The read is answered right away, and sending all params continues
+    // where it left off.
+    ASSERT_EQ(sender.sent.size(), num_params + 1);
+    EXPECT_EQ(sender.sent[sent_before_read], "PARAM_0090");
+    for (unsigned i = 0; i < num_params; ++i) {
+        const auto position = i < sent_before_read ? i : i + 1;
+        char name[17];
+        snprintf(name, sizeof(name), "PARAM_%04u", i);
+        EXPECT_EQ(sender.sent[position], name);
+    }
+}
+
+TEST(MavlinkParameterServer, StreamingParamsDoesNotAllocate)
+{
+    constexpr unsigned num_params = 1000;
+
+    FakeTime time;
+    MavlinkMessageHandler message_handler;
+    RecordingSender sender;
+    MavlinkParameterServer server{sender, message_handler, time, make_params(num_params)};
+    server.set_max_message_rate(1000.0);
+
+    // The ids are short enough to be stored without allocating.
+    sender.sent.reserve(num_params);
+
+    AllocationCounter::reset();
+    AllocationCounter::set_enabled_on_this_thread(true);
+    request_list(message_handler);
+    for (unsigned tick = 0; sender.sent.size() < num_params && tick < 10000; ++tick) {
+        time.sleep_for(std::chrono::milliseconds(1));
+        server.do_work();
+    }
+    AllocationCounter::set_enabled_on_this_thread(false);
+
+    EXPECT_EQ(AllocationCounter::num_allocations(), 0u);
+    EXPECT_EQ(sender.sent.size(), num_params);
+}
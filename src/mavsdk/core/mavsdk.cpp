@@ -74,6 +74,26 @@ void Mavsdk::set_timeout_s(double timeout_s)
     _impl->set_timeout_s(timeout_s);
 }
 
+void Mavsdk::set_num_system_worker_threads(unsigned num_threads)
+{
+    _impl->set_num_system_worker_threads(num_threads);
+}
+
+void Mavsdk::set_param_cache_directory(const std::string& path)
+{
+    _impl->set_param_cache_directory(path);
+}
+
+std::vector<Mavsdk::CallbackStatistics> Mavsdk::get_callback_statistics() const
+{
+    return _impl->callback_profiler.statistics();
+}
+
+void Mavsdk::reset_callback_statistics()
+{
+    _impl->callback_profiler.reset();
+}
+
 Mavsdk::NewSystemHandle Mavsdk::subscribe_on_new_system(const NewSystemCallback& callback)
 {
     return _impl->subscribe_on_new_system(callback);
@@ -36,6 +36,11 @@ MavsdkImpl::MavsdkImpl() : timeout_handler(_time), call_every_handler(_time)
         }
     }
 
+    timeout_handler.set_wakeup_callback(
+        [this](SteadyTimePoint wakeup_time) { wake_work_thread(wakeup_time); });
+    call_every_handler.set_wakeup_callback(
+        [this](SteadyTimePoint wakeup_time) { wake_work_thread(wakeup_time); });
+
     _work_thread = new std::thread(&MavsdkImpl::work_thread, this);
 
     _process_user_callbacks_thread =
@@ -56,6 +61,10 @@ MavsdkImpl::~MavsdkImpl()
     }
 
     if (_work_thread != nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(_work_thread_mutex);
+            _work_thread_cv.notify_one();
+        }
         _work_thread->join();
         delete _work_thread;
         _work_thread = nullptr;
@@ -722,24 +731,71 @@ bool MavsdkImpl::is_any_system_connected() const
 void MavsdkImpl::work_thread()
 {
     while (!_should_exit) {
+        {
+            // Anything added from now on needs to lower the wakeup time again.
+            std::lock_guard<std::mutex> lock(_work_thread_mutex);
+            _work_thread_wakeup = SteadyTimePoint::max();
+        }
+
         timeout_handler.run_once();
         call_every_handler.run_once();
 
+        auto wakeup_time = SteadyTimePoint::max();
+
         {
             std::lock_guard<std::mutex> lock(_server_components_mutex);
             for (auto& it : _server_components) {
                 if (it.second != nullptr) {
-                    it.second->_impl->do_work();
+                    wakeup_time = std::min(wakeup_time, it.second->_impl->do_work());
                 }
             }
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        for (const auto& next_wakeup :
+             {timeout_handler.next_wakeup(), call_every_handler.next_wakeup()}) {
+            if (next_wakeup && next_wakeup.value() < wakeup_time) {
+                wakeup_time = next_wakeup.value();
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(_work_thread_mutex);
+        if (_work_thread_wakeup < wakeup_time) {
+            wakeup_time = _work_thread_wakeup;
+        }
+        _work_thread_wakeup = wakeup_time;
+        const auto woken_up = [&]() {
+            return _should_exit || _work_thread_wakeup < wakeup_time;
+        };
+        if (wakeup_time == SteadyTimePoint::max()) {
+            _work_thread_cv.wait(lock, woken_up);
+        } else {
+            _work_thread_cv.wait_until(lock, wakeup_time, woken_up);
+        }
     }
 }
 
+void MavsdkImpl::wake_work_thread(SteadyTimePoint wakeup_time)
+{
+    std::lock_guard<std::mutex> lock(_work_thread_mutex);
+    if (wakeup_time < _work_thread_wakeup) {
+        _work_thread_wakeup = wakeup_time;
+        _work_thread_cv.notify_one();
+    }
+}
+
+void MavsdkImpl::notify_server_component_work_available()
+{
+    wake_work_thread(_time.steady_time());
+}
+
+void MavsdkImpl::call_user_callback_located(
+    const char* filename, const int linenumber, const std::function<void()>& func)
+{
+    call_user_callback_located(filename, linenumber, QueuedCallback(func));
+}
+
 void MavsdkImpl::call_user_callback_located(
-    const std::string& filename, const int linenumber, const std::function<void()>& func)
+    const char* filename, const int linenumber, const QueuedCallback& func)
 {
     auto callback_size = _user_callback_queue.size();
     if (callback_size == 10) {
@@ -756,11 +812,8 @@ void MavsdkImpl::call_user_callback_located(
         return;
     }
 
-    // We only need to keep track of filename and linenumber if we're actually debugging this.
-    UserCallback user_callback =
-        _callback_debugging ? UserCallback{func, filename, linenumber} : UserCallback{func};
-
-    _user_callback_queue.enqueue(user_callback);
+    _user_callback_queue.enqueue(
+        UserCallback{func, callback_profiler.site(filename, linenumber), _time.steady_time()});
 }
 
 void MavsdkImpl::process_user_callbacks_thread()
@@ -771,28 +824,43 @@ void MavsdkImpl::process_user_callbacks_thread()
             continue;
         }
 
-        void* cookie{nullptr};
-
         const double timeout_s = 1.0;
-        timeout_handler.add(
-            [&]() {
-                if (_callback_debugging) {
-                    LogWarn() << "Callback called from " << callback.value().filename << ":"
-                              << callback.value().linenumber << " took more than " << timeout_s
-                              << " second to run.";
+        auto& site = *callback.value().site;
+
+        // When debugging, we want to abort while the callback is still stuck,
+        // otherwise it's enough to check the time once it is done.
+        void* cookie{nullptr};
+        if (_callback_debugging) {
+            timeout_handler.add(
+                [&]() {
+                    LogWarn() << "Callback called from " << site.filename << ":" << site.linenumber
+                              << " took more than " << timeout_s << " second to run.";
+                    log::flush();
                     fflush(stdout);
                     fflush(stderr);
                     abort();
-                } else {
-                    LogWarn()
-                        << "Callback took more than " << timeout_s << " second to run.\n"
-                        << "See: https://mavsdk.mavlink.io/main/en/cpp/troubleshooting.html#user_callbacks";
-                }
-            },
-            timeout_s,
-            &cookie);
+                },
+                timeout_s,
+                &cookie);
+        }
+
+        const auto start_time = _time.steady_time();
         callback.value().func();
-        timeout_handler.remove(cookie);
+        const auto end_time = _time.steady_time();
+
+        if (_callback_debugging) {
+            timeout_handler.remove(cookie);
+        }
+
+        CallbackProfiler::record(
+            site, start_time - callback.value().queued_time, end_time - start_time);
+
+        if (end_time - start_time > std::chrono::duration<double>(timeout_s)) {
+            LogWarn()
+                << "Callback called from " << site.filename << ":" << site.linenumber
+                << " took more than " << timeout_s << " second to run.\n"
+                << "See: https://mavsdk.mavlink.io/main/en/cpp/troubleshooting.html#user_callbacks";
+        }
     }
 }
 
@@ -4,9 +4,11 @@
 #include <utility>
 #include <vector>
 #include <atomic>
+#include <condition_variable>
 #include <thread>
 
 #include "call_every_handler.h"
+#include "callback_profiler.h"
 #include "connection.h"
 #include "mavsdk.h"
 #include "mavlink_include.h"
@@ -18,6 +20,7 @@
 #include "system.h"
 #include "timeout_handler.h"
 #include "callback_list.h"
+#include "worker_pool.h"
 
 namespace mavsdk {
 
@@ -94,14 +97,46 @@ public:
 
     TimeoutHandler timeout_handler;
     CallEveryHandler call_every_handler;
+    WorkerPool worker_pool{};
+    CallbackProfiler callback_profiler{};
 
     void call_user_callback_located(
-        const std::string& filename, int linenumber, const std::function<void()>& func);
+        const char* filename, int linenumber, const std::function<void()>& func);
+    void call_user_callback_located(
+        const char* filename, int linenumber, const QueuedCallback& func);
 
-    void set_timeout_s(double timeout_s) { _timeout_s = timeout_s; }
+    void set_timeout_s(double timeout_s)
+    {
+        _timeout_s = timeout_s;
+        _timeout_s_adaptive = false;
+    }
 
     double timeout_s() const { return _timeout_s; };
 
+    // Whether systems may adapt the timeout to the measured round trip time,
+    // which is the case unless the user has set one explicitly.
+    bool timeout_s_adaptive() const { return _timeout_s_adaptive; }
+
+    void set_num_system_worker_threads(unsigned num_threads)
+    {
+        worker_pool.set_num_threads(num_threads);
+    }
+
+    void set_param_cache_directory(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(_param_cache_directory_mutex);
+        _param_cache_directory = path;
+    }
+
+    std::string param_cache_directory() const
+    {
+        std::lock_guard<std::mutex> lock(_param_cache_directory_mutex);
+        return _param_cache_directory;
+    }
+
+    // Called by server components when there might be work for their do_work().
+    void notify_server_component_work_available();
+
     MavlinkMessageHandler mavlink_message_handler{};
     Time time{};
 
@@ -111,6 +146,7 @@ private:
         uint8_t system_id, uint8_t component_id, bool always_connected = false);
 
     void work_thread();
+    void wake_work_thread(SteadyTimePoint wakeup_time);
     void process_user_callbacks_thread();
 
     void send_heartbeat();
@@ -137,19 +173,26 @@ private:
 
     struct UserCallback {
         UserCallback() = default;
-        explicit UserCallback(std::function<void()> func_) : func(std::move(func_)) {}
-        UserCallback(std::function<void()> func_, std::string filename_, const int linenumber_) :
+        UserCallback(
+            QueuedCallback func_,
+            CallbackProfiler::Site& site_,
+            SteadyTimePoint queued_time_) :
             func(std::move(func_)),
-            filename(std::move(filename_)),
-            linenumber(linenumber_)
+            site(&site_),
+            queued_time(queued_time_)
         {}
 
-        std::function<void()> func{};
-        std::string filename{};
-        int linenumber{};
+        QueuedCallback func{};
+        CallbackProfiler::Site* site{nullptr};
+        SteadyTimePoint queued_time{};
     };
 
     std::thread* _work_thread{nullptr};
+    std::mutex _work_thread_mutex{};
+    std::condition_variable _work_thread_cv{};
+    // When the work thread is going to wake up next, max() while it is busy.
+    SteadyTimePoint _work_thread_wakeup{SteadyTimePoint::max()};
+
     std::thread* _process_user_callbacks_thread{nullptr};
     SafeQueue<UserCallback> _user_callback_queue{};
 
@@ -161,6 +204,10 @@ private:
     std::function<bool(mavlink_message_t&)> _intercept_outgoing_messages_callback{nullptr};
 
     std::atomic<double> _timeout_s{Mavsdk::DEFAULT_TIMEOUT_S};
+    std::atomic<bool> _timeout_s_adaptive{true};
+
+    mutable std::mutex _param_cache_directory_mutex{};
+    std::string _param_cache_directory{};
 
     static constexpr double HEARTBEAT_SEND_INTERVAL_S = 1.0;
     void* _heartbeat_send_cookie{nullptr};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace mavsdk {
+
+/**
+ * A param id the way it is sent in MAVLink messages: up to 16 chars, zero
+ * padded, and not null terminated if all 16 are used.
+ *
+ * Unlike std::string it is stored inline, so creating and copying it never
+ * allocates, and its hash is calculated once when it is created.
+ */
+class ParamId {
+public:
+    static constexpr size_t MAX_LEN = 16;
+
+    ParamId() = default;
+
+    // Anything longer than MAX_LEN is cut off, so ids that are too long need
+    // to be rejected before.
+    ParamId(const char* id) : ParamId(id, std::strlen(id)) {}
+    ParamId(const std::string& id) : ParamId(id.data(), id.size()) {}
+
+    static ParamId from_message_buffer(const char* buffer)
+    {
+        size_t len = 0;
+        while (len < MAX_LEN && buffer[len] != '\0') {
+            ++len;
+        }
+        return ParamId{buffer, len};
+    }
+
+    [[nodiscard]] const std::array<char, MAX_LEN>& message_buffer() const { return _buffer; }
+
+    [[nodiscard]] const char* data() const { return _buffer.data(); }
+    [[nodiscard]] size_t size() const { return _len; }
+    [[nodiscard]] bool empty() const { return _len == 0; }
+
+    [[nodiscard]] std::string_view view() const { return {_buffer.data(), _len}; }
+    [[nodiscard]] std::string str() const { return std::string{view()}; }
+
+    [[nodiscard]] uint32_t hash() const { return _hash; }
+
+    friend bool operator==(const ParamId& lhs, const ParamId& rhs)
+    {
+        return lhs._hash == rhs._hash && lhs._len == rhs._len && lhs._buffer == rhs._buffer;
+    }
+
+    friend bool operator!=(const ParamId& lhs, const ParamId& rhs) { return !(lhs == rhs); }
+
+    friend std::ostream& operator<<(std::ostream& str, const ParamId& id)
+    {
+        return str << id.view();
+    }
+
+private:
+    // FNV-1a
+    static constexpr uint32_t HASH_OFFSET = 2166136261u;
+    static constexpr uint32_t HASH_PRIME = 16777619u;
+
+    ParamId(const char* id, size_t len) : _len(static_cast<uint8_t>(std::min(len, MAX_LEN)))
+    {
+        std::memcpy(_buffer.data(), id, _len);
+        for (size_t i = 0; i < _len; ++i) {
+            _hash = (_hash ^ static_cast<uint8_t>(_buffer[i])) * HASH_PRIME;
+        }
+    }
+
+    std::array<char, MAX_LEN> _buffer{};
+    uint8_t _len{0};
+    uint32_t _hash{HASH_OFFSET};
+};
+
+} // namespace mavsdk
+
+namespace std {
+
+template<> struct hash<mavsdk::ParamId> {
+    size_t operator()(const mavsdk::ParamId& id) const noexcept { return id.hash(); }
+};
+
+} // namespace std
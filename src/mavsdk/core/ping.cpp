@@ -65,6 +65,11 @@ void Ping::process_ping(const mavlink_message_t& message)
         }
 
         _last_ping_time_us = _system_impl.get_time().elapsed_us() - ping.time_usec;
+
+        // Every system's ping gets all replies, so only measure our own.
+        if (message.sysid == _system_impl.get_system_id()) {
+            _system_impl.rtt_estimator().add_sample(last_ping_time_s());
+        }
     }
 }
 
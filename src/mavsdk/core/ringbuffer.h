@@ -27,9 +27,16 @@ public:
         _storage[_index] = value;
     }
 
-    T& operator[](int index) { return _storage[(_index + index + 1) % N]; }
+    void clear()
+    {
+        _index = 0;
+        _size = 0;
+    }
+
+    // Index 0 is the oldest element.
+    T& operator[](int index) { return _storage[(_index + N + 1 - _size + index) % N]; }
 
-    const T& operator[](int index) const { return _storage[(_index + index + 1) % N]; }
+    const T& operator[](int index) const { return _storage[(_index + N + 1 - _size + index) % N]; }
 
     using iterator = RingbufferIterator<T, N>;
     using const_iterator = ConstRingbufferIterator<T, N>;
@@ -0,0 +1,73 @@
+#include "rtt_estimator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mavsdk {
+
+void RttEstimator::add_sample(double rtt_s)
+{
+    if (!std::isfinite(rtt_s) || rtt_s < 0.0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_has_sample) {
+        _srtt_s = rtt_s;
+        _rttvar_s = rtt_s / 2.0;
+        _has_sample = true;
+    } else {
+        _rttvar_s = (1.0 - BETA) * _rttvar_s + BETA * std::abs(_srtt_s - rtt_s);
+        _srtt_s = (1.0 - ALPHA) * _srtt_s + ALPHA * rtt_s;
+    }
+
+    _backoff_shift = 0;
+}
+
+void RttEstimator::backoff()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_backoff_shift < MAX_BACKOFF_SHIFT) {
+        ++_backoff_shift;
+    }
+}
+
+void RttEstimator::reset()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _has_sample = false;
+    _srtt_s = 0.0;
+    _rttvar_s = 0.0;
+    _backoff_shift = 0;
+}
+
+double RttEstimator::timeout_s(double initial_timeout_s) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const double timeout_s =
+        _has_sample ?
+            std::clamp(
+                _srtt_s + std::max(GRANULARITY_S, K * _rttvar_s), MIN_TIMEOUT_S, MAX_TIMEOUT_S) :
+            initial_timeout_s;
+
+    // Backing off never goes beyond the upper bound, unless the initial
+    // timeout is longer than that already.
+    return std::min(
+        timeout_s * static_cast<double>(1u << _backoff_shift),
+        std::max(MAX_TIMEOUT_S, timeout_s));
+}
+
+std::optional<double> RttEstimator::smoothed_rtt_s() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_has_sample) {
+        return std::nullopt;
+    }
+    return _srtt_s;
+}
+
+} // namespace mavsdk
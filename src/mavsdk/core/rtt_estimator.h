@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mutex>
+#include <optional>
+
+namespace mavsdk {
+
+// Estimates the round trip time to a system from replies to our requests,
+// and derives how long to wait for a reply before retransmitting, the same
+// way TCP does it (RFC 6298).
+class RttEstimator {
+public:
+    RttEstimator() = default;
+    ~RttEstimator() = default;
+
+    // Replies to requests that were retransmitted must not be added, as it
+    // is unknown which transmission they are a reply to.
+    void add_sample(double rtt_s);
+
+    // A reply did not arrive in time. The timeout is doubled until the next
+    // sample arrives, in case the round trip time has grown.
+    void backoff();
+
+    // Forget everything measured, e.g. when the link may have changed.
+    void reset();
+
+    // The timeout to wait for a reply. As long as nothing has been measured
+    // the given initial timeout is used instead of the estimate.
+    [[nodiscard]] double timeout_s(double initial_timeout_s) const;
+
+    [[nodiscard]] std::optional<double> smoothed_rtt_s() const;
+
+    RttEstimator(const RttEstimator&) = delete;
+    RttEstimator& operator=(const RttEstimator&) = delete;
+
+    // The lower bound leaves some room for processing on the other side, the
+    // upper bound still allows to notice a lost link in reasonable time.
+    static constexpr double MIN_TIMEOUT_S = 0.1;
+    static constexpr double MAX_TIMEOUT_S = 5.0;
+
+private:
+    static constexpr double ALPHA = 1.0 / 8.0;
+    static constexpr double BETA = 1.0 / 4.0;
+    static constexpr double K = 4.0;
+    static constexpr double GRANULARITY_S = 0.01;
+    static constexpr unsigned MAX_BACKOFF_SHIFT = 6;
+
+    mutable std::mutex _mutex{};
+    bool _has_sample{false};
+    double _srtt_s{0.0};
+    double _rttvar_s{0.0};
+    unsigned _backoff_shift{0};
+};
+
+} // namespace mavsdk
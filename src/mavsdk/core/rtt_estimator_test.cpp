@@ -0,0 +1,105 @@
+#include "rtt_estimator.h"
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(RttEstimator, InitialTimeoutWithoutSamples)
+{
+    RttEstimator estimator;
+
+    EXPECT_FALSE(estimator.smoothed_rtt_s());
+    EXPECT_DOUBLE_EQ(estimator.timeout_s(0.5), 0.5);
+    EXPECT_DOUBLE_EQ(estimator.timeout_s(0.2), 0.2);
+}
+
+TEST(RttEstimator, FirstSample)
+{
+    RttEstimator estimator;
+
+    estimator.add_sample(0.2);
+
+    ASSERT_TRUE(estimator.smoothed_rtt_s());
+    EXPECT_DOUBLE_EQ(estimator.smoothed_rtt_s().value(), 0.2);
+    // SRTT + 4 * RTTVAR with RTTVAR being half the first sample.
+    EXPECT_DOUBLE_EQ(estimator.timeout_s(0.5), 0.6);
+}
+
+TEST(RttEstimator, ConvergesToStableRtt)
+{
+    RttEstimator estimator;
+
+    for (unsigned i = 0; i < 100; ++i) {
+        estimator.add_sample(0.3);
+    }
+
+    EXPECT_NEAR(estimator.smoothed_rtt_s().value(), 0.3, 1e-9);
+    // The variance has decayed, so only the granularity is added on top.
+    EXPECT_NEAR(estimator.timeout_s(0.5), 0.31, 1e-3);
+}
+
+TEST(RttEstimator, FollowsJitter)
+{
+    RttEstimator stable;
+    RttEstimator jittery;
+
+    for (unsigned i = 0; i < 100; ++i) {
+        stable.add_sample(0.3);
+        jittery.add_sample(i % 2 == 0 ? 0.2 : 0.4);
+    }
+
+    EXPECT_NEAR(jittery.smoothed_rtt_s().value(), 0.3, 0.02);
+    EXPECT_GT(jittery.timeout_s(0.5), stable.timeout_s(0.5) + 0.2);
+}
+
+TEST(RttEstimator, BoundedTimeout)
+{
+    RttEstimator fast;
+    RttEstimator slow;
+
+    fast.add_sample(0.001);
+    slow.add_sample(10.0);
+
+    EXPECT_DOUBLE_EQ(fast.timeout_s(0.5), RttEstimator::MIN_TIMEOUT_S);
+    EXPECT_DOUBLE_EQ(slow.timeout_s(0.5), RttEstimator::MAX_TIMEOUT_S);
+}
+
+TEST(RttEstimator, IgnoresInvalidSamples)
+{
+    RttEstimator estimator;
+
+    estimator.add_sample(-1.0);
+    estimator.add_sample(NAN);
+
+    EXPECT_FALSE(estimator.smoothed_rtt_s());
+}
+
+TEST(RttEstimator, BackoffUntilNextSample)
+{
+    RttEstimator estimator;
+
+    estimator.backoff();
+    EXPECT_DOUBLE_EQ(estimator.timeout_s(0.5), 1.0);
+    estimator.backoff();
+    EXPECT_DOUBLE_EQ(estimator.timeout_s(0.5), 2.0);
+
+    for (unsigned i = 0; i < 10; ++i) {
+        estimator.backoff();
+    }
+    EXPECT_DOUBLE_EQ(estimator.timeout_s(0.5), RttEstimator::MAX_TIMEOUT_S);
+
+    estimator.add_sample(0.2);
+    EXPECT_DOUBLE_EQ(estimator.timeout_s(0.5), 0.6);
+}
+
+TEST(RttEstimator, Reset)
+{
+    RttEstimator estimator;
+
+    estimator.add_sample(0.2);
+    estimator.backoff();
+    estimator.reset();
+
+    EXPECT_FALSE(estimator.smoothed_rtt_s());
+    EXPECT_DOUBLE_EQ(estimator.timeout_s(0.5), 0.5);
+}
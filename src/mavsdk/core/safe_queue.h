@@ -1,7 +1,9 @@
 #pragma once
 
-#include <queue>
+#include <cstddef>
 #include <mutex>
+#include <utility>
+#include <vector>
 #include <optional>
 #include <condition_variable>
 #include <cstdio>
@@ -11,6 +13,9 @@ namespace mavsdk {
 /*
  * Thread-safe queue taken from:
  * http://stackoverflow.com/questions/15278343/c11-thread-safe-queue#answer-16075550
+ *
+ * The items are kept in a ring buffer which only ever grows, so a queue which
+ * has reached its working size no longer allocates.
  */
 
 template<class T> class SafeQueue {
@@ -21,14 +26,18 @@ public:
     void enqueue(T item)
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        _queue.push(item);
+        if (_size == _buffer.size()) {
+            grow();
+        }
+        _buffer[(_head + _size) % _buffer.size()] = std::move(item);
+        ++_size;
         _condition_var.notify_one();
     }
 
     std::optional<T> dequeue()
     {
         std::unique_lock<std::mutex> lock(_mutex);
-        while (_queue.empty()) {
+        while (_size == 0) {
             if (_should_exit) {
                 return std::nullopt;
             }
@@ -38,9 +47,12 @@ public:
         if (_should_exit) {
             return std::nullopt;
         } else {
-            T item = _queue.front();
-            _queue.pop();
-            return {item};
+            T item = std::move(_buffer[_head]);
+            // Don't hold on to whatever the item owns.
+            _buffer[_head] = T{};
+            _head = (_head + 1) % _buffer.size();
+            --_size;
+            return {std::move(item)};
         }
     }
 
@@ -56,11 +68,25 @@ public:
     std::size_t size() const
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        return _queue.size();
+        return _size;
     }
 
 private:
-    std::queue<T> _queue{};
+    void grow()
+    {
+        std::vector<T> buffer(_buffer.empty() ? INITIAL_CAPACITY : _buffer.size() * 2);
+        for (std::size_t i = 0; i < _size; ++i) {
+            buffer[i] = std::move(_buffer[(_head + i) % _buffer.size()]);
+        }
+        _buffer.swap(buffer);
+        _head = 0;
+    }
+
+    static constexpr std::size_t INITIAL_CAPACITY = 16;
+
+    std::vector<T> _buffer{};
+    std::size_t _head{0};
+    std::size_t _size{0};
     mutable std::mutex _mutex{};
     std::condition_variable _condition_var{};
     bool _should_exit{false};
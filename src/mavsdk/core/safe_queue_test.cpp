@@ -44,3 +44,24 @@ TEST(SafeQueue, StopEarly)
     safe_queue.stop();
     EXPECT_EQ(safe_queue.dequeue(), std::nullopt);
 }
+
+TEST(SafeQueue, KeepsOrderWhenGrowing)
+{
+    SafeQueue<int> safe_queue{};
+
+    // Move the start around the buffer before it needs to grow.
+    for (int i = 0; i < 10; ++i) {
+        safe_queue.enqueue(i);
+        EXPECT_EQ(safe_queue.dequeue().value(), i);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        safe_queue.enqueue(i);
+    }
+    ASSERT_EQ(safe_queue.size(), 100);
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(safe_queue.dequeue().value(), i);
+    }
+    EXPECT_EQ(safe_queue.size(), 0);
+}
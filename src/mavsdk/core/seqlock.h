@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace mavsdk {
+
+// Holds a value which is read a lot more often than it is written, e.g. the
+// latest telemetry. Readers never take a lock and never hold up a writer, they
+// just try again if a write happened while they were copying the value out.
+//
+// The value is kept in atomic words rather than as T, so the concurrent copies
+// are not data races, see Hans Boehm, "Can Seqlocks Get Along With
+// Programming Language Memory Models?".
+template<typename T> class Seqlock {
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock needs a trivially copyable type");
+
+    Seqlock() : Seqlock(T{}) {}
+    explicit Seqlock(const T& value) { store_words(value); }
+
+    ~Seqlock() = default;
+
+    // delete copy and move constructors and assign operators
+    Seqlock(Seqlock const&) = delete; // Copy construct
+    Seqlock(Seqlock&&) = delete; // Move construct
+    Seqlock& operator=(Seqlock const&) = delete; // Copy assign
+    Seqlock& operator=(Seqlock&&) = delete; // Move assign
+
+    [[nodiscard]] T load() const
+    {
+        while (true) {
+            const uint64_t before = _sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                // A write is in progress.
+                std::this_thread::yield();
+                continue;
+            }
+
+            // The acquire loads keep the second sequence load below from
+            // moving up, so any write that overlapped with the copy is seen.
+            std::array<uint64_t, NUM_WORDS> words;
+            for (size_t i = 0; i < NUM_WORDS; ++i) {
+                words[i] = _words[i].load(std::memory_order_acquire);
+            }
+
+            if (_sequence.load(std::memory_order_relaxed) == before) {
+                T value;
+                std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+                return value;
+            }
+        }
+    }
+
+    void store(const T& value)
+    {
+        update([&](T& current) { current = value; });
+    }
+
+    // Changes part of the value. Concurrent writers are serialized, so this
+    // does not lose updates done in the meantime.
+    template<typename F> void update(F&& func)
+    {
+        const uint64_t sequence = begin_write();
+
+        std::array<uint64_t, NUM_WORDS> words;
+        for (size_t i = 0; i < NUM_WORDS; ++i) {
+            words[i] = _words[i].load(std::memory_order_relaxed);
+        }
+        T value;
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+
+        func(value);
+
+        store_words(value);
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+private:
+    static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    uint64_t begin_write()
+    {
+        uint64_t sequence = _sequence.load(std::memory_order_relaxed);
+        while (true) {
+            // Writers only ever wait for another writer, never for readers.
+            if (sequence & 1) {
+                std::this_thread::yield();
+                sequence = _sequence.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (_sequence.compare_exchange_weak(
+                    sequence, sequence + 1, std::memory_order_acquire)) {
+                return sequence;
+            }
+        }
+    }
+
+    void store_words(const T& value)
+    {
+        std::array<uint64_t, NUM_WORDS> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        // Release, so a reader which sees a new word also sees the odd
+        // sequence stored before it.
+        for (size_t i = 0; i < NUM_WORDS; ++i) {
+            _words[i].store(words[i], std::memory_order_release);
+        }
+    }
+
+    std::atomic<uint64_t> _sequence{0};
+    std::array<std::atomic<uint64_t>, NUM_WORDS> _words{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,79 @@
+#include "seqlock.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+struct SeqlockTestValue {
+    double a{0.0};
+    double b{0.0};
+    uint32_t c{0};
+    uint8_t d{0};
+};
+
+TEST(Seqlock, StoreAndLoad)
+{
+    Seqlock<SeqlockTestValue> seqlock;
+    EXPECT_EQ(seqlock.load().c, 0u);
+
+    seqlock.store(SeqlockTestValue{1.0, 2.0, 3, 4});
+    const auto value = seqlock.load();
+    EXPECT_DOUBLE_EQ(value.a, 1.0);
+    EXPECT_DOUBLE_EQ(value.b, 2.0);
+    EXPECT_EQ(value.c, 3u);
+    EXPECT_EQ(value.d, 4u);
+
+    seqlock.update([](SeqlockTestValue& current) { current.d = 42; });
+    EXPECT_DOUBLE_EQ(seqlock.load().a, 1.0);
+    EXPECT_EQ(seqlock.load().d, 42u);
+}
+
+TEST(Seqlock, ReadersNeverSeeTornValues)
+{
+    Seqlock<SeqlockTestValue> seqlock;
+    std::atomic<bool> done{false};
+    std::atomic<unsigned> num_torn{0};
+
+    // All fields of a stored value are equal, so a mix of two writes shows up
+    // as a mismatch.
+    std::vector<std::thread> readers;
+    for (unsigned i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                const auto value = seqlock.load();
+                if (value.a != value.b || static_cast<uint32_t>(value.a) != value.c ||
+                    static_cast<uint8_t>(value.c) != value.d) {
+                    ++num_torn;
+                }
+            }
+        });
+    }
+
+    // Two writers, to make sure they don't lose each other's updates.
+    auto writer = [&]() {
+        for (uint32_t i = 1; i <= 100000; ++i) {
+            seqlock.update([&](SeqlockTestValue& current) {
+                const uint32_t next = current.c + 1;
+                current.a = next;
+                current.b = next;
+                current.c = next;
+                current.d = static_cast<uint8_t>(next);
+            });
+        }
+    };
+    std::thread first_writer(writer);
+    std::thread second_writer(writer);
+    first_writer.join();
+    second_writer.join();
+
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(num_torn, 0u);
+    EXPECT_EQ(seqlock.load().c, 200000u);
+}
@@ -8,13 +8,13 @@ ServerComponentImpl::ServerComponentImpl(MavsdkImpl& mavsdk_impl, uint8_t compon
     _mavsdk_impl(mavsdk_impl),
     _own_component_id(component_id),
     _our_sender(mavsdk_impl, *this),
-    _mavlink_command_receiver(mavsdk_impl),
+    _mavlink_command_receiver(mavsdk_impl, *this),
     _mission_transfer(
         _our_sender,
         mavsdk_impl.mavlink_message_handler,
         mavsdk_impl.timeout_handler,
         [this]() { return _mavsdk_impl.timeout_s(); }),
-    _mavlink_parameter_server(_our_sender, mavsdk_impl.mavlink_message_handler),
+    _mavlink_parameter_server(_our_sender, mavsdk_impl.mavlink_message_handler, mavsdk_impl.time),
     _mavlink_request_message_handler(mavsdk_impl, *this, _mavlink_command_receiver)
 {
     register_mavlink_command_handler(
@@ -40,6 +40,13 @@ ServerComponentImpl::ServerComponentImpl(MavsdkImpl& mavsdk_impl, uint8_t compon
             return MAV_RESULT_ACCEPTED;
         },
         this);
+
+    // Commands are handled as they are received, the rest is done by
+    // do_work() on the work thread of MavsdkImpl.
+    _mission_transfer.set_work_available_callback(
+        [this]() { _mavsdk_impl.notify_server_component_work_available(); });
+    _mavlink_parameter_server.set_work_available_callback(
+        [this]() { _mavsdk_impl.notify_server_component_work_available(); });
 }
 
 ServerComponentImpl::~ServerComponentImpl()
@@ -108,10 +115,13 @@ void ServerComponentImpl::unregister_all_mavlink_message_handlers(const void* co
     _mavsdk_impl.mavlink_message_handler.unregister_all(cookie);
 }
 
-void ServerComponentImpl::do_work()
+SteadyTimePoint ServerComponentImpl::do_work()
 {
     _mavlink_parameter_server.do_work();
     _mission_transfer.do_work();
+
+    // Sending params is paced, so there might be some left to send later.
+    return _mavlink_parameter_server.next_work_time();
 }
 
 uint8_t ServerComponentImpl::get_own_system_id() const
@@ -247,7 +257,13 @@ uint32_t ServerComponentImpl::get_custom_mode() const
 }
 
 void ServerComponentImpl::call_user_callback_located(
-    const std::string& filename, const int linenumber, const std::function<void()>& func)
+    const char* filename, const int linenumber, const std::function<void()>& func)
+{
+    _mavsdk_impl.call_user_callback_located(filename, linenumber, func);
+}
+
+void ServerComponentImpl::call_user_callback_located(
+    const char* filename, const int linenumber, const QueuedCallback& func)
 {
     _mavsdk_impl.call_user_callback_located(filename, linenumber, func);
 }
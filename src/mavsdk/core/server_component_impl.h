@@ -1,5 +1,6 @@
 #pragma once
 
+#include "callback_list.h"
 #include "mavlink_include.h"
 #include "mavlink_command_receiver.h"
 #include "mavlink_mission_transfer.h"
@@ -120,7 +121,9 @@ public:
     [[nodiscard]] uint32_t get_custom_mode() const;
 
     void call_user_callback_located(
-        const std::string& filename, const int linenumber, const std::function<void()>& func);
+        const char* filename, int linenumber, const std::function<void()>& func);
+    void call_user_callback_located(
+        const char* filename, int linenumber, const QueuedCallback& func);
 
     // Autopilot version data
     void add_capabilities(uint64_t capabilities);
@@ -140,7 +143,8 @@ public:
         return _mavlink_request_message_handler;
     }
 
-    void do_work();
+    // Returns when it needs to run again, other than when work is signalled.
+    SteadyTimePoint do_work();
 
 private:
     MavsdkImpl& _mavsdk_impl;
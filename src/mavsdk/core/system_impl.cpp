@@ -6,12 +6,18 @@
 #include "px4_custom_mode.h"
 #include "ardupilot_custom_mode.h"
 #include "request_message.h"
+#include "fs.h"
 #include "callback_list.tpp"
 #include "unused.h"
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <fstream>
 #include <functional>
 #include <future>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
 #include <utility>
 
 namespace mavsdk {
@@ -35,23 +41,18 @@ SystemImpl::SystemImpl(MavsdkImpl& parent) :
         *this, _command_sender, _mavsdk_impl.mavlink_message_handler, _mavsdk_impl.timeout_handler),
     _mavlink_ftp(*this)
 {
-    _system_thread = new std::thread(&SystemImpl::system_thread, this);
+    _command_sender.set_work_available_callback([this]() { notify_work_available(); });
+    _mission_transfer.set_work_available_callback([this]() { notify_work_available(); });
 }
 
 SystemImpl::~SystemImpl()
 {
-    _should_exit = true;
+    _mavsdk_impl.worker_pool.remove(_worker_pool_cookie);
     _mavsdk_impl.mavlink_message_handler.unregister_all(this);
 
     if (!_always_connected) {
         unregister_timeout_handler(_heartbeat_timeout_cookie);
     }
-
-    if (_system_thread != nullptr) {
-        _system_thread->join();
-        delete _system_thread;
-        _system_thread = nullptr;
-    }
 }
 
 void SystemImpl::init(uint8_t system_id, uint8_t comp_id, bool connected)
@@ -96,6 +97,9 @@ void SystemImpl::init(uint8_t system_id, uint8_t comp_id, bool connected)
     //    this);
 
     add_new_component(comp_id);
+
+    // The work of a system always runs on the same worker thread.
+    _mavsdk_impl.worker_pool.add([this]() { return do_work(); }, &_worker_pool_cookie, system_id);
 }
 
 bool SystemImpl::is_connected() const
@@ -149,12 +153,22 @@ void SystemImpl::unregister_timeout_handler(const void* cookie)
 
 double SystemImpl::timeout_s() const
 {
-    return _mavsdk_impl.timeout_s();
+    return timeout_s(_mavsdk_impl.timeout_s());
+}
+
+double SystemImpl::timeout_s(double initial_timeout_s) const
+{
+    // A timeout set by the user applies to all protocols.
+    if (!_mavsdk_impl.timeout_s_adaptive()) {
+        return _mavsdk_impl.timeout_s();
+    }
+    return _rtt_estimator.timeout_s(initial_timeout_s);
 }
 
 void SystemImpl::enable_timesync()
 {
     _timesync.enable();
+    notify_work_available();
 }
 
 System::IsConnectedHandle
@@ -270,6 +284,29 @@ void SystemImpl::process_autopilot_version(const mavlink_message_t& message)
 
     _mission_transfer.set_int_messages_supported(
         autopilot_version.capabilities & MAV_PROTOCOL_CAPABILITY_MISSION_INT);
+
+    if (message.sysid != get_system_id() || message.compid != MAV_COMP_ID_AUTOPILOT1) {
+        return;
+    }
+
+    _autopilot_ftp_supported = (autopilot_version.capabilities & MAV_PROTOCOL_CAPABILITY_FTP) != 0;
+
+    // Autopilots that don't have the 8 byte uid might have the longer one.
+    std::stringstream uid;
+    uid << std::hex << std::setfill('0');
+    if (autopilot_version.uid != 0) {
+        uid << std::setw(16) << autopilot_version.uid;
+    } else if (std::any_of(
+                   std::begin(autopilot_version.uid2),
+                   std::end(autopilot_version.uid2),
+                   [](uint8_t byte) { return byte != 0; })) {
+        for (const auto byte : autopilot_version.uid2) {
+            uid << std::setw(2) << static_cast<unsigned>(byte);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_autopilot_uid_mutex);
+    _autopilot_uid = uid.str();
 }
 
 void SystemImpl::heartbeats_timed_out()
@@ -278,36 +315,35 @@ void SystemImpl::heartbeats_timed_out()
     set_disconnected();
 }
 
-void SystemImpl::system_thread()
+SteadyTimePoint SystemImpl::do_work()
 {
-    SteadyTimePoint last_ping_time{};
-
-    while (!_should_exit) {
-        {
-            std::lock_guard<std::mutex> lock(_mavlink_parameter_clients_mutex);
-            for (auto& entry : _mavlink_parameter_clients) {
-                entry.parameter_client->do_work();
-            }
-        }
-        _command_sender.do_work();
-        _timesync.do_work();
-        _mission_transfer.do_work();
-
-        if (_mavsdk_impl.time.elapsed_since_s(last_ping_time) >= SystemImpl::_ping_interval_s) {
-            if (_connected) {
-                _ping.run_once();
-            }
-            last_ping_time = _mavsdk_impl.time.steady_time();
+    {
+        std::lock_guard<std::mutex> lock(_mavlink_parameter_clients_mutex);
+        for (auto& entry : _mavlink_parameter_clients) {
+            entry.parameter_client->do_work();
         }
+    }
+    _command_sender.do_work();
+    _timesync.do_work();
+    _mission_transfer.do_work();
 
+    if (_mavsdk_impl.time.elapsed_since_s(_last_ping_time) >= SystemImpl::_ping_interval_s) {
         if (_connected) {
-            // Work fairly fast if we're connected.
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        } else {
-            // Be less aggressive when unconnected.
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            _ping.run_once();
         }
+        _last_ping_time = _mavsdk_impl.time.steady_time();
     }
+
+    // Other than that, we only need to run again when something has been
+    // queued or finished, which is signalled separately.
+    auto next_ping_time = _last_ping_time;
+    Time::shift_steady_time_by(next_ping_time, SystemImpl::_ping_interval_s);
+    return std::min(next_ping_time, _timesync.next_work_time());
+}
+
+void SystemImpl::notify_work_available()
+{
+    _mavsdk_impl.worker_pool.signal(_worker_pool_cookie);
 }
 
 // std::optional<mavlink_message_t>
@@ -608,6 +644,14 @@ void SystemImpl::set_disconnected()
         //_heartbeat_timeout_cookie = nullptr;
 
         _connected = false;
+        // The link might be a different one once we are reconnected.
+        _rtt_estimator.reset();
+        // And it might even be a different vehicle.
+        {
+            std::lock_guard<std::mutex> uid_lock(_autopilot_uid_mutex);
+            _autopilot_uid.clear();
+        }
+        _autopilot_ftp_supported = false;
         _mavsdk_impl.notify_on_timeout();
         _is_connected_callbacks.queue(
             false, [this](const auto& func) { _mavsdk_impl.call_user_callback(func); });
@@ -735,6 +779,17 @@ void SystemImpl::set_param_int_async(
         ->set_param_int_async(name, value, callback, cookie);
 }
 
+void SystemImpl::set_param_custom_async(
+    const std::string& name,
+    const std::string& value,
+    const SetParamCallback& callback,
+    const void* cookie,
+    std::optional<uint8_t> maybe_component_id)
+{
+    param_sender(maybe_component_id ? maybe_component_id.value() : 1, true)
+        ->set_param_custom_async(name, value, callback, cookie);
+}
+
 std::pair<MavlinkParameterClient::Result, float> SystemImpl::get_param_float(
     const std::string& name, std::optional<uint8_t> maybe_component_id, bool extended)
 {
@@ -791,9 +846,13 @@ void SystemImpl::get_param_int_async(
 }
 
 void SystemImpl::get_param_custom_async(
-    const std::string& name, const GetParamCustomCallback& callback, const void* cookie)
+    const std::string& name,
+    const GetParamCustomCallback& callback,
+    const void* cookie,
+    std::optional<uint8_t> maybe_component_id)
 {
-    param_sender(1, false)->get_param_custom_async(name, callback, cookie);
+    param_sender(maybe_component_id ? maybe_component_id.value() : 1, true)
+        ->get_param_custom_async(name, callback, cookie);
 }
 
 void SystemImpl::cancel_all_param(const void* cookie)
@@ -1195,6 +1254,52 @@ void SystemImpl::set_msg_rate_async(
     send_command_async(command, callback);
 }
 
+void SystemImpl::set_msg_rates_async(
+    const std::vector<std::pair<uint16_t, double>>& message_rates,
+    const CommandResultCallback& callback,
+    uint8_t component_id)
+{
+    if (message_rates.empty()) {
+        if (callback) {
+            callback(MavlinkCommandSender::Result::Success, NAN);
+        }
+        return;
+    }
+
+    struct Batch {
+        std::mutex mutex{};
+        size_t remaining{0};
+        MavlinkCommandSender::Result result{MavlinkCommandSender::Result::Success};
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->remaining = message_rates.size();
+
+    for (const auto& [message_id, rate_hz] : message_rates) {
+        send_command_async(
+            make_command_msg_rate(message_id, rate_hz, component_id),
+            [batch, callback](MavlinkCommandSender::Result result, float) {
+                if (result == MavlinkCommandSender::Result::InProgress) {
+                    return;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(batch->mutex);
+                    if (result != MavlinkCommandSender::Result::Success &&
+                        batch->result == MavlinkCommandSender::Result::Success) {
+                        batch->result = result;
+                    }
+                    if (--batch->remaining > 0) {
+                        return;
+                    }
+                }
+
+                if (callback) {
+                    callback(batch->result, NAN);
+                }
+            });
+    }
+}
+
 MavlinkCommandSender::CommandLong
 SystemImpl::make_command_msg_rate(uint16_t message_id, double rate_hz, uint8_t component_id)
 {
@@ -1242,6 +1347,11 @@ void SystemImpl::unregister_plugin(PluginImplBase* plugin_impl)
     plugin_impl->disable();
     plugin_impl->deinit();
 
+    // The timeouts and periodic calls of the plugin are removed now, but one
+    // of them might still be running on the work thread.
+    _mavsdk_impl.timeout_handler.wait_for_callback();
+    _mavsdk_impl.call_every_handler.wait_for_callback();
+
     // Remove first, so it won't get enabled/disabled anymore.
     {
         std::lock_guard<std::mutex> lock(_plugin_impls_mutex);
@@ -1253,7 +1363,13 @@ void SystemImpl::unregister_plugin(PluginImplBase* plugin_impl)
 }
 
 void SystemImpl::call_user_callback_located(
-    const std::string& filename, const int linenumber, const std::function<void()>& func)
+    const char* filename, const int linenumber, const std::function<void()>& func)
+{
+    _mavsdk_impl.call_user_callback_located(filename, linenumber, func);
+}
+
+void SystemImpl::call_user_callback_located(
+    const char* filename, const int linenumber, const QueuedCallback& func)
 {
     _mavsdk_impl.call_user_callback_located(filename, linenumber, func);
 }
@@ -1346,7 +1462,91 @@ MavlinkParameterClient* SystemImpl::param_sender(uint8_t component_id, bool exte
          component_id,
          extended});
 
-    return _mavlink_parameter_clients.back().parameter_client.get();
+    auto* parameter_client = _mavlink_parameter_clients.back().parameter_client.get();
+    parameter_client->set_work_available_callback([this]() { notify_work_available(); });
+    parameter_client->set_call_user_callback(
+        [this](const std::function<void()>& func) { call_user_callback(func); });
+    parameter_client->set_cache_file_path_callback(
+        [this, component_id]() { return param_cache_file_path(component_id); });
+    parameter_client->set_file_downloader(
+        [this, component_id](const std::string& remote_path, const auto& callback) {
+            return download_param_file(component_id, remote_path, callback);
+        });
+
+    return parameter_client;
+}
+
+std::optional<std::string> SystemImpl::param_cache_file_path(uint8_t component_id)
+{
+    const auto directory = _mavsdk_impl.param_cache_directory();
+    if (directory.empty()) {
+        return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lock(_autopilot_uid_mutex);
+    if (_autopilot_uid.empty()) {
+        return std::nullopt;
+    }
+
+    return directory + path_separator + "params_" + _autopilot_uid + "_" +
+           std::to_string(component_id) + ".bin";
+}
+
+bool SystemImpl::download_param_file(
+    uint8_t component_id,
+    const std::string& remote_path,
+    const MavlinkParameterClient::FileDownloadResultCallback& callback)
+{
+    // MAVLink FTP is only used with the autopilot.
+    if (!_autopilot_ftp_supported || component_id != get_autopilot_id()) {
+        return false;
+    }
+
+    auto maybe_tmp_directory = create_tmp_directory("mavsdk-param-download");
+    if (!maybe_tmp_directory) {
+        return false;
+    }
+    const auto tmp_directory = maybe_tmp_directory.value();
+    const auto local_path = tmp_directory + path_separator + fs_filename(remote_path);
+
+    _mavlink_ftp.download_async(
+        remote_path,
+        tmp_directory,
+        [tmp_directory, local_path, callback](
+            MavlinkFtp::ClientResult result, MavlinkFtp::ProgressData) {
+            using FileDownloadResult = MavlinkParameterClient::FileDownloadResult;
+
+            if (result == MavlinkFtp::ClientResult::Next) {
+                return;
+            }
+
+            std::vector<uint8_t> content;
+            if (result == MavlinkFtp::ClientResult::Success) {
+                std::ifstream file(local_path, std::ios::binary);
+                content.assign(
+                    std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+            fs_remove(local_path);
+            fs_remove(tmp_directory);
+
+            switch (result) {
+                case MavlinkFtp::ClientResult::Success:
+                    callback(FileDownloadResult::Success, std::move(content));
+                    break;
+                case MavlinkFtp::ClientResult::Timeout:
+                case MavlinkFtp::ClientResult::Busy:
+                case MavlinkFtp::ClientResult::FileIoError:
+                case MavlinkFtp::ClientResult::NoSystem:
+                    // Worth trying again next time.
+                    callback(FileDownloadResult::Failed, {});
+                    break;
+                default:
+                    // PX4, for instance, doesn't have the file.
+                    callback(FileDownloadResult::Unsupported, {});
+                    break;
+            }
+        });
+    return true;
 }
 
 } // namespace mavsdk
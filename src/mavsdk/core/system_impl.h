@@ -12,6 +12,7 @@
 #include "mavlink_request_message_handler.h"
 #include "mavlink_statustext_handler.h"
 #include "request_message.h"
+#include "rtt_estimator.h"
 #include "ardupilot_custom_mode.h"
 #include "ping.h"
 #include "timeout_handler.h"
@@ -21,6 +22,7 @@
 #include <cstdint>
 #include <functional>
 #include <atomic>
+#include <utility>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -98,6 +100,14 @@ public:
         const CommandResultCallback& callback,
         uint8_t maybe_component_id = MAV_COMP_ID_AUTOPILOT1);
 
+    // Sets the rates of several messages at once. The commands are all sent
+    // without waiting for each other's ack, and the callback is called once
+    // with the first failure, or success if all of them succeeded.
+    void set_msg_rates_async(
+        const std::vector<std::pair<uint16_t, double>>& message_rates,
+        const CommandResultCallback& callback,
+        uint8_t maybe_component_id = MAV_COMP_ID_AUTOPILOT1);
+
     // Adds unique component ids
     void add_new_component(uint8_t component_id);
     size_t total_components() const;
@@ -175,6 +185,13 @@ public:
         std::optional<uint8_t> maybe_component_id = {},
         bool extended = false);
 
+    void set_param_custom_async(
+        const std::string& name,
+        const std::string& value,
+        const SetParamCallback& callback,
+        const void* cookie,
+        std::optional<uint8_t> maybe_component_id = {});
+
     FlightMode get_flight_mode() const;
 
     MavlinkCommandSender::Result
@@ -228,7 +245,10 @@ public:
         std::optional<uint8_t> maybe_component_id = {},
         bool extended = false);
     void get_param_custom_async(
-        const std::string& name, const GetParamCustomCallback& callback, const void* cookie);
+        const std::string& name,
+        const GetParamCustomCallback& callback,
+        const void* cookie,
+        std::optional<uint8_t> maybe_component_id = {});
 
     void set_param_async(
         const std::string& name,
@@ -272,7 +292,9 @@ public:
     void unregister_plugin(PluginImplBase* plugin_impl);
 
     void call_user_callback_located(
-        const std::string& filename, int linenumber, const std::function<void()>& func);
+        const char* filename, int linenumber, const std::function<void()>& func);
+    void call_user_callback_located(
+        const char* filename, int linenumber, const QueuedCallback& func);
 
     void send_autopilot_version_request();
     void send_autopilot_version_request_async(
@@ -289,7 +311,14 @@ public:
     SystemImpl(const SystemImpl&) = delete;
     const SystemImpl& operator=(const SystemImpl&) = delete;
 
+    // Timeout to wait for replies of this system, derived from the round trip
+    // time once it is measured, or the one set with Mavsdk::set_timeout_s().
+    // The second version is for protocols that use a different initial
+    // timeout than the one configured for Mavsdk.
     double timeout_s() const;
+    double timeout_s(double initial_timeout_s) const;
+
+    RttEstimator& rtt_estimator() { return _rtt_estimator; }
 
 private:
     static bool is_autopilot(uint8_t comp_id);
@@ -308,7 +337,8 @@ private:
     static std::string component_name(uint8_t component_id);
     static System::ComponentType component_type(uint8_t component_id);
 
-    void system_thread();
+    SteadyTimePoint do_work();
+    void notify_work_available();
 
     std::pair<MavlinkCommandSender::Result, MavlinkCommandSender::CommandLong>
     make_command_flight_mode(FlightMode mode, uint8_t component_id);
@@ -347,6 +377,11 @@ private:
     MavlinkStatustextHandler _statustext_handler{};
 
     MavlinkParameterClient* param_sender(uint8_t component_id, bool extended);
+    std::optional<std::string> param_cache_file_path(uint8_t component_id);
+    bool download_param_file(
+        uint8_t component_id,
+        const std::string& remote_path,
+        const MavlinkParameterClient::FileDownloadResultCallback& callback);
 
     struct StatustextCallback {
         std::function<void(const MavlinkStatustextHandler::Statustext&)> callback;
@@ -363,8 +398,9 @@ private:
 
     MavsdkImpl& _mavsdk_impl;
 
-    std::thread* _system_thread{nullptr};
-    std::atomic<bool> _should_exit{false};
+    // Our do_work() is run on the worker pool shared by all systems.
+    void* _worker_pool_cookie{nullptr};
+    SteadyTimePoint _last_ping_time{};
 
     static constexpr double HEARTBEAT_TIMEOUT_S = 3.0;
 
@@ -375,8 +411,17 @@ private:
 
     std::atomic<bool> _autopilot_version_pending{false};
 
+    // Identifies the vehicle across connections, for caching its params.
+    std::mutex _autopilot_uid_mutex{};
+    std::string _autopilot_uid{};
+
+    std::atomic<bool> _autopilot_ftp_supported{false};
+
     static constexpr double _ping_interval_s = 5.0;
 
+    // Fed by ping, timesync and command acks.
+    RttEstimator _rtt_estimator{};
+
     struct ParamSenderEntry {
         std::unique_ptr<MavlinkParameterClient> parameter_client;
         uint8_t component_id;
@@ -1,26 +1,31 @@
 #include "timeout_handler.h"
 
+#include <utility>
+
 namespace mavsdk {
 
 TimeoutHandler::TimeoutHandler(Time& time) : _time(time) {}
 
 void TimeoutHandler::add(std::function<void()> callback, double duration_s, void** cookie)
 {
-    auto new_timeout = std::make_shared<Timeout>();
-    new_timeout->callback = callback;
-    new_timeout->time = _time.steady_time_in_future(duration_s);
+    auto new_timeout = std::make_unique<Timeout>();
+    new_timeout->callback = std::move(callback);
     new_timeout->duration_s = duration_s;
 
     void* new_cookie = static_cast<void*>(new_timeout.get());
+    const auto deadline = _time.steady_time_in_future(duration_s);
 
     {
         std::lock_guard<std::mutex> lock(_timeouts_mutex);
-        _timeouts.insert(std::pair<void*, std::shared_ptr<Timeout>>(new_cookie, new_timeout));
+        _timer_wheel.schedule(*new_timeout, deadline);
+        _timeouts.emplace(new_cookie, std::move(new_timeout));
     }
 
     if (cookie != nullptr) {
         *cookie = new_cookie;
     }
+
+    notify_wakeup(deadline);
 }
 
 void TimeoutHandler::refresh(const void* cookie)
@@ -29,12 +34,19 @@ void TimeoutHandler::refresh(const void* cookie)
         return;
     }
 
-    std::lock_guard<std::mutex> lock(_timeouts_mutex);
+    std::optional<SteadyTimePoint> deadline;
+    {
+        std::lock_guard<std::mutex> lock(_timeouts_mutex);
 
-    auto it = _timeouts.find(const_cast<void*>(cookie));
-    if (it != _timeouts.end()) {
-        auto future_time = _time.steady_time_in_future(it->second->duration_s);
-        it->second->time = future_time;
+        auto it = _timeouts.find(const_cast<void*>(cookie));
+        if (it != _timeouts.end()) {
+            deadline = _time.steady_time_in_future(it->second->duration_s);
+            _timer_wheel.schedule(*it->second, deadline.value());
+        }
+    }
+
+    if (deadline) {
+        notify_wakeup(deadline.value());
     }
 }
 
@@ -48,44 +60,70 @@ void TimeoutHandler::remove(const void* cookie)
 
     auto it = _timeouts.find(const_cast<void*>(cookie));
     if (it != _timeouts.end()) {
-        _timeouts.erase(const_cast<void*>(cookie));
-        _iterator_invalidated = true;
+        _timer_wheel.cancel(*it->second);
+        _timeouts.erase(it);
     }
 }
 
 void TimeoutHandler::run_once()
 {
-    _timeouts_mutex.lock();
+    std::unique_lock<std::mutex> lock(_timeouts_mutex);
 
-    auto now = _time.steady_time();
+    const auto now = _time.steady_time();
 
-    for (auto it = _timeouts.begin(); it != _timeouts.end(); /* no ++it */) {
-        // If time is passed, call timeout callback.
-        if (it->second->time < now) {
-            if (it->second->callback) {
-                // Get a copy for the callback because we will remove it.
-                std::function<void()> callback = it->second->callback;
+    // We take the expired timeouts out one by one because the lock is released
+    // during the callback and timeouts might get added or removed meanwhile.
+    while (auto* timer = _timer_wheel.pop_expired(now)) {
+        auto it = _timeouts.find(static_cast<void*>(static_cast<Timeout*>(timer)));
+        if (it == _timeouts.end()) {
+            continue;
+        }
 
-                // Self-destruct before calling to avoid locking issues.
-                _timeouts.erase(it++);
+        // Get the callback out because we self-destruct before calling to
+        // avoid locking issues.
+        std::function<void()> callback = std::move(it->second->callback);
+        _timeouts.erase(it);
+
+        if (callback) {
+            // Unlock while we callback because it might in turn want to add timeouts.
+            _calling = true;
+            _calling_thread_id = std::this_thread::get_id();
+            lock.unlock();
+            callback();
+            lock.lock();
+            _calling = false;
+            _callback_done_cv.notify_all();
+        }
+    }
+}
 
-                // Unlock while we callback because it might in turn want to add timeouts.
-                _timeouts_mutex.unlock();
-                callback();
-                _timeouts_mutex.lock();
-            }
+void TimeoutHandler::wait_for_callback()
+{
+    std::unique_lock<std::mutex> lock(_timeouts_mutex);
+    if (_calling && _calling_thread_id == std::this_thread::get_id()) {
+        return;
+    }
+    _callback_done_cv.wait(lock, [this]() { return !_calling; });
+}
 
-        } else {
-            ++it;
-        }
+std::optional<SteadyTimePoint> TimeoutHandler::next_wakeup()
+{
+    std::lock_guard<std::mutex> lock(_timeouts_mutex);
+    return _timer_wheel.next_wakeup();
+}
 
-        // We start over if anyone has messed with this while we called the callback.
-        if (_iterator_invalidated) {
-            _iterator_invalidated = false;
-            it = _timeouts.begin();
-        }
+void TimeoutHandler::set_wakeup_callback(std::function<void(SteadyTimePoint)> callback)
+{
+    std::lock_guard<std::mutex> lock(_wakeup_callback_mutex);
+    _wakeup_callback = std::move(callback);
+}
+
+void TimeoutHandler::notify_wakeup(SteadyTimePoint deadline)
+{
+    std::lock_guard<std::mutex> lock(_wakeup_callback_mutex);
+    if (_wakeup_callback) {
+        _wakeup_callback(deadline);
     }
-    _timeouts_mutex.unlock();
 }
 
 } // namespace mavsdk
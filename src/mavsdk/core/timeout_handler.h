@@ -1,10 +1,14 @@
 #pragma once
 
+#include <condition_variable>
 #include <mutex>
 #include <memory>
 #include <functional>
+#include <optional>
+#include <thread>
 #include <unordered_map>
 #include "mavsdk_time.h"
+#include "timer_wheel.h"
 
 namespace mavsdk {
 
@@ -25,18 +29,40 @@ public:
 
     void run_once();
 
+    // Blocks until the callback being called by run_once(), if any, has
+    // returned. Returns straightaway when called from a callback.
+    void wait_for_callback();
+
+    // Earliest time at which run_once() has something to do.
+    std::optional<SteadyTimePoint> next_wakeup();
+
+    // Called with the new deadline whenever a timeout is added or refreshed,
+    // so that whoever calls run_once() can wake up earlier if needed.
+    void set_wakeup_callback(std::function<void(SteadyTimePoint)> callback);
+
+    // The time the timeouts are measured in.
+    Time& time() { return _time; }
+
 private:
-    struct Timeout {
+    struct Timeout : public TimerWheel::Timer {
         std::function<void()> callback{};
-        SteadyTimePoint time{};
         double duration_s{0.0};
     };
 
-    std::unordered_map<void*, std::shared_ptr<Timeout>> _timeouts{};
+    void notify_wakeup(SteadyTimePoint deadline);
+
+    std::unordered_map<void*, std::unique_ptr<Timeout>> _timeouts{};
     std::mutex _timeouts_mutex{};
-    bool _iterator_invalidated{false};
+
+    std::condition_variable _callback_done_cv{};
+    bool _calling{false};
+    std::thread::id _calling_thread_id{};
 
     Time& _time;
+    TimerWheel _timer_wheel{};
+
+    std::mutex _wakeup_callback_mutex{};
+    std::function<void(SteadyTimePoint)> _wakeup_callback{nullptr};
 };
 
 } // namespace mavsdk
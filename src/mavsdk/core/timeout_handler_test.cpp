@@ -1,5 +1,7 @@
 #include "timeout_handler.h"
 #include "unused.h"
+#include <atomic>
+#include <thread>
 #include <gtest/gtest.h>
 
 #ifdef FAKE_TIME
@@ -169,3 +171,60 @@ TEST(TimeoutHandler, NextTimeoutRemovedDuringCallback)
     time.sleep_for(std::chrono::milliseconds(1000));
     th.run_once();
 }
+
+TEST(TimeoutHandler, WaitForCallbackStillRunning)
+{
+    Time time{};
+    TimeoutHandler th(time);
+
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    std::atomic<bool> returned{false};
+
+    th.add(
+        [&]() {
+            started = true;
+            while (!release) {
+                std::this_thread::yield();
+            }
+            returned = true;
+        },
+        0.1,
+        nullptr);
+
+    time.sleep_for(std::chrono::milliseconds(150));
+    std::thread run_thread([&th]() { th.run_once(); });
+    while (!started) {
+        std::this_thread::yield();
+    }
+
+    std::thread release_thread([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        release = true;
+    });
+    th.wait_for_callback();
+    EXPECT_TRUE(returned);
+
+    release_thread.join();
+    run_thread.join();
+}
+
+TEST(TimeoutHandler, WaitForCallbackFromCallback)
+{
+    Time time{};
+    TimeoutHandler th(time);
+
+    bool timeout_happened = false;
+
+    th.add(
+        [&]() {
+            th.wait_for_callback();
+            timeout_happened = true;
+        },
+        0.1,
+        nullptr);
+
+    time.sleep_for(std::chrono::milliseconds(150));
+    th.run_once();
+    EXPECT_TRUE(timeout_happened);
+}
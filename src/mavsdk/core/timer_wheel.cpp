@@ -0,0 +1,189 @@
+#include "timer_wheel.h"
+
+#include <algorithm>
+
+namespace mavsdk {
+
+void TimerWheel::schedule(Timer& timer, SteadyTimePoint deadline)
+{
+    if (timer._scheduled) {
+        unlink(timer);
+    }
+
+    timer.deadline = deadline;
+
+    // Anything already overdue goes into the current slot so that it is
+    // picked up by the next pop_expired().
+    const int64_t tick = std::max(tick_of(deadline), _current_tick);
+    link(timer, static_cast<size_t>(tick % NUM_SLOTS));
+}
+
+void TimerWheel::cancel(Timer& timer)
+{
+    if (timer._scheduled) {
+        unlink(timer);
+    }
+}
+
+TimerWheel::Timer* TimerWheel::pop_expired(SteadyTimePoint now)
+{
+    const int64_t now_tick = tick_of(now);
+
+    // We never need to look at more than one full rotation because every
+    // slot is checked for expired timers regardless of how far in the future
+    // the other ones in it are.
+    for (size_t visited = 0; visited < NUM_SLOTS && _current_tick <= now_tick;) {
+        const auto current_slot = static_cast<size_t>(_current_tick % NUM_SLOTS);
+        const auto maybe_slot = next_occupied_slot(current_slot);
+        if (!maybe_slot) {
+            break;
+        }
+
+        const size_t distance = (maybe_slot.value() + NUM_SLOTS - current_slot) % NUM_SLOTS;
+        if (_current_tick + static_cast<int64_t>(distance) > now_tick ||
+            visited + distance >= NUM_SLOTS) {
+            break;
+        }
+        _current_tick += static_cast<int64_t>(distance);
+        visited += distance;
+
+        for (Timer* timer = _slots[maybe_slot.value()]; timer != nullptr; timer = timer->_next) {
+            if (timer->deadline < now) {
+                unlink(*timer);
+                return timer;
+            }
+        }
+
+        if (_current_tick == now_tick) {
+            // Timers later in the current tick stay where they are.
+            return nullptr;
+        }
+        ++_current_tick;
+        ++visited;
+    }
+
+    _current_tick = std::max(_current_tick, now_tick);
+    return nullptr;
+}
+
+std::optional<SteadyTimePoint> TimerWheel::next_wakeup() const
+{
+    if (_num_scheduled == 0) {
+        return {};
+    }
+
+    std::optional<SteadyTimePoint> earliest{};
+
+    const auto current_slot = static_cast<size_t>(_current_tick % NUM_SLOTS);
+    size_t slot = current_slot;
+
+    for (size_t visited = 0; visited < NUM_SLOTS;) {
+        const auto maybe_slot = next_occupied_slot(slot);
+        if (!maybe_slot) {
+            break;
+        }
+        const size_t distance = (maybe_slot.value() + NUM_SLOTS - slot) % NUM_SLOTS;
+        visited += distance;
+        if (visited >= NUM_SLOTS) {
+            break;
+        }
+        slot = maybe_slot.value();
+
+        const int64_t tick =
+            _current_tick + static_cast<int64_t>((slot + NUM_SLOTS - current_slot) % NUM_SLOTS);
+        const SteadyTimePoint end_of_tick = start_of(tick + 1);
+
+        bool due_in_this_rotation = false;
+        for (const Timer* timer = _slots[slot]; timer != nullptr; timer = timer->_next) {
+            if (!earliest || timer->deadline < earliest.value()) {
+                earliest = timer->deadline;
+            }
+            if (timer->deadline < end_of_tick) {
+                due_in_this_rotation = true;
+            }
+        }
+
+        // All slots before this one were empty for this rotation, so nothing
+        // further on can be earlier.
+        if (due_in_this_rotation) {
+            break;
+        }
+
+        slot = (slot + 1) % NUM_SLOTS;
+        ++visited;
+    }
+
+    return earliest;
+}
+
+int64_t TimerWheel::tick_of(SteadyTimePoint time)
+{
+    return std::max(static_cast<int64_t>(time.time_since_epoch() / TICK), int64_t(0));
+}
+
+SteadyTimePoint TimerWheel::start_of(int64_t tick)
+{
+    return SteadyTimePoint{} + std::chrono::duration_cast<SteadyTimePoint::duration>(TICK * tick);
+}
+
+void TimerWheel::link(Timer& timer, size_t slot)
+{
+    timer._slot = slot;
+    timer._prev = nullptr;
+    timer._next = _slots[slot];
+    if (timer._next != nullptr) {
+        timer._next->_prev = &timer;
+    }
+    _slots[slot] = &timer;
+    _occupied[slot / BITS_PER_WORD] |= (uint64_t(1) << (slot % BITS_PER_WORD));
+
+    timer._scheduled = true;
+    ++_num_scheduled;
+}
+
+void TimerWheel::unlink(Timer& timer)
+{
+    if (timer._prev != nullptr) {
+        timer._prev->_next = timer._next;
+    } else {
+        _slots[timer._slot] = timer._next;
+    }
+    if (timer._next != nullptr) {
+        timer._next->_prev = timer._prev;
+    }
+    if (_slots[timer._slot] == nullptr) {
+        _occupied[timer._slot / BITS_PER_WORD] &=
+            ~(uint64_t(1) << (timer._slot % BITS_PER_WORD));
+    }
+
+    timer._prev = nullptr;
+    timer._next = nullptr;
+    timer._scheduled = false;
+    --_num_scheduled;
+}
+
+std::optional<size_t> TimerWheel::next_occupied_slot(size_t from) const
+{
+    // Look at the words of the bitmap starting at `from`, wrapping around once.
+    for (size_t i = 0; i <= _occupied.size(); ++i) {
+        const size_t word_index = (from / BITS_PER_WORD + i) % _occupied.size();
+        uint64_t word = _occupied[word_index];
+        if (i == 0) {
+            // Ignore the slots before `from` in the first word.
+            word &= ~uint64_t(0) << (from % BITS_PER_WORD);
+        } else if (i == _occupied.size()) {
+            // And only those in the last one.
+            word &= ~(~uint64_t(0) << (from % BITS_PER_WORD));
+        }
+        if (word != 0) {
+            size_t bit = 0;
+            while ((word & (uint64_t(1) << bit)) == 0) {
+                ++bit;
+            }
+            return word_index * BITS_PER_WORD + bit;
+        }
+    }
+    return {};
+}
+
+} // namespace mavsdk
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "mavsdk_time.h"
+
+namespace mavsdk {
+
+// Hashed timing wheel.
+//
+// Timers are kept in intrusive lists, one per tick slot, so scheduling,
+// rescheduling and cancelling a timer is O(1). Expiring timers only visits
+// the slots whose tick has passed since the last call instead of every timer.
+// Timers further away than one rotation simply stay in their slot until
+// their deadline has actually passed.
+//
+// The wheel does not own the timers and is not thread-safe, users are
+// expected to hold their own lock.
+class TimerWheel {
+public:
+    struct Timer {
+        SteadyTimePoint deadline{};
+
+    private:
+        Timer* _prev{nullptr};
+        Timer* _next{nullptr};
+        size_t _slot{0};
+        bool _scheduled{false};
+
+        friend TimerWheel;
+    };
+
+    TimerWheel() = default;
+    ~TimerWheel() = default;
+
+    // delete copy and move constructors and assign operators
+    TimerWheel(TimerWheel const&) = delete; // Copy construct
+    TimerWheel(TimerWheel&&) = delete; // Move construct
+    TimerWheel& operator=(TimerWheel const&) = delete; // Copy assign
+    TimerWheel& operator=(TimerWheel&&) = delete; // Move assign
+
+    // Schedules the timer, or moves it if it was already scheduled.
+    void schedule(Timer& timer, SteadyTimePoint deadline);
+    void cancel(Timer& timer);
+    [[nodiscard]] static bool is_scheduled(const Timer& timer) { return timer._scheduled; }
+
+    // Takes one timer with a deadline before now out of the wheel, or returns
+    // nullptr if there is none.
+    Timer* pop_expired(SteadyTimePoint now);
+
+    // Time until which it is safe to sleep without missing a deadline. This is
+    // exact unless the next timer is more than one rotation away, in which case
+    // it can be earlier than the actual deadline.
+    [[nodiscard]] std::optional<SteadyTimePoint> next_wakeup() const;
+
+    [[nodiscard]] bool empty() const { return _num_scheduled == 0; }
+
+    static constexpr std::chrono::microseconds TICK{1000};
+    static constexpr size_t NUM_SLOTS = 1024;
+
+private:
+    // Ticks are counted from the clock's epoch.
+    static int64_t tick_of(SteadyTimePoint time);
+    static SteadyTimePoint start_of(int64_t tick);
+    void link(Timer& timer, size_t slot);
+    void unlink(Timer& timer);
+    std::optional<size_t> next_occupied_slot(size_t from) const;
+
+    static constexpr size_t BITS_PER_WORD = 64;
+
+    int64_t _current_tick{0};
+    std::array<Timer*, NUM_SLOTS> _slots{};
+    std::array<uint64_t, NUM_SLOTS / BITS_PER_WORD> _occupied{};
+    size_t _num_scheduled{0};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,114 @@
+#include "timer_wheel.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace mavsdk;
+using namespace std::chrono_literals;
+
+TEST(TimerWheel, PopExpiredInDeadlineOrder)
+{
+    const SteadyTimePoint start{};
+    TimerWheel wheel;
+
+    TimerWheel::Timer first;
+    TimerWheel::Timer second;
+    TimerWheel::Timer third;
+    wheel.schedule(second, start + 20ms);
+    wheel.schedule(first, start + 10ms);
+    wheel.schedule(third, start + 30ms);
+
+    EXPECT_EQ(wheel.pop_expired(start + 5ms), nullptr);
+    EXPECT_EQ(wheel.pop_expired(start + 15ms), &first);
+    EXPECT_EQ(wheel.pop_expired(start + 15ms), nullptr);
+    EXPECT_EQ(wheel.pop_expired(start + 35ms), &second);
+    EXPECT_EQ(wheel.pop_expired(start + 35ms), &third);
+    EXPECT_EQ(wheel.pop_expired(start + 35ms), nullptr);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, RescheduleAndCancel)
+{
+    const SteadyTimePoint start{};
+    TimerWheel wheel;
+
+    TimerWheel::Timer timer;
+    wheel.schedule(timer, start + 10ms);
+    wheel.schedule(timer, start + 50ms);
+    EXPECT_EQ(wheel.pop_expired(start + 20ms), nullptr);
+    EXPECT_EQ(wheel.pop_expired(start + 60ms), &timer);
+    EXPECT_FALSE(TimerWheel::is_scheduled(timer));
+
+    wheel.schedule(timer, start + 70ms);
+    wheel.cancel(timer);
+    EXPECT_EQ(wheel.pop_expired(start + 100ms), nullptr);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, SubTickPrecision)
+{
+    const SteadyTimePoint start{};
+    TimerWheel wheel;
+
+    TimerWheel::Timer timer;
+    wheel.schedule(timer, start + 10ms + 300us);
+
+    // Same tick, but not yet due.
+    EXPECT_EQ(wheel.pop_expired(start + 10ms + 200us), nullptr);
+    EXPECT_EQ(wheel.next_wakeup(), start + 10ms + 300us);
+    EXPECT_EQ(wheel.pop_expired(start + 10ms + 400us), &timer);
+}
+
+TEST(TimerWheel, BeyondOneRotation)
+{
+    const SteadyTimePoint start{};
+    TimerWheel wheel;
+
+    const auto rotation = TimerWheel::TICK * TimerWheel::NUM_SLOTS;
+
+    TimerWheel::Timer far;
+    TimerWheel::Timer near;
+    wheel.schedule(far, start + 3 * rotation + 5ms);
+    wheel.schedule(near, start + 20ms);
+
+    EXPECT_EQ(wheel.next_wakeup(), start + 20ms);
+    EXPECT_EQ(wheel.pop_expired(start + 25ms), &near);
+    EXPECT_EQ(wheel.next_wakeup(), start + 3 * rotation + 5ms);
+
+    // Passing the slot in earlier rotations must not expire it.
+    EXPECT_EQ(wheel.pop_expired(start + rotation + 10ms), nullptr);
+    EXPECT_EQ(wheel.pop_expired(start + 2 * rotation + 10ms), nullptr);
+    EXPECT_EQ(wheel.pop_expired(start + 3 * rotation + 10ms), &far);
+}
+
+TEST(TimerWheel, OverdueWhenScheduled)
+{
+    const SteadyTimePoint start{};
+    TimerWheel wheel;
+
+    TimerWheel::Timer late;
+    EXPECT_EQ(wheel.pop_expired(start + 500ms), nullptr);
+    wheel.schedule(late, start + 100ms);
+    EXPECT_EQ(wheel.next_wakeup(), start + 100ms);
+    EXPECT_EQ(wheel.pop_expired(start + 501ms), &late);
+}
+
+TEST(TimerWheel, ManyTimers)
+{
+    const SteadyTimePoint start{};
+    TimerWheel wheel;
+
+    std::vector<TimerWheel::Timer> timers(5000);
+    for (size_t i = 0; i < timers.size(); ++i) {
+        wheel.schedule(timers[i], start + std::chrono::milliseconds(i % 3000) + 1ms);
+    }
+
+    size_t expired = 0;
+    for (auto now = start; now < start + 3100ms; now += 7ms) {
+        while (auto* timer = wheel.pop_expired(now)) {
+            EXPECT_LT(timer->deadline, now);
+            ++expired;
+        }
+    }
+    EXPECT_EQ(expired, timers.size());
+    EXPECT_FALSE(wheel.next_wakeup());
+}
@@ -41,6 +41,17 @@ void Timesync::do_work()
     }
 }
 
+SteadyTimePoint Timesync::next_work_time() const
+{
+    if (!_is_enabled) {
+        return SteadyTimePoint::max();
+    }
+
+    auto next_time = _last_time;
+    Time::shift_steady_time_by(next_time, TIMESYNC_SEND_INTERVAL_S);
+    return next_time;
+}
+
 void Timesync::process_timesync(const mavlink_message_t& message)
 {
     mavlink_timesync_t timesync{};
@@ -55,6 +66,12 @@ void Timesync::process_timesync(const mavlink_message_t& message)
         // Send synced time to remote system
         send_timesync(now_ns, timesync.ts1);
     } else if (timesync.tc1 > 0) {
+        // Every system's timesync gets all replies, so only measure our own.
+        if (message.sysid == _system_impl.get_system_id()) {
+            _system_impl.rtt_estimator().add_sample(
+                static_cast<double>(now_ns - timesync.ts1) * 1e-9);
+        }
+
         // Time offset between this system and the remote system is calculated assuming RTT for
         // the timesync packet is roughly equal both ways.
         set_timesync_offset((timesync.tc1 * 2 - (timesync.ts1 + now_ns)) / 2, timesync.ts1);
@@ -15,6 +15,9 @@ public:
     void enable();
     void do_work();
 
+    // Time at which do_work() needs to be called next.
+    [[nodiscard]] SteadyTimePoint next_work_time() const;
+
     Timesync(const Timesync&) = delete;
     Timesync& operator=(const Timesync&) = delete;
 
@@ -0,0 +1,53 @@
+#include "unittests_allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local bool counting_enabled = false;
+std::atomic<unsigned> allocation_count{0};
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    if (counting_enabled) {
+        ++allocation_count;
+    }
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        // We build without exceptions, so there is no std::bad_alloc to throw.
+        std::abort();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace mavsdk {
+
+void AllocationCounter::set_enabled_on_this_thread(bool enabled)
+{
+    counting_enabled = enabled;
+}
+
+void AllocationCounter::reset()
+{
+    allocation_count = 0;
+}
+
+unsigned AllocationCounter::num_allocations()
+{
+    return allocation_count;
+}
+
+} // namespace mavsdk
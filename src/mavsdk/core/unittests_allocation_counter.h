@@ -0,0 +1,15 @@
+#pragma once
+
+namespace mavsdk {
+
+// Counts heap allocations in unit tests. operator new is replaced for the
+// whole test binary, and allocations are counted on the threads where
+// counting is enabled.
+class AllocationCounter {
+public:
+    static void set_enabled_on_this_thread(bool enabled);
+    static void reset();
+    static unsigned num_allocations();
+};
+
+} // namespace mavsdk
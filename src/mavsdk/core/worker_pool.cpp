@@ -0,0 +1,269 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace mavsdk {
+
+thread_local const WorkerPool::Entry* WorkerPool::_running_entry = nullptr;
+
+WorkerPool::WorkerPool(unsigned num_threads)
+{
+    set_num_threads(num_threads);
+}
+
+WorkerPool::~WorkerPool()
+{
+    std::lock_guard<std::mutex> threads_lock(_threads_mutex);
+    stop_threads();
+}
+
+unsigned WorkerPool::default_num_threads()
+{
+    // Can be 0 if it is not known.
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void WorkerPool::add(Task task, void** cookie, unsigned key)
+{
+    auto new_entry = std::make_shared<Entry>();
+    new_entry->task = std::move(task);
+    new_entry->key = key;
+
+    const void* new_cookie = static_cast<const void*>(new_entry.get());
+
+    std::lock_guard<std::shared_mutex> lock(_entries_mutex);
+    // Set before the task can run, so the task can use it.
+    if (cookie != nullptr) {
+        *cookie = const_cast<void*>(new_cookie);
+    }
+    _entries.emplace(new_cookie, new_entry);
+
+    new_entry->shard_index = key % _shards.size();
+    auto& shard = *_shards[new_entry->shard_index];
+    std::lock_guard<std::mutex> shard_lock(shard.mutex);
+    ++shard.num_entries;
+    enqueue(shard, new_entry);
+}
+
+void WorkerPool::remove(const void* cookie)
+{
+    std::shared_ptr<Entry> entry;
+    std::shared_ptr<Shard> shard;
+    {
+        std::lock_guard<std::shared_mutex> lock(_entries_mutex);
+
+        auto it = _entries.find(cookie);
+        if (it == _entries.end()) {
+            return;
+        }
+        entry = it->second;
+        _entries.erase(it);
+        shard = _shards[entry->shard_index];
+    }
+
+    std::unique_lock<std::mutex> shard_lock(shard->mutex);
+    --shard->num_entries;
+    entry->removed = true;
+    ++entry->deadline_generation;
+
+    if (entry->queued) {
+        shard->ready.erase(
+            std::remove(shard->ready.begin(), shard->ready.end(), entry), shard->ready.end());
+        entry->queued = false;
+    }
+
+    // A task removing itself would otherwise wait for itself forever. The
+    // shard is kept alive by us, so waiting on it is fine even if the number
+    // of threads changes meanwhile.
+    if (entry.get() != _running_entry) {
+        shard->done_cv.wait(shard_lock, [&entry]() { return !entry->running; });
+    }
+}
+
+void WorkerPool::signal(const void* cookie)
+{
+    std::shared_lock<std::shared_mutex> lock(_entries_mutex);
+
+    auto it = _entries.find(cookie);
+    if (it == _entries.end()) {
+        return;
+    }
+    const auto& entry = it->second;
+    auto& shard = *_shards[entry->shard_index];
+
+    std::lock_guard<std::mutex> shard_lock(shard.mutex);
+    entry->signalled = true;
+    if (!entry->running) {
+        enqueue(shard, entry);
+    }
+}
+
+void WorkerPool::set_num_threads(unsigned num_threads)
+{
+    num_threads = std::max(num_threads, 1u);
+
+    std::lock_guard<std::mutex> threads_lock(_threads_mutex);
+
+    if (num_threads == _shards.size()) {
+        return;
+    }
+
+    // Tasks are assigned to threads by key, so they all need to be
+    // redistributed.
+    stop_threads();
+    start_threads(num_threads);
+}
+
+unsigned WorkerPool::num_threads() const
+{
+    std::shared_lock<std::shared_mutex> lock(_entries_mutex);
+    return static_cast<unsigned>(_shards.size());
+}
+
+void WorkerPool::stop_threads()
+{
+    // Needs _threads_mutex locked.
+    std::vector<std::shared_ptr<Shard>> shards;
+    {
+        std::shared_lock<std::shared_mutex> lock(_entries_mutex);
+        shards = _shards;
+    }
+
+    for (auto& shard : shards) {
+        {
+            std::lock_guard<std::mutex> shard_lock(shard->mutex);
+            shard->should_exit = true;
+        }
+        shard->work_cv.notify_all();
+    }
+
+    // Threads finish the task they are running before they exit. Meanwhile,
+    // tasks are still added to and signalled on the old shards.
+    for (auto& shard : shards) {
+        shard->thread.join();
+    }
+}
+
+void WorkerPool::start_threads(unsigned num_threads)
+{
+    // Needs _threads_mutex locked and the threads stopped.
+    std::lock_guard<std::shared_mutex> lock(_entries_mutex);
+
+    std::vector<std::shared_ptr<Shard>> old_shards = std::move(_shards);
+
+    _shards.clear();
+    for (unsigned i = 0; i < num_threads; ++i) {
+        _shards.push_back(std::make_shared<Shard>());
+    }
+
+    for (auto& pair : _entries) {
+        auto& entry = pair.second;
+        const bool queued = entry->queued || entry->signalled;
+        entry->queued = false;
+        entry->shard_index = entry->key % _shards.size();
+
+        auto& shard = *_shards[entry->shard_index];
+        ++shard.num_entries;
+        if (queued) {
+            enqueue(shard, entry);
+        } else {
+            schedule(shard, entry);
+        }
+    }
+
+    for (auto& shard : _shards) {
+        shard->thread = std::thread(&WorkerPool::worker_thread, this, std::ref(*shard));
+    }
+}
+
+void WorkerPool::enqueue(Shard& shard, const std::shared_ptr<Entry>& entry)
+{
+    // Needs the shard mutex locked.
+    if (entry->queued) {
+        return;
+    }
+    entry->queued = true;
+    ++entry->deadline_generation;
+    shard.ready.push_back(entry);
+    shard.work_cv.notify_one();
+}
+
+void WorkerPool::schedule(Shard& shard, const std::shared_ptr<Entry>& entry)
+{
+    // Needs the shard mutex locked.
+    ++entry->deadline_generation;
+    if (entry->deadline == SteadyTimePoint::max()) {
+        return;
+    }
+
+    // Tasks that are signalled a lot leave many stale deadlines behind.
+    if (shard.deadlines.size() > 2 * shard.num_entries + 16) {
+        shard.deadlines.erase(
+            std::remove_if(
+                shard.deadlines.begin(),
+                shard.deadlines.end(),
+                [](const Deadline& deadline) {
+                    return deadline.generation != deadline.entry->deadline_generation;
+                }),
+            shard.deadlines.end());
+        std::make_heap(shard.deadlines.begin(), shard.deadlines.end(), std::greater<>{});
+    }
+
+    shard.deadlines.push_back(Deadline{entry->deadline, entry->deadline_generation, entry});
+    std::push_heap(shard.deadlines.begin(), shard.deadlines.end(), std::greater<>{});
+}
+
+void WorkerPool::worker_thread(Shard& shard)
+{
+    std::unique_lock<std::mutex> lock(shard.mutex);
+
+    while (!shard.should_exit) {
+        const auto now = _time.steady_time();
+
+        while (!shard.deadlines.empty() && shard.deadlines.front().time <= now) {
+            std::pop_heap(shard.deadlines.begin(), shard.deadlines.end(), std::greater<>{});
+            const auto deadline = std::move(shard.deadlines.back());
+            shard.deadlines.pop_back();
+
+            if (deadline.generation == deadline.entry->deadline_generation) {
+                enqueue(shard, deadline.entry);
+            }
+        }
+
+        if (shard.ready.empty()) {
+            if (shard.deadlines.empty()) {
+                shard.work_cv.wait(lock);
+            } else {
+                shard.work_cv.wait_until(lock, shard.deadlines.front().time);
+            }
+            continue;
+        }
+
+        auto entry = shard.ready.front();
+        shard.ready.pop_front();
+        entry->queued = false;
+        entry->signalled = false;
+        entry->running = true;
+
+        lock.unlock();
+        _running_entry = entry.get();
+        const auto deadline = entry->task();
+        _running_entry = nullptr;
+        lock.lock();
+
+        entry->running = false;
+        entry->deadline = deadline;
+        if (!entry->removed) {
+            if (entry->signalled) {
+                enqueue(shard, entry);
+            } else {
+                schedule(shard, entry);
+            }
+        }
+        shard.done_cv.notify_all();
+    }
+}
+
+} // namespace mavsdk
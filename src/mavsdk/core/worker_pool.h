@@ -0,0 +1,120 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "mavsdk_time.h"
+
+namespace mavsdk {
+
+// A fixed number of threads shared by any number of tasks.
+//
+// A task is run whenever it has been signalled or its deadline has passed,
+// and returns its next deadline. Tasks are spread over the threads by a key,
+// so tasks with the same key, e.g. of the same system, always run on the same
+// thread, and each thread only looks at its own tasks. A task is never run by
+// two threads at the same time, so it does not need to be thread-safe against
+// itself.
+class WorkerPool {
+public:
+    // Returns the time at which the task wants to be run again at the latest.
+    using Task = std::function<SteadyTimePoint()>;
+
+    explicit WorkerPool(unsigned num_threads = default_num_threads());
+    ~WorkerPool();
+
+    // delete copy and move constructors and assign operators
+    WorkerPool(WorkerPool const&) = delete; // Copy construct
+    WorkerPool(WorkerPool&&) = delete; // Move construct
+    WorkerPool& operator=(WorkerPool const&) = delete; // Copy assign
+    WorkerPool& operator=(WorkerPool&&) = delete; // Move assign
+
+    // The task is run once straightaway.
+    void add(Task task, void** cookie, unsigned key = 0);
+
+    // Blocks until the task has finished running unless called from the task
+    // itself.
+    void remove(const void* cookie);
+
+    // Runs the task as soon as possible. If it is running right now, it is run
+    // again afterwards.
+    void signal(const void* cookie);
+
+    // Must not be called from a task.
+    void set_num_threads(unsigned num_threads);
+    [[nodiscard]] unsigned num_threads() const;
+
+    // One thread per core.
+    static unsigned default_num_threads();
+
+private:
+    struct Entry {
+        Task task{nullptr};
+        unsigned key{0};
+        // Only changed while no threads are running.
+        size_t shard_index{0};
+
+        // The rest is protected by the mutex of the shard.
+        SteadyTimePoint deadline{};
+        // Bumped whenever the deadline in the heap no longer applies.
+        uint64_t deadline_generation{0};
+        bool signalled{false};
+        bool queued{false};
+        bool running{false};
+        bool removed{false};
+    };
+
+    struct Deadline {
+        SteadyTimePoint time{};
+        uint64_t generation{0};
+        std::shared_ptr<Entry> entry{};
+
+        // For a min-heap.
+        bool operator>(const Deadline& other) const { return time > other.time; }
+    };
+
+    // The tasks of one thread.
+    struct Shard {
+        std::mutex mutex{};
+        std::condition_variable work_cv{};
+        std::condition_variable done_cv{};
+        std::deque<std::shared_ptr<Entry>> ready{};
+        // A min-heap of the deadlines of tasks that are neither queued nor
+        // running. Stale ones are skipped when they come up.
+        std::vector<Deadline> deadlines{};
+        size_t num_entries{0};
+        bool should_exit{false};
+        std::thread thread{};
+    };
+
+    void worker_thread(Shard& shard);
+    static void enqueue(Shard& shard, const std::shared_ptr<Entry>& entry);
+    static void schedule(Shard& shard, const std::shared_ptr<Entry>& entry);
+
+    void start_threads(unsigned num_threads);
+    void stop_threads();
+
+    // The entry whose task is running on this thread, so that a task can
+    // remove itself without waiting for itself.
+    static thread_local const Entry* _running_entry;
+
+    // Held shared to look up entries and shards, exclusively to add or remove
+    // entries and to replace the shards. Taken before the mutex of a shard.
+    mutable std::shared_mutex _entries_mutex{};
+    std::unordered_map<const void*, std::shared_ptr<Entry>> _entries{};
+    std::vector<std::shared_ptr<Shard>> _shards{};
+
+    // Only needed to serialize resizing.
+    std::mutex _threads_mutex{};
+
+    Time _time{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,330 @@
+#include "worker_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+SteadyTimePoint never()
+{
+    return SteadyTimePoint::max();
+}
+
+SteadyTimePoint in_ms(int ms)
+{
+    return std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+}
+} // namespace
+
+TEST(WorkerPool, RunsOnceWhenAdded)
+{
+    WorkerPool pool;
+
+    std::promise<void> prom;
+    auto fut = prom.get_future();
+
+    void* cookie = nullptr;
+    pool.add(
+        [&prom]() {
+            prom.set_value();
+            return never();
+        },
+        &cookie);
+
+    EXPECT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    pool.remove(cookie);
+}
+
+TEST(WorkerPool, RunsWhenSignalled)
+{
+    WorkerPool pool;
+
+    std::atomic<int> num_called{0};
+
+    void* cookie = nullptr;
+    pool.add(
+        [&num_called]() {
+            ++num_called;
+            return never();
+        },
+        &cookie);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(num_called, 1);
+
+    pool.signal(cookie);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(num_called, 2);
+
+    pool.remove(cookie);
+    pool.signal(cookie);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(num_called, 2);
+}
+
+TEST(WorkerPool, RunsAtDeadline)
+{
+    WorkerPool pool;
+
+    std::atomic<int> num_called{0};
+
+    void* cookie = nullptr;
+    pool.add(
+        [&num_called]() {
+            ++num_called;
+            return in_ms(100);
+        },
+        &cookie);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    pool.remove(cookie);
+
+    // Straightaway, after 100 ms and after 200 ms.
+    EXPECT_EQ(num_called, 3);
+}
+
+TEST(WorkerPool, SignalReplacesDeadline)
+{
+    WorkerPool pool;
+
+    std::atomic<int> num_called{0};
+
+    void* cookie = nullptr;
+    pool.add(
+        [&num_called]() {
+            ++num_called;
+            return in_ms(100);
+        },
+        &cookie);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    pool.signal(cookie);
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    pool.remove(cookie);
+
+    // Straightaway and when signalled, but not at the first deadline because
+    // the signalled run returned a later one.
+    EXPECT_EQ(num_called, 2);
+}
+
+TEST(WorkerPool, TasksWithSameKeyRunOnSameThread)
+{
+    constexpr unsigned num_threads = 4;
+    constexpr unsigned num_tasks = 2 * num_threads;
+    WorkerPool pool{num_threads};
+
+    std::mutex mutex;
+    std::vector<std::vector<std::thread::id>> thread_ids(num_tasks);
+    std::vector<void*> cookies(num_tasks, nullptr);
+
+    for (unsigned key = 0; key < num_tasks; ++key) {
+        pool.add(
+            [&, key]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                thread_ids[key].push_back(std::this_thread::get_id());
+                return in_ms(1);
+            },
+            &cookies[key],
+            key);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Changing the number of threads redistributes the tasks.
+    pool.set_num_threads(num_threads + 1);
+    pool.set_num_threads(num_threads);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    for (auto& cookie : cookies) {
+        pool.remove(cookie);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (unsigned key = 0; key < num_tasks; ++key) {
+        ASSERT_GT(thread_ids[key].size(), 1u);
+        EXPECT_NE(thread_ids[key].front(), thread_ids[(key + 1) % num_tasks].front());
+        EXPECT_EQ(thread_ids[key].back(), thread_ids[(key + num_threads) % num_tasks].back());
+    }
+}
+
+TEST(WorkerPool, TaskNeverRunsConcurrently)
+{
+    WorkerPool pool{4};
+
+    std::atomic<int> num_running{0};
+    std::atomic<int> max_running{0};
+    std::atomic<int> num_called{0};
+
+    void* cookie = nullptr;
+    pool.add(
+        [&]() {
+            const int running = ++num_running;
+            max_running = std::max(max_running.load(), running);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++num_called;
+            --num_running;
+            return never();
+        },
+        &cookie);
+
+    for (int i = 0; i < 100; ++i) {
+        pool.signal(cookie);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    pool.remove(cookie);
+
+    EXPECT_EQ(max_running, 1);
+    // Signals while running are combined but never lost.
+    EXPECT_GT(num_called, 1);
+}
+
+TEST(WorkerPool, ManyTasksOnFewThreads)
+{
+    WorkerPool pool{2};
+
+    constexpr int num_tasks = 200;
+    std::atomic<int> num_called{0};
+    std::vector<void*> cookies(num_tasks, nullptr);
+
+    for (auto& cookie : cookies) {
+        pool.add(
+            [&num_called]() {
+                ++num_called;
+                return never();
+            },
+            &cookie);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(num_called, num_tasks);
+
+    for (auto& cookie : cookies) {
+        pool.signal(cookie);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    for (auto& cookie : cookies) {
+        pool.remove(cookie);
+    }
+
+    EXPECT_EQ(num_called, 2 * num_tasks);
+}
+
+TEST(WorkerPool, RemoveWaitsForRunningTask)
+{
+    WorkerPool pool;
+
+    std::promise<void> started;
+    auto started_fut = started.get_future();
+    std::atomic<bool> finished{false};
+
+    void* cookie = nullptr;
+    pool.add(
+        [&]() {
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            finished = true;
+            return never();
+        },
+        &cookie);
+
+    started_fut.wait();
+    pool.remove(cookie);
+    EXPECT_TRUE(finished);
+}
+
+TEST(WorkerPool, TaskCanRemoveItself)
+{
+    WorkerPool pool;
+
+    std::promise<void> prom;
+    auto fut = prom.get_future();
+
+    void* cookie = nullptr;
+    pool.add(
+        [&]() {
+            pool.remove(cookie);
+            prom.set_value();
+            return in_ms(1);
+        },
+        &cookie);
+
+    EXPECT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+}
+
+TEST(WorkerPool, TaskRemovingAnotherTaskWaitsForIt)
+{
+    WorkerPool pool{2};
+
+    std::promise<void> started;
+    auto started_fut = started.get_future();
+    std::atomic<bool> finished{false};
+
+    void* running_cookie = nullptr;
+    pool.add(
+        [&]() {
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            finished = true;
+            return never();
+        },
+        &running_cookie,
+        0);
+
+    started_fut.wait();
+
+    std::promise<bool> removed;
+    auto removed_fut = removed.get_future();
+
+    void* removing_cookie = nullptr;
+    pool.add(
+        [&]() {
+            pool.remove(running_cookie);
+            removed.set_value(finished);
+            return never();
+        },
+        &removing_cookie,
+        1);
+
+    ASSERT_EQ(removed_fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_TRUE(removed_fut.get());
+
+    pool.remove(removing_cookie);
+}
+
+TEST(WorkerPool, ChangeNumThreads)
+{
+    WorkerPool pool;
+    EXPECT_EQ(pool.num_threads(), WorkerPool::default_num_threads());
+
+    std::atomic<int> num_called{0};
+    void* cookie = nullptr;
+    pool.add(
+        [&num_called]() {
+            ++num_called;
+            return in_ms(10);
+        },
+        &cookie);
+
+    pool.set_num_threads(8);
+    EXPECT_EQ(pool.num_threads(), 8u);
+
+    pool.set_num_threads(2);
+    EXPECT_EQ(pool.num_threads(), 2u);
+
+    const int before = num_called;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_GT(num_called, before);
+
+    pool.set_num_threads(0);
+    EXPECT_EQ(pool.num_threads(), 1u);
+
+    pool.remove(cookie);
+}
@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -133,6 +134,23 @@ public:
      */
     Result arm() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to arm the drone.
+     *
+     * Arming a drone normally causes motors to spin at idle.
+     * Before arming take all safety precautions and stand clear of the drone!
+     *
+     * This function can be awaited. See 'arm_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> arm_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { arm_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to disarm the drone.
      *
@@ -155,6 +173,23 @@ public:
      */
     Result disarm() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to disarm the drone.
+     *
+     * This will disarm a drone that considers itself landed. If flying, the drone should
+     * reject the disarm command. Disarming means that all motors will stop.
+     *
+     * This function can be awaited. See 'disarm_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> disarm_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { disarm_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to take off and hover.
      *
@@ -181,6 +216,25 @@ public:
      */
     Result takeoff() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to take off and hover.
+     *
+     * This switches the drone into position control mode and commands
+     * it to take off and hover at the takeoff altitude.
+     *
+     * Note that the vehicle must be armed before it can take off.
+     *
+     * This function can be awaited. See 'takeoff_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> takeoff_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { takeoff_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to land at the current position.
      *
@@ -201,6 +255,22 @@ public:
      */
     Result land() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to land at the current position.
+     *
+     * This switches the drone to 'Land' flight mode.
+     *
+     * This function can be awaited. See 'land_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> land_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { land_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to reboot the drone components.
      *
@@ -221,6 +291,22 @@ public:
      */
     Result reboot() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to reboot the drone components.
+     *
+     * This will reboot the autopilot, companion computer, camera and gimbal.
+     *
+     * This function can be awaited. See 'reboot_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> reboot_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { reboot_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to shut down the drone components.
      *
@@ -245,6 +331,24 @@ public:
      */
     Result shutdown() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to shut down the drone components.
+     *
+     * This will shut down the autopilot, onboard computer, camera and gimbal.
+     * This command should only be used when the autopilot is disarmed and autopilots commonly
+     * reject it if they are not already ready to shut down.
+     *
+     * This function can be awaited. See 'shutdown_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> shutdown_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { shutdown_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to terminate the drone.
      *
@@ -267,6 +371,23 @@ public:
      */
     Result terminate() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to terminate the drone.
+     *
+     * This will run the terminate routine as configured on the drone (e.g. disarm and open the
+     * parachute).
+     *
+     * This function can be awaited. See 'terminate_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> terminate_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { terminate_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to kill the drone.
      *
@@ -289,6 +410,23 @@ public:
      */
     Result kill() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to kill the drone.
+     *
+     * This will disarm a drone irrespective of whether it is landed or flying.
+     * Note that the drone will fall out of the sky if this command is used while flying.
+     *
+     * This function can be awaited. See 'kill_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> kill_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { kill_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to return to the launch (takeoff) position and land.
      *
@@ -315,6 +453,25 @@ public:
      */
     Result return_to_launch() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to return to the launch (takeoff) position and land.
+     *
+     * This switches the drone into [Return
+     * mode](https://docs.px4.io/master/en/flight_modes/return.html) which generally means it will
+     * rise up to a certain altitude to clear any obstacles before heading back to the launch
+     * (takeoff) position and land there.
+     *
+     * This function can be awaited. See 'return_to_launch_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> return_to_launch_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { return_to_launch_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to move the vehicle to a specific global position.
      *
@@ -347,6 +504,29 @@ public:
     Result goto_location(
         double latitude_deg, double longitude_deg, float absolute_altitude_m, float yaw_deg) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to move the vehicle to a specific global position.
+     *
+     * The latitude and longitude are given in degrees (WGS84 frame) and the altitude
+     * in meters AMSL (above mean sea level).
+     *
+     * The yaw angle is in degrees (frame is NED, 0 is North, positive is clockwise).
+     *
+     * This function can be awaited. See 'goto_location_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> goto_location_awaitable(
+        double latitude_deg, double longitude_deg, float absolute_altitude_m, float yaw_deg)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            goto_location_async(
+                latitude_deg, longitude_deg, absolute_altitude_m, yaw_deg, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Send command do orbit to the drone.
      *
@@ -380,6 +560,37 @@ public:
         double longitude_deg,
         double absolute_altitude_m) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command do orbit to the drone.
+     *
+     * This will run the orbit routine with the given parameters.
+     *
+     * This function can be awaited. See 'do_orbit_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> do_orbit_awaitable(
+        float radius_m,
+        float velocity_ms,
+        OrbitYawBehavior yaw_behavior,
+        double latitude_deg,
+        double longitude_deg,
+        double absolute_altitude_m)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            do_orbit_async(
+                radius_m,
+                velocity_ms,
+                yaw_behavior,
+                latitude_deg,
+                longitude_deg,
+                absolute_altitude_m,
+                callback);
+        });
+    }
+#endif
+
     /**
      * @brief Send command to hold position (a.k.a. "Loiter").
      *
@@ -408,6 +619,26 @@ public:
      */
     Result hold() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to hold position (a.k.a. "Loiter").
+     *
+     * Sends a command to drone to change to Hold flight mode, causing the
+     * vehicle to stop and maintain its current GPS position and altitude.
+     *
+     * Note: this command is specific to the PX4 Autopilot flight stack as
+     * it implies a change to a PX4-specific mode.
+     *
+     * This function can be awaited. See 'hold_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> hold_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { hold_async(callback); });
+    }
+#endif
+
     /**
      * @brief Send command to set the value of an actuator.
      *
@@ -424,6 +655,22 @@ public:
      */
     Result set_actuator(int32_t index, float value) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to set the value of an actuator.
+     *
+     * This function can be awaited. See 'set_actuator_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_actuator_awaitable(int32_t index, float value)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_actuator_async(index, value, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Send command to transition the drone to fixedwing.
      *
@@ -449,6 +696,27 @@ public:
      */
     Result transition_to_fixedwing() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to transition the drone to fixedwing.
+     *
+     * The associated action will only be executed for VTOL vehicles (on other vehicle types the
+     * command will fail). The command will succeed if called when the vehicle
+     * is already in fixedwing mode.
+     *
+     * This function can be awaited. See 'transition_to_fixedwing_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> transition_to_fixedwing_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            transition_to_fixedwing_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Send command to transition the drone to multicopter.
      *
@@ -474,6 +742,27 @@ public:
      */
     Result transition_to_multicopter() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send command to transition the drone to multicopter.
+     *
+     * The associated action will only be executed for VTOL vehicles (on other vehicle types the
+     * command will fail). The command will succeed if called when the vehicle
+     * is already in multicopter mode.
+     *
+     * This function can be awaited. See 'transition_to_multicopter_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> transition_to_multicopter_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            transition_to_multicopter_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for get_takeoff_altitude_async.
      */
@@ -495,6 +784,22 @@ public:
      */
     std::pair<Result, float> get_takeoff_altitude() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Get the takeoff altitude (in meters above ground).
+     *
+     * This function can be awaited. See 'get_takeoff_altitude_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, float> get_takeoff_altitude_awaitable()
+    {
+        return Awaitable<Result, float>([=, this](auto callback) {
+            get_takeoff_altitude_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set takeoff altitude (in meters above ground).
      *
@@ -511,6 +816,22 @@ public:
      */
     Result set_takeoff_altitude(float altitude) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set takeoff altitude (in meters above ground).
+     *
+     * This function can be awaited. See 'set_takeoff_altitude_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_takeoff_altitude_awaitable(float altitude)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_takeoff_altitude_async(altitude, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for get_maximum_speed_async.
      */
@@ -532,6 +853,22 @@ public:
      */
     std::pair<Result, float> get_maximum_speed() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Get the vehicle maximum speed (in metres/second).
+     *
+     * This function can be awaited. See 'get_maximum_speed_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, float> get_maximum_speed_awaitable()
+    {
+        return Awaitable<Result, float>([=, this](auto callback) {
+            get_maximum_speed_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set vehicle maximum speed (in metres/second).
      *
@@ -548,6 +885,22 @@ public:
      */
     Result set_maximum_speed(float speed) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set vehicle maximum speed (in metres/second).
+     *
+     * This function can be awaited. See 'set_maximum_speed_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_maximum_speed_awaitable(float speed)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_maximum_speed_async(speed, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for get_return_to_launch_altitude_async.
      */
@@ -571,6 +924,23 @@ public:
      */
     std::pair<Result, float> get_return_to_launch_altitude() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Get the return to launch minimum return altitude (in meters).
+     *
+     * This function can be awaited. See 'get_return_to_launch_altitude_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, float> get_return_to_launch_altitude_awaitable()
+    {
+        return Awaitable<Result, float>([=, this](auto callback) {
+            get_return_to_launch_altitude_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set the return to launch minimum return altitude (in meters).
      *
@@ -612,6 +982,25 @@ public:
      */
     Result set_current_speed(float speed_m_s) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set current speed.
+     *
+     * This will set the speed during a mission, reposition, and similar.
+     * It is ephemeral, so not stored on the drone and does not survive a reboot.
+     *
+     * This function can be awaited. See 'set_current_speed_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_current_speed_awaitable(float speed_m_s)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_current_speed_async(speed_m_s, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Copy constructor.
      */
@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -520,6 +521,20 @@ public:
      */
     Result prepare() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Prepare the camera plugin (e.g. download the camera definition, etc).
+     *
+     * This function can be awaited. See 'prepare_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> prepare_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { prepare_async(callback); });
+    }
+#endif
+
     /**
      * @brief Take one photo.
      *
@@ -536,6 +551,20 @@ public:
      */
     Result take_photo() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Take one photo.
+     *
+     * This function can be awaited. See 'take_photo_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> take_photo_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { take_photo_async(callback); });
+    }
+#endif
+
     /**
      * @brief Start photo timelapse with a given interval.
      *
@@ -552,6 +581,22 @@ public:
      */
     Result start_photo_interval(float interval_s) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Start photo timelapse with a given interval.
+     *
+     * This function can be awaited. See 'start_photo_interval_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> start_photo_interval_awaitable(float interval_s)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            start_photo_interval_async(interval_s, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Stop a running photo timelapse.
      *
@@ -568,6 +613,20 @@ public:
      */
     Result stop_photo_interval() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Stop a running photo timelapse.
+     *
+     * This function can be awaited. See 'stop_photo_interval_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> stop_photo_interval_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { stop_photo_interval_async(callback); });
+    }
+#endif
+
     /**
      * @brief Start a video recording.
      *
@@ -584,6 +643,20 @@ public:
      */
     Result start_video() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Start a video recording.
+     *
+     * This function can be awaited. See 'start_video_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> start_video_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { start_video_async(callback); });
+    }
+#endif
+
     /**
      * @brief Stop a running video recording.
      *
@@ -600,6 +673,20 @@ public:
      */
     Result stop_video() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Stop a running video recording.
+     *
+     * This function can be awaited. See 'stop_video_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> stop_video_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { stop_video_async(callback); });
+    }
+#endif
+
     /**
      * @brief Start video streaming.
      *
@@ -634,6 +721,20 @@ public:
      */
     Result set_mode(Mode mode) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set camera mode.
+     *
+     * This function can be awaited. See 'set_mode_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_mode_awaitable(Mode mode)
+    {
+        return Awaitable<Result>([=, this](auto callback) { set_mode_async(mode, callback); });
+    }
+#endif
+
     /**
      * @brief Callback type for list_photos_async.
      */
@@ -655,6 +756,22 @@ public:
      */
     std::pair<Result, std::vector<Camera::CaptureInfo>> list_photos(PhotosRange photos_range) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief List photos available on the camera.
+     *
+     * This function can be awaited. See 'list_photos_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, std::vector<CaptureInfo>> list_photos_awaitable(PhotosRange photos_range)
+    {
+        return Awaitable<Result, std::vector<CaptureInfo>>([=, this](auto callback) {
+            list_photos_async(photos_range, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for subscribe_mode.
      */
@@ -851,6 +968,24 @@ public:
      */
     Result set_setting(Setting setting) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set a setting to some value.
+     *
+     * Only setting_id of setting and option_id of option needs to be set.
+     *
+     * This function can be awaited. See 'set_setting_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_setting_awaitable(Setting setting)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_setting_async(setting, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for get_setting_async.
      */
@@ -876,6 +1011,24 @@ public:
      */
     std::pair<Result, Camera::Setting> get_setting(Setting setting) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Get a setting.
+     *
+     * Only setting_id of setting needs to be set.
+     *
+     * This function can be awaited. See 'get_setting_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, Setting> get_setting_awaitable(Setting setting)
+    {
+        return Awaitable<Result, Setting>([=, this](auto callback) {
+            get_setting_async(setting, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Format storage (e.g. SD card) in camera.
      *
@@ -896,6 +1049,24 @@ public:
      */
     Result format_storage(int32_t storage_id) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Format storage (e.g. SD card) in camera.
+     *
+     * This will delete all content of the camera storage!
+     *
+     * This function can be awaited. See 'format_storage_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> format_storage_awaitable(int32_t storage_id)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            format_storage_async(storage_id, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Select current camera .
      *
@@ -927,6 +1098,22 @@ public:
      */
     Result reset_settings() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Reset all settings in camera.
+     *
+     * This will reset all camera settings to default value
+     *
+     * This function can be awaited. See 'reset_settings_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> reset_settings_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { reset_settings_async(callback); });
+    }
+#endif
+
     /**
      * @brief Manual set the definition data
      *
@@ -17,6 +17,7 @@
 #include "server_plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -161,6 +162,22 @@ public:
      */
     std::pair<Result, std::vector<std::string>> list_directory(std::string remote_dir) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Lists items from a remote directory.
+     *
+     * This function can be awaited. See 'list_directory_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, std::vector<std::string>> list_directory_awaitable(std::string remote_dir)
+    {
+        return Awaitable<Result, std::vector<std::string>>([=, this](auto callback) {
+            list_directory_async(remote_dir, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Creates a remote directory.
      *
@@ -177,6 +194,22 @@ public:
      */
     Result create_directory(std::string remote_dir) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Creates a remote directory.
+     *
+     * This function can be awaited. See 'create_directory_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> create_directory_awaitable(std::string remote_dir)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            create_directory_async(remote_dir, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Removes a remote directory.
      *
@@ -193,6 +226,22 @@ public:
      */
     Result remove_directory(std::string remote_dir) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Removes a remote directory.
+     *
+     * This function can be awaited. See 'remove_directory_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> remove_directory_awaitable(std::string remote_dir)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            remove_directory_async(remote_dir, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Removes a remote file.
      *
@@ -209,6 +258,22 @@ public:
      */
     Result remove_file(std::string remote_file_path) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Removes a remote file.
+     *
+     * This function can be awaited. See 'remove_file_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> remove_file_awaitable(std::string remote_file_path)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            remove_file_async(remote_file_path, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Renames a remote file or remote directory.
      *
@@ -226,6 +291,22 @@ public:
      */
     Result rename(std::string remote_from_path, std::string remote_to_path) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Renames a remote file or remote directory.
+     *
+     * This function can be awaited. See 'rename_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> rename_awaitable(std::string remote_from_path, std::string remote_to_path)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            rename_async(remote_from_path, remote_to_path, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for are_files_identical_async.
      */
@@ -251,6 +332,23 @@ public:
     std::pair<Result, bool>
     are_files_identical(std::string local_file_path, std::string remote_file_path) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Compares a local file to a remote file using a CRC32 checksum.
+     *
+     * This function can be awaited. See 'are_files_identical_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, bool> are_files_identical_awaitable(
+        std::string local_file_path, std::string remote_file_path)
+    {
+        return Awaitable<Result, bool>([=, this](auto callback) {
+            are_files_identical_async(local_file_path, remote_file_path, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set root directory for MAVLink FTP server.
      *
@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -210,6 +211,25 @@ public:
      */
     Result upload_geofence(GeofenceData geofence_data) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Upload geofences.
+     *
+     * Polygon and Circular geofences are uploaded to a drone. Once uploaded, the geofence will
+     * remain on the drone even if a connection is lost.
+     *
+     * This function can be awaited. See 'upload_geofence_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> upload_geofence_awaitable(GeofenceData geofence_data)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            upload_geofence_async(geofence_data, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Clear all geofences saved on the vehicle.
      *
@@ -226,6 +246,20 @@ public:
      */
     Result clear_geofence() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Clear all geofences saved on the vehicle.
+     *
+     * This function can be awaited. See 'clear_geofence_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> clear_geofence_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { clear_geofence_async(callback); });
+    }
+#endif
+
     /**
      * @brief Copy constructor.
      */
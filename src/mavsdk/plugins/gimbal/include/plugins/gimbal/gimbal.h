@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -167,6 +168,26 @@ public:
      */
     Result set_pitch_and_yaw(float pitch_deg, float yaw_deg) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set gimbal pitch and yaw angles.
+     *
+     * This sets the desired pitch and yaw angles of a gimbal.
+     * Will return when the command is accepted, however, it might
+     * take the gimbal longer to actually be set to the new angles.
+     *
+     * This function can be awaited. See 'set_pitch_and_yaw_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_pitch_and_yaw_awaitable(float pitch_deg, float yaw_deg)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_pitch_and_yaw_async(pitch_deg, yaw_deg, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set gimbal angular rates around pitch and yaw axes.
      *
@@ -194,6 +215,28 @@ public:
      */
     Result set_pitch_rate_and_yaw_rate(float pitch_rate_deg_s, float yaw_rate_deg_s) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set gimbal angular rates around pitch and yaw axes.
+     *
+     * This sets the desired angular rates around pitch and yaw axes of a gimbal.
+     * Will return when the command is accepted, however, it might
+     * take the gimbal longer to actually reach the angular rate.
+     *
+     * This function can be awaited. See 'set_pitch_rate_and_yaw_rate_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_pitch_rate_and_yaw_rate_awaitable(
+        float pitch_rate_deg_s, float yaw_rate_deg_s)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_pitch_rate_and_yaw_rate_async(pitch_rate_deg_s, yaw_rate_deg_s, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set gimbal mode.
      *
@@ -218,6 +261,26 @@ public:
      */
     Result set_mode(GimbalMode gimbal_mode) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set gimbal mode.
+     *
+     * This sets the desired yaw mode of a gimbal.
+     * Will return when the command is accepted. However, it might
+     * take the gimbal longer to actually be set to the new angles.
+     *
+     * This function can be awaited. See 'set_mode_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_mode_awaitable(GimbalMode gimbal_mode)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_mode_async(gimbal_mode, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set gimbal region of interest (ROI).
      *
@@ -247,6 +310,29 @@ public:
      */
     Result set_roi_location(double latitude_deg, double longitude_deg, float altitude_m) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set gimbal region of interest (ROI).
+     *
+     * This sets a region of interest that the gimbal will point to.
+     * The gimbal will continue to point to the specified region until it
+     * receives a new command.
+     * The function will return when the command is accepted, however, it might
+     * take the gimbal longer to actually rotate to the ROI.
+     *
+     * This function can be awaited. See 'set_roi_location_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_roi_location_awaitable(
+        double latitude_deg, double longitude_deg, float altitude_m)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_roi_location_async(latitude_deg, longitude_deg, altitude_m, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Take control.
      *
@@ -279,6 +365,30 @@ public:
      */
     Result take_control(ControlMode control_mode) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Take control.
+     *
+     * There can be only two components in control of a gimbal at any given time.
+     * One with "primary" control, and one with "secondary" control. The way the
+     * secondary control is implemented is not specified and hence depends on the
+     * vehicle.
+     *
+     * Components are expected to be cooperative, which means that they can
+     * override each other and should therefore do it carefully.
+     *
+     * This function can be awaited. See 'take_control_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> take_control_awaitable(ControlMode control_mode)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            take_control_async(control_mode, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Release control.
      *
@@ -299,6 +409,22 @@ public:
      */
     Result release_control() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Release control.
+     *
+     * Release control, such that other components can control the gimbal.
+     *
+     * This function can be awaited. See 'release_control_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> release_control_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { release_control_async(callback); });
+    }
+#endif
+
     /**
      * @brief Callback type for subscribe_control.
      */
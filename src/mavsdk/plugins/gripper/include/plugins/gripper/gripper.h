@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -118,6 +119,20 @@ public:
      */
     Result grab(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Gripper grab cargo.
+     *
+     * This function can be awaited. See 'grab_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> grab_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) { grab_async(instance, callback); });
+    }
+#endif
+
     /**
      * @brief Gripper release cargo.
      *
@@ -134,6 +149,20 @@ public:
      */
     Result release(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Gripper release cargo.
+     *
+     * This function can be awaited. See 'release_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> release_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) { release_async(instance, callback); });
+    }
+#endif
+
     /**
      * @brief Copy constructor.
      */
@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -151,6 +152,22 @@ public:
      */
     std::pair<Result, std::vector<LogFiles::Entry>> get_entries() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Get List of log files.
+     *
+     * This function can be awaited. See 'get_entries_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, std::vector<Entry>> get_entries_awaitable()
+    {
+        return Awaitable<Result, std::vector<Entry>>([=, this](auto callback) {
+            get_entries_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for download_log_file_async.
      */
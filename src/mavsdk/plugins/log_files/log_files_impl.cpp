@@ -94,7 +94,9 @@ void LogFilesImpl::get_entries_async(LogFiles::GetEntriesCallback callback)
     }
 
     _system_impl->register_timeout_handler(
-        [this]() { list_timeout(); }, LIST_TIMEOUT_S, &_entries.cookie);
+        [this]() { list_timeout(); },
+        _system_impl->timeout_s(LIST_INITIAL_TIMEOUT_S),
+        &_entries.cookie);
 
     request_list_entry(-1);
 }
@@ -197,7 +199,9 @@ void LogFilesImpl::list_timeout()
                 }
             }
             _system_impl->register_timeout_handler(
-                [this]() { list_timeout(); }, LIST_TIMEOUT_S, &_entries.cookie);
+                [this]() { list_timeout(); },
+                _system_impl->timeout_s(LIST_INITIAL_TIMEOUT_S),
+                &_entries.cookie);
             _entries.retries++;
         }
     }
@@ -298,7 +302,9 @@ void LogFilesImpl::download_log_file_async(
             ((part_size % MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) != 0));
 
         _system_impl->register_timeout_handler(
-            [this]() { LogFilesImpl::data_timeout(); }, DATA_TIMEOUT_S, &_data.cookie);
+            [this]() { LogFilesImpl::data_timeout(); },
+            _system_impl->timeout_s(DATA_INITIAL_TIMEOUT_S),
+            &_data.cookie);
 
         request_log_data(_data.id, _data.part_start, _data.bytes.size());
 
@@ -475,7 +481,9 @@ void LogFilesImpl::data_timeout()
     {
         std::lock_guard<std::mutex> lock(_data.mutex);
         _system_impl->register_timeout_handler(
-            [this]() { LogFilesImpl::data_timeout(); }, DATA_TIMEOUT_S, &_data.cookie);
+            [this]() { LogFilesImpl::data_timeout(); },
+            _system_impl->timeout_s(DATA_INITIAL_TIMEOUT_S),
+            &_data.cookie);
         _data.rerequesting = true;
         check_part();
     }
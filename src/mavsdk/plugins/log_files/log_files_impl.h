@@ -56,8 +56,9 @@ private:
     std::size_t determine_part_end();
     void reset_data();
 
-    static constexpr double LIST_TIMEOUT_S = 0.2;
-    static constexpr double DATA_TIMEOUT_S = 0.1;
+    // The timeouts adapt to the round trip time once it has been measured.
+    static constexpr double LIST_INITIAL_TIMEOUT_S = 0.2;
+    static constexpr double DATA_INITIAL_TIMEOUT_S = 0.1;
 
     Time _time{};
 
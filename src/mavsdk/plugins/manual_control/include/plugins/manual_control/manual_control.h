@@ -17,6 +17,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -109,6 +110,26 @@ public:
      */
     Result start_position_control() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Start position control using e.g. joystick input.
+     *
+     * Requires manual control input to be sent regularly already.
+     * Requires a valid position using e.g. GPS, external vision, or optical flow.
+     *
+     * This function can be awaited. See 'start_position_control_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> start_position_control_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            start_position_control_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Start altitude control
      *
@@ -132,6 +153,26 @@ public:
      */
     Result start_altitude_control() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Start altitude control
+     *
+     * Requires manual control input to be sent regularly already.
+     * Does not require a  valid position e.g. GPS.
+     *
+     * This function can be awaited. See 'start_altitude_control_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> start_altitude_control_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            start_altitude_control_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set manual control input
      *
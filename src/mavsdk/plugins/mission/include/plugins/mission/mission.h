@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -301,6 +302,80 @@ public:
      */
     Result upload_mission(MissionPlan mission_plan) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Upload a list of mission items to the system.
+     *
+     * The mission items are uploaded to a drone. Once uploaded the mission can be started and
+     * executed even if the connection is lost.
+     *
+     * This function can be awaited. See 'upload_mission_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> upload_mission_awaitable(MissionPlan mission_plan)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            upload_mission_async(mission_plan, callback);
+        });
+    }
+#endif
+
+    /**
+     * @brief Upload only the mission items which changed.
+     *
+     * The mission is compared to the one last uploaded, downloaded or cleared, and only the
+     * mission items which differ are sent using MISSION_WRITE_PARTIAL_LIST. This assumes that
+     * the mission on the drone was not changed by anyone else in the meantime.
+     *
+     * If the number of mission items changed, no mission is known yet, or the drone does not
+     * support partial uploads, the whole mission is uploaded instead.
+     *
+     * This function is non-blocking. See 'upload_mission_changes' for the blocking counterpart.
+     */
+    void upload_mission_changes_async(MissionPlan mission_plan, const ResultCallback callback);
+
+    /**
+     * @brief Upload only the mission items which changed.
+     *
+     * The mission is compared to the one last uploaded, downloaded or cleared, and only the
+     * mission items which differ are sent using MISSION_WRITE_PARTIAL_LIST. This assumes that
+     * the mission on the drone was not changed by anyone else in the meantime.
+     *
+     * If the number of mission items changed, no mission is known yet, or the drone does not
+     * support partial uploads, the whole mission is uploaded instead.
+     *
+     * This function is blocking. See 'upload_mission_changes_async' for the non-blocking
+     * counterpart.
+     *
+     * @return Result of request.
+     */
+    Result upload_mission_changes(MissionPlan mission_plan) const;
+
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Upload only the mission items which changed.
+     *
+     * The mission is compared to the one last uploaded, downloaded or cleared, and only the
+     * mission items which differ are sent using MISSION_WRITE_PARTIAL_LIST. This assumes that
+     * the mission on the drone was not changed by anyone else in the meantime.
+     *
+     * If the number of mission items changed, no mission is known yet, or the drone does not
+     * support partial uploads, the whole mission is uploaded instead.
+     *
+     * This function can be awaited. See 'upload_mission_changes_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> upload_mission_changes_awaitable(MissionPlan mission_plan)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            upload_mission_changes_async(mission_plan, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for upload_mission_with_progress_async.
      */
@@ -351,6 +426,25 @@ public:
      */
     std::pair<Result, Mission::MissionPlan> download_mission() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Download a list of mission items from the system (asynchronous).
+     *
+     * Will fail if any of the downloaded mission items are not supported
+     * by the MAVSDK API.
+     *
+     * This function can be awaited. See 'download_mission_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, MissionPlan> download_mission_awaitable()
+    {
+        return Awaitable<Result, MissionPlan>([=, this](auto callback) {
+            download_mission_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for download_mission_with_progress_async.
      */
@@ -393,6 +487,22 @@ public:
      */
     Result start_mission() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Start the mission.
+     *
+     * A mission must be uploaded to the vehicle before this can be called.
+     *
+     * This function can be awaited. See 'start_mission_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> start_mission_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { start_mission_async(callback); });
+    }
+#endif
+
     /**
      * @brief Pause the mission.
      *
@@ -419,6 +529,25 @@ public:
      */
     Result pause_mission() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Pause the mission.
+     *
+     * Pausing the mission puts the vehicle into
+     * [HOLD mode](https://docs.px4.io/en/flight_modes/hold.html).
+     * A multicopter should just hover at the spot while a fixedwing vehicle should loiter
+     * around the location where it paused.
+     *
+     * This function can be awaited. See 'pause_mission_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> pause_mission_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { pause_mission_async(callback); });
+    }
+#endif
+
     /**
      * @brief Clear the mission saved on the vehicle.
      *
@@ -435,6 +564,20 @@ public:
      */
     Result clear_mission() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Clear the mission saved on the vehicle.
+     *
+     * This function can be awaited. See 'clear_mission_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> clear_mission_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { clear_mission_async(callback); });
+    }
+#endif
+
     /**
      * @brief Sets the mission item index to go to.
      *
@@ -464,6 +607,29 @@ public:
      */
     Result set_current_mission_item(int32_t index) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Sets the mission item index to go to.
+     *
+     * By setting the current index to 0, the mission is restarted from the beginning. If it is set
+     * to a specific index of a mission item, the mission will be set to this item.
+     *
+     * Note that this is not necessarily true for general missions using MAVLink if loop counters
+     * are used.
+     *
+     * This function can be awaited. See 'set_current_mission_item_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_current_mission_item_awaitable(int32_t index)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_current_mission_item_async(index, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Check if the mission has been finished.
      *
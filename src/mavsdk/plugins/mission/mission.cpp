@@ -35,6 +35,16 @@ Mission::Result Mission::upload_mission(MissionPlan mission_plan) const
     return _impl->upload_mission(mission_plan);
 }
 
+void Mission::upload_mission_changes_async(MissionPlan mission_plan, const ResultCallback callback)
+{
+    _impl->upload_mission_async(mission_plan, callback, true);
+}
+
+Mission::Result Mission::upload_mission_changes(MissionPlan mission_plan) const
+{
+    return _impl->upload_mission(mission_plan, true);
+}
+
 void Mission::upload_mission_with_progress_async(
     MissionPlan mission_plan, const UploadMissionWithProgressCallback& callback)
 {
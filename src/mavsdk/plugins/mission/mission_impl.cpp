@@ -130,17 +130,23 @@ void MissionImpl::receive_protocol_timeout()
     _gimbal_protocol_cookie = nullptr;
 }
 
-Mission::Result MissionImpl::upload_mission(const Mission::MissionPlan& mission_plan)
+Mission::Result
+MissionImpl::upload_mission(const Mission::MissionPlan& mission_plan, bool only_changes)
 {
     auto prom = std::promise<Mission::Result>();
     auto fut = prom.get_future();
 
-    upload_mission_async(mission_plan, [&prom](Mission::Result result) { prom.set_value(result); });
+    upload_mission_async(
+        mission_plan,
+        [&prom](Mission::Result result) { prom.set_value(result); },
+        only_changes);
     return fut.get();
 }
 
 void MissionImpl::upload_mission_async(
-    const Mission::MissionPlan& mission_plan, const Mission::ResultCallback& callback)
+    const Mission::MissionPlan& mission_plan,
+    const Mission::ResultCallback& callback,
+    bool only_changes)
 {
     if (_mission_data.last_upload.lock()) {
         _system_impl->call_user_callback([callback]() {
@@ -153,20 +159,25 @@ void MissionImpl::upload_mission_async(
 
     reset_mission_progress();
 
-    wait_for_protocol_async([callback, mission_plan, this]() {
+    wait_for_protocol_async([callback, mission_plan, only_changes, this]() {
         const auto int_items = convert_to_int_items(mission_plan.mission_items);
 
-        _mission_data.last_upload = _system_impl->mission_transfer().upload_items_async(
-            MAV_MISSION_TYPE_MISSION,
-            int_items,
-            [this, callback](MavlinkMissionTransfer::Result result) {
-                auto converted_result = convert_result(result);
-                _system_impl->call_user_callback([callback, converted_result]() {
-                    if (callback) {
-                        callback(converted_result);
-                    }
-                });
+        auto transfer_callback = [this, callback](MavlinkMissionTransfer::Result result) {
+            auto converted_result = convert_result(result);
+            _system_impl->call_user_callback([callback, converted_result]() {
+                if (callback) {
+                    callback(converted_result);
+                }
             });
+        };
+
+        if (only_changes) {
+            _mission_data.last_upload = _system_impl->mission_transfer().upload_changed_items_async(
+                MAV_MISSION_TYPE_MISSION, int_items, transfer_callback);
+        } else {
+            _mission_data.last_upload = _system_impl->mission_transfer().upload_items_async(
+                MAV_MISSION_TYPE_MISSION, int_items, transfer_callback);
+        }
     });
 }
 
@@ -26,10 +26,13 @@ public:
     void enable() override;
     void disable() override;
 
-    Mission::Result upload_mission(const Mission::MissionPlan& mission_plan);
+    Mission::Result
+    upload_mission(const Mission::MissionPlan& mission_plan, bool only_changes = false);
 
     void upload_mission_async(
-        const Mission::MissionPlan& mission_plan, const Mission::ResultCallback& callback);
+        const Mission::MissionPlan& mission_plan,
+        const Mission::ResultCallback& callback,
+        bool only_changes = false);
     void upload_mission_with_progress_async(
         const Mission::MissionPlan& mission_plan,
         const Mission::UploadMissionWithProgressCallback callback);
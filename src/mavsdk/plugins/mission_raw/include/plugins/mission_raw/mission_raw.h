@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -168,6 +169,7 @@ public:
         ProtocolError, /**< @brief There was a protocol error. */
         IntMessagesNotSupported, /**< @brief The system does not support the MISSION_INT protocol.
                                   */
+        Unchanged, /**< @brief The mission is unchanged, the items are from the cache. */
     };
 
     /**
@@ -205,6 +207,65 @@ public:
      */
     Result upload_mission(std::vector<MissionItem> mission_items) const;
 
+    /**
+     * @brief Upload only the raw mission items which changed.
+     *
+     * The items are compared to the mission last uploaded, downloaded or cleared
+     * using this plugin, and only the items which differ are sent using
+     * MISSION_WRITE_PARTIAL_LIST. This assumes that the mission on the drone
+     * was not changed by anyone else in the meantime.
+     *
+     * If the number of items changed, no mission is known yet, or the drone
+     * does not support partial uploads, the whole mission is uploaded instead.
+     *
+     * This function is non-blocking. See 'upload_mission_changes' for the blocking counterpart.
+     */
+    void upload_mission_changes_async(
+        std::vector<MissionItem> mission_items, const ResultCallback callback);
+
+    /**
+     * @brief Upload only the raw mission items which changed.
+     *
+     * The items are compared to the mission last uploaded, downloaded or cleared
+     * using this plugin, and only the items which differ are sent using
+     * MISSION_WRITE_PARTIAL_LIST. This assumes that the mission on the drone
+     * was not changed by anyone else in the meantime.
+     *
+     * If the number of items changed, no mission is known yet, or the drone
+     * does not support partial uploads, the whole mission is uploaded instead.
+     *
+     * This function is blocking. See 'upload_mission_changes_async' for the non-blocking
+     * counterpart.
+     *
+     * @return Result of request.
+     */
+    Result upload_mission_changes(std::vector<MissionItem> mission_items) const;
+
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Upload only the raw mission items which changed.
+     *
+     * The items are compared to the mission last uploaded, downloaded or cleared
+     * using this plugin, and only the items which differ are sent using
+     * MISSION_WRITE_PARTIAL_LIST. This assumes that the mission on the drone
+     * was not changed by anyone else in the meantime.
+     *
+     * If the number of items changed, no mission is known yet, or the drone
+     * does not support partial uploads, the whole mission is uploaded instead.
+     *
+     * This function can be awaited. See 'upload_mission_changes_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> upload_mission_changes_awaitable(std::vector<MissionItem> mission_items)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            upload_mission_changes_async(mission_items, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Upload a list of geofence items to the system.
      *
@@ -239,6 +300,22 @@ public:
      */
     Result upload_rally_points(std::vector<MissionItem> mission_items) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Upload a list of rally point items to the system.
+     *
+     * This function can be awaited. See 'upload_rally_points_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> upload_rally_points_awaitable(std::vector<MissionItem> mission_items)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            upload_rally_points_async(mission_items, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Cancel an ongoing mission upload.
      *
@@ -269,6 +346,77 @@ public:
      */
     std::pair<Result, std::vector<MissionRaw::MissionItem>> download_mission() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Download a list of raw mission items from the system (asynchronous).
+     *
+     * This function can be awaited. See 'download_mission_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, std::vector<MissionItem>> download_mission_awaitable()
+    {
+        return Awaitable<Result, std::vector<MissionItem>>([=, this](auto callback) {
+            download_mission_async(callback);
+        });
+    }
+#endif
+
+    /**
+     * @brief Download a list of raw mission items from the system unless it is unchanged.
+     *
+     * The mission last uploaded or downloaded is kept in memory together with the id the system
+     * reported for it (opaque_id in MISSION_ACK, MISSION_COUNT and MISSION_CURRENT). If the
+     * system reports the same id again, the download is skipped and the kept items are returned
+     * with Result::Unchanged.
+     *
+     * Systems which don't report mission ids always get the whole mission downloaded.
+     *
+     * This function is non-blocking. See 'download_mission_cached' for the blocking counterpart.
+     */
+    void download_mission_cached_async(const DownloadMissionCallback callback);
+
+    /**
+     * @brief Download a list of raw mission items from the system unless it is unchanged.
+     *
+     * The mission last uploaded or downloaded is kept in memory together with the id the system
+     * reported for it (opaque_id in MISSION_ACK, MISSION_COUNT and MISSION_CURRENT). If the
+     * system reports the same id again, the download is skipped and the kept items are returned
+     * with Result::Unchanged.
+     *
+     * Systems which don't report mission ids always get the whole mission downloaded.
+     *
+     * This function is blocking. See 'download_mission_cached_async' for the non-blocking
+     * counterpart.
+     *
+     * @return Result of request.
+     */
+    std::pair<Result, std::vector<MissionRaw::MissionItem>> download_mission_cached() const;
+
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Download a list of raw mission items from the system unless it is unchanged.
+     *
+     * The mission last uploaded or downloaded is kept in memory together with the id the system
+     * reported for it (opaque_id in MISSION_ACK, MISSION_COUNT and MISSION_CURRENT). If the
+     * system reports the same id again, the download is skipped and the kept items are returned
+     * with Result::Unchanged.
+     *
+     * Systems which don't report mission ids always get the whole mission downloaded.
+     *
+     * This function can be awaited. See 'download_mission_cached_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, std::vector<MissionItem>> download_mission_cached_awaitable()
+    {
+        return Awaitable<Result, std::vector<MissionItem>>([=, this](auto callback) {
+            download_mission_cached_async(callback);
+        });
+    }
+#endif
+
     /**
      * @brief Cancel an ongoing mission download.
      *
@@ -298,6 +446,22 @@ public:
      */
     Result start_mission() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Start the mission.
+     *
+     * A mission must be uploaded to the vehicle before this can be called.
+     *
+     * This function can be awaited. See 'start_mission_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> start_mission_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { start_mission_async(callback); });
+    }
+#endif
+
     /**
      * @brief Pause the mission.
      *
@@ -324,6 +488,25 @@ public:
      */
     Result pause_mission() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Pause the mission.
+     *
+     * Pausing the mission puts the vehicle into
+     * [HOLD mode](https://docs.px4.io/en/flight_modes/hold.html).
+     * A multicopter should just hover at the spot while a fixedwing vehicle should loiter
+     * around the location where it paused.
+     *
+     * This function can be awaited. See 'pause_mission_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> pause_mission_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { pause_mission_async(callback); });
+    }
+#endif
+
     /**
      * @brief Clear the mission saved on the vehicle.
      *
@@ -340,6 +523,20 @@ public:
      */
     Result clear_mission() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Clear the mission saved on the vehicle.
+     *
+     * This function can be awaited. See 'clear_mission_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> clear_mission_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { clear_mission_async(callback); });
+    }
+#endif
+
     /**
      * @brief Sets the raw mission item index to go to.
      *
@@ -363,6 +560,26 @@ public:
      */
     Result set_current_mission_item(int32_t index) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Sets the raw mission item index to go to.
+     *
+     * By setting the current index to 0, the mission is restarted from the beginning. If it is set
+     * to a specific index of a raw mission item, the mission will be set to this item.
+     *
+     * This function can be awaited. See 'set_current_mission_item_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_current_mission_item_awaitable(int32_t index)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_current_mission_item_async(index, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for subscribe_mission_progress.
      */
@@ -36,6 +36,17 @@ MissionRaw::Result MissionRaw::upload_mission(std::vector<MissionItem> mission_i
     return _impl->upload_mission(mission_items);
 }
 
+void MissionRaw::upload_mission_changes_async(
+    std::vector<MissionItem> mission_items, const ResultCallback callback)
+{
+    _impl->upload_mission_changes_async(mission_items, callback);
+}
+
+MissionRaw::Result MissionRaw::upload_mission_changes(std::vector<MissionItem> mission_items) const
+{
+    return _impl->upload_mission_changes(mission_items);
+}
+
 void MissionRaw::upload_geofence_async(
     std::vector<MissionItem> mission_items, const ResultCallback callback)
 {
@@ -74,6 +85,17 @@ MissionRaw::download_mission() const
     return _impl->download_mission();
 }
 
+void MissionRaw::download_mission_cached_async(const DownloadMissionCallback callback)
+{
+    _impl->download_mission_async(callback, true);
+}
+
+std::pair<MissionRaw::Result, std::vector<MissionRaw::MissionItem>>
+MissionRaw::download_mission_cached() const
+{
+    return _impl->download_mission(true);
+}
+
 MissionRaw::Result MissionRaw::cancel_mission_download() const
 {
     return _impl->cancel_mission_download();
@@ -284,6 +306,8 @@ std::ostream& operator<<(std::ostream& str, MissionRaw::Result const& result)
             return str << "Protocol Error";
         case MissionRaw::Result::IntMessagesNotSupported:
             return str << "Int Messages Not Supported";
+        case MissionRaw::Result::Unchanged:
+            return str << "Unchanged";
         default:
             return str << "Unknown";
     }
@@ -132,7 +132,8 @@ MissionRaw::Result MissionRawImpl::upload_mission_items(
 void MissionRawImpl::upload_mission_items_async(
     const std::vector<MissionRaw::MissionItem>& mission_raw,
     uint8_t type,
-    const MissionRaw::ResultCallback& callback)
+    const MissionRaw::ResultCallback& callback,
+    bool only_changes)
 {
     if (_last_upload.lock()) {
         _system_impl->call_user_callback([callback]() {
@@ -147,16 +148,23 @@ void MissionRawImpl::upload_mission_items_async(
 
     const auto int_items = convert_to_int_items(mission_raw);
 
-    _last_upload = _system_impl->mission_transfer().upload_items_async(
-        type, int_items, [this, callback, int_items](MavlinkMissionTransfer::Result result) {
-            auto converted_result = convert_result(result);
-            auto converted_items = convert_items(int_items);
-            _system_impl->call_user_callback([callback, converted_result, converted_items]() {
-                if (callback) {
-                    callback(converted_result);
-                }
-            });
+    auto transfer_callback = [this, callback, int_items](MavlinkMissionTransfer::Result result) {
+        auto converted_result = convert_result(result);
+        auto converted_items = convert_items(int_items);
+        _system_impl->call_user_callback([callback, converted_result, converted_items]() {
+            if (callback) {
+                callback(converted_result);
+            }
         });
+    };
+
+    if (only_changes) {
+        _last_upload = _system_impl->mission_transfer().upload_changed_items_async(
+            type, int_items, transfer_callback);
+    } else {
+        _last_upload = _system_impl->mission_transfer().upload_items_async(
+            type, int_items, transfer_callback);
+    }
 }
 
 MissionRaw::Result
@@ -172,6 +180,24 @@ void MissionRawImpl::upload_mission_async(
     upload_mission_items_async(mission_raw, MAV_MISSION_TYPE_MISSION, callback);
 }
 
+MissionRaw::Result
+MissionRawImpl::upload_mission_changes(std::vector<MissionRaw::MissionItem> mission_items)
+{
+    auto prom = std::promise<MissionRaw::Result>();
+    auto fut = prom.get_future();
+
+    upload_mission_changes_async(
+        mission_items, [&prom](MissionRaw::Result result) { prom.set_value(result); });
+    return fut.get();
+}
+
+void MissionRawImpl::upload_mission_changes_async(
+    const std::vector<MissionRaw::MissionItem>& mission_raw,
+    const MissionRaw::ResultCallback& callback)
+{
+    upload_mission_items_async(mission_raw, MAV_MISSION_TYPE_MISSION, callback, true);
+}
+
 MissionRaw::Result
 MissionRawImpl::upload_geofence(std::vector<MissionRaw::MissionItem> mission_items)
 {
@@ -210,7 +236,7 @@ MissionRaw::Result MissionRawImpl::cancel_mission_upload()
 }
 
 std::pair<MissionRaw::Result, std::vector<MissionRaw::MissionItem>>
-MissionRawImpl::download_mission()
+MissionRawImpl::download_mission(bool use_cache)
 {
     auto prom = std::promise<std::pair<MissionRaw::Result, std::vector<MissionRaw::MissionItem>>>();
     auto fut = prom.get_future();
@@ -218,11 +244,13 @@ MissionRawImpl::download_mission()
     download_mission_async(
         [&prom](MissionRaw::Result result, std::vector<MissionRaw::MissionItem> mission_items) {
             prom.set_value(std::make_pair<>(result, mission_items));
-        });
+        },
+        use_cache);
     return fut.get();
 }
 
-void MissionRawImpl::download_mission_async(const MissionRaw::DownloadMissionCallback& callback)
+void MissionRawImpl::download_mission_async(
+    const MissionRaw::DownloadMissionCallback& callback, bool use_cache)
 {
     if (_last_download.lock()) {
         _system_impl->call_user_callback([callback]() {
@@ -234,17 +262,23 @@ void MissionRawImpl::download_mission_async(const MissionRaw::DownloadMissionCal
         return;
     }
 
-    _last_download = _system_impl->mission_transfer().download_items_async(
-        MAV_MISSION_TYPE_MISSION,
-        [this, callback](
-            MavlinkMissionTransfer::Result result,
-            std::vector<MavlinkMissionTransfer::ItemInt> items) {
-            auto converted_result = convert_result(result);
-            auto converted_items = convert_items(items);
-            _system_impl->call_user_callback([callback, converted_result, converted_items]() {
-                callback(converted_result, converted_items);
-            });
+    auto transfer_callback = [this, callback](
+                                 MavlinkMissionTransfer::Result result,
+                                 std::vector<MavlinkMissionTransfer::ItemInt> items) {
+        auto converted_result = convert_result(result);
+        auto converted_items = convert_items(items);
+        _system_impl->call_user_callback([callback, converted_result, converted_items]() {
+            callback(converted_result, converted_items);
         });
+    };
+
+    if (use_cache) {
+        _last_download = _system_impl->mission_transfer().download_items_cached_async(
+            MAV_MISSION_TYPE_MISSION, transfer_callback);
+    } else {
+        _last_download = _system_impl->mission_transfer().download_items_async(
+            MAV_MISSION_TYPE_MISSION, transfer_callback);
+    }
 }
 
 MissionRaw::Result MissionRawImpl::cancel_mission_download()
@@ -582,6 +616,8 @@ MissionRaw::Result MissionRawImpl::convert_result(MavlinkMissionTransfer::Result
             return MissionRaw::Result::InvalidArgument;
         case MavlinkMissionTransfer::Result::IntMessagesNotSupported:
             return MissionRaw::Result::IntMessagesNotSupported;
+        case MavlinkMissionTransfer::Result::Unchanged:
+            return MissionRaw::Result::Unchanged;
         default:
             return MissionRaw::Result::Unknown;
     }
@@ -22,14 +22,20 @@ public:
     void enable() override;
     void disable() override;
 
-    std::pair<MissionRaw::Result, std::vector<MissionRaw::MissionItem>> download_mission();
-    void download_mission_async(const MissionRaw::DownloadMissionCallback& callback);
+    std::pair<MissionRaw::Result, std::vector<MissionRaw::MissionItem>>
+    download_mission(bool use_cache = false);
+    void download_mission_async(
+        const MissionRaw::DownloadMissionCallback& callback, bool use_cache = false);
     MissionRaw::Result cancel_mission_download();
 
     MissionRaw::Result upload_mission(std::vector<MissionRaw::MissionItem> mission_items);
     void upload_mission_async(
         const std::vector<MissionRaw::MissionItem>& mission_raw,
         const MissionRaw::ResultCallback& callback);
+    MissionRaw::Result upload_mission_changes(std::vector<MissionRaw::MissionItem> mission_items);
+    void upload_mission_changes_async(
+        const std::vector<MissionRaw::MissionItem>& mission_raw,
+        const MissionRaw::ResultCallback& callback);
     MissionRaw::Result upload_geofence(std::vector<MissionRaw::MissionItem> mission_items);
     void upload_geofence_async(
         const std::vector<MissionRaw::MissionItem>& mission_raw,
@@ -109,7 +115,8 @@ private:
     void upload_mission_items_async(
         const std::vector<MissionRaw::MissionItem>& mission_raw,
         uint8_t type,
-        const MissionRaw::ResultCallback& callback);
+        const MissionRaw::ResultCallback& callback,
+        bool only_changes = false);
 
     // TODO: check if these need a mutex as well.
     std::weak_ptr<MavlinkMissionTransfer::WorkItem> _last_upload{};
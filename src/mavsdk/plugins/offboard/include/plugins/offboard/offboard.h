@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -374,6 +375,20 @@ public:
      */
     Result start() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Start offboard control.
+     *
+     * This function can be awaited. See 'start_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> start_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { start_async(callback); });
+    }
+#endif
+
     /**
      * @brief Stop offboard control.
      *
@@ -394,6 +409,22 @@ public:
      */
     Result stop() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Stop offboard control.
+     *
+     * The vehicle will be put into Hold mode: https://docs.px4.io/en/flight_modes/hold.html
+     *
+     * This function can be awaited. See 'stop_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> stop_awaitable()
+    {
+        return Awaitable<Result>([=, this](auto callback) { stop_async(callback); });
+    }
+#endif
+
     /**
      * @brief Check if offboard control is active.
      *
@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -193,72 +194,249 @@ public:
      */
     using ResultCallback = std::function<void(Result)>;
 
+    /**
+     * @brief Callback type for get_param_int_async.
+     */
+    using GetParamIntCallback = std::function<void(Result, int32_t)>;
+
     /**
      * @brief Get an int parameter.
      *
      * If the type is wrong, the result will be `WRONG_TYPE`.
      *
-     * This function is blocking.
+     * This function is non-blocking. See 'get_param_int' for the blocking counterpart.
+     */
+    void get_param_int_async(std::string name, const GetParamIntCallback callback);
+
+    /**
+     * @brief Get an int parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function is blocking. See 'get_param_int_async' for the non-blocking counterpart.
      *
      * @return Result of request.
      */
     std::pair<Result, int32_t> get_param_int(std::string name) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Get an int parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function can be awaited. See 'get_param_int_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, int32_t> get_param_int_awaitable(std::string name)
+    {
+        return Awaitable<Result, int32_t>([=, this](auto callback) {
+            get_param_int_async(name, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set an int parameter.
      *
      * If the type is wrong, the result will be `WRONG_TYPE`.
      *
-     * This function is blocking.
+     * This function is non-blocking. See 'set_param_int' for the blocking counterpart.
+     */
+    void set_param_int_async(std::string name, int32_t value, const ResultCallback callback);
+
+    /**
+     * @brief Set an int parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function is blocking. See 'set_param_int_async' for the non-blocking counterpart.
      *
      * @return Result of request.
      */
     Result set_param_int(std::string name, int32_t value) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set an int parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function can be awaited. See 'set_param_int_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_param_int_awaitable(std::string name, int32_t value)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_param_int_async(name, value, callback);
+        });
+    }
+#endif
+
+    /**
+     * @brief Callback type for get_param_float_async.
+     */
+    using GetParamFloatCallback = std::function<void(Result, float)>;
+
     /**
      * @brief Get a float parameter.
      *
      * If the type is wrong, the result will be `WRONG_TYPE`.
      *
-     * This function is blocking.
+     * This function is non-blocking. See 'get_param_float' for the blocking counterpart.
+     */
+    void get_param_float_async(std::string name, const GetParamFloatCallback callback);
+
+    /**
+     * @brief Get a float parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function is blocking. See 'get_param_float_async' for the non-blocking counterpart.
      *
      * @return Result of request.
      */
     std::pair<Result, float> get_param_float(std::string name) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Get a float parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function can be awaited. See 'get_param_float_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, float> get_param_float_awaitable(std::string name)
+    {
+        return Awaitable<Result, float>([=, this](auto callback) {
+            get_param_float_async(name, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set a float parameter.
      *
      * If the type is wrong, the result will be `WRONG_TYPE`.
      *
-     * This function is blocking.
+     * This function is non-blocking. See 'set_param_float' for the blocking counterpart.
+     */
+    void set_param_float_async(std::string name, float value, const ResultCallback callback);
+
+    /**
+     * @brief Set a float parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function is blocking. See 'set_param_float_async' for the non-blocking counterpart.
      *
      * @return Result of request.
      */
     Result set_param_float(std::string name, float value) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set a float parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function can be awaited. See 'set_param_float_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_param_float_awaitable(std::string name, float value)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_param_float_async(name, value, callback);
+        });
+    }
+#endif
+
+    /**
+     * @brief Callback type for get_param_custom_async.
+     */
+    using GetParamCustomCallback = std::function<void(Result, std::string)>;
+
     /**
      * @brief Get a custom parameter.
      *
      * If the type is wrong, the result will be `WRONG_TYPE`.
      *
-     * This function is blocking.
+     * This function is non-blocking. See 'get_param_custom' for the blocking counterpart.
+     */
+    void get_param_custom_async(std::string name, const GetParamCustomCallback callback);
+
+    /**
+     * @brief Get a custom parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function is blocking. See 'get_param_custom_async' for the non-blocking counterpart.
      *
      * @return Result of request.
      */
     std::pair<Result, std::string> get_param_custom(std::string name) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Get a custom parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function can be awaited. See 'get_param_custom_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, std::string> get_param_custom_awaitable(std::string name)
+    {
+        return Awaitable<Result, std::string>([=, this](auto callback) {
+            get_param_custom_async(name, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set a custom parameter.
      *
      * If the type is wrong, the result will be `WRONG_TYPE`.
      *
-     * This function is blocking.
+     * This function is non-blocking. See 'set_param_custom' for the blocking counterpart.
+     */
+    void set_param_custom_async(std::string name, std::string value, const ResultCallback callback);
+
+    /**
+     * @brief Set a custom parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function is blocking. See 'set_param_custom_async' for the non-blocking counterpart.
      *
      * @return Result of request.
      */
     Result set_param_custom(std::string name, std::string value) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set a custom parameter.
+     *
+     * If the type is wrong, the result will be `WRONG_TYPE`.
+     *
+     * This function can be awaited. See 'set_param_custom_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_param_custom_awaitable(std::string name, std::string value)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_param_custom_async(name, value, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Get all parameters.
      *
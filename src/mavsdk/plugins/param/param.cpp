@@ -23,31 +23,62 @@ Param::Param(std::shared_ptr<System> system) :
 
 Param::~Param() {}
 
+void Param::get_param_int_async(std::string name, const GetParamIntCallback callback)
+{
+    _impl->get_param_int_async(name, callback);
+}
+
 std::pair<Param::Result, int32_t> Param::get_param_int(std::string name) const
 {
     return _impl->get_param_int(name);
 }
 
+void Param::set_param_int_async(std::string name, int32_t value, const ResultCallback callback)
+{
+    _impl->set_param_int_async(name, value, callback);
+}
+
 Param::Result Param::set_param_int(std::string name, int32_t value) const
 {
     return _impl->set_param_int(name, value);
 }
 
+void Param::get_param_float_async(std::string name, const GetParamFloatCallback callback)
+{
+    _impl->get_param_float_async(name, callback);
+}
+
 std::pair<Param::Result, float> Param::get_param_float(std::string name) const
 {
     return _impl->get_param_float(name);
 }
 
+void Param::set_param_float_async(std::string name, float value, const ResultCallback callback)
+{
+    _impl->set_param_float_async(name, value, callback);
+}
+
 Param::Result Param::set_param_float(std::string name, float value) const
 {
     return _impl->set_param_float(name, value);
 }
 
+void Param::get_param_custom_async(std::string name, const GetParamCustomCallback callback)
+{
+    _impl->get_param_custom_async(name, callback);
+}
+
 std::pair<Param::Result, std::string> Param::get_param_custom(std::string name) const
 {
     return _impl->get_param_custom(name);
 }
 
+void Param::set_param_custom_async(
+    std::string name, std::string value, const ResultCallback callback)
+{
+    _impl->set_param_custom_async(name, value, callback);
+}
+
 Param::Result Param::set_param_custom(std::string name, std::string value) const
 {
     return _impl->set_param_custom(name, value);
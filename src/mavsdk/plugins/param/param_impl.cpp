@@ -28,6 +28,23 @@ void ParamImpl::enable() {}
 
 void ParamImpl::disable() {}
 
+void ParamImpl::get_param_int_async(
+    const std::string& name, const Param::GetParamIntCallback& callback)
+{
+    _system_impl->get_param_int_async(
+        name,
+        [this, callback](MavlinkParameterClient::Result result, int32_t value) {
+            if (callback) {
+                const auto param_result = result_from_mavlink_parameter_client_result(result);
+                _system_impl->call_user_callback(
+                    [callback, param_result, value]() { callback(param_result, value); });
+            }
+        },
+        this,
+        _component_id,
+        _protocol_version == Param::ProtocolVersion::Ext);
+}
+
 std::pair<Param::Result, int32_t> ParamImpl::get_param_int(const std::string& name)
 {
     std::pair<MavlinkParameterClient::Result, int32_t> result = _system_impl->get_param_int(
@@ -36,6 +53,20 @@ std::pair<Param::Result, int32_t> ParamImpl::get_param_int(const std::string& na
         result_from_mavlink_parameter_client_result(result.first), result.second);
 }
 
+void ParamImpl::set_param_int_async(
+    const std::string& name, int32_t value, const Param::ResultCallback& callback)
+{
+    _system_impl->set_param_int_async(
+        name,
+        value,
+        [this, callback](MavlinkParameterClient::Result result) {
+            call_result_callback(result, callback);
+        },
+        this,
+        _component_id,
+        _protocol_version == Param::ProtocolVersion::Ext);
+}
+
 Param::Result ParamImpl::set_param_int(const std::string& name, int32_t value)
 {
     MavlinkParameterClient::Result result = _system_impl->set_param_int(
@@ -43,6 +74,23 @@ Param::Result ParamImpl::set_param_int(const std::string& name, int32_t value)
     return result_from_mavlink_parameter_client_result(result);
 }
 
+void ParamImpl::get_param_float_async(
+    const std::string& name, const Param::GetParamFloatCallback& callback)
+{
+    _system_impl->get_param_float_async(
+        name,
+        [this, callback](MavlinkParameterClient::Result result, float value) {
+            if (callback) {
+                const auto param_result = result_from_mavlink_parameter_client_result(result);
+                _system_impl->call_user_callback(
+                    [callback, param_result, value]() { callback(param_result, value); });
+            }
+        },
+        this,
+        _component_id,
+        _protocol_version == Param::ProtocolVersion::Ext);
+}
+
 std::pair<Param::Result, float> ParamImpl::get_param_float(const std::string& name)
 {
     std::pair<MavlinkParameterClient::Result, float> result = _system_impl->get_param_float(
@@ -51,6 +99,20 @@ std::pair<Param::Result, float> ParamImpl::get_param_float(const std::string& na
         result_from_mavlink_parameter_client_result(result.first), result.second);
 }
 
+void ParamImpl::set_param_float_async(
+    const std::string& name, float value, const Param::ResultCallback& callback)
+{
+    _system_impl->set_param_float_async(
+        name,
+        value,
+        [this, callback](MavlinkParameterClient::Result result) {
+            call_result_callback(result, callback);
+        },
+        this,
+        _component_id,
+        _protocol_version == Param::ProtocolVersion::Ext);
+}
+
 Param::Result ParamImpl::set_param_float(const std::string& name, float value)
 {
     MavlinkParameterClient::Result result = _system_impl->set_param_float(
@@ -58,6 +120,22 @@ Param::Result ParamImpl::set_param_float(const std::string& name, float value)
     return result_from_mavlink_parameter_client_result(result);
 }
 
+void ParamImpl::get_param_custom_async(
+    const std::string& name, const Param::GetParamCustomCallback& callback)
+{
+    _system_impl->get_param_custom_async(
+        name,
+        [this, callback](MavlinkParameterClient::Result result, const std::string& value) {
+            if (callback) {
+                const auto param_result = result_from_mavlink_parameter_client_result(result);
+                _system_impl->call_user_callback(
+                    [callback, param_result, value]() { callback(param_result, value); });
+            }
+        },
+        this,
+        _component_id);
+}
+
 std::pair<Param::Result, std::string> ParamImpl::get_param_custom(const std::string& name)
 {
     auto result = _system_impl->get_param_custom(name, _component_id);
@@ -65,6 +143,19 @@ std::pair<Param::Result, std::string> ParamImpl::get_param_custom(const std::str
         result_from_mavlink_parameter_client_result(result.first), result.second);
 }
 
+void ParamImpl::set_param_custom_async(
+    const std::string& name, const std::string& value, const Param::ResultCallback& callback)
+{
+    _system_impl->set_param_custom_async(
+        name,
+        value,
+        [this, callback](MavlinkParameterClient::Result result) {
+            call_result_callback(result, callback);
+        },
+        this,
+        _component_id);
+}
+
 Param::Result ParamImpl::set_param_custom(const std::string& name, const std::string& value)
 {
     auto result = _system_impl->set_param_custom(name, value, _component_id);
@@ -121,6 +212,15 @@ ParamImpl::select_component(int32_t component_id, Param::ProtocolVersion protoco
     return Param::Result::Unknown;
 }
 
+void ParamImpl::call_result_callback(
+    MavlinkParameterClient::Result result, const Param::ResultCallback& callback)
+{
+    if (callback) {
+        const auto param_result = result_from_mavlink_parameter_client_result(result);
+        _system_impl->call_user_callback([callback, param_result]() { callback(param_result); });
+    }
+}
+
 Param::Result
 ParamImpl::result_from_mavlink_parameter_client_result(MavlinkParameterClient::Result result)
 {
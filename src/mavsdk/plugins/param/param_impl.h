@@ -20,16 +20,27 @@ public:
     void enable() override;
     void disable() override;
 
+    void get_param_int_async(const std::string& name, const Param::GetParamIntCallback& callback);
     std::pair<Param::Result, int32_t> get_param_int(const std::string& name);
 
+    void set_param_int_async(
+        const std::string& name, int32_t value, const Param::ResultCallback& callback);
     Param::Result set_param_int(const std::string& name, int32_t value);
 
+    void
+    get_param_float_async(const std::string& name, const Param::GetParamFloatCallback& callback);
     std::pair<Param::Result, float> get_param_float(const std::string& name);
 
+    void set_param_float_async(
+        const std::string& name, float value, const Param::ResultCallback& callback);
     Param::Result set_param_float(const std::string& name, float value);
 
+    void
+    get_param_custom_async(const std::string& name, const Param::GetParamCustomCallback& callback);
     std::pair<Param::Result, std::string> get_param_custom(const std::string& name);
 
+    void set_param_custom_async(
+        const std::string& name, const std::string& value, const Param::ResultCallback& callback);
     Param::Result set_param_custom(const std::string& name, const std::string& value);
 
     Param::AllParams get_all_params();
@@ -37,6 +48,9 @@ public:
     Param::Result select_component(int32_t component_id, Param::ProtocolVersion protocol_version);
 
 private:
+    void call_result_callback(
+        MavlinkParameterClient::Result result, const Param::ResultCallback& callback);
+
     static Param::Result
     result_from_mavlink_parameter_client_result(MavlinkParameterClient::Result result);
 
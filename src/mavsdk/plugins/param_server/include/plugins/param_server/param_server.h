@@ -16,6 +16,7 @@
 #include "server_plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
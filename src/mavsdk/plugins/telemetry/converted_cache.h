@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace mavsdk {
+
+// Keeps the latest raw message and converts it only when it is read, for
+// telemetry that is expensive to convert, e.g. because it fills vectors.
+// The conversion is kept until the next message arrives, so reading the
+// same message again only copies it.
+template<typename Raw, typename Converted> class ConvertedCache {
+public:
+    // The message is converted on the first read.
+    void store(const Raw& raw)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _raw = raw;
+        _dirty = true;
+    }
+
+    // For when the message has been converted anyway, e.g. for subscribers.
+    void store(const Raw& raw, Converted converted)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _raw = raw;
+        _converted = std::move(converted);
+        _dirty = false;
+    }
+
+    // Returns nothing if no message has been stored yet.
+    template<typename F> std::optional<Converted> load(F&& convert) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_raw) {
+            return std::nullopt;
+        }
+        if (_dirty) {
+            _converted = convert(_raw.value());
+            _dirty = false;
+        }
+        return _converted;
+    }
+
+private:
+    mutable std::mutex _mutex{};
+    std::optional<Raw> _raw{};
+    mutable Converted _converted{};
+    mutable bool _dirty{false};
+};
+
+} // namespace mavsdk
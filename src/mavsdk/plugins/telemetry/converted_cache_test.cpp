@@ -0,0 +1,65 @@
+#include "converted_cache.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+
+struct Counted {
+    std::vector<int> values{};
+};
+
+} // namespace
+
+TEST(ConvertedCache, EmptyHasNothing)
+{
+    ConvertedCache<int, Counted> cache;
+    unsigned num_conversions = 0;
+    EXPECT_FALSE(cache.load([&](int raw) {
+        ++num_conversions;
+        return Counted{{raw}};
+    }));
+    EXPECT_EQ(num_conversions, 0u);
+}
+
+TEST(ConvertedCache, ConvertsOnceUntilNextMessage)
+{
+    ConvertedCache<int, Counted> cache;
+    unsigned num_conversions = 0;
+    const auto convert = [&](int raw) {
+        ++num_conversions;
+        return Counted{{raw}};
+    };
+
+    cache.store(1);
+    cache.store(2);
+    EXPECT_EQ(num_conversions, 0u);
+
+    for (unsigned i = 0; i < 3; ++i) {
+        const auto converted = cache.load(convert);
+        ASSERT_TRUE(converted);
+        EXPECT_EQ(converted.value().values, std::vector<int>{2});
+    }
+    EXPECT_EQ(num_conversions, 1u);
+
+    cache.store(3);
+    ASSERT_TRUE(cache.load(convert));
+    EXPECT_EQ(cache.load(convert).value().values, std::vector<int>{3});
+    EXPECT_EQ(num_conversions, 2u);
+}
+
+TEST(ConvertedCache, StoringConvertedSkipsConversion)
+{
+    ConvertedCache<int, Counted> cache;
+    unsigned num_conversions = 0;
+    const auto convert = [&](int raw) {
+        ++num_conversions;
+        return Counted{{raw}};
+    };
+
+    cache.store(4, Counted{{4}});
+    ASSERT_TRUE(cache.load(convert));
+    EXPECT_EQ(cache.load(convert).value().values, std::vector<int>{4});
+    EXPECT_EQ(num_conversions, 0u);
+}
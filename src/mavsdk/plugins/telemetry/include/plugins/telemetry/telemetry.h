@@ -9,6 +9,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,6 +17,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -994,6 +996,179 @@ public:
      */
     friend std::ostream& operator<<(std::ostream& str, Telemetry::Altitude const& altitude);
 
+    /**
+     * @brief Snapshot type, the cached values of all fields taken at the same time.
+     *
+     * Every field comes with the autopilot time in microseconds at which it was
+     * last updated (see `autopilot_time_us`), or 0 if it has not been received yet.
+     */
+    struct Snapshot {
+        Position position{}; /**< @brief Position */
+        uint64_t position_time_us{}; /**< @brief Time of last update */
+        Position home{}; /**< @brief Home position */
+        uint64_t home_time_us{}; /**< @brief Time of last update */
+        Heading heading{}; /**< @brief Heading */
+        uint64_t heading_time_us{}; /**< @brief Time of last update */
+        Altitude altitude{}; /**< @brief Altitude */
+        uint64_t altitude_time_us{}; /**< @brief Time of last update */
+        VelocityNed velocity_ned{}; /**< @brief Velocity NED */
+        uint64_t velocity_ned_time_us{}; /**< @brief Time of last update */
+        PositionVelocityNed position_velocity_ned{}; /**< @brief Position and velocity NED */
+        uint64_t position_velocity_ned_time_us{}; /**< @brief Time of last update */
+        Quaternion attitude_quaternion{}; /**< @brief Attitude quaternion */
+        uint64_t attitude_quaternion_time_us{}; /**< @brief Time of last update */
+        AngularVelocityBody attitude_angular_velocity_body{}; /**< @brief Angular velocity */
+        uint64_t attitude_angular_velocity_body_time_us{}; /**< @brief Time of last update */
+        Imu imu{}; /**< @brief IMU reading NED */
+        uint64_t imu_time_us{}; /**< @brief Time of last update */
+        GpsInfo gps_info{}; /**< @brief GPS information */
+        uint64_t gps_info_time_us{}; /**< @brief Time of last update */
+        Battery battery{}; /**< @brief Battery */
+        uint64_t battery_time_us{}; /**< @brief Time of last update */
+        Health health{}; /**< @brief Health */
+        uint64_t health_time_us{}; /**< @brief Time of last update */
+        RcStatus rc_status{}; /**< @brief RC status */
+        uint64_t rc_status_time_us{}; /**< @brief Time of last update */
+        FlightMode flight_mode{}; /**< @brief Flight mode */
+        uint64_t flight_mode_time_us{}; /**< @brief Time of last update */
+        bool armed{false}; /**< @brief Armed state */
+        uint64_t armed_time_us{}; /**< @brief Time of last update */
+        bool in_air{false}; /**< @brief In-air state */
+        uint64_t in_air_time_us{}; /**< @brief Time of last update */
+        LandedState landed_state{}; /**< @brief Landed state */
+        uint64_t landed_state_time_us{}; /**< @brief Time of last update */
+        VtolState vtol_state{}; /**< @brief VTOL state */
+        uint64_t vtol_state_time_us{}; /**< @brief Time of last update */
+        DistanceSensor distance_sensor{}; /**< @brief Distance sensor */
+        uint64_t distance_sensor_time_us{}; /**< @brief Time of last update */
+    };
+
+    /**
+     * @brief Equal operator to compare two `Telemetry::Snapshot` objects.
+     *
+     * @return `true` if items are equal.
+     */
+    friend bool operator==(const Telemetry::Snapshot& lhs, const Telemetry::Snapshot& rhs);
+
+    /**
+     * @brief Stream operator to print information about a `Telemetry::Snapshot`.
+     *
+     * @return A reference to the stream.
+     */
+    friend std::ostream& operator<<(std::ostream& str, Telemetry::Snapshot const& snapshot);
+
+    /**
+     * @brief Telemetry stream whose rate can be set, see the set_rate functions.
+     */
+    enum class Stream {
+        PositionVelocityNed, /**< @brief See set_rate_position_velocity_ned. */
+        Position, /**< @brief See set_rate_position. */
+        Home, /**< @brief See set_rate_home. */
+        InAir, /**< @brief See set_rate_in_air. */
+        LandedState, /**< @brief See set_rate_landed_state. */
+        VtolState, /**< @brief See set_rate_vtol_state. */
+        Altitude, /**< @brief See set_rate_altitude. */
+        AttitudeQuaternion, /**< @brief See set_rate_attitude_quaternion. */
+        AttitudeEuler, /**< @brief See set_rate_attitude_euler. */
+        CameraAttitude, /**< @brief See set_rate_camera_attitude. */
+        VelocityNed, /**< @brief See set_rate_velocity_ned. */
+        Imu, /**< @brief See set_rate_imu. */
+        ScaledImu, /**< @brief See set_rate_scaled_imu. */
+        RawImu, /**< @brief See set_rate_raw_imu. */
+        FixedwingMetrics, /**< @brief See set_rate_fixedwing_metrics. */
+        GroundTruth, /**< @brief See set_rate_ground_truth. */
+        GpsInfo, /**< @brief See set_rate_gps_info. */
+        Battery, /**< @brief See set_rate_battery. */
+        UnixEpochTime, /**< @brief See set_rate_unix_epoch_time. */
+        ActuatorControlTarget, /**< @brief See set_rate_actuator_control_target. */
+        ActuatorOutputStatus, /**< @brief See set_rate_actuator_output_status. */
+        Odometry, /**< @brief See set_rate_odometry. */
+        DistanceSensor, /**< @brief See set_rate_distance_sensor. */
+        ScaledPressure, /**< @brief Scaled pressure (SCALED_PRESSURE message). */
+    };
+
+    /**
+     * @brief Stream operator to print information about a `Telemetry::Stream`.
+     *
+     * @return A reference to the stream.
+     */
+    friend std::ostream& operator<<(std::ostream& str, Telemetry::Stream const& stream);
+
+    /**
+     * @brief Rate of one telemetry stream.
+     */
+    struct StreamRate {
+        Stream stream{}; /**< @brief The stream */
+        double rate_hz{}; /**< @brief Rate in Hz, 0 for the default rate, -1 to stop it */
+    };
+
+    /**
+     * @brief Equal operator to compare two `Telemetry::StreamRate` objects.
+     *
+     * @return `true` if items are equal.
+     */
+    friend bool operator==(const Telemetry::StreamRate& lhs, const Telemetry::StreamRate& rhs);
+
+    /**
+     * @brief Stream operator to print information about a `Telemetry::StreamRate`.
+     *
+     * @return A reference to the stream.
+     */
+    friend std::ostream& operator<<(std::ostream& str, Telemetry::StreamRate const& stream_rate);
+
+    /**
+     * @brief Set of stream rates which are applied together, e.g. one per
+     * link type or flight phase.
+     */
+    struct StreamProfile {
+        std::vector<StreamRate> stream_rates{}; /**< @brief Rates of the streams to set */
+    };
+
+    /**
+     * @brief Equal operator to compare two `Telemetry::StreamProfile` objects.
+     *
+     * @return `true` if items are equal.
+     */
+    friend bool
+    operator==(const Telemetry::StreamProfile& lhs, const Telemetry::StreamProfile& rhs);
+
+    /**
+     * @brief Stream operator to print information about a `Telemetry::StreamProfile`.
+     *
+     * @return A reference to the stream.
+     */
+    friend std::ostream&
+    operator<<(std::ostream& str, Telemetry::StreamProfile const& stream_profile);
+
+    /**
+     * @brief Options for one subscription, which leave the others on the same
+     * stream alone.
+     */
+    struct SubscriptionOptions {
+        bool conflate{}; /**< @brief Keep at most one callback queued, skipping to the newest update
+                            if the callback is slower than the updates */
+        double max_rate_hz{}; /**< @brief Maximum callback rate in Hz, 0 for no limit, otherwise at
+                                 least 0.001. Updates in between are dropped for this subscription
+                                 only, unlike the set_rate functions this does not change what the
+                                 vehicle sends */
+    };
+
+    /**
+     * @brief Equal operator to compare two `Telemetry::SubscriptionOptions` objects.
+     *
+     * @return `true` if items are equal.
+     */
+    friend bool operator==(
+        const Telemetry::SubscriptionOptions& lhs, const Telemetry::SubscriptionOptions& rhs);
+
+    /**
+     * @brief Stream operator to print information about a `Telemetry::SubscriptionOptions`.
+     *
+     * @return A reference to the stream.
+     */
+    friend std::ostream&
+    operator<<(std::ostream& str, Telemetry::SubscriptionOptions const& subscription_options);
+
     /**
      * @brief Possible results returned for telemetry requests.
      */
@@ -1006,6 +1181,7 @@ public:
         CommandDenied, /**< @brief Command refused by vehicle. */
         Timeout, /**< @brief Request timed out. */
         Unsupported, /**< @brief Request not supported. */
+        InvalidArgument, /**< @brief Invalid argument. */
     };
 
     /**
@@ -1035,6 +1211,14 @@ public:
      */
     PositionHandle subscribe_position(const PositionCallback& callback);
 
+    /**
+     * @brief Like subscribe_position, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, PositionHandle>
+    subscribe_position(const PositionCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_position
      */
@@ -1062,6 +1246,14 @@ public:
      */
     HomeHandle subscribe_home(const HomeCallback& callback);
 
+    /**
+     * @brief Like subscribe_home, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, HomeHandle>
+    subscribe_home(const HomeCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_home
      */
@@ -1089,6 +1281,14 @@ public:
      */
     InAirHandle subscribe_in_air(const InAirCallback& callback);
 
+    /**
+     * @brief Like subscribe_in_air, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, InAirHandle>
+    subscribe_in_air(const InAirCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_in_air
      */
@@ -1116,6 +1316,14 @@ public:
      */
     LandedStateHandle subscribe_landed_state(const LandedStateCallback& callback);
 
+    /**
+     * @brief Like subscribe_landed_state, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, LandedStateHandle>
+    subscribe_landed_state(const LandedStateCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_landed_state
      */
@@ -1143,6 +1351,14 @@ public:
      */
     ArmedHandle subscribe_armed(const ArmedCallback& callback);
 
+    /**
+     * @brief Like subscribe_armed, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, ArmedHandle>
+    subscribe_armed(const ArmedCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_armed
      */
@@ -1170,6 +1386,14 @@ public:
      */
     VtolStateHandle subscribe_vtol_state(const VtolStateCallback& callback);
 
+    /**
+     * @brief Like subscribe_vtol_state, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, VtolStateHandle>
+    subscribe_vtol_state(const VtolStateCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_vtol_state
      */
@@ -1198,6 +1422,14 @@ public:
     AttitudeQuaternionHandle
     subscribe_attitude_quaternion(const AttitudeQuaternionCallback& callback);
 
+    /**
+     * @brief Like subscribe_attitude_quaternion, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, AttitudeQuaternionHandle> subscribe_attitude_quaternion(
+        const AttitudeQuaternionCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_attitude_quaternion
      */
@@ -1225,6 +1457,14 @@ public:
      */
     AttitudeEulerHandle subscribe_attitude_euler(const AttitudeEulerCallback& callback);
 
+    /**
+     * @brief Like subscribe_attitude_euler, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, AttitudeEulerHandle> subscribe_attitude_euler(
+        const AttitudeEulerCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_attitude_euler
      */
@@ -1253,6 +1493,14 @@ public:
     AttitudeAngularVelocityBodyHandle
     subscribe_attitude_angular_velocity_body(const AttitudeAngularVelocityBodyCallback& callback);
 
+    /**
+     * @brief Like subscribe_attitude_angular_velocity_body, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, AttitudeAngularVelocityBodyHandle> subscribe_attitude_angular_velocity_body(
+        const AttitudeAngularVelocityBodyCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_attitude_angular_velocity_body
      */
@@ -1281,6 +1529,14 @@ public:
     CameraAttitudeQuaternionHandle
     subscribe_camera_attitude_quaternion(const CameraAttitudeQuaternionCallback& callback);
 
+    /**
+     * @brief Like subscribe_camera_attitude_quaternion, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, CameraAttitudeQuaternionHandle> subscribe_camera_attitude_quaternion(
+        const CameraAttitudeQuaternionCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_camera_attitude_quaternion
      */
@@ -1309,6 +1565,14 @@ public:
     CameraAttitudeEulerHandle
     subscribe_camera_attitude_euler(const CameraAttitudeEulerCallback& callback);
 
+    /**
+     * @brief Like subscribe_camera_attitude_euler, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, CameraAttitudeEulerHandle> subscribe_camera_attitude_euler(
+        const CameraAttitudeEulerCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_camera_attitude_euler
      */
@@ -1336,6 +1600,14 @@ public:
      */
     VelocityNedHandle subscribe_velocity_ned(const VelocityNedCallback& callback);
 
+    /**
+     * @brief Like subscribe_velocity_ned, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, VelocityNedHandle>
+    subscribe_velocity_ned(const VelocityNedCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_velocity_ned
      */
@@ -1363,6 +1635,14 @@ public:
      */
     GpsInfoHandle subscribe_gps_info(const GpsInfoCallback& callback);
 
+    /**
+     * @brief Like subscribe_gps_info, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, GpsInfoHandle>
+    subscribe_gps_info(const GpsInfoCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_gps_info
      */
@@ -1390,6 +1670,14 @@ public:
      */
     RawGpsHandle subscribe_raw_gps(const RawGpsCallback& callback);
 
+    /**
+     * @brief Like subscribe_raw_gps, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, RawGpsHandle>
+    subscribe_raw_gps(const RawGpsCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_raw_gps
      */
@@ -1417,6 +1705,14 @@ public:
      */
     BatteryHandle subscribe_battery(const BatteryCallback& callback);
 
+    /**
+     * @brief Like subscribe_battery, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, BatteryHandle>
+    subscribe_battery(const BatteryCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_battery
      */
@@ -1444,6 +1740,14 @@ public:
      */
     FlightModeHandle subscribe_flight_mode(const FlightModeCallback& callback);
 
+    /**
+     * @brief Like subscribe_flight_mode, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, FlightModeHandle>
+    subscribe_flight_mode(const FlightModeCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_flight_mode
      */
@@ -1471,6 +1775,14 @@ public:
      */
     HealthHandle subscribe_health(const HealthCallback& callback);
 
+    /**
+     * @brief Like subscribe_health, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, HealthHandle>
+    subscribe_health(const HealthCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_health
      */
@@ -1498,6 +1810,14 @@ public:
      */
     RcStatusHandle subscribe_rc_status(const RcStatusCallback& callback);
 
+    /**
+     * @brief Like subscribe_rc_status, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, RcStatusHandle>
+    subscribe_rc_status(const RcStatusCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_rc_status
      */
@@ -1525,6 +1845,14 @@ public:
      */
     StatusTextHandle subscribe_status_text(const StatusTextCallback& callback);
 
+    /**
+     * @brief Like subscribe_status_text, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, StatusTextHandle>
+    subscribe_status_text(const StatusTextCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_status_text
      */
@@ -1553,6 +1881,14 @@ public:
     ActuatorControlTargetHandle
     subscribe_actuator_control_target(const ActuatorControlTargetCallback& callback);
 
+    /**
+     * @brief Like subscribe_actuator_control_target, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, ActuatorControlTargetHandle> subscribe_actuator_control_target(
+        const ActuatorControlTargetCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_actuator_control_target
      */
@@ -1581,6 +1917,14 @@ public:
     ActuatorOutputStatusHandle
     subscribe_actuator_output_status(const ActuatorOutputStatusCallback& callback);
 
+    /**
+     * @brief Like subscribe_actuator_output_status, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, ActuatorOutputStatusHandle> subscribe_actuator_output_status(
+        const ActuatorOutputStatusCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_actuator_output_status
      */
@@ -1608,6 +1952,14 @@ public:
      */
     OdometryHandle subscribe_odometry(const OdometryCallback& callback);
 
+    /**
+     * @brief Like subscribe_odometry, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, OdometryHandle>
+    subscribe_odometry(const OdometryCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_odometry
      */
@@ -1636,6 +1988,14 @@ public:
     PositionVelocityNedHandle
     subscribe_position_velocity_ned(const PositionVelocityNedCallback& callback);
 
+    /**
+     * @brief Like subscribe_position_velocity_ned, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, PositionVelocityNedHandle> subscribe_position_velocity_ned(
+        const PositionVelocityNedCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_position_velocity_ned
      */
@@ -1663,6 +2023,14 @@ public:
      */
     GroundTruthHandle subscribe_ground_truth(const GroundTruthCallback& callback);
 
+    /**
+     * @brief Like subscribe_ground_truth, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, GroundTruthHandle>
+    subscribe_ground_truth(const GroundTruthCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_ground_truth
      */
@@ -1690,6 +2058,14 @@ public:
      */
     FixedwingMetricsHandle subscribe_fixedwing_metrics(const FixedwingMetricsCallback& callback);
 
+    /**
+     * @brief Like subscribe_fixedwing_metrics, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, FixedwingMetricsHandle> subscribe_fixedwing_metrics(
+        const FixedwingMetricsCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_fixedwing_metrics
      */
@@ -1717,6 +2093,14 @@ public:
      */
     ImuHandle subscribe_imu(const ImuCallback& callback);
 
+    /**
+     * @brief Like subscribe_imu, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, ImuHandle>
+    subscribe_imu(const ImuCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_imu
      */
@@ -1744,6 +2128,14 @@ public:
      */
     ScaledImuHandle subscribe_scaled_imu(const ScaledImuCallback& callback);
 
+    /**
+     * @brief Like subscribe_scaled_imu, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, ScaledImuHandle>
+    subscribe_scaled_imu(const ScaledImuCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_scaled_imu
      */
@@ -1771,6 +2163,14 @@ public:
      */
     RawImuHandle subscribe_raw_imu(const RawImuCallback& callback);
 
+    /**
+     * @brief Like subscribe_raw_imu, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, RawImuHandle>
+    subscribe_raw_imu(const RawImuCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_raw_imu
      */
@@ -1798,6 +2198,14 @@ public:
      */
     HealthAllOkHandle subscribe_health_all_ok(const HealthAllOkCallback& callback);
 
+    /**
+     * @brief Like subscribe_health_all_ok, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, HealthAllOkHandle> subscribe_health_all_ok(
+        const HealthAllOkCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_health_all_ok
      */
@@ -1825,6 +2233,14 @@ public:
      */
     UnixEpochTimeHandle subscribe_unix_epoch_time(const UnixEpochTimeCallback& callback);
 
+    /**
+     * @brief Like subscribe_unix_epoch_time, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, UnixEpochTimeHandle> subscribe_unix_epoch_time(
+        const UnixEpochTimeCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_unix_epoch_time
      */
@@ -1852,6 +2268,14 @@ public:
      */
     DistanceSensorHandle subscribe_distance_sensor(const DistanceSensorCallback& callback);
 
+    /**
+     * @brief Like subscribe_distance_sensor, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, DistanceSensorHandle> subscribe_distance_sensor(
+        const DistanceSensorCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_distance_sensor
      */
@@ -1879,6 +2303,14 @@ public:
      */
     ScaledPressureHandle subscribe_scaled_pressure(const ScaledPressureCallback& callback);
 
+    /**
+     * @brief Like subscribe_scaled_pressure, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, ScaledPressureHandle> subscribe_scaled_pressure(
+        const ScaledPressureCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_scaled_pressure
      */
@@ -1906,6 +2338,14 @@ public:
      */
     HeadingHandle subscribe_heading(const HeadingCallback& callback);
 
+    /**
+     * @brief Like subscribe_heading, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, HeadingHandle>
+    subscribe_heading(const HeadingCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_heading
      */
@@ -1933,6 +2373,14 @@ public:
      */
     AltitudeHandle subscribe_altitude(const AltitudeCallback& callback);
 
+    /**
+     * @brief Like subscribe_altitude, with options for this subscription.
+     *
+     * @return Result, which is InvalidArgument for invalid options, and handle.
+     */
+    std::pair<Result, AltitudeHandle>
+    subscribe_altitude(const AltitudeCallback& callback, const SubscriptionOptions& options);
+
     /**
      * @brief Unsubscribe from subscribe_altitude
      */
@@ -1961,6 +2409,22 @@ public:
      */
     Result set_rate_position(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'position' updates.
+     *
+     * This function can be awaited. See 'set_rate_position_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_position_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_position_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'home position' updates.
      *
@@ -1977,6 +2441,22 @@ public:
      */
     Result set_rate_home(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'home position' updates.
+     *
+     * This function can be awaited. See 'set_rate_home_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_home_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_home_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to in-air updates.
      *
@@ -1993,6 +2473,22 @@ public:
      */
     Result set_rate_in_air(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to in-air updates.
+     *
+     * This function can be awaited. See 'set_rate_in_air_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_in_air_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_in_air_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to landed state updates
      *
@@ -2010,6 +2506,22 @@ public:
      */
     Result set_rate_landed_state(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to landed state updates
+     *
+     * This function can be awaited. See 'set_rate_landed_state_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_landed_state_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_landed_state_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to VTOL state updates
      *
@@ -2026,6 +2538,22 @@ public:
      */
     Result set_rate_vtol_state(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to VTOL state updates
+     *
+     * This function can be awaited. See 'set_rate_vtol_state_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_vtol_state_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_vtol_state_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'attitude euler angle' updates.
      *
@@ -2044,6 +2572,23 @@ public:
      */
     Result set_rate_attitude_quaternion(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'attitude euler angle' updates.
+     *
+     * This function can be awaited. See 'set_rate_attitude_quaternion_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_attitude_quaternion_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_attitude_quaternion_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'attitude quaternion' updates.
      *
@@ -2061,6 +2606,23 @@ public:
      */
     Result set_rate_attitude_euler(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'attitude quaternion' updates.
+     *
+     * This function can be awaited. See 'set_rate_attitude_euler_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_attitude_euler_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_attitude_euler_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate of camera attitude updates.
      *
@@ -2078,6 +2640,23 @@ public:
      */
     Result set_rate_camera_attitude(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate of camera attitude updates.
+     *
+     * This function can be awaited. See 'set_rate_camera_attitude_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_camera_attitude_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_camera_attitude_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'ground speed' updates (NED).
      *
@@ -2095,6 +2674,22 @@ public:
      */
     Result set_rate_velocity_ned(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'ground speed' updates (NED).
+     *
+     * This function can be awaited. See 'set_rate_velocity_ned_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_velocity_ned_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_velocity_ned_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'GPS info' updates.
      *
@@ -2111,6 +2706,22 @@ public:
      */
     Result set_rate_gps_info(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'GPS info' updates.
+     *
+     * This function can be awaited. See 'set_rate_gps_info_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_gps_info_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_gps_info_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'battery' updates.
      *
@@ -2127,6 +2738,22 @@ public:
      */
     Result set_rate_battery(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'battery' updates.
+     *
+     * This function can be awaited. See 'set_rate_battery_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_battery_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_battery_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'RC status' updates.
      *
@@ -2143,6 +2770,22 @@ public:
      */
     Result set_rate_rc_status(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'RC status' updates.
+     *
+     * This function can be awaited. See 'set_rate_rc_status_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_rc_status_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_rc_status_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'actuator control target' updates.
      *
@@ -2161,6 +2804,23 @@ public:
      */
     Result set_rate_actuator_control_target(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'actuator control target' updates.
+     *
+     * This function can be awaited. See 'set_rate_actuator_control_target_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_actuator_control_target_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_actuator_control_target_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'actuator output status' updates.
      *
@@ -2179,6 +2839,23 @@ public:
      */
     Result set_rate_actuator_output_status(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'actuator output status' updates.
+     *
+     * This function can be awaited. See 'set_rate_actuator_output_status_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_actuator_output_status_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_actuator_output_status_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'odometry' updates.
      *
@@ -2195,6 +2872,22 @@ public:
      */
     Result set_rate_odometry(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'odometry' updates.
+     *
+     * This function can be awaited. See 'set_rate_odometry_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_odometry_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_odometry_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'position velocity' updates.
      *
@@ -2213,6 +2906,23 @@ public:
      */
     Result set_rate_position_velocity_ned(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'position velocity' updates.
+     *
+     * This function can be awaited. See 'set_rate_position_velocity_ned_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_position_velocity_ned_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_position_velocity_ned_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'ground truth' updates.
      *
@@ -2230,6 +2940,22 @@ public:
      */
     Result set_rate_ground_truth(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'ground truth' updates.
+     *
+     * This function can be awaited. See 'set_rate_ground_truth_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_ground_truth_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_ground_truth_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'fixedwing metrics' updates.
      *
@@ -2247,6 +2973,23 @@ public:
      */
     Result set_rate_fixedwing_metrics(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'fixedwing metrics' updates.
+     *
+     * This function can be awaited. See 'set_rate_fixedwing_metrics_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_fixedwing_metrics_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_fixedwing_metrics_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'IMU' updates.
      *
@@ -2263,6 +3006,22 @@ public:
      */
     Result set_rate_imu(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'IMU' updates.
+     *
+     * This function can be awaited. See 'set_rate_imu_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_imu_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_imu_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'Scaled IMU' updates.
      *
@@ -2279,6 +3038,22 @@ public:
      */
     Result set_rate_scaled_imu(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'Scaled IMU' updates.
+     *
+     * This function can be awaited. See 'set_rate_scaled_imu_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_scaled_imu_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_scaled_imu_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'Raw IMU' updates.
      *
@@ -2295,6 +3070,22 @@ public:
      */
     Result set_rate_raw_imu(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'Raw IMU' updates.
+     *
+     * This function can be awaited. See 'set_rate_raw_imu_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_raw_imu_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_raw_imu_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'unix epoch time' updates.
      *
@@ -2312,6 +3103,23 @@ public:
      */
     Result set_rate_unix_epoch_time(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'unix epoch time' updates.
+     *
+     * This function can be awaited. See 'set_rate_unix_epoch_time_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_unix_epoch_time_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_unix_epoch_time_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'Distance Sensor' updates.
      *
@@ -2329,6 +3137,62 @@ public:
      */
     Result set_rate_distance_sensor(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'Distance Sensor' updates.
+     *
+     * This function can be awaited. See 'set_rate_distance_sensor_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_distance_sensor_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_distance_sensor_async(rate_hz, callback);
+        });
+    }
+#endif
+
+    /**
+     * @brief Set the rates of all streams in a profile.
+     *
+     * Streams that come from the same message are merged into one message
+     * interval command at the highest rate asked for. The commands are all
+     * sent at once rather than one after the other, so this takes about one
+     * round trip however many streams are set. The result is the first
+     * failure, or success if all rates were set.
+     *
+     * This function is non-blocking. See 'set_stream_profile' for the blocking counterpart.
+     */
+    void set_stream_profile_async(StreamProfile stream_profile, const ResultCallback callback);
+
+    /**
+     * @brief Set the rates of all streams in a profile.
+     *
+     * This function is blocking. See 'set_stream_profile_async' for the non-blocking
+     * counterpart.
+     *
+     * @return Result of request.
+     */
+    Result set_stream_profile(StreamProfile stream_profile) const;
+
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set the rates of all streams in a profile.
+     *
+     * This function can be awaited. See 'set_stream_profile_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_stream_profile_awaitable(StreamProfile stream_profile)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_stream_profile_async(stream_profile, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Set rate to 'Altitude' updates.
      *
@@ -2345,6 +3209,22 @@ public:
      */
     Result set_rate_altitude(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'Altitude' updates.
+     *
+     * This function can be awaited. See 'set_rate_altitude_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_altitude_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_altitude_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Callback type for get_gps_global_origin_async.
      */
@@ -2367,6 +3247,106 @@ public:
      */
     std::pair<Result, Telemetry::GpsGlobalOrigin> get_gps_global_origin() const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Get the GPS location of where the estimator has been initialized.
+     *
+     * This function can be awaited. See 'get_gps_global_origin_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result, GpsGlobalOrigin> get_gps_global_origin_awaitable()
+    {
+        return Awaitable<Result, GpsGlobalOrigin>([=, this](auto callback) {
+            get_gps_global_origin_async(callback);
+        });
+    }
+#endif
+
+    /**
+     * @brief Enable or disable keeping a history of recent telemetry.
+     *
+     * With the history enabled, the last 256 samples of position, attitude
+     * quaternion, velocity NED and odometry are kept, stamped with the
+     * autopilot time in the message they came in (see `autopilot_time_us`).
+     * Messages without a time are not recorded.
+     * They can then be looked up with `position_at`, `attitude_quaternion_at`,
+     * `velocity_ned_at` and `odometry_at`, e.g. to align them with camera
+     * frames. Disabling the history drops the recorded samples.
+     *
+     * This function is blocking.
+     *
+     * @return Result of request.
+     */
+    Result set_history_enabled(bool enabled) const;
+
+    /**
+     * @brief Get the position at a time in the past.
+     *
+     * Between two recorded samples the position is interpolated linearly.
+     *
+     * @param time_us Autopilot time in microseconds, see `autopilot_time_us`.
+     * @return The position, or nothing if the history is not enabled or does
+     *         not cover the time.
+     */
+    std::optional<Position> position_at(uint64_t time_us) const;
+
+    /**
+     * @brief Get the attitude quaternion at a time in the past.
+     *
+     * Between two recorded samples the attitude is interpolated using slerp.
+     *
+     * @param time_us Autopilot time in microseconds, see `autopilot_time_us`.
+     * @return The attitude, or nothing if the history is not enabled or does
+     *         not cover the time.
+     */
+    std::optional<Quaternion> attitude_quaternion_at(uint64_t time_us) const;
+
+    /**
+     * @brief Get the velocity NED at a time in the past.
+     *
+     * Between two recorded samples the velocity is interpolated linearly.
+     *
+     * @param time_us Autopilot time in microseconds, see `autopilot_time_us`.
+     * @return The velocity, or nothing if the history is not enabled or does
+     *         not cover the time.
+     */
+    std::optional<VelocityNed> velocity_ned_at(uint64_t time_us) const;
+
+    /**
+     * @brief Get the odometry at a time in the past.
+     *
+     * Between two recorded samples position, velocities and attitude are
+     * interpolated, frames and covariances are taken from the closer sample.
+     *
+     * @param time_us Autopilot time in microseconds, see `autopilot_time_us`.
+     * @return The odometry, or nothing if the history is not enabled or does
+     *         not cover the time.
+     */
+    std::optional<Odometry> odometry_at(uint64_t time_us) const;
+
+    /**
+     * @brief Get the current autopilot time.
+     *
+     * This is the local system clock shifted by the offset to the autopilot
+     * clock as estimated using timesync, and the time base used by the history.
+     *
+     * @return Autopilot time in microseconds.
+     */
+    uint64_t autopilot_time_us() const;
+
+    /**
+     * @brief Get all cached values at once.
+     *
+     * Unlike calling the individual getters one after another, the values in
+     * the snapshot are consistent with each other: no update is applied only
+     * partially. Taking a snapshot does not allocate and does not block the
+     * receiving of telemetry.
+     *
+     * @return The snapshot.
+     */
+    Snapshot snapshot() const;
+
     /**
      * @brief Copy constructor.
      */
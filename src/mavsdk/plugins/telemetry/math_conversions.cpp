@@ -40,4 +40,121 @@ Telemetry::Quaternion to_quaternion_from_euler_angle(Telemetry::EulerAngle euler
     return quaternion;
 }
 
+template<typename T> static T lerp(T before, T after, double fraction)
+{
+    const double before_double = static_cast<double>(before);
+    return static_cast<T>(before_double + (static_cast<double>(after) - before_double) * fraction);
+}
+
+Telemetry::Position
+interpolate(const Telemetry::Position& before, const Telemetry::Position& after, double fraction)
+{
+    // Take the short way across the antimeridian.
+    double delta_longitude_deg = after.longitude_deg - before.longitude_deg;
+    if (delta_longitude_deg > 180.0) {
+        delta_longitude_deg -= 360.0;
+    } else if (delta_longitude_deg < -180.0) {
+        delta_longitude_deg += 360.0;
+    }
+    double longitude_deg = before.longitude_deg + delta_longitude_deg * fraction;
+    if (longitude_deg > 180.0) {
+        longitude_deg -= 360.0;
+    } else if (longitude_deg < -180.0) {
+        longitude_deg += 360.0;
+    }
+
+    Telemetry::Position position;
+    position.latitude_deg = lerp(before.latitude_deg, after.latitude_deg, fraction);
+    position.longitude_deg = longitude_deg;
+    position.absolute_altitude_m =
+        lerp(before.absolute_altitude_m, after.absolute_altitude_m, fraction);
+    position.relative_altitude_m =
+        lerp(before.relative_altitude_m, after.relative_altitude_m, fraction);
+    return position;
+}
+
+Telemetry::VelocityNed interpolate(
+    const Telemetry::VelocityNed& before, const Telemetry::VelocityNed& after, double fraction)
+{
+    Telemetry::VelocityNed velocity;
+    velocity.north_m_s = lerp(before.north_m_s, after.north_m_s, fraction);
+    velocity.east_m_s = lerp(before.east_m_s, after.east_m_s, fraction);
+    velocity.down_m_s = lerp(before.down_m_s, after.down_m_s, fraction);
+    return velocity;
+}
+
+Telemetry::Quaternion interpolate(
+    const Telemetry::Quaternion& before, const Telemetry::Quaternion& after, double fraction)
+{
+    // Spherical linear interpolation.
+    double w = after.w;
+    double x = after.x;
+    double y = after.y;
+    double z = after.z;
+
+    double cos_theta = static_cast<double>(before.w) * w + static_cast<double>(before.x) * x +
+                       static_cast<double>(before.y) * y + static_cast<double>(before.z) * z;
+    if (cos_theta < 0.0) {
+        // q and -q are the same rotation, take the shorter way.
+        w = -w;
+        x = -x;
+        y = -y;
+        z = -z;
+        cos_theta = -cos_theta;
+    }
+
+    double scale_before = 1.0 - fraction;
+    double scale_after = fraction;
+    // For nearly identical rotations sin(theta) is close to 0, linear is fine then.
+    if (cos_theta < 0.9995) {
+        const double theta = std::acos(cos_theta);
+        const double sin_theta = std::sin(theta);
+        scale_before = std::sin((1.0 - fraction) * theta) / sin_theta;
+        scale_after = std::sin(fraction * theta) / sin_theta;
+    }
+
+    w = scale_before * static_cast<double>(before.w) + scale_after * w;
+    x = scale_before * static_cast<double>(before.x) + scale_after * x;
+    y = scale_before * static_cast<double>(before.y) + scale_after * y;
+    z = scale_before * static_cast<double>(before.z) + scale_after * z;
+    const double norm = std::sqrt(w * w + x * x + y * y + z * z);
+
+    Telemetry::Quaternion quaternion;
+    quaternion.w = float(w / norm);
+    quaternion.x = float(x / norm);
+    quaternion.y = float(y / norm);
+    quaternion.z = float(z / norm);
+    quaternion.timestamp_us = lerp(before.timestamp_us, after.timestamp_us, fraction);
+    return quaternion;
+}
+
+Telemetry::Odometry
+interpolate(const Telemetry::Odometry& before, const Telemetry::Odometry& after, double fraction)
+{
+    // Frames and covariances can't be interpolated, they are taken from the
+    // closer sample.
+    Telemetry::Odometry odometry = (fraction < 0.5) ? before : after;
+
+    odometry.time_usec = lerp(before.time_usec, after.time_usec, fraction);
+    odometry.position_body.x_m = lerp(before.position_body.x_m, after.position_body.x_m, fraction);
+    odometry.position_body.y_m = lerp(before.position_body.y_m, after.position_body.y_m, fraction);
+    odometry.position_body.z_m = lerp(before.position_body.z_m, after.position_body.z_m, fraction);
+    odometry.q = interpolate(before.q, after.q, fraction);
+    odometry.velocity_body.x_m_s =
+        lerp(before.velocity_body.x_m_s, after.velocity_body.x_m_s, fraction);
+    odometry.velocity_body.y_m_s =
+        lerp(before.velocity_body.y_m_s, after.velocity_body.y_m_s, fraction);
+    odometry.velocity_body.z_m_s =
+        lerp(before.velocity_body.z_m_s, after.velocity_body.z_m_s, fraction);
+    odometry.angular_velocity_body.roll_rad_s = lerp(
+        before.angular_velocity_body.roll_rad_s, after.angular_velocity_body.roll_rad_s, fraction);
+    odometry.angular_velocity_body.pitch_rad_s = lerp(
+        before.angular_velocity_body.pitch_rad_s,
+        after.angular_velocity_body.pitch_rad_s,
+        fraction);
+    odometry.angular_velocity_body.yaw_rad_s = lerp(
+        before.angular_velocity_body.yaw_rad_s, after.angular_velocity_body.yaw_rad_s, fraction);
+    return odometry;
+}
+
 } // namespace mavsdk
@@ -7,4 +7,14 @@ namespace mavsdk {
 Telemetry::EulerAngle to_euler_angle_from_quaternion(Telemetry::Quaternion quaternion);
 Telemetry::Quaternion to_quaternion_from_euler_angle(Telemetry::EulerAngle euler_angle);
 
+// Interpolate between two samples, fraction 0 is before and 1 is after.
+Telemetry::Position
+interpolate(const Telemetry::Position& before, const Telemetry::Position& after, double fraction);
+Telemetry::VelocityNed interpolate(
+    const Telemetry::VelocityNed& before, const Telemetry::VelocityNed& after, double fraction);
+Telemetry::Quaternion interpolate(
+    const Telemetry::Quaternion& before, const Telemetry::Quaternion& after, double fraction);
+Telemetry::Odometry
+interpolate(const Telemetry::Odometry& before, const Telemetry::Odometry& after, double fraction);
+
 } // namespace mavsdk
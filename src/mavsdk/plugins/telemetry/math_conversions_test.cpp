@@ -111,3 +111,50 @@ TEST(MathConversions, QuaternionToEulerAndBackSomeCase)
     EXPECT_NEAR(q2.y, q2_mavlink[2], 0.01f);
     EXPECT_NEAR(q2.z, q2_mavlink[3], 0.01f);
 }
+
+TEST(MathConversions, InterpolatePosition)
+{
+    Telemetry::Position before{47.0, 8.0, 500.0f, 10.0f};
+    Telemetry::Position after{48.0, 9.0, 600.0f, 20.0f};
+
+    const auto position = interpolate(before, after, 0.25);
+    EXPECT_DOUBLE_EQ(position.latitude_deg, 47.25);
+    EXPECT_DOUBLE_EQ(position.longitude_deg, 8.25);
+    EXPECT_FLOAT_EQ(position.absolute_altitude_m, 525.0f);
+    EXPECT_FLOAT_EQ(position.relative_altitude_m, 12.5f);
+}
+
+TEST(MathConversions, InterpolatePositionAcrossAntimeridian)
+{
+    Telemetry::Position before{0.0, 179.0, 0.0f, 0.0f};
+    Telemetry::Position after{0.0, -179.0, 0.0f, 0.0f};
+
+    EXPECT_NEAR(interpolate(before, after, 0.25).longitude_deg, 179.5, 1e-9);
+    EXPECT_NEAR(interpolate(before, after, 0.75).longitude_deg, -179.5, 1e-9);
+}
+
+TEST(MathConversions, InterpolateQuaternion)
+{
+    Telemetry::EulerAngle yaw_0{0.0f, 0.0f, 0.0f, 1000};
+    Telemetry::EulerAngle yaw_90{0.0f, 0.0f, 90.0f, 2000};
+
+    const auto quaternion = interpolate(
+        to_quaternion_from_euler_angle(yaw_0), to_quaternion_from_euler_angle(yaw_90), 0.5);
+    const auto euler_angle = to_euler_angle_from_quaternion(quaternion);
+
+    EXPECT_NEAR(euler_angle.roll_deg, 0.0f, 1e-3f);
+    EXPECT_NEAR(euler_angle.pitch_deg, 0.0f, 1e-3f);
+    EXPECT_NEAR(euler_angle.yaw_deg, 45.0f, 1e-3f);
+    EXPECT_EQ(quaternion.timestamp_us, 1500);
+}
+
+TEST(MathConversions, InterpolateQuaternionShortestPath)
+{
+    // The same rotation with opposite sign, so there is nothing to interpolate.
+    Telemetry::Quaternion before{1.0f, 0.0f, 0.0f, 0.0f, 0};
+    Telemetry::Quaternion after{-1.0f, 0.0f, 0.0f, 0.0f, 0};
+
+    const auto quaternion = interpolate(before, after, 0.5);
+    EXPECT_FLOAT_EQ(std::abs(quaternion.w), 1.0f);
+    EXPECT_FLOAT_EQ(quaternion.x, 0.0f);
+}
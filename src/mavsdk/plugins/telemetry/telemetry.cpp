@@ -52,7 +52,13 @@ Telemetry::~Telemetry() {}
 
 Telemetry::PositionHandle Telemetry::subscribe_position(const PositionCallback& callback)
 {
-    return _impl->subscribe_position(callback);
+    return _impl->subscribe_position(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::PositionHandle>
+Telemetry::subscribe_position(const PositionCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_position(callback, options);
 }
 
 void Telemetry::unsubscribe_position(PositionHandle handle)
@@ -67,7 +73,13 @@ Telemetry::Position Telemetry::position() const
 
 Telemetry::HomeHandle Telemetry::subscribe_home(const HomeCallback& callback)
 {
-    return _impl->subscribe_home(callback);
+    return _impl->subscribe_home(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::HomeHandle>
+Telemetry::subscribe_home(const HomeCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_home(callback, options);
 }
 
 void Telemetry::unsubscribe_home(HomeHandle handle)
@@ -82,7 +94,13 @@ Telemetry::Position Telemetry::home() const
 
 Telemetry::InAirHandle Telemetry::subscribe_in_air(const InAirCallback& callback)
 {
-    return _impl->subscribe_in_air(callback);
+    return _impl->subscribe_in_air(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::InAirHandle>
+Telemetry::subscribe_in_air(const InAirCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_in_air(callback, options);
 }
 
 void Telemetry::unsubscribe_in_air(InAirHandle handle)
@@ -97,7 +115,13 @@ bool Telemetry::in_air() const
 
 Telemetry::LandedStateHandle Telemetry::subscribe_landed_state(const LandedStateCallback& callback)
 {
-    return _impl->subscribe_landed_state(callback);
+    return _impl->subscribe_landed_state(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::LandedStateHandle> Telemetry::subscribe_landed_state(
+    const LandedStateCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_landed_state(callback, options);
 }
 
 void Telemetry::unsubscribe_landed_state(LandedStateHandle handle)
@@ -112,7 +136,13 @@ Telemetry::LandedState Telemetry::landed_state() const
 
 Telemetry::ArmedHandle Telemetry::subscribe_armed(const ArmedCallback& callback)
 {
-    return _impl->subscribe_armed(callback);
+    return _impl->subscribe_armed(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::ArmedHandle>
+Telemetry::subscribe_armed(const ArmedCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_armed(callback, options);
 }
 
 void Telemetry::unsubscribe_armed(ArmedHandle handle)
@@ -127,7 +157,13 @@ bool Telemetry::armed() const
 
 Telemetry::VtolStateHandle Telemetry::subscribe_vtol_state(const VtolStateCallback& callback)
 {
-    return _impl->subscribe_vtol_state(callback);
+    return _impl->subscribe_vtol_state(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::VtolStateHandle> Telemetry::subscribe_vtol_state(
+    const VtolStateCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_vtol_state(callback, options);
 }
 
 void Telemetry::unsubscribe_vtol_state(VtolStateHandle handle)
@@ -143,7 +179,14 @@ Telemetry::VtolState Telemetry::vtol_state() const
 Telemetry::AttitudeQuaternionHandle
 Telemetry::subscribe_attitude_quaternion(const AttitudeQuaternionCallback& callback)
 {
-    return _impl->subscribe_attitude_quaternion(callback);
+    return _impl->subscribe_attitude_quaternion(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::AttitudeQuaternionHandle>
+Telemetry::subscribe_attitude_quaternion(
+    const AttitudeQuaternionCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_attitude_quaternion(callback, options);
 }
 
 void Telemetry::unsubscribe_attitude_quaternion(AttitudeQuaternionHandle handle)
@@ -159,7 +202,13 @@ Telemetry::Quaternion Telemetry::attitude_quaternion() const
 Telemetry::AttitudeEulerHandle
 Telemetry::subscribe_attitude_euler(const AttitudeEulerCallback& callback)
 {
-    return _impl->subscribe_attitude_euler(callback);
+    return _impl->subscribe_attitude_euler(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::AttitudeEulerHandle> Telemetry::subscribe_attitude_euler(
+    const AttitudeEulerCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_attitude_euler(callback, options);
 }
 
 void Telemetry::unsubscribe_attitude_euler(AttitudeEulerHandle handle)
@@ -175,7 +224,14 @@ Telemetry::EulerAngle Telemetry::attitude_euler() const
 Telemetry::AttitudeAngularVelocityBodyHandle Telemetry::subscribe_attitude_angular_velocity_body(
     const AttitudeAngularVelocityBodyCallback& callback)
 {
-    return _impl->subscribe_attitude_angular_velocity_body(callback);
+    return _impl->subscribe_attitude_angular_velocity_body(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::AttitudeAngularVelocityBodyHandle>
+Telemetry::subscribe_attitude_angular_velocity_body(
+    const AttitudeAngularVelocityBodyCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_attitude_angular_velocity_body(callback, options);
 }
 
 void Telemetry::unsubscribe_attitude_angular_velocity_body(AttitudeAngularVelocityBodyHandle handle)
@@ -191,7 +247,14 @@ Telemetry::AngularVelocityBody Telemetry::attitude_angular_velocity_body() const
 Telemetry::CameraAttitudeQuaternionHandle
 Telemetry::subscribe_camera_attitude_quaternion(const CameraAttitudeQuaternionCallback& callback)
 {
-    return _impl->subscribe_camera_attitude_quaternion(callback);
+    return _impl->subscribe_camera_attitude_quaternion(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::CameraAttitudeQuaternionHandle>
+Telemetry::subscribe_camera_attitude_quaternion(
+    const CameraAttitudeQuaternionCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_camera_attitude_quaternion(callback, options);
 }
 
 void Telemetry::unsubscribe_camera_attitude_quaternion(CameraAttitudeQuaternionHandle handle)
@@ -207,7 +270,14 @@ Telemetry::Quaternion Telemetry::camera_attitude_quaternion() const
 Telemetry::CameraAttitudeEulerHandle
 Telemetry::subscribe_camera_attitude_euler(const CameraAttitudeEulerCallback& callback)
 {
-    return _impl->subscribe_camera_attitude_euler(callback);
+    return _impl->subscribe_camera_attitude_euler(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::CameraAttitudeEulerHandle>
+Telemetry::subscribe_camera_attitude_euler(
+    const CameraAttitudeEulerCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_camera_attitude_euler(callback, options);
 }
 
 void Telemetry::unsubscribe_camera_attitude_euler(CameraAttitudeEulerHandle handle)
@@ -222,7 +292,13 @@ Telemetry::EulerAngle Telemetry::camera_attitude_euler() const
 
 Telemetry::VelocityNedHandle Telemetry::subscribe_velocity_ned(const VelocityNedCallback& callback)
 {
-    return _impl->subscribe_velocity_ned(callback);
+    return _impl->subscribe_velocity_ned(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::VelocityNedHandle> Telemetry::subscribe_velocity_ned(
+    const VelocityNedCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_velocity_ned(callback, options);
 }
 
 void Telemetry::unsubscribe_velocity_ned(VelocityNedHandle handle)
@@ -237,7 +313,13 @@ Telemetry::VelocityNed Telemetry::velocity_ned() const
 
 Telemetry::GpsInfoHandle Telemetry::subscribe_gps_info(const GpsInfoCallback& callback)
 {
-    return _impl->subscribe_gps_info(callback);
+    return _impl->subscribe_gps_info(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::GpsInfoHandle>
+Telemetry::subscribe_gps_info(const GpsInfoCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_gps_info(callback, options);
 }
 
 void Telemetry::unsubscribe_gps_info(GpsInfoHandle handle)
@@ -252,7 +334,13 @@ Telemetry::GpsInfo Telemetry::gps_info() const
 
 Telemetry::RawGpsHandle Telemetry::subscribe_raw_gps(const RawGpsCallback& callback)
 {
-    return _impl->subscribe_raw_gps(callback);
+    return _impl->subscribe_raw_gps(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::RawGpsHandle>
+Telemetry::subscribe_raw_gps(const RawGpsCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_raw_gps(callback, options);
 }
 
 void Telemetry::unsubscribe_raw_gps(RawGpsHandle handle)
@@ -267,7 +355,13 @@ Telemetry::RawGps Telemetry::raw_gps() const
 
 Telemetry::BatteryHandle Telemetry::subscribe_battery(const BatteryCallback& callback)
 {
-    return _impl->subscribe_battery(callback);
+    return _impl->subscribe_battery(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::BatteryHandle>
+Telemetry::subscribe_battery(const BatteryCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_battery(callback, options);
 }
 
 void Telemetry::unsubscribe_battery(BatteryHandle handle)
@@ -282,7 +376,13 @@ Telemetry::Battery Telemetry::battery() const
 
 Telemetry::FlightModeHandle Telemetry::subscribe_flight_mode(const FlightModeCallback& callback)
 {
-    return _impl->subscribe_flight_mode(callback);
+    return _impl->subscribe_flight_mode(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::FlightModeHandle> Telemetry::subscribe_flight_mode(
+    const FlightModeCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_flight_mode(callback, options);
 }
 
 void Telemetry::unsubscribe_flight_mode(FlightModeHandle handle)
@@ -297,7 +397,13 @@ Telemetry::FlightMode Telemetry::flight_mode() const
 
 Telemetry::HealthHandle Telemetry::subscribe_health(const HealthCallback& callback)
 {
-    return _impl->subscribe_health(callback);
+    return _impl->subscribe_health(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::HealthHandle>
+Telemetry::subscribe_health(const HealthCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_health(callback, options);
 }
 
 void Telemetry::unsubscribe_health(HealthHandle handle)
@@ -312,7 +418,13 @@ Telemetry::Health Telemetry::health() const
 
 Telemetry::RcStatusHandle Telemetry::subscribe_rc_status(const RcStatusCallback& callback)
 {
-    return _impl->subscribe_rc_status(callback);
+    return _impl->subscribe_rc_status(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::RcStatusHandle>
+Telemetry::subscribe_rc_status(const RcStatusCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_rc_status(callback, options);
 }
 
 void Telemetry::unsubscribe_rc_status(RcStatusHandle handle)
@@ -327,7 +439,13 @@ Telemetry::RcStatus Telemetry::rc_status() const
 
 Telemetry::StatusTextHandle Telemetry::subscribe_status_text(const StatusTextCallback& callback)
 {
-    return _impl->subscribe_status_text(callback);
+    return _impl->subscribe_status_text(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::StatusTextHandle> Telemetry::subscribe_status_text(
+    const StatusTextCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_status_text(callback, options);
 }
 
 void Telemetry::unsubscribe_status_text(StatusTextHandle handle)
@@ -343,7 +461,14 @@ Telemetry::StatusText Telemetry::status_text() const
 Telemetry::ActuatorControlTargetHandle
 Telemetry::subscribe_actuator_control_target(const ActuatorControlTargetCallback& callback)
 {
-    return _impl->subscribe_actuator_control_target(callback);
+    return _impl->subscribe_actuator_control_target(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::ActuatorControlTargetHandle>
+Telemetry::subscribe_actuator_control_target(
+    const ActuatorControlTargetCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_actuator_control_target(callback, options);
 }
 
 void Telemetry::unsubscribe_actuator_control_target(ActuatorControlTargetHandle handle)
@@ -359,7 +484,14 @@ Telemetry::ActuatorControlTarget Telemetry::actuator_control_target() const
 Telemetry::ActuatorOutputStatusHandle
 Telemetry::subscribe_actuator_output_status(const ActuatorOutputStatusCallback& callback)
 {
-    return _impl->subscribe_actuator_output_status(callback);
+    return _impl->subscribe_actuator_output_status(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::ActuatorOutputStatusHandle>
+Telemetry::subscribe_actuator_output_status(
+    const ActuatorOutputStatusCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_actuator_output_status(callback, options);
 }
 
 void Telemetry::unsubscribe_actuator_output_status(ActuatorOutputStatusHandle handle)
@@ -374,7 +506,13 @@ Telemetry::ActuatorOutputStatus Telemetry::actuator_output_status() const
 
 Telemetry::OdometryHandle Telemetry::subscribe_odometry(const OdometryCallback& callback)
 {
-    return _impl->subscribe_odometry(callback);
+    return _impl->subscribe_odometry(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::OdometryHandle>
+Telemetry::subscribe_odometry(const OdometryCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_odometry(callback, options);
 }
 
 void Telemetry::unsubscribe_odometry(OdometryHandle handle)
@@ -390,7 +528,14 @@ Telemetry::Odometry Telemetry::odometry() const
 Telemetry::PositionVelocityNedHandle
 Telemetry::subscribe_position_velocity_ned(const PositionVelocityNedCallback& callback)
 {
-    return _impl->subscribe_position_velocity_ned(callback);
+    return _impl->subscribe_position_velocity_ned(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::PositionVelocityNedHandle>
+Telemetry::subscribe_position_velocity_ned(
+    const PositionVelocityNedCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_position_velocity_ned(callback, options);
 }
 
 void Telemetry::unsubscribe_position_velocity_ned(PositionVelocityNedHandle handle)
@@ -405,7 +550,13 @@ Telemetry::PositionVelocityNed Telemetry::position_velocity_ned() const
 
 Telemetry::GroundTruthHandle Telemetry::subscribe_ground_truth(const GroundTruthCallback& callback)
 {
-    return _impl->subscribe_ground_truth(callback);
+    return _impl->subscribe_ground_truth(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::GroundTruthHandle> Telemetry::subscribe_ground_truth(
+    const GroundTruthCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_ground_truth(callback, options);
 }
 
 void Telemetry::unsubscribe_ground_truth(GroundTruthHandle handle)
@@ -421,7 +572,14 @@ Telemetry::GroundTruth Telemetry::ground_truth() const
 Telemetry::FixedwingMetricsHandle
 Telemetry::subscribe_fixedwing_metrics(const FixedwingMetricsCallback& callback)
 {
-    return _impl->subscribe_fixedwing_metrics(callback);
+    return _impl->subscribe_fixedwing_metrics(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::FixedwingMetricsHandle>
+Telemetry::subscribe_fixedwing_metrics(
+    const FixedwingMetricsCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_fixedwing_metrics(callback, options);
 }
 
 void Telemetry::unsubscribe_fixedwing_metrics(FixedwingMetricsHandle handle)
@@ -436,7 +594,13 @@ Telemetry::FixedwingMetrics Telemetry::fixedwing_metrics() const
 
 Telemetry::ImuHandle Telemetry::subscribe_imu(const ImuCallback& callback)
 {
-    return _impl->subscribe_imu(callback);
+    return _impl->subscribe_imu(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::ImuHandle>
+Telemetry::subscribe_imu(const ImuCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_imu(callback, options);
 }
 
 void Telemetry::unsubscribe_imu(ImuHandle handle)
@@ -451,7 +615,13 @@ Telemetry::Imu Telemetry::imu() const
 
 Telemetry::ScaledImuHandle Telemetry::subscribe_scaled_imu(const ScaledImuCallback& callback)
 {
-    return _impl->subscribe_scaled_imu(callback);
+    return _impl->subscribe_scaled_imu(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::ScaledImuHandle> Telemetry::subscribe_scaled_imu(
+    const ScaledImuCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_scaled_imu(callback, options);
 }
 
 void Telemetry::unsubscribe_scaled_imu(ScaledImuHandle handle)
@@ -466,7 +636,13 @@ Telemetry::Imu Telemetry::scaled_imu() const
 
 Telemetry::RawImuHandle Telemetry::subscribe_raw_imu(const RawImuCallback& callback)
 {
-    return _impl->subscribe_raw_imu(callback);
+    return _impl->subscribe_raw_imu(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::RawImuHandle>
+Telemetry::subscribe_raw_imu(const RawImuCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_raw_imu(callback, options);
 }
 
 void Telemetry::unsubscribe_raw_imu(RawImuHandle handle)
@@ -481,7 +657,13 @@ Telemetry::Imu Telemetry::raw_imu() const
 
 Telemetry::HealthAllOkHandle Telemetry::subscribe_health_all_ok(const HealthAllOkCallback& callback)
 {
-    return _impl->subscribe_health_all_ok(callback);
+    return _impl->subscribe_health_all_ok(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::HealthAllOkHandle> Telemetry::subscribe_health_all_ok(
+    const HealthAllOkCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_health_all_ok(callback, options);
 }
 
 void Telemetry::unsubscribe_health_all_ok(HealthAllOkHandle handle)
@@ -497,7 +679,13 @@ bool Telemetry::health_all_ok() const
 Telemetry::UnixEpochTimeHandle
 Telemetry::subscribe_unix_epoch_time(const UnixEpochTimeCallback& callback)
 {
-    return _impl->subscribe_unix_epoch_time(callback);
+    return _impl->subscribe_unix_epoch_time(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::UnixEpochTimeHandle> Telemetry::subscribe_unix_epoch_time(
+    const UnixEpochTimeCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_unix_epoch_time(callback, options);
 }
 
 void Telemetry::unsubscribe_unix_epoch_time(UnixEpochTimeHandle handle)
@@ -513,7 +701,13 @@ uint64_t Telemetry::unix_epoch_time() const
 Telemetry::DistanceSensorHandle
 Telemetry::subscribe_distance_sensor(const DistanceSensorCallback& callback)
 {
-    return _impl->subscribe_distance_sensor(callback);
+    return _impl->subscribe_distance_sensor(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::DistanceSensorHandle> Telemetry::subscribe_distance_sensor(
+    const DistanceSensorCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_distance_sensor(callback, options);
 }
 
 void Telemetry::unsubscribe_distance_sensor(DistanceSensorHandle handle)
@@ -529,7 +723,13 @@ Telemetry::DistanceSensor Telemetry::distance_sensor() const
 Telemetry::ScaledPressureHandle
 Telemetry::subscribe_scaled_pressure(const ScaledPressureCallback& callback)
 {
-    return _impl->subscribe_scaled_pressure(callback);
+    return _impl->subscribe_scaled_pressure(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::ScaledPressureHandle> Telemetry::subscribe_scaled_pressure(
+    const ScaledPressureCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_scaled_pressure(callback, options);
 }
 
 void Telemetry::unsubscribe_scaled_pressure(ScaledPressureHandle handle)
@@ -544,7 +744,13 @@ Telemetry::ScaledPressure Telemetry::scaled_pressure() const
 
 Telemetry::HeadingHandle Telemetry::subscribe_heading(const HeadingCallback& callback)
 {
-    return _impl->subscribe_heading(callback);
+    return _impl->subscribe_heading(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::HeadingHandle>
+Telemetry::subscribe_heading(const HeadingCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_heading(callback, options);
 }
 
 void Telemetry::unsubscribe_heading(HeadingHandle handle)
@@ -559,7 +765,13 @@ Telemetry::Heading Telemetry::heading() const
 
 Telemetry::AltitudeHandle Telemetry::subscribe_altitude(const AltitudeCallback& callback)
 {
-    return _impl->subscribe_altitude(callback);
+    return _impl->subscribe_altitude(callback, SubscriptionOptions{}).second;
+}
+
+std::pair<Telemetry::Result, Telemetry::AltitudeHandle>
+Telemetry::subscribe_altitude(const AltitudeCallback& callback, const SubscriptionOptions& options)
+{
+    return _impl->subscribe_altitude(callback, options);
 }
 
 void Telemetry::unsubscribe_altitude(AltitudeHandle handle)
@@ -803,6 +1015,17 @@ Telemetry::Result Telemetry::set_rate_distance_sensor(double rate_hz) const
     return _impl->set_rate_distance_sensor(rate_hz);
 }
 
+void Telemetry::set_stream_profile_async(
+    StreamProfile stream_profile, const ResultCallback callback)
+{
+    _impl->set_stream_profile_async(stream_profile, callback);
+}
+
+Telemetry::Result Telemetry::set_stream_profile(StreamProfile stream_profile) const
+{
+    return _impl->set_stream_profile(stream_profile);
+}
+
 void Telemetry::set_rate_altitude_async(double rate_hz, const ResultCallback callback)
 {
     _impl->set_rate_altitude_async(rate_hz, callback);
@@ -823,6 +1046,41 @@ std::pair<Telemetry::Result, Telemetry::GpsGlobalOrigin> Telemetry::get_gps_glob
     return _impl->get_gps_global_origin();
 }
 
+Telemetry::Result Telemetry::set_history_enabled(bool enabled) const
+{
+    return _impl->set_history_enabled(enabled);
+}
+
+std::optional<Telemetry::Position> Telemetry::position_at(uint64_t time_us) const
+{
+    return _impl->position_at(time_us);
+}
+
+std::optional<Telemetry::Quaternion> Telemetry::attitude_quaternion_at(uint64_t time_us) const
+{
+    return _impl->attitude_quaternion_at(time_us);
+}
+
+std::optional<Telemetry::VelocityNed> Telemetry::velocity_ned_at(uint64_t time_us) const
+{
+    return _impl->velocity_ned_at(time_us);
+}
+
+std::optional<Telemetry::Odometry> Telemetry::odometry_at(uint64_t time_us) const
+{
+    return _impl->odometry_at(time_us);
+}
+
+uint64_t Telemetry::autopilot_time_us() const
+{
+    return _impl->autopilot_time_us();
+}
+
+Telemetry::Snapshot Telemetry::snapshot() const
+{
+    return _impl->snapshot();
+}
+
 bool operator==(const Telemetry::Position& lhs, const Telemetry::Position& rhs)
 {
     return ((std::isnan(rhs.latitude_deg) && std::isnan(lhs.latitude_deg)) ||
@@ -1514,6 +1772,207 @@ std::ostream& operator<<(std::ostream& str, Telemetry::Altitude const& altitude)
     return str;
 }
 
+bool operator==(const Telemetry::Snapshot& lhs, const Telemetry::Snapshot& rhs)
+{
+    return (rhs.position == lhs.position) &&
+           (rhs.position_time_us == lhs.position_time_us) &&
+           (rhs.home == lhs.home) &&
+           (rhs.home_time_us == lhs.home_time_us) &&
+           (rhs.heading == lhs.heading) &&
+           (rhs.heading_time_us == lhs.heading_time_us) &&
+           (rhs.altitude == lhs.altitude) &&
+           (rhs.altitude_time_us == lhs.altitude_time_us) &&
+           (rhs.velocity_ned == lhs.velocity_ned) &&
+           (rhs.velocity_ned_time_us == lhs.velocity_ned_time_us) &&
+           (rhs.position_velocity_ned == lhs.position_velocity_ned) &&
+           (rhs.position_velocity_ned_time_us == lhs.position_velocity_ned_time_us) &&
+           (rhs.attitude_quaternion == lhs.attitude_quaternion) &&
+           (rhs.attitude_quaternion_time_us == lhs.attitude_quaternion_time_us) &&
+           (rhs.attitude_angular_velocity_body == lhs.attitude_angular_velocity_body) &&
+           (rhs.attitude_angular_velocity_body_time_us ==
+            lhs.attitude_angular_velocity_body_time_us) &&
+           (rhs.imu == lhs.imu) &&
+           (rhs.imu_time_us == lhs.imu_time_us) &&
+           (rhs.gps_info == lhs.gps_info) &&
+           (rhs.gps_info_time_us == lhs.gps_info_time_us) &&
+           (rhs.battery == lhs.battery) &&
+           (rhs.battery_time_us == lhs.battery_time_us) &&
+           (rhs.health == lhs.health) &&
+           (rhs.health_time_us == lhs.health_time_us) &&
+           (rhs.rc_status == lhs.rc_status) &&
+           (rhs.rc_status_time_us == lhs.rc_status_time_us) &&
+           (rhs.flight_mode == lhs.flight_mode) &&
+           (rhs.flight_mode_time_us == lhs.flight_mode_time_us) &&
+           (rhs.armed == lhs.armed) &&
+           (rhs.armed_time_us == lhs.armed_time_us) &&
+           (rhs.in_air == lhs.in_air) &&
+           (rhs.in_air_time_us == lhs.in_air_time_us) &&
+           (rhs.landed_state == lhs.landed_state) &&
+           (rhs.landed_state_time_us == lhs.landed_state_time_us) &&
+           (rhs.vtol_state == lhs.vtol_state) &&
+           (rhs.vtol_state_time_us == lhs.vtol_state_time_us) &&
+           (rhs.distance_sensor == lhs.distance_sensor) &&
+           (rhs.distance_sensor_time_us == lhs.distance_sensor_time_us);
+}
+
+std::ostream& operator<<(std::ostream& str, Telemetry::Snapshot const& snapshot)
+{
+    str << std::setprecision(15);
+    str << "snapshot:" << '\n' << "{\n";
+    str << "    position: " << snapshot.position << '\n';
+    str << "    position_time_us: " << snapshot.position_time_us << '\n';
+    str << "    home: " << snapshot.home << '\n';
+    str << "    home_time_us: " << snapshot.home_time_us << '\n';
+    str << "    heading: " << snapshot.heading << '\n';
+    str << "    heading_time_us: " << snapshot.heading_time_us << '\n';
+    str << "    altitude: " << snapshot.altitude << '\n';
+    str << "    altitude_time_us: " << snapshot.altitude_time_us << '\n';
+    str << "    velocity_ned: " << snapshot.velocity_ned << '\n';
+    str << "    velocity_ned_time_us: " << snapshot.velocity_ned_time_us << '\n';
+    str << "    position_velocity_ned: " << snapshot.position_velocity_ned << '\n';
+    str << "    position_velocity_ned_time_us: " << snapshot.position_velocity_ned_time_us << '\n';
+    str << "    attitude_quaternion: " << snapshot.attitude_quaternion << '\n';
+    str << "    attitude_quaternion_time_us: " << snapshot.attitude_quaternion_time_us << '\n';
+    str << "    attitude_angular_velocity_body: "
+        << snapshot.attitude_angular_velocity_body << '\n';
+    str << "    attitude_angular_velocity_body_time_us: "
+        << snapshot.attitude_angular_velocity_body_time_us << '\n';
+    str << "    imu: " << snapshot.imu << '\n';
+    str << "    imu_time_us: " << snapshot.imu_time_us << '\n';
+    str << "    gps_info: " << snapshot.gps_info << '\n';
+    str << "    gps_info_time_us: " << snapshot.gps_info_time_us << '\n';
+    str << "    battery: " << snapshot.battery << '\n';
+    str << "    battery_time_us: " << snapshot.battery_time_us << '\n';
+    str << "    health: " << snapshot.health << '\n';
+    str << "    health_time_us: " << snapshot.health_time_us << '\n';
+    str << "    rc_status: " << snapshot.rc_status << '\n';
+    str << "    rc_status_time_us: " << snapshot.rc_status_time_us << '\n';
+    str << "    flight_mode: " << snapshot.flight_mode << '\n';
+    str << "    flight_mode_time_us: " << snapshot.flight_mode_time_us << '\n';
+    str << "    armed: " << snapshot.armed << '\n';
+    str << "    armed_time_us: " << snapshot.armed_time_us << '\n';
+    str << "    in_air: " << snapshot.in_air << '\n';
+    str << "    in_air_time_us: " << snapshot.in_air_time_us << '\n';
+    str << "    landed_state: " << snapshot.landed_state << '\n';
+    str << "    landed_state_time_us: " << snapshot.landed_state_time_us << '\n';
+    str << "    vtol_state: " << snapshot.vtol_state << '\n';
+    str << "    vtol_state_time_us: " << snapshot.vtol_state_time_us << '\n';
+    str << "    distance_sensor: " << snapshot.distance_sensor << '\n';
+    str << "    distance_sensor_time_us: " << snapshot.distance_sensor_time_us << '\n';
+    str << '}';
+    return str;
+}
+
+std::ostream& operator<<(std::ostream& str, Telemetry::Stream const& stream)
+{
+    switch (stream) {
+        case Telemetry::Stream::PositionVelocityNed:
+            return str << "Position Velocity Ned";
+        case Telemetry::Stream::Position:
+            return str << "Position";
+        case Telemetry::Stream::Home:
+            return str << "Home";
+        case Telemetry::Stream::InAir:
+            return str << "In Air";
+        case Telemetry::Stream::LandedState:
+            return str << "Landed State";
+        case Telemetry::Stream::VtolState:
+            return str << "Vtol State";
+        case Telemetry::Stream::Altitude:
+            return str << "Altitude";
+        case Telemetry::Stream::AttitudeQuaternion:
+            return str << "Attitude Quaternion";
+        case Telemetry::Stream::AttitudeEuler:
+            return str << "Attitude Euler";
+        case Telemetry::Stream::CameraAttitude:
+            return str << "Camera Attitude";
+        case Telemetry::Stream::VelocityNed:
+            return str << "Velocity Ned";
+        case Telemetry::Stream::Imu:
+            return str << "Imu";
+        case Telemetry::Stream::ScaledImu:
+            return str << "Scaled Imu";
+        case Telemetry::Stream::RawImu:
+            return str << "Raw Imu";
+        case Telemetry::Stream::FixedwingMetrics:
+            return str << "Fixedwing Metrics";
+        case Telemetry::Stream::GroundTruth:
+            return str << "Ground Truth";
+        case Telemetry::Stream::GpsInfo:
+            return str << "Gps Info";
+        case Telemetry::Stream::Battery:
+            return str << "Battery";
+        case Telemetry::Stream::UnixEpochTime:
+            return str << "Unix Epoch Time";
+        case Telemetry::Stream::ActuatorControlTarget:
+            return str << "Actuator Control Target";
+        case Telemetry::Stream::ActuatorOutputStatus:
+            return str << "Actuator Output Status";
+        case Telemetry::Stream::Odometry:
+            return str << "Odometry";
+        case Telemetry::Stream::DistanceSensor:
+            return str << "Distance Sensor";
+        case Telemetry::Stream::ScaledPressure:
+            return str << "Scaled Pressure";
+        default:
+            return str << "Unknown";
+    }
+}
+
+bool operator==(const Telemetry::StreamRate& lhs, const Telemetry::StreamRate& rhs)
+{
+    return (rhs.stream == lhs.stream) &&
+           ((std::isnan(rhs.rate_hz) && std::isnan(lhs.rate_hz)) || rhs.rate_hz == lhs.rate_hz);
+}
+
+std::ostream& operator<<(std::ostream& str, Telemetry::StreamRate const& stream_rate)
+{
+    str << std::setprecision(15);
+    str << "stream_rate:" << '\n' << "{\n";
+    str << "    stream: " << stream_rate.stream << '\n';
+    str << "    rate_hz: " << stream_rate.rate_hz << '\n';
+    str << '}';
+    return str;
+}
+
+bool operator==(const Telemetry::StreamProfile& lhs, const Telemetry::StreamProfile& rhs)
+{
+    return (rhs.stream_rates == lhs.stream_rates);
+}
+
+std::ostream& operator<<(std::ostream& str, Telemetry::StreamProfile const& stream_profile)
+{
+    str << std::setprecision(15);
+    str << "stream_profile:" << '\n' << "{\n";
+    str << "    stream_rates: [";
+    for (auto it = stream_profile.stream_rates.begin(); it != stream_profile.stream_rates.end();
+         ++it) {
+        str << *it;
+        str << (it + 1 != stream_profile.stream_rates.end() ? ", " : "]\n");
+    }
+    str << '}';
+    return str;
+}
+
+bool operator==(
+    const Telemetry::SubscriptionOptions& lhs, const Telemetry::SubscriptionOptions& rhs)
+{
+    return (rhs.conflate == lhs.conflate) &&
+           ((std::isnan(rhs.max_rate_hz) && std::isnan(lhs.max_rate_hz)) ||
+            rhs.max_rate_hz == lhs.max_rate_hz);
+}
+
+std::ostream&
+operator<<(std::ostream& str, Telemetry::SubscriptionOptions const& subscription_options)
+{
+    str << std::setprecision(15);
+    str << "subscription_options:" << '\n' << "{\n";
+    str << "    conflate: " << subscription_options.conflate << '\n';
+    str << "    max_rate_hz: " << subscription_options.max_rate_hz << '\n';
+    str << '}';
+    return str;
+}
+
 std::ostream& operator<<(std::ostream& str, Telemetry::Result const& result)
 {
     switch (result) {
@@ -1533,6 +1992,8 @@ std::ostream& operator<<(std::ostream& str, Telemetry::Result const& result)
             return str << "Timeout";
         case Telemetry::Result::Unsupported:
             return str << "Unsupported";
+        case Telemetry::Result::InvalidArgument:
+            return str << "Invalid Argument";
         default:
             return str << "Unknown";
     }
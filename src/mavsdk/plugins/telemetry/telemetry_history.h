@@ -0,0 +1,78 @@
+#pragma once
+
+#include "math_conversions.h"
+#include "ringbuffer.h"
+#include <cstdint>
+#include <optional>
+
+namespace mavsdk {
+
+// The last N samples of a telemetry value together with the time they were
+// taken at, so that a value can be looked up for a time in the past.
+template<typename T, std::size_t N> class TelemetryHistory {
+public:
+    void push(uint64_t time_us, const T& value)
+    {
+        if (_samples.size() > 0) {
+            const uint64_t last_time_us = _samples[int(_samples.size()) - 1].time_us;
+            if (time_us < last_time_us) {
+                // A sample arriving a bit late is older than what we have
+                // and dropped, while time going back a lot means the
+                // autopilot rebooted and the samples before can't be
+                // compared anymore.
+                if (last_time_us - time_us <= MAX_REORDER_US) {
+                    return;
+                }
+                _samples.clear();
+            }
+        }
+        _samples.push(Sample{time_us, value});
+    }
+
+    void clear() { _samples.clear(); }
+
+    // Returns the sample at the given time, interpolated between the samples
+    // before and after it, or nothing if the time is not covered.
+    std::optional<T> at(uint64_t time_us) const
+    {
+        const int size = int(_samples.size());
+        if (size == 0 || time_us < _samples[0].time_us ||
+            time_us > _samples[size - 1].time_us) {
+            return std::nullopt;
+        }
+
+        // Find the first sample not before the requested time.
+        int low = 0;
+        int high = size - 1;
+        while (low < high) {
+            const int middle = low + (high - low) / 2;
+            if (_samples[middle].time_us < time_us) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        const Sample& after = _samples[low];
+        if (after.time_us == time_us || low == 0) {
+            return after.value;
+        }
+
+        const Sample& before = _samples[low - 1];
+        const double fraction = double(time_us - before.time_us) /
+                                double(after.time_us - before.time_us);
+        return interpolate(before.value, after.value, fraction);
+    }
+
+private:
+    static constexpr uint64_t MAX_REORDER_US = 1000000;
+
+    struct Sample {
+        uint64_t time_us{0};
+        T value{};
+    };
+
+    Ringbuffer<Sample, N> _samples{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,144 @@
+#include "telemetry_history.h"
+#include "mavsdk_impl.h"
+#include "plugins/telemetry/telemetry.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(TelemetryHistory, EmptyHasNothing)
+{
+    TelemetryHistory<Telemetry::VelocityNed, 4> history;
+    EXPECT_FALSE(history.at(0));
+    EXPECT_FALSE(history.at(1000));
+}
+
+TEST(TelemetryHistory, ExactAndInterpolated)
+{
+    TelemetryHistory<Telemetry::VelocityNed, 4> history;
+    history.push(1000, Telemetry::VelocityNed{1.0f, 0.0f, 0.0f});
+    history.push(2000, Telemetry::VelocityNed{2.0f, 0.0f, 0.0f});
+    history.push(4000, Telemetry::VelocityNed{4.0f, 0.0f, 0.0f});
+
+    ASSERT_TRUE(history.at(1000));
+    EXPECT_FLOAT_EQ(history.at(1000).value().north_m_s, 1.0f);
+    ASSERT_TRUE(history.at(4000));
+    EXPECT_FLOAT_EQ(history.at(4000).value().north_m_s, 4.0f);
+
+    ASSERT_TRUE(history.at(1500));
+    EXPECT_FLOAT_EQ(history.at(1500).value().north_m_s, 1.5f);
+    ASSERT_TRUE(history.at(3000));
+    EXPECT_FLOAT_EQ(history.at(3000).value().north_m_s, 3.0f);
+
+    // Outside of what was recorded.
+    EXPECT_FALSE(history.at(999));
+    EXPECT_FALSE(history.at(4001));
+}
+
+TEST(TelemetryHistory, OldSamplesAreDropped)
+{
+    TelemetryHistory<Telemetry::VelocityNed, 4> history;
+    for (unsigned i = 1; i <= 10; ++i) {
+        history.push(i * 1000, Telemetry::VelocityNed{float(i), 0.0f, 0.0f});
+    }
+
+    EXPECT_FALSE(history.at(6000));
+    ASSERT_TRUE(history.at(7000));
+    EXPECT_FLOAT_EQ(history.at(7000).value().north_m_s, 7.0f);
+    ASSERT_TRUE(history.at(9250));
+    EXPECT_FLOAT_EQ(history.at(9250).value().north_m_s, 9.25f);
+}
+
+TEST(TelemetryHistory, LateSampleIsDropped)
+{
+    TelemetryHistory<Telemetry::VelocityNed, 4> history;
+    history.push(5000, Telemetry::VelocityNed{5.0f, 0.0f, 0.0f});
+    history.push(7000, Telemetry::VelocityNed{7.0f, 0.0f, 0.0f});
+    history.push(6000, Telemetry::VelocityNed{100.0f, 0.0f, 0.0f});
+
+    ASSERT_TRUE(history.at(6000));
+    EXPECT_FLOAT_EQ(history.at(6000).value().north_m_s, 6.0f);
+}
+
+TEST(TelemetryHistory, TimeGoingBackwardsStartsOver)
+{
+    TelemetryHistory<Telemetry::VelocityNed, 4> history;
+    history.push(5000000, Telemetry::VelocityNed{5.0f, 0.0f, 0.0f});
+    history.push(6000000, Telemetry::VelocityNed{6.0f, 0.0f, 0.0f});
+    history.push(1000, Telemetry::VelocityNed{1.0f, 0.0f, 0.0f});
+
+    EXPECT_FALSE(history.at(5500000));
+    ASSERT_TRUE(history.at(1000));
+    EXPECT_FLOAT_EQ(history.at(1000).value().north_m_s, 1.0f);
+}
+
+TEST(TelemetryHistory, LookupInFullHistory)
+{
+    TelemetryHistory<Telemetry::Position, 256> history;
+    for (unsigned i = 0; i < 1000; ++i) {
+        history.push(
+            1000000 + i * 20000, Telemetry::Position{double(i), double(i), float(i), float(i)});
+    }
+
+    // The oldest remaining sample is number 744.
+    EXPECT_FALSE(history.at(1000000 + 743 * 20000));
+    for (unsigned i = 744; i < 999; ++i) {
+        const auto position = history.at(1000000 + i * 20000 + 5000);
+        ASSERT_TRUE(position);
+        EXPECT_DOUBLE_EQ(position.value().latitude_deg, i + 0.25);
+    }
+}
+
+// Messages without a time must not end up in the history stamped with the
+// time of receipt, which is not the autopilot's boot time.
+TEST(TelemetryHistory, MessagesWithoutTimeAreSkipped)
+{
+    MavsdkImpl mavsdk_impl;
+
+    mavlink_message_t heartbeat;
+    mavlink_msg_heartbeat_pack(
+        1,
+        MAV_COMP_ID_AUTOPILOT1,
+        &heartbeat,
+        MAV_TYPE_QUADROTOR,
+        MAV_AUTOPILOT_PX4,
+        0,
+        0,
+        MAV_STATE_ACTIVE);
+    mavsdk_impl.receive_message(heartbeat, nullptr);
+    ASSERT_EQ(mavsdk_impl.systems().size(), 1u);
+
+    auto telemetry = Telemetry{mavsdk_impl.systems().front()};
+    ASSERT_EQ(telemetry.set_history_enabled(true), Telemetry::Result::Success);
+
+    auto receive_attitude = [&](uint32_t time_boot_ms, float q1) {
+        const float q[4] = {q1, 0.0f, 0.0f, 0.0f};
+        mavlink_message_t message;
+        mavlink_msg_attitude_quaternion_pack(
+            1,
+            MAV_COMP_ID_AUTOPILOT1,
+            &message,
+            time_boot_ms,
+            q[0],
+            q[1],
+            q[2],
+            q[3],
+            0.0f,
+            0.0f,
+            0.0f,
+            q);
+        mavsdk_impl.receive_message(message, nullptr);
+    };
+
+    receive_attitude(1000, 1.0f);
+    receive_attitude(0, -1.0f);
+    receive_attitude(2000, 1.0f);
+    receive_attitude(0, -1.0f);
+    receive_attitude(3000, 1.0f);
+
+    for (const uint64_t time_us : {1000000u, 1500000u, 2500000u, 3000000u}) {
+        const auto attitude = telemetry.attitude_quaternion_at(time_us);
+        ASSERT_TRUE(attitude) << time_us;
+        EXPECT_FLOAT_EQ(attitude.value().w, 1.0f) << time_us;
+    }
+}
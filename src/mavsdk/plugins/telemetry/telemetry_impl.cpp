@@ -6,6 +6,7 @@
 
 #include <cmath>
 #include <functional>
+#include <map>
 #include <string>
 #include <array>
 #include <cassert>
@@ -245,7 +246,7 @@ void TelemetryImpl::request_home_position_again()
 {
     {
         std::lock_guard<std::mutex> lock(_request_home_position_mutex);
-        if (_health.is_home_position_ok) {
+        if (_health.load().is_home_position_ok) {
             _system_impl->remove_call_every(_homepos_cookie);
             return;
         }
@@ -661,6 +662,118 @@ void TelemetryImpl::set_rate_scaled_pressure_async(
         });
 }
 
+void TelemetryImpl::set_stream_profile_async(
+    const Telemetry::StreamProfile& stream_profile, Telemetry::ResultCallback callback)
+{
+    // Several streams can come from the same message, that one then needs
+    // to be sent at the highest rate any of them asks for.
+    std::map<uint16_t, double> message_rates;
+    auto add_message_rate = [&](uint16_t message_id, double rate_hz) {
+        auto it = message_rates.find(message_id);
+        if (it == message_rates.end()) {
+            message_rates.emplace(message_id, rate_hz);
+        } else {
+            it->second = std::max(it->second, rate_hz);
+        }
+    };
+
+    for (const auto& stream_rate : stream_profile.stream_rates) {
+        switch (stream_rate.stream) {
+            case Telemetry::Stream::PositionVelocityNed:
+                add_message_rate(MAVLINK_MSG_ID_LOCAL_POSITION_NED, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::Position:
+                _position_rate_hz = stream_rate.rate_hz;
+                add_message_rate(
+                    MAVLINK_MSG_ID_GLOBAL_POSITION_INT,
+                    std::max(_position_rate_hz, _velocity_ned_rate_hz));
+                break;
+            case Telemetry::Stream::VelocityNed:
+                _velocity_ned_rate_hz = stream_rate.rate_hz;
+                add_message_rate(
+                    MAVLINK_MSG_ID_GLOBAL_POSITION_INT,
+                    std::max(_position_rate_hz, _velocity_ned_rate_hz));
+                break;
+            case Telemetry::Stream::Home:
+                add_message_rate(MAVLINK_MSG_ID_HOME_POSITION, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::InAir:
+            case Telemetry::Stream::LandedState:
+            case Telemetry::Stream::VtolState:
+                add_message_rate(MAVLINK_MSG_ID_EXTENDED_SYS_STATE, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::Altitude:
+                add_message_rate(MAVLINK_MSG_ID_ALTITUDE, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::AttitudeQuaternion:
+                add_message_rate(MAVLINK_MSG_ID_ATTITUDE_QUATERNION, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::AttitudeEuler:
+                add_message_rate(MAVLINK_MSG_ID_ATTITUDE, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::CameraAttitude:
+                add_message_rate(MAVLINK_MSG_ID_MOUNT_ORIENTATION, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::Imu:
+                add_message_rate(MAVLINK_MSG_ID_HIGHRES_IMU, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::ScaledImu:
+                add_message_rate(MAVLINK_MSG_ID_SCALED_IMU, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::RawImu:
+                add_message_rate(MAVLINK_MSG_ID_RAW_IMU, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::FixedwingMetrics:
+                add_message_rate(MAVLINK_MSG_ID_VFR_HUD, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::GroundTruth:
+                add_message_rate(MAVLINK_MSG_ID_HIL_STATE_QUATERNION, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::GpsInfo:
+                add_message_rate(MAVLINK_MSG_ID_GPS_RAW_INT, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::Battery:
+                add_message_rate(MAVLINK_MSG_ID_BATTERY_STATUS, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::UnixEpochTime:
+                add_message_rate(MAVLINK_MSG_ID_UTM_GLOBAL_POSITION, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::ActuatorControlTarget:
+                add_message_rate(MAVLINK_MSG_ID_ACTUATOR_CONTROL_TARGET, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::ActuatorOutputStatus:
+                add_message_rate(MAVLINK_MSG_ID_ACTUATOR_OUTPUT_STATUS, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::Odometry:
+                add_message_rate(MAVLINK_MSG_ID_ODOMETRY, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::DistanceSensor:
+                add_message_rate(MAVLINK_MSG_ID_DISTANCE_SENSOR, stream_rate.rate_hz);
+                break;
+            case Telemetry::Stream::ScaledPressure:
+                add_message_rate(MAVLINK_MSG_ID_SCALED_PRESSURE, stream_rate.rate_hz);
+                break;
+        }
+    }
+
+    _system_impl->set_msg_rates_async(
+        std::vector<std::pair<uint16_t, double>>(message_rates.begin(), message_rates.end()),
+        [callback](MavlinkCommandSender::Result command_result, float) {
+            command_result_callback(command_result, callback);
+        });
+}
+
+Telemetry::Result TelemetryImpl::set_stream_profile(const Telemetry::StreamProfile& stream_profile)
+{
+    auto prom = std::promise<Telemetry::Result>();
+    auto fut = prom.get_future();
+
+    set_stream_profile_async(
+        stream_profile, [&prom](Telemetry::Result result) { prom.set_value(result); });
+
+    return fut.get();
+}
+
 Telemetry::Result
 TelemetryImpl::telemetry_result_from_command_result(MavlinkCommandSender::Result command_result)
 {
@@ -722,30 +835,42 @@ void TelemetryImpl::process_global_position_int(const mavlink_message_t& message
     mavlink_global_position_int_t global_position_int;
     mavlink_msg_global_position_int_decode(&message, &global_position_int);
 
-    {
-        Telemetry::Position position;
-        position.latitude_deg = global_position_int.lat * 1e-7;
-        position.longitude_deg = global_position_int.lon * 1e-7;
-        position.absolute_altitude_m = global_position_int.alt * 1e-3f;
-        position.relative_altitude_m = global_position_int.relative_alt * 1e-3f;
-        set_position(position);
-    }
-
-    {
-        Telemetry::VelocityNed velocity;
-        velocity.north_m_s = global_position_int.vx * 1e-2f;
-        velocity.east_m_s = global_position_int.vy * 1e-2f;
-        velocity.down_m_s = global_position_int.vz * 1e-2f;
-        set_velocity_ned(velocity);
-    }
+    Telemetry::Position new_position;
+    new_position.latitude_deg = global_position_int.lat * 1e-7;
+    new_position.longitude_deg = global_position_int.lon * 1e-7;
+    new_position.absolute_altitude_m = global_position_int.alt * 1e-3f;
+    new_position.relative_altitude_m = global_position_int.relative_alt * 1e-3f;
+    set_position(new_position);
+
+    Telemetry::VelocityNed new_velocity;
+    new_velocity.north_m_s = global_position_int.vx * 1e-2f;
+    new_velocity.east_m_s = global_position_int.vy * 1e-2f;
+    new_velocity.down_m_s = global_position_int.vz * 1e-2f;
+    set_velocity_ned(new_velocity);
+
+    add_to_history(
+        std::chrono::milliseconds(global_position_int.time_boot_ms),
+        [&](History& history, uint64_t time_us) {
+            history.position.push(time_us, new_position);
+            history.velocity_ned.push(time_us, new_velocity);
+        });
 
-    {
-        Telemetry::Heading heading;
-        heading.heading_deg = (global_position_int.hdg != std::numeric_limits<uint16_t>::max()) ?
+    Telemetry::Heading new_heading;
+    new_heading.heading_deg = (global_position_int.hdg != std::numeric_limits<uint16_t>::max()) ?
                                   static_cast<double>(global_position_int.hdg) * 1e-2 :
                                   static_cast<double>(NAN);
-        set_heading(heading);
-    }
+    set_heading(new_heading);
+
+    // All from the same message, so they go into the snapshot together.
+    const uint64_t time_us = autopilot_time_us();
+    _snapshot.update([&](Telemetry::Snapshot& snapshot) {
+        snapshot.position = new_position;
+        snapshot.position_time_us = time_us;
+        snapshot.velocity_ned = new_velocity;
+        snapshot.velocity_ned_time_us = time_us;
+        snapshot.heading = new_heading;
+        snapshot.heading_time_us = time_us;
+    });
 
     std::lock_guard<std::mutex> lock(_subscription_mutex);
     _position_subscriptions.queue(
@@ -793,9 +918,16 @@ void TelemetryImpl::process_attitude(const mavlink_message_t& message)
     angular_velocity_body.pitch_rad_s = attitude.pitchspeed;
     angular_velocity_body.yaw_rad_s = attitude.yawspeed;
     set_attitude_angular_velocity_body(angular_velocity_body);
-
-    _attitude_euler_angle_subscriptions.queue(
-        attitude_euler(), [this](const auto& func) { _system_impl->call_user_callback(func); });
+    update_snapshot(
+        &Telemetry::Snapshot::attitude_angular_velocity_body,
+        &Telemetry::Snapshot::attitude_angular_velocity_body_time_us,
+        angular_velocity_body);
+
+    // Converting to euler angles is not free, only do it if someone listens.
+    if (!_attitude_euler_angle_subscriptions.empty()) {
+        _attitude_euler_angle_subscriptions.queue(
+            attitude_euler(), [this](const auto& func) { _system_impl->call_user_callback(func); });
+    }
 
     _attitude_angular_velocity_body_subscriptions.queue(
         attitude_angular_velocity_body(),
@@ -821,9 +953,22 @@ void TelemetryImpl::process_attitude_quaternion(const mavlink_message_t& message
     angular_velocity_body.yaw_rad_s = mavlink_attitude_quaternion.yawspeed;
 
     set_attitude_quaternion(quaternion);
+    add_to_history(
+        std::chrono::milliseconds(mavlink_attitude_quaternion.time_boot_ms),
+        [&](History& history, uint64_t time_us) {
+            history.attitude_quaternion.push(time_us, quaternion);
+        });
 
     set_attitude_angular_velocity_body(angular_velocity_body);
 
+    const uint64_t time_us = autopilot_time_us();
+    _snapshot.update([&](Telemetry::Snapshot& snapshot) {
+        snapshot.attitude_quaternion = quaternion;
+        snapshot.attitude_quaternion_time_us = time_us;
+        snapshot.attitude_angular_velocity_body = angular_velocity_body;
+        snapshot.attitude_angular_velocity_body_time_us = time_us;
+    });
+
     std::lock_guard<std::mutex> lock(_subscription_mutex);
     _attitude_quaternion_angle_subscriptions.queue(attitude_quaternion(), [this](const auto& func) {
         _system_impl->call_user_callback(func);
@@ -868,9 +1013,11 @@ void TelemetryImpl::process_mount_orientation(const mavlink_message_t& message)
     set_camera_attitude_euler_angle(euler_angle);
 
     std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _camera_attitude_quaternion_subscriptions.queue(
-        camera_attitude_quaternion(),
-        [this](const auto& func) { _system_impl->call_user_callback(func); });
+    if (!_camera_attitude_quaternion_subscriptions.empty()) {
+        _camera_attitude_quaternion_subscriptions.queue(
+            camera_attitude_quaternion(),
+            [this](const auto& func) { _system_impl->call_user_callback(func); });
+    }
 
     _camera_attitude_euler_angle_subscriptions.queue(
         camera_attitude_euler(),
@@ -896,9 +1043,11 @@ void TelemetryImpl::process_gimbal_device_attitude_status(const mavlink_message_
     set_camera_attitude_euler_angle(euler_angle);
 
     std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _camera_attitude_quaternion_subscriptions.queue(
-        camera_attitude_quaternion(),
-        [this](const auto& func) { _system_impl->call_user_callback(func); });
+    if (!_camera_attitude_quaternion_subscriptions.empty()) {
+        _camera_attitude_quaternion_subscriptions.queue(
+            camera_attitude_quaternion(),
+            [this](const auto& func) { _system_impl->call_user_callback(func); });
+    }
 
     _camera_attitude_euler_angle_subscriptions.queue(
         camera_attitude_euler(),
@@ -1253,6 +1402,10 @@ void TelemetryImpl::process_heartbeat(const mavlink_message_t& message)
     mavlink_msg_heartbeat_decode(&message, &heartbeat);
 
     set_armed(((heartbeat.base_mode & MAV_MODE_FLAG_SAFETY_ARMED) ? true : false));
+    update_snapshot(
+        &Telemetry::Snapshot::flight_mode,
+        &Telemetry::Snapshot::flight_mode_time_us,
+        telemetry_flight_mode_from_flight_mode(_system_impl->get_flight_mode()));
 
     std::lock_guard<std::mutex> lock(_subscription_mutex);
     _armed_subscriptions.queue(
@@ -1348,21 +1501,15 @@ void TelemetryImpl::process_actuator_control_target(const mavlink_message_t& mes
     mavlink_set_actuator_control_target_t target;
     mavlink_msg_set_actuator_control_target_decode(&message, &target);
 
-    uint32_t group = target.group_mlx;
-    std::vector<float> controls;
-
-    const unsigned control_size = sizeof(target.controls) / sizeof(target.controls[0]);
-    // Can't use std::copy because target is packed.
-    for (std::size_t i = 0; i < control_size; ++i) {
-        controls.push_back(target.controls[i]);
-    }
-
-    set_actuator_control_target(group, controls);
-
     std::lock_guard<std::mutex> lock(_subscription_mutex);
+    if (_actuator_control_target_subscriptions.empty()) {
+        _actuator_control_target.store(target);
+        return;
+    }
+    const auto target_struct = actuator_control_target_from_mavlink(target);
+    _actuator_control_target.store(target, target_struct);
     _actuator_control_target_subscriptions.queue(
-        actuator_control_target(),
-        [this](const auto& func) { _system_impl->call_user_callback(func); });
+        target_struct, [this](const auto& func) { _system_impl->call_user_callback(func); });
 }
 
 void TelemetryImpl::process_actuator_output_status(const mavlink_message_t& message)
@@ -1370,21 +1517,15 @@ void TelemetryImpl::process_actuator_output_status(const mavlink_message_t& mess
     mavlink_actuator_output_status_t status;
     mavlink_msg_actuator_output_status_decode(&message, &status);
 
-    uint32_t active = status.active;
-    std::vector<float> actuators;
-
-    const unsigned actuators_size = sizeof(status.actuator) / sizeof(status.actuator[0]);
-    // Can't use std::copy because status is packed.
-    for (std::size_t i = 0; i < actuators_size; ++i) {
-        actuators.push_back(status.actuator[i]);
-    }
-
-    set_actuator_output_status(active, actuators);
-
     std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _actuator_output_status_subscriptions.queue(actuator_output_status(), [this](const auto& func) {
-        _system_impl->call_user_callback(func);
-    });
+    if (_actuator_output_status_subscriptions.empty()) {
+        _actuator_output_status.store(status);
+        return;
+    }
+    const auto status_struct = actuator_output_status_from_mavlink(status);
+    _actuator_output_status.store(status, status_struct);
+    _actuator_output_status_subscriptions.queue(
+        status_struct, [this](const auto& func) { _system_impl->call_user_callback(func); });
 }
 
 void TelemetryImpl::process_odometry(const mavlink_message_t& message)
@@ -1392,49 +1533,26 @@ void TelemetryImpl::process_odometry(const mavlink_message_t& message)
     mavlink_odometry_t odometry_msg;
     mavlink_msg_odometry_decode(&message, &odometry_msg);
 
-    Telemetry::Odometry odometry_struct{};
-
-    odometry_struct.time_usec = odometry_msg.time_usec;
-    odometry_struct.frame_id = static_cast<Telemetry::Odometry::MavFrame>(odometry_msg.frame_id);
-    odometry_struct.child_frame_id =
-        static_cast<Telemetry::Odometry::MavFrame>(odometry_msg.child_frame_id);
-
-    odometry_struct.position_body.x_m = odometry_msg.x;
-    odometry_struct.position_body.y_m = odometry_msg.y;
-    odometry_struct.position_body.z_m = odometry_msg.z;
-
-    odometry_struct.q.w = odometry_msg.q[0];
-    odometry_struct.q.x = odometry_msg.q[1];
-    odometry_struct.q.y = odometry_msg.q[2];
-    odometry_struct.q.z = odometry_msg.q[3];
-
-    odometry_struct.velocity_body.x_m_s = odometry_msg.vx;
-    odometry_struct.velocity_body.y_m_s = odometry_msg.vy;
-    odometry_struct.velocity_body.z_m_s = odometry_msg.vz;
-
-    odometry_struct.angular_velocity_body.roll_rad_s = odometry_msg.rollspeed;
-    odometry_struct.angular_velocity_body.pitch_rad_s = odometry_msg.pitchspeed;
-    odometry_struct.angular_velocity_body.yaw_rad_s = odometry_msg.yawspeed;
-
-    const std::size_t len_pose_covariance =
-        sizeof(odometry_msg.pose_covariance) / sizeof(odometry_msg.pose_covariance[0]);
-    for (std::size_t i = 0; i < len_pose_covariance; ++i) {
-        odometry_struct.pose_covariance.covariance_matrix.push_back(
-            odometry_msg.pose_covariance[i]);
+    std::lock_guard<std::mutex> lock(_subscription_mutex);
+    const bool subscribed = !_odometry_subscriptions.empty();
+    if (!subscribed && !_history_enabled) {
+        _odometry.store(odometry_msg);
+        return;
     }
 
-    const std::size_t len_velocity_covariance =
-        sizeof(odometry_msg.velocity_covariance) / sizeof(odometry_msg.velocity_covariance[0]);
-    for (std::size_t i = 0; i < len_velocity_covariance; ++i) {
-        odometry_struct.velocity_covariance.covariance_matrix.push_back(
-            odometry_msg.velocity_covariance[i]);
-    }
+    const auto odometry_struct = odometry_from_mavlink(odometry_msg);
+    _odometry.store(odometry_msg, odometry_struct);
 
-    set_odometry(odometry_struct);
+    add_to_history(
+        std::chrono::microseconds(odometry_msg.time_usec),
+        [&](History& history, uint64_t time_us) {
+            history.odometry.push(time_us, odometry_struct);
+        });
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _odometry_subscriptions.queue(
-        odometry(), [this](const auto& func) { _system_impl->call_user_callback(func); });
+    if (subscribed) {
+        _odometry_subscriptions.queue(
+            odometry_struct, [this](const auto& func) { _system_impl->call_user_callback(func); });
+    }
 }
 
 void TelemetryImpl::process_distance_sensor(const mavlink_message_t& message)
@@ -1514,6 +1632,28 @@ Telemetry::VtolState TelemetryImpl::to_vtol_state(mavlink_extended_sys_state_t e
     }
 }
 
+CallbackQueueMode TelemetryImpl::queue_mode(const Telemetry::SubscriptionOptions& options)
+{
+    return options.conflate ? CallbackQueueMode::Latest : CallbackQueueMode::Every;
+}
+
+template<typename T>
+std::pair<Telemetry::Result, Handle<T>> TelemetryImpl::subscribe_with_options(
+    CallbackList<T>& subscriptions,
+    const std::function<void(T)>& callback,
+    const Telemetry::SubscriptionOptions& options)
+{
+    if (!std::isfinite(options.max_rate_hz) || options.max_rate_hz < 0.0 ||
+        (options.max_rate_hz > 0.0 && options.max_rate_hz < CALLBACK_MIN_RATE_HZ)) {
+        return {Telemetry::Result::InvalidArgument, {}};
+    }
+
+    std::lock_guard<std::mutex> lock(_subscription_mutex);
+    return {
+        Telemetry::Result::Success,
+        subscriptions.subscribe(callback, queue_mode(options), options.max_rate_hz)};
+}
+
 Telemetry::FlightMode TelemetryImpl::telemetry_flight_mode_from_flight_mode(FlightMode flight_mode)
 {
     switch (flight_mode) {
@@ -1751,64 +1891,118 @@ void TelemetryImpl::receive_unix_epoch_timeout()
     set_unix_epoch_time_us(unix_epoch);
 }
 
+template<typename T>
+void TelemetryImpl::update_snapshot(
+    T Telemetry::Snapshot::*field, uint64_t Telemetry::Snapshot::*time_field, const T& value)
+{
+    const uint64_t time_us = autopilot_time_us();
+    _snapshot.update([&](Telemetry::Snapshot& snapshot) {
+        snapshot.*field = value;
+        snapshot.*time_field = time_us;
+    });
+}
+
+void TelemetryImpl::update_health(bool Telemetry::Health::*field, bool ok)
+{
+    // The snapshot is changed the same way instead of copying _health over,
+    // so concurrent updates of different flags can't overwrite each other.
+    _health.update([&](Telemetry::Health& new_health) { new_health.*field = ok; });
+
+    const uint64_t time_us = autopilot_time_us();
+    _snapshot.update([&](Telemetry::Snapshot& snapshot) {
+        snapshot.health.*field = ok;
+        snapshot.health_time_us = time_us;
+    });
+}
+
+Telemetry::Snapshot TelemetryImpl::snapshot() const
+{
+    return _snapshot.load();
+}
+
+template<typename AddFunc>
+void TelemetryImpl::add_to_history(
+    std::chrono::microseconds time_since_boot, const AddFunc& add_func)
+{
+    if (!_history_enabled) {
+        return;
+    }
+
+    // Samples are stamped with the time the autopilot put in the message, so
+    // they line up however late they arrived. The autopilot's boot time is
+    // what AutopilotTime follows via timesync. Samples from senders that leave
+    // the time at 0 are skipped: stamping them with the time of receipt would
+    // mix two time bases in one history, which only agree once timesync has
+    // converged.
+    if (time_since_boot.count() == 0) {
+        return;
+    }
+    const uint64_t time_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            AutopilotTimePoint{time_since_boot}.time_since_epoch())
+            .count());
+
+    std::lock_guard<std::mutex> lock(_history_mutex);
+    if (_history) {
+        add_func(*_history, time_us);
+    }
+}
+
 Telemetry::PositionVelocityNed TelemetryImpl::position_velocity_ned() const
 {
-    std::lock_guard<std::mutex> lock(_position_velocity_ned_mutex);
-    return _position_velocity_ned;
+    return _position_velocity_ned.load();
 }
 
 void TelemetryImpl::set_position_velocity_ned(Telemetry::PositionVelocityNed position_velocity_ned)
 {
-    std::lock_guard<std::mutex> lock(_position_velocity_ned_mutex);
-    _position_velocity_ned = position_velocity_ned;
+    _position_velocity_ned.store(position_velocity_ned);
+    update_snapshot(
+        &Telemetry::Snapshot::position_velocity_ned,
+        &Telemetry::Snapshot::position_velocity_ned_time_us,
+        position_velocity_ned);
 }
 
 Telemetry::Position TelemetryImpl::position() const
 {
-    std::lock_guard<std::mutex> lock(_position_mutex);
-    return _position;
+    return _position.load();
 }
 
 void TelemetryImpl::set_position(Telemetry::Position position)
 {
-    std::lock_guard<std::mutex> lock(_position_mutex);
-    _position = position;
+    _position.store(position);
 }
 
 Telemetry::Heading TelemetryImpl::heading() const
 {
-    std::lock_guard<std::mutex> lock(_heading_mutex);
-    return _heading;
+    return _heading.load();
 }
 
 void TelemetryImpl::set_heading(Telemetry::Heading heading)
 {
-    std::lock_guard<std::mutex> lock(_heading_mutex);
-    _heading = heading;
+    _heading.store(heading);
 }
 
 Telemetry::Altitude TelemetryImpl::altitude() const
 {
-    std::lock_guard<std::mutex> lock(_altitude_mutex);
-    return _altitude;
+    return _altitude.load();
 }
 
 void TelemetryImpl::set_altitude(Telemetry::Altitude altitude)
 {
-    std::lock_guard<std::mutex> lock(_altitude_mutex);
-    _altitude = altitude;
+    _altitude.store(altitude);
+    update_snapshot(
+        &Telemetry::Snapshot::altitude, &Telemetry::Snapshot::altitude_time_us, altitude);
 }
 
 Telemetry::Position TelemetryImpl::home() const
 {
-    std::lock_guard<std::mutex> lock(_home_position_mutex);
-    return _home_position;
+    return _home_position.load();
 }
 
 void TelemetryImpl::set_home_position(Telemetry::Position home_position)
 {
-    std::lock_guard<std::mutex> lock(_home_position_mutex);
-    _home_position = home_position;
+    _home_position.store(home_position);
+    update_snapshot(&Telemetry::Snapshot::home, &Telemetry::Snapshot::home_time_us, home_position);
 }
 
 bool TelemetryImpl::armed() const
@@ -1824,6 +2018,7 @@ bool TelemetryImpl::in_air() const
 void TelemetryImpl::set_in_air(bool in_air_new)
 {
     _in_air = in_air_new;
+    update_snapshot(&Telemetry::Snapshot::in_air, &Telemetry::Snapshot::in_air_time_us, in_air_new);
 }
 
 void TelemetryImpl::set_status_text(Telemetry::StatusText status_text)
@@ -1841,168 +2036,147 @@ Telemetry::StatusText TelemetryImpl::status_text() const
 void TelemetryImpl::set_armed(bool armed_new)
 {
     _armed = armed_new;
+    update_snapshot(&Telemetry::Snapshot::armed, &Telemetry::Snapshot::armed_time_us, armed_new);
 }
 
 Telemetry::Quaternion TelemetryImpl::attitude_quaternion() const
 {
-    std::lock_guard<std::mutex> lock(_attitude_quaternion_mutex);
-    return _attitude_quaternion;
+    return _attitude_quaternion.load();
 }
 
 Telemetry::AngularVelocityBody TelemetryImpl::attitude_angular_velocity_body() const
 {
-    std::lock_guard<std::mutex> lock(_attitude_angular_velocity_body_mutex);
-    return _attitude_angular_velocity_body;
+    return _attitude_angular_velocity_body.load();
 }
 
 Telemetry::GroundTruth TelemetryImpl::ground_truth() const
 {
-    std::lock_guard<std::mutex> lock(_ground_truth_mutex);
-    return _ground_truth;
+    return _ground_truth.load();
 }
 
 Telemetry::FixedwingMetrics TelemetryImpl::fixedwing_metrics() const
 {
-    std::lock_guard<std::mutex> lock(_fixedwing_metrics_mutex);
-    return _fixedwing_metrics;
+    return _fixedwing_metrics.load();
 }
 
 Telemetry::EulerAngle TelemetryImpl::attitude_euler() const
 {
-    std::lock_guard<std::mutex> lock(_attitude_quaternion_mutex);
-    Telemetry::EulerAngle euler = to_euler_angle_from_quaternion(_attitude_quaternion);
+    Telemetry::EulerAngle euler = to_euler_angle_from_quaternion(_attitude_quaternion.load());
 
     return euler;
 }
 
 void TelemetryImpl::set_attitude_quaternion(Telemetry::Quaternion quaternion)
 {
-    std::lock_guard<std::mutex> lock(_attitude_quaternion_mutex);
-    _attitude_quaternion = quaternion;
+    _attitude_quaternion.store(quaternion);
 }
 
 void TelemetryImpl::set_attitude_angular_velocity_body(
     Telemetry::AngularVelocityBody angular_velocity_body)
 {
-    std::lock_guard<std::mutex> lock(_attitude_quaternion_mutex);
-    _attitude_angular_velocity_body = angular_velocity_body;
+    _attitude_angular_velocity_body.store(angular_velocity_body);
 }
 
 void TelemetryImpl::set_ground_truth(Telemetry::GroundTruth ground_truth)
 {
-    std::lock_guard<std::mutex> lock(_ground_truth_mutex);
-    _ground_truth = ground_truth;
+    _ground_truth.store(ground_truth);
 }
 
 void TelemetryImpl::set_fixedwing_metrics(Telemetry::FixedwingMetrics fixedwing_metrics)
 {
-    std::lock_guard<std::mutex> lock(_fixedwing_metrics_mutex);
-    _fixedwing_metrics = fixedwing_metrics;
+    _fixedwing_metrics.store(fixedwing_metrics);
 }
 
 Telemetry::Quaternion TelemetryImpl::camera_attitude_quaternion() const
 {
-    std::lock_guard<std::mutex> lock(_camera_attitude_euler_angle_mutex);
-    Telemetry::Quaternion quaternion = to_quaternion_from_euler_angle(_camera_attitude_euler_angle);
+    Telemetry::Quaternion quaternion =
+        to_quaternion_from_euler_angle(_camera_attitude_euler_angle.load());
 
     return quaternion;
 }
 
 Telemetry::EulerAngle TelemetryImpl::camera_attitude_euler() const
 {
-    std::lock_guard<std::mutex> lock(_camera_attitude_euler_angle_mutex);
-
-    return _camera_attitude_euler_angle;
+    return _camera_attitude_euler_angle.load();
 }
 
 void TelemetryImpl::set_camera_attitude_euler_angle(Telemetry::EulerAngle euler_angle)
 {
-    std::lock_guard<std::mutex> lock(_camera_attitude_euler_angle_mutex);
-    _camera_attitude_euler_angle = euler_angle;
+    _camera_attitude_euler_angle.store(euler_angle);
 }
 
 Telemetry::VelocityNed TelemetryImpl::velocity_ned() const
 {
-    std::lock_guard<std::mutex> lock(_velocity_ned_mutex);
-    return _velocity_ned;
+    return _velocity_ned.load();
 }
 
 void TelemetryImpl::set_velocity_ned(Telemetry::VelocityNed velocity_ned)
 {
-    std::lock_guard<std::mutex> lock(_velocity_ned_mutex);
-    _velocity_ned = velocity_ned;
+    _velocity_ned.store(velocity_ned);
 }
 
 Telemetry::Imu TelemetryImpl::imu() const
 {
-    std::lock_guard<std::mutex> lock(_imu_reading_ned_mutex);
-    return _imu_reading_ned;
+    return _imu_reading_ned.load();
 }
 
 void TelemetryImpl::set_imu_reading_ned(Telemetry::Imu imu_reading_ned)
 {
-    std::lock_guard<std::mutex> lock(_imu_reading_ned_mutex);
-    _imu_reading_ned = imu_reading_ned;
+    _imu_reading_ned.store(imu_reading_ned);
+    update_snapshot(&Telemetry::Snapshot::imu, &Telemetry::Snapshot::imu_time_us, imu_reading_ned);
 }
 
 Telemetry::Imu TelemetryImpl::scaled_imu() const
 {
-    std::lock_guard<std::mutex> lock(_scaled_imu_mutex);
-    return _scaled_imu;
+    return _scaled_imu.load();
 }
 
 void TelemetryImpl::set_scaled_imu(Telemetry::Imu scaled_imu)
 {
-    std::lock_guard<std::mutex> lock(_scaled_imu_mutex);
-    _scaled_imu = scaled_imu;
+    _scaled_imu.store(scaled_imu);
 }
 
 Telemetry::Imu TelemetryImpl::raw_imu() const
 {
-    std::lock_guard<std::mutex> lock(_raw_imu_mutex);
-    return _raw_imu;
+    return _raw_imu.load();
 }
 
 void TelemetryImpl::set_raw_imu(Telemetry::Imu raw_imu)
 {
-    std::lock_guard<std::mutex> lock(_raw_imu_mutex);
-    _raw_imu = raw_imu;
+    _raw_imu.store(raw_imu);
 }
 
 Telemetry::GpsInfo TelemetryImpl::gps_info() const
 {
-    std::lock_guard<std::mutex> lock(_gps_info_mutex);
-    return _gps_info;
+    return _gps_info.load();
 }
 
 void TelemetryImpl::set_gps_info(Telemetry::GpsInfo gps_info)
 {
-    std::lock_guard<std::mutex> lock(_gps_info_mutex);
-    _gps_info = gps_info;
+    _gps_info.store(gps_info);
+    update_snapshot(
+        &Telemetry::Snapshot::gps_info, &Telemetry::Snapshot::gps_info_time_us, gps_info);
 }
 
 Telemetry::RawGps TelemetryImpl::raw_gps() const
 {
-    std::lock_guard<std::mutex> lock(_raw_gps_mutex);
-    return _raw_gps;
+    return _raw_gps.load();
 }
 
 void TelemetryImpl::set_raw_gps(Telemetry::RawGps raw_gps)
 {
-    std::lock_guard<std::mutex> lock(_raw_gps_mutex);
-    _raw_gps = raw_gps;
+    _raw_gps.store(raw_gps);
 }
 
 Telemetry::Battery TelemetryImpl::battery() const
 {
-    std::lock_guard<std::mutex> lock(_battery_mutex);
-    return _battery;
+    return _battery.load();
 }
 
 void TelemetryImpl::set_battery(Telemetry::Battery battery)
 {
-    std::lock_guard<std::mutex> lock(_battery_mutex);
-    _battery = battery;
+    _battery.store(battery);
+    update_snapshot(&Telemetry::Snapshot::battery, &Telemetry::Snapshot::battery_time_us, battery);
 }
 
 Telemetry::FlightMode TelemetryImpl::flight_mode() const
@@ -2012,16 +2186,16 @@ Telemetry::FlightMode TelemetryImpl::flight_mode() const
 
 Telemetry::Health TelemetryImpl::health() const
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    return _health;
+    return _health.load();
 }
 
 bool TelemetryImpl::health_all_ok() const
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    if (_health.is_gyrometer_calibration_ok && _health.is_accelerometer_calibration_ok &&
-        _health.is_magnetometer_calibration_ok && _health.is_local_position_ok &&
-        _health.is_global_position_ok && _health.is_home_position_ok) {
+    const auto current_health = _health.load();
+    if (current_health.is_gyrometer_calibration_ok &&
+        current_health.is_accelerometer_calibration_ok &&
+        current_health.is_magnetometer_calibration_ok && current_health.is_local_position_ok &&
+        current_health.is_global_position_ok && current_health.is_home_position_ok) {
         return true;
     } else {
         return false;
@@ -2030,178 +2204,231 @@ bool TelemetryImpl::health_all_ok() const
 
 Telemetry::RcStatus TelemetryImpl::rc_status() const
 {
-    std::lock_guard<std::mutex> lock(_rc_status_mutex);
-    return _rc_status;
+    return _rc_status.load();
 }
 
 uint64_t TelemetryImpl::unix_epoch_time() const
 {
-    std::lock_guard<std::mutex> lock(_unix_epoch_time_mutex);
-    return _unix_epoch_time_us;
+    return _unix_epoch_time_us.load();
 }
 
 Telemetry::ActuatorControlTarget TelemetryImpl::actuator_control_target() const
 {
-    std::lock_guard<std::mutex> lock(_actuator_control_target_mutex);
-    return _actuator_control_target;
+    return _actuator_control_target.load(actuator_control_target_from_mavlink)
+        .value_or(Telemetry::ActuatorControlTarget{});
 }
 
 Telemetry::ActuatorOutputStatus TelemetryImpl::actuator_output_status() const
 {
-    std::lock_guard<std::mutex> lock(_actuator_output_status_mutex);
-    return _actuator_output_status;
+    return _actuator_output_status.load(actuator_output_status_from_mavlink)
+        .value_or(Telemetry::ActuatorOutputStatus{});
 }
 
 Telemetry::Odometry TelemetryImpl::odometry() const
 {
-    std::lock_guard<std::mutex> lock(_odometry_mutex);
-    return _odometry;
+    return _odometry.load(odometry_from_mavlink).value_or(Telemetry::Odometry{});
 }
 
 Telemetry::DistanceSensor TelemetryImpl::distance_sensor() const
 {
-    std::lock_guard<std::mutex> lock(_distance_sensor_mutex);
-    return _distance_sensor;
+    return _distance_sensor.load();
 }
 
 Telemetry::ScaledPressure TelemetryImpl::scaled_pressure() const
 {
-    std::lock_guard<std::mutex> lock(_scaled_pressure_mutex);
-    return _scaled_pressure;
+    return _scaled_pressure.load();
 }
 
 void TelemetryImpl::set_health_local_position(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_local_position_ok = ok;
+    update_health(&Telemetry::Health::is_local_position_ok, ok);
 }
 
 void TelemetryImpl::set_health_global_position(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_global_position_ok = ok;
+    update_health(&Telemetry::Health::is_global_position_ok, ok);
 }
 
 void TelemetryImpl::set_health_home_position(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_home_position_ok = ok;
+    update_health(&Telemetry::Health::is_home_position_ok, ok);
 }
 
 void TelemetryImpl::set_health_gyrometer_calibration(bool ok)
 {
     _has_received_gyro_calibration = true;
 
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_gyrometer_calibration_ok = (ok || _hitl_enabled);
+    update_health(&Telemetry::Health::is_gyrometer_calibration_ok, ok || _hitl_enabled);
 }
 
 void TelemetryImpl::set_health_accelerometer_calibration(bool ok)
 {
     _has_received_accel_calibration = true;
 
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_accelerometer_calibration_ok = (ok || _hitl_enabled);
+    update_health(&Telemetry::Health::is_accelerometer_calibration_ok, ok || _hitl_enabled);
 }
 
 void TelemetryImpl::set_health_magnetometer_calibration(bool ok)
 {
     _has_received_mag_calibration = true;
 
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_magnetometer_calibration_ok = (ok || _hitl_enabled);
+    update_health(&Telemetry::Health::is_magnetometer_calibration_ok, ok || _hitl_enabled);
 }
 
 void TelemetryImpl::set_health_armable(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_armable = ok;
+    update_health(&Telemetry::Health::is_armable, ok);
 }
 
 Telemetry::VtolState TelemetryImpl::vtol_state() const
 {
-    std::lock_guard<std::mutex> lock(_vtol_state_mutex);
-    return _vtol_state;
+    return _vtol_state.load();
 }
 
 void TelemetryImpl::set_vtol_state(Telemetry::VtolState vtol_state)
 {
-    std::lock_guard<std::mutex> lock(_vtol_state_mutex);
-    _vtol_state = vtol_state;
+    _vtol_state.store(vtol_state);
+    update_snapshot(
+        &Telemetry::Snapshot::vtol_state, &Telemetry::Snapshot::vtol_state_time_us, vtol_state);
 }
 
 Telemetry::LandedState TelemetryImpl::landed_state() const
 {
-    std::lock_guard<std::mutex> lock(_landed_state_mutex);
-    return _landed_state;
+    return _landed_state.load();
 }
 
 void TelemetryImpl::set_landed_state(Telemetry::LandedState landed_state)
 {
-    std::lock_guard<std::mutex> lock(_landed_state_mutex);
-    _landed_state = landed_state;
+    _landed_state.store(landed_state);
+    update_snapshot(
+        &Telemetry::Snapshot::landed_state,
+        &Telemetry::Snapshot::landed_state_time_us,
+        landed_state);
 }
 
 void TelemetryImpl::set_rc_status(
     std::optional<bool> maybe_available, std::optional<float> maybe_signal_strength_percent)
 {
-    std::lock_guard<std::mutex> lock(_rc_status_mutex);
+    auto update_rc_status = [&](Telemetry::RcStatus& new_rc_status) {
+        if (maybe_available) {
+            new_rc_status.is_available = maybe_available.value();
+            if (maybe_available.value()) {
+                new_rc_status.was_available_once = true;
+            }
+        }
 
-    if (maybe_available) {
-        _rc_status.is_available = maybe_available.value();
-        if (maybe_available.value()) {
-            _rc_status.was_available_once = true;
+        if (maybe_signal_strength_percent) {
+            new_rc_status.signal_strength_percent = maybe_signal_strength_percent.value();
         }
-    }
+    };
 
-    if (maybe_signal_strength_percent) {
-        _rc_status.signal_strength_percent = maybe_signal_strength_percent.value();
-    }
+    _rc_status.update(update_rc_status);
+
+    const uint64_t time_us = autopilot_time_us();
+    _snapshot.update([&](Telemetry::Snapshot& snapshot) {
+        update_rc_status(snapshot.rc_status);
+        snapshot.rc_status_time_us = time_us;
+    });
 }
 
 void TelemetryImpl::set_unix_epoch_time_us(uint64_t time_us)
 {
-    std::lock_guard<std::mutex> lock(_unix_epoch_time_mutex);
-    _unix_epoch_time_us = time_us;
+    _unix_epoch_time_us.store(time_us);
 }
 
-void TelemetryImpl::set_actuator_control_target(uint8_t group, const std::vector<float>& controls)
+Telemetry::ActuatorControlTarget TelemetryImpl::actuator_control_target_from_mavlink(
+    const mavlink_set_actuator_control_target_t& target)
 {
-    std::lock_guard<std::mutex> lock(_actuator_control_target_mutex);
-    _actuator_control_target.group = group;
-    _actuator_control_target.controls = controls;
+    Telemetry::ActuatorControlTarget actuator_control_target;
+    actuator_control_target.group = target.group_mlx;
+
+    const unsigned control_size = sizeof(target.controls) / sizeof(target.controls[0]);
+    actuator_control_target.controls.reserve(control_size);
+    // Can't use std::copy because target is packed.
+    for (std::size_t i = 0; i < control_size; ++i) {
+        actuator_control_target.controls.push_back(target.controls[i]);
+    }
+    return actuator_control_target;
 }
 
-void TelemetryImpl::set_actuator_output_status(uint32_t active, const std::vector<float>& actuators)
+Telemetry::ActuatorOutputStatus TelemetryImpl::actuator_output_status_from_mavlink(
+    const mavlink_actuator_output_status_t& status)
 {
-    std::lock_guard<std::mutex> lock(_actuator_output_status_mutex);
-    _actuator_output_status.active = active;
-    _actuator_output_status.actuator = actuators;
+    Telemetry::ActuatorOutputStatus actuator_output_status;
+    actuator_output_status.active = status.active;
+
+    const unsigned actuators_size = sizeof(status.actuator) / sizeof(status.actuator[0]);
+    actuator_output_status.actuator.reserve(actuators_size);
+    // Can't use std::copy because status is packed.
+    for (std::size_t i = 0; i < actuators_size; ++i) {
+        actuator_output_status.actuator.push_back(status.actuator[i]);
+    }
+    return actuator_output_status;
 }
 
-void TelemetryImpl::set_odometry(Telemetry::Odometry& odometry)
+Telemetry::Odometry TelemetryImpl::odometry_from_mavlink(const mavlink_odometry_t& odometry_msg)
 {
-    std::lock_guard<std::mutex> lock(_odometry_mutex);
-    _odometry = odometry;
+    Telemetry::Odometry odometry_struct{};
+
+    odometry_struct.time_usec = odometry_msg.time_usec;
+    odometry_struct.frame_id = static_cast<Telemetry::Odometry::MavFrame>(odometry_msg.frame_id);
+    odometry_struct.child_frame_id =
+        static_cast<Telemetry::Odometry::MavFrame>(odometry_msg.child_frame_id);
+
+    odometry_struct.position_body.x_m = odometry_msg.x;
+    odometry_struct.position_body.y_m = odometry_msg.y;
+    odometry_struct.position_body.z_m = odometry_msg.z;
+
+    odometry_struct.q.w = odometry_msg.q[0];
+    odometry_struct.q.x = odometry_msg.q[1];
+    odometry_struct.q.y = odometry_msg.q[2];
+    odometry_struct.q.z = odometry_msg.q[3];
+
+    odometry_struct.velocity_body.x_m_s = odometry_msg.vx;
+    odometry_struct.velocity_body.y_m_s = odometry_msg.vy;
+    odometry_struct.velocity_body.z_m_s = odometry_msg.vz;
+
+    odometry_struct.angular_velocity_body.roll_rad_s = odometry_msg.rollspeed;
+    odometry_struct.angular_velocity_body.pitch_rad_s = odometry_msg.pitchspeed;
+    odometry_struct.angular_velocity_body.yaw_rad_s = odometry_msg.yawspeed;
+
+    const std::size_t len_pose_covariance =
+        sizeof(odometry_msg.pose_covariance) / sizeof(odometry_msg.pose_covariance[0]);
+    for (std::size_t i = 0; i < len_pose_covariance; ++i) {
+        odometry_struct.pose_covariance.covariance_matrix.push_back(
+            odometry_msg.pose_covariance[i]);
+    }
+
+    const std::size_t len_velocity_covariance =
+        sizeof(odometry_msg.velocity_covariance) / sizeof(odometry_msg.velocity_covariance[0]);
+    for (std::size_t i = 0; i < len_velocity_covariance; ++i) {
+        odometry_struct.velocity_covariance.covariance_matrix.push_back(
+            odometry_msg.velocity_covariance[i]);
+    }
+
+    return odometry_struct;
 }
 
 void TelemetryImpl::set_distance_sensor(Telemetry::DistanceSensor& distance_sensor)
 {
-    std::lock_guard<std::mutex> lock(_distance_sensor_mutex);
-    _distance_sensor = distance_sensor;
+    _distance_sensor.store(distance_sensor);
+    update_snapshot(
+        &Telemetry::Snapshot::distance_sensor,
+        &Telemetry::Snapshot::distance_sensor_time_us,
+        distance_sensor);
 }
 
 void TelemetryImpl::set_scaled_pressure(Telemetry::ScaledPressure& scaled_pressure)
 {
-    std::lock_guard<std::mutex> lock(_scaled_pressure_mutex);
-    _scaled_pressure = scaled_pressure;
+    _scaled_pressure.store(scaled_pressure);
 }
 
-Telemetry::PositionVelocityNedHandle TelemetryImpl::subscribe_position_velocity_ned(
-    const Telemetry::PositionVelocityNedCallback& callback)
+std::pair<Telemetry::Result, Telemetry::PositionVelocityNedHandle>
+TelemetryImpl::subscribe_position_velocity_ned(
+    const Telemetry::PositionVelocityNedCallback& callback,
+    const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _position_velocity_ned_subscriptions.subscribe(callback);
+    return subscribe_with_options(_position_velocity_ned_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_position_velocity_ned(Telemetry::PositionVelocityNedHandle handle)
@@ -2210,11 +2437,10 @@ void TelemetryImpl::unsubscribe_position_velocity_ned(Telemetry::PositionVelocit
     _position_velocity_ned_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::PositionHandle
-TelemetryImpl::subscribe_position(const Telemetry::PositionCallback& callback)
+std::pair<Telemetry::Result, Telemetry::PositionHandle> TelemetryImpl::subscribe_position(
+    const Telemetry::PositionCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _position_subscriptions.subscribe(callback);
+    return subscribe_with_options(_position_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_position(Telemetry::PositionHandle handle)
@@ -2223,10 +2449,10 @@ void TelemetryImpl::unsubscribe_position(Telemetry::PositionHandle handle)
     _position_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::HomeHandle TelemetryImpl::subscribe_home(const Telemetry::PositionCallback& callback)
+std::pair<Telemetry::Result, Telemetry::HomeHandle> TelemetryImpl::subscribe_home(
+    const Telemetry::PositionCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _home_position_subscriptions.subscribe(callback);
+    return subscribe_with_options(_home_position_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_home(Telemetry::HomeHandle handle)
@@ -2235,10 +2461,10 @@ void TelemetryImpl::unsubscribe_home(Telemetry::HomeHandle handle)
     _home_position_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::InAirHandle TelemetryImpl::subscribe_in_air(const Telemetry::InAirCallback& callback)
+std::pair<Telemetry::Result, Telemetry::InAirHandle> TelemetryImpl::subscribe_in_air(
+    const Telemetry::InAirCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _in_air_subscriptions.subscribe(callback);
+    return subscribe_with_options(_in_air_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_in_air(Telemetry::InAirHandle handle)
@@ -2247,11 +2473,10 @@ void TelemetryImpl::unsubscribe_in_air(Telemetry::InAirHandle handle)
     return _in_air_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::StatusTextHandle
-TelemetryImpl::subscribe_status_text(const Telemetry::StatusTextCallback& callback)
+std::pair<Telemetry::Result, Telemetry::StatusTextHandle> TelemetryImpl::subscribe_status_text(
+    const Telemetry::StatusTextCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _status_text_subscriptions.subscribe(callback);
+    return subscribe_with_options(_status_text_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_status_text(Handle<Telemetry::StatusText> handle)
@@ -2260,10 +2485,10 @@ void TelemetryImpl::unsubscribe_status_text(Handle<Telemetry::StatusText> handle
     _status_text_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::ArmedHandle TelemetryImpl::subscribe_armed(const Telemetry::ArmedCallback& callback)
+std::pair<Telemetry::Result, Telemetry::ArmedHandle> TelemetryImpl::subscribe_armed(
+    const Telemetry::ArmedCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _armed_subscriptions.subscribe(callback);
+    return subscribe_with_options(_armed_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_armed(Telemetry::ArmedHandle handle)
@@ -2272,11 +2497,12 @@ void TelemetryImpl::unsubscribe_armed(Telemetry::ArmedHandle handle)
     _armed_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::AttitudeQuaternionHandle
-TelemetryImpl::subscribe_attitude_quaternion(const Telemetry::AttitudeQuaternionCallback& callback)
+std::pair<Telemetry::Result, Telemetry::AttitudeQuaternionHandle>
+TelemetryImpl::subscribe_attitude_quaternion(
+    const Telemetry::AttitudeQuaternionCallback& callback,
+    const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _attitude_quaternion_angle_subscriptions.subscribe(callback);
+    return subscribe_with_options(_attitude_quaternion_angle_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_attitude_quaternion(Telemetry::AttitudeQuaternionHandle handle)
@@ -2285,11 +2511,11 @@ void TelemetryImpl::unsubscribe_attitude_quaternion(Telemetry::AttitudeQuaternio
     _attitude_quaternion_angle_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::AttitudeEulerHandle
-TelemetryImpl::subscribe_attitude_euler(const Telemetry::AttitudeEulerCallback& callback)
+std::pair<Telemetry::Result, Telemetry::AttitudeEulerHandle>
+TelemetryImpl::subscribe_attitude_euler(
+    const Telemetry::AttitudeEulerCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _attitude_euler_angle_subscriptions.subscribe(callback);
+    return subscribe_with_options(_attitude_euler_angle_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_attitude_euler(Telemetry::AttitudeEulerHandle handle)
@@ -2298,12 +2524,12 @@ void TelemetryImpl::unsubscribe_attitude_euler(Telemetry::AttitudeEulerHandle ha
     _attitude_euler_angle_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::AttitudeAngularVelocityBodyHandle
+std::pair<Telemetry::Result, Telemetry::AttitudeAngularVelocityBodyHandle>
 TelemetryImpl::subscribe_attitude_angular_velocity_body(
-    const Telemetry::AttitudeAngularVelocityBodyCallback& callback)
+    const Telemetry::AttitudeAngularVelocityBodyCallback& callback,
+    const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _attitude_angular_velocity_body_subscriptions.subscribe(callback);
+    return subscribe_with_options(_attitude_angular_velocity_body_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_attitude_angular_velocity_body(
@@ -2313,11 +2539,12 @@ void TelemetryImpl::unsubscribe_attitude_angular_velocity_body(
     _attitude_angular_velocity_body_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::FixedwingMetricsHandle
-TelemetryImpl::subscribe_fixedwing_metrics(const Telemetry::FixedwingMetricsCallback& callback)
+std::pair<Telemetry::Result, Telemetry::FixedwingMetricsHandle>
+TelemetryImpl::subscribe_fixedwing_metrics(
+    const Telemetry::FixedwingMetricsCallback& callback,
+    const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _fixedwing_metrics_subscriptions.subscribe(callback);
+    return subscribe_with_options(_fixedwing_metrics_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_fixedwing_metrics(Telemetry::FixedwingMetricsHandle handle)
@@ -2326,11 +2553,10 @@ void TelemetryImpl::unsubscribe_fixedwing_metrics(Telemetry::FixedwingMetricsHan
     _fixedwing_metrics_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::GroundTruthHandle
-TelemetryImpl::subscribe_ground_truth(const Telemetry::GroundTruthCallback& callback)
+std::pair<Telemetry::Result, Telemetry::GroundTruthHandle> TelemetryImpl::subscribe_ground_truth(
+    const Telemetry::GroundTruthCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _ground_truth_subscriptions.subscribe(callback);
+    return subscribe_with_options(_ground_truth_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_ground_truth(Telemetry::GroundTruthHandle handle)
@@ -2339,11 +2565,12 @@ void TelemetryImpl::unsubscribe_ground_truth(Telemetry::GroundTruthHandle handle
     _ground_truth_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::AttitudeQuaternionHandle TelemetryImpl::subscribe_camera_attitude_quaternion(
-    const Telemetry::AttitudeQuaternionCallback& callback)
+std::pair<Telemetry::Result, Telemetry::AttitudeQuaternionHandle>
+TelemetryImpl::subscribe_camera_attitude_quaternion(
+    const Telemetry::AttitudeQuaternionCallback& callback,
+    const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _camera_attitude_quaternion_subscriptions.subscribe(callback);
+    return subscribe_with_options(_camera_attitude_quaternion_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_camera_attitude_quaternion(
@@ -2353,11 +2580,11 @@ void TelemetryImpl::unsubscribe_camera_attitude_quaternion(
     _camera_attitude_quaternion_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::AttitudeEulerHandle
-TelemetryImpl::subscribe_camera_attitude_euler(const Telemetry::AttitudeEulerCallback& callback)
+std::pair<Telemetry::Result, Telemetry::AttitudeEulerHandle>
+TelemetryImpl::subscribe_camera_attitude_euler(
+    const Telemetry::AttitudeEulerCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _camera_attitude_euler_angle_subscriptions.subscribe(callback);
+    return subscribe_with_options(_camera_attitude_euler_angle_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_camera_attitude_euler(Telemetry::AttitudeEulerHandle handle)
@@ -2366,11 +2593,10 @@ void TelemetryImpl::unsubscribe_camera_attitude_euler(Telemetry::AttitudeEulerHa
     _camera_attitude_euler_angle_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::VelocityNedHandle
-TelemetryImpl::subscribe_velocity_ned(const Telemetry::VelocityNedCallback& callback)
+std::pair<Telemetry::Result, Telemetry::VelocityNedHandle> TelemetryImpl::subscribe_velocity_ned(
+    const Telemetry::VelocityNedCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _velocity_ned_subscriptions.subscribe(callback);
+    return subscribe_with_options(_velocity_ned_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_velocity_ned(Telemetry::VelocityNedHandle handle)
@@ -2379,10 +2605,10 @@ void TelemetryImpl::unsubscribe_velocity_ned(Telemetry::VelocityNedHandle handle
     _velocity_ned_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::ImuHandle TelemetryImpl::subscribe_imu(const Telemetry::ImuCallback& callback)
+std::pair<Telemetry::Result, Telemetry::ImuHandle> TelemetryImpl::subscribe_imu(
+    const Telemetry::ImuCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _imu_reading_ned_subscriptions.subscribe(callback);
+    return subscribe_with_options(_imu_reading_ned_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_imu(Telemetry::ImuHandle handle)
@@ -2391,11 +2617,10 @@ void TelemetryImpl::unsubscribe_imu(Telemetry::ImuHandle handle)
     return _imu_reading_ned_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::ScaledImuHandle
-TelemetryImpl::subscribe_scaled_imu(const Telemetry::ScaledImuCallback& callback)
+std::pair<Telemetry::Result, Telemetry::ScaledImuHandle> TelemetryImpl::subscribe_scaled_imu(
+    const Telemetry::ScaledImuCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _scaled_imu_subscriptions.subscribe(callback);
+    return subscribe_with_options(_scaled_imu_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_scaled_imu(Telemetry::ScaledImuHandle handle)
@@ -2404,10 +2629,10 @@ void TelemetryImpl::unsubscribe_scaled_imu(Telemetry::ScaledImuHandle handle)
     _scaled_imu_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::RawImuHandle TelemetryImpl::subscribe_raw_imu(const Telemetry::RawImuCallback& callback)
+std::pair<Telemetry::Result, Telemetry::RawImuHandle> TelemetryImpl::subscribe_raw_imu(
+    const Telemetry::RawImuCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _raw_imu_subscriptions.subscribe(callback);
+    return subscribe_with_options(_raw_imu_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_raw_imu(Telemetry::RawImuHandle handle)
@@ -2416,11 +2641,10 @@ void TelemetryImpl::unsubscribe_raw_imu(Telemetry::RawImuHandle handle)
     _raw_imu_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::GpsInfoHandle
-TelemetryImpl::subscribe_gps_info(const Telemetry::GpsInfoCallback& callback)
+std::pair<Telemetry::Result, Telemetry::GpsInfoHandle> TelemetryImpl::subscribe_gps_info(
+    const Telemetry::GpsInfoCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _gps_info_subscriptions.subscribe(callback);
+    return subscribe_with_options(_gps_info_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_gps_info(Telemetry::GpsInfoHandle handle)
@@ -2429,10 +2653,10 @@ void TelemetryImpl::unsubscribe_gps_info(Telemetry::GpsInfoHandle handle)
     _gps_info_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::RawGpsHandle TelemetryImpl::subscribe_raw_gps(const Telemetry::RawGpsCallback& callback)
+std::pair<Telemetry::Result, Telemetry::RawGpsHandle> TelemetryImpl::subscribe_raw_gps(
+    const Telemetry::RawGpsCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _raw_gps_subscriptions.subscribe(callback);
+    return subscribe_with_options(_raw_gps_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_raw_gps(Telemetry::RawGpsHandle handle)
@@ -2441,11 +2665,10 @@ void TelemetryImpl::unsubscribe_raw_gps(Telemetry::RawGpsHandle handle)
     _raw_gps_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::BatteryHandle
-TelemetryImpl::subscribe_battery(const Telemetry::BatteryCallback& callback)
+std::pair<Telemetry::Result, Telemetry::BatteryHandle> TelemetryImpl::subscribe_battery(
+    const Telemetry::BatteryCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _battery_subscriptions.subscribe(callback);
+    return subscribe_with_options(_battery_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_battery(Telemetry::BatteryHandle handle)
@@ -2454,11 +2677,10 @@ void TelemetryImpl::unsubscribe_battery(Telemetry::BatteryHandle handle)
     _battery_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::FlightModeHandle
-TelemetryImpl::subscribe_flight_mode(const Telemetry::FlightModeCallback& callback)
+std::pair<Telemetry::Result, Telemetry::FlightModeHandle> TelemetryImpl::subscribe_flight_mode(
+    const Telemetry::FlightModeCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _flight_mode_subscriptions.subscribe(callback);
+    return subscribe_with_options(_flight_mode_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_flight_mode(Telemetry::FlightModeHandle handle)
@@ -2467,10 +2689,10 @@ void TelemetryImpl::unsubscribe_flight_mode(Telemetry::FlightModeHandle handle)
     _flight_mode_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::HealthHandle TelemetryImpl::subscribe_health(const Telemetry::HealthCallback& callback)
+std::pair<Telemetry::Result, Telemetry::HealthHandle> TelemetryImpl::subscribe_health(
+    const Telemetry::HealthCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _health_subscriptions.subscribe(callback);
+    return subscribe_with_options(_health_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_health(Telemetry::HealthHandle handle)
@@ -2479,11 +2701,10 @@ void TelemetryImpl::unsubscribe_health(Telemetry::HealthHandle handle)
     _health_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::HealthAllOkHandle
-TelemetryImpl::subscribe_health_all_ok(const Telemetry::HealthAllOkCallback& callback)
+std::pair<Telemetry::Result, Telemetry::HealthAllOkHandle> TelemetryImpl::subscribe_health_all_ok(
+    const Telemetry::HealthAllOkCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _health_all_ok_subscriptions.subscribe(callback);
+    return subscribe_with_options(_health_all_ok_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_health_all_ok(Telemetry::HealthAllOkHandle handle)
@@ -2492,11 +2713,10 @@ void TelemetryImpl::unsubscribe_health_all_ok(Telemetry::HealthAllOkHandle handl
     _health_all_ok_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::VtolStateHandle
-TelemetryImpl::subscribe_vtol_state(const Telemetry::VtolStateCallback& callback)
+std::pair<Telemetry::Result, Telemetry::VtolStateHandle> TelemetryImpl::subscribe_vtol_state(
+    const Telemetry::VtolStateCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _vtol_state_subscriptions.subscribe(callback);
+    return subscribe_with_options(_vtol_state_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_vtol_state(Telemetry::VtolStateHandle handle)
@@ -2505,11 +2725,10 @@ void TelemetryImpl::unsubscribe_vtol_state(Telemetry::VtolStateHandle handle)
     _vtol_state_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::LandedStateHandle
-TelemetryImpl::subscribe_landed_state(const Telemetry::LandedStateCallback& callback)
+std::pair<Telemetry::Result, Telemetry::LandedStateHandle> TelemetryImpl::subscribe_landed_state(
+    const Telemetry::LandedStateCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _landed_state_subscriptions.subscribe(callback);
+    return subscribe_with_options(_landed_state_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_landed_state(Telemetry::LandedStateHandle handle)
@@ -2518,11 +2737,10 @@ void TelemetryImpl::unsubscribe_landed_state(Telemetry::LandedStateHandle handle
     _landed_state_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::RcStatusHandle
-TelemetryImpl::subscribe_rc_status(const Telemetry::RcStatusCallback& callback)
+std::pair<Telemetry::Result, Telemetry::RcStatusHandle> TelemetryImpl::subscribe_rc_status(
+    const Telemetry::RcStatusCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _rc_status_subscriptions.subscribe(callback);
+    return subscribe_with_options(_rc_status_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_rc_status(Telemetry::RcStatusHandle handle)
@@ -2531,11 +2749,11 @@ void TelemetryImpl::unsubscribe_rc_status(Telemetry::RcStatusHandle handle)
     _rc_status_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::UnixEpochTimeHandle
-TelemetryImpl::subscribe_unix_epoch_time(const Telemetry::UnixEpochTimeCallback& callback)
+std::pair<Telemetry::Result, Telemetry::UnixEpochTimeHandle>
+TelemetryImpl::subscribe_unix_epoch_time(
+    const Telemetry::UnixEpochTimeCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _unix_epoch_time_subscriptions.subscribe(callback);
+    return subscribe_with_options(_unix_epoch_time_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_unix_epoch_time(Telemetry::UnixEpochTimeHandle handle)
@@ -2544,11 +2762,12 @@ void TelemetryImpl::unsubscribe_unix_epoch_time(Telemetry::UnixEpochTimeHandle h
     _unix_epoch_time_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::ActuatorControlTargetHandle TelemetryImpl::subscribe_actuator_control_target(
-    const Telemetry::ActuatorControlTargetCallback& callback)
+std::pair<Telemetry::Result, Telemetry::ActuatorControlTargetHandle>
+TelemetryImpl::subscribe_actuator_control_target(
+    const Telemetry::ActuatorControlTargetCallback& callback,
+    const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _actuator_control_target_subscriptions.subscribe(callback);
+    return subscribe_with_options(_actuator_control_target_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_actuator_control_target(
@@ -2558,11 +2777,12 @@ void TelemetryImpl::unsubscribe_actuator_control_target(
     _actuator_control_target_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::ActuatorOutputStatusHandle TelemetryImpl::subscribe_actuator_output_status(
-    const Telemetry::ActuatorOutputStatusCallback& callback)
+std::pair<Telemetry::Result, Telemetry::ActuatorOutputStatusHandle>
+TelemetryImpl::subscribe_actuator_output_status(
+    const Telemetry::ActuatorOutputStatusCallback& callback,
+    const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _actuator_output_status_subscriptions.subscribe(callback);
+    return subscribe_with_options(_actuator_output_status_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_actuator_output_status(Telemetry::ActuatorOutputStatusHandle handle)
@@ -2571,11 +2791,10 @@ void TelemetryImpl::unsubscribe_actuator_output_status(Telemetry::ActuatorOutput
     _actuator_output_status_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::OdometryHandle
-TelemetryImpl::subscribe_odometry(const Telemetry::OdometryCallback& callback)
+std::pair<Telemetry::Result, Telemetry::OdometryHandle> TelemetryImpl::subscribe_odometry(
+    const Telemetry::OdometryCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _odometry_subscriptions.subscribe(callback);
+    return subscribe_with_options(_odometry_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_odometry(Telemetry::OdometryHandle handle)
@@ -2584,11 +2803,12 @@ void TelemetryImpl::unsubscribe_odometry(Telemetry::OdometryHandle handle)
     _odometry_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::DistanceSensorHandle
-TelemetryImpl::subscribe_distance_sensor(const Telemetry::DistanceSensorCallback& callback)
+std::pair<Telemetry::Result, Telemetry::DistanceSensorHandle>
+TelemetryImpl::subscribe_distance_sensor(
+    const Telemetry::DistanceSensorCallback& callback,
+    const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _distance_sensor_subscriptions.subscribe(callback);
+    return subscribe_with_options(_distance_sensor_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_distance_sensor(Telemetry::DistanceSensorHandle handle)
@@ -2597,11 +2817,12 @@ void TelemetryImpl::unsubscribe_distance_sensor(Telemetry::DistanceSensorHandle
     _distance_sensor_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::ScaledPressureHandle
-TelemetryImpl::subscribe_scaled_pressure(const Telemetry::ScaledPressureCallback& callback)
+std::pair<Telemetry::Result, Telemetry::ScaledPressureHandle>
+TelemetryImpl::subscribe_scaled_pressure(
+    const Telemetry::ScaledPressureCallback& callback,
+    const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _scaled_pressure_subscriptions.subscribe(callback);
+    return subscribe_with_options(_scaled_pressure_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_scaled_pressure(Telemetry::ScaledPressureHandle handle)
@@ -2610,11 +2831,10 @@ void TelemetryImpl::unsubscribe_scaled_pressure(Telemetry::ScaledPressureHandle
     _scaled_pressure_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::HeadingHandle
-TelemetryImpl::subscribe_heading(const Telemetry::HeadingCallback& callback)
+std::pair<Telemetry::Result, Telemetry::HeadingHandle> TelemetryImpl::subscribe_heading(
+    const Telemetry::HeadingCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _heading_subscriptions.subscribe(callback);
+    return subscribe_with_options(_heading_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_heading(Telemetry::HeadingHandle handle)
@@ -2623,11 +2843,10 @@ void TelemetryImpl::unsubscribe_heading(Telemetry::HeadingHandle handle)
     _heading_subscriptions.unsubscribe(handle);
 }
 
-Telemetry::AltitudeHandle
-TelemetryImpl::subscribe_altitude(const Telemetry::AltitudeCallback& callback)
+std::pair<Telemetry::Result, Telemetry::AltitudeHandle> TelemetryImpl::subscribe_altitude(
+    const Telemetry::AltitudeCallback& callback, const Telemetry::SubscriptionOptions& options)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    return _altitude_subscriptions.subscribe(callback);
+    return subscribe_with_options(_altitude_subscriptions, callback, options);
 }
 
 void TelemetryImpl::unsubscribe_altitude(Telemetry::AltitudeHandle handle)
@@ -2684,16 +2903,56 @@ std::pair<Telemetry::Result, Telemetry::GpsGlobalOrigin> TelemetryImpl::get_gps_
     return fut.get();
 }
 
+Telemetry::Result TelemetryImpl::set_history_enabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(_history_mutex);
+    if (enabled && !_history) {
+        _history = std::make_unique<History>();
+    } else if (!enabled) {
+        _history.reset();
+    }
+    _history_enabled = enabled;
+    return Telemetry::Result::Success;
+}
+
+std::optional<Telemetry::Position> TelemetryImpl::position_at(uint64_t time_us) const
+{
+    std::lock_guard<std::mutex> lock(_history_mutex);
+    return _history ? _history->position.at(time_us) : std::nullopt;
+}
+
+std::optional<Telemetry::Quaternion> TelemetryImpl::attitude_quaternion_at(uint64_t time_us) const
+{
+    std::lock_guard<std::mutex> lock(_history_mutex);
+    return _history ? _history->attitude_quaternion.at(time_us) : std::nullopt;
+}
+
+std::optional<Telemetry::VelocityNed> TelemetryImpl::velocity_ned_at(uint64_t time_us) const
+{
+    std::lock_guard<std::mutex> lock(_history_mutex);
+    return _history ? _history->velocity_ned.at(time_us) : std::nullopt;
+}
+
+std::optional<Telemetry::Odometry> TelemetryImpl::odometry_at(uint64_t time_us) const
+{
+    std::lock_guard<std::mutex> lock(_history_mutex);
+    return _history ? _history->odometry.at(time_us) : std::nullopt;
+}
+
+uint64_t TelemetryImpl::autopilot_time_us() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     _system_impl->get_autopilot_time().now().time_since_epoch())
+                                     .count());
+}
+
 void TelemetryImpl::check_calibration()
 {
-    {
-        std::lock_guard<std::mutex> lock(_health_mutex);
-        if ((_has_received_gyro_calibration && _has_received_accel_calibration &&
-             _has_received_mag_calibration) ||
-            _has_received_hitl_param) {
-            _system_impl->remove_call_every(_calibration_cookie);
-            return;
-        }
+    if ((_has_received_gyro_calibration && _has_received_accel_calibration &&
+         _has_received_mag_calibration) ||
+        _has_received_hitl_param) {
+        _system_impl->remove_call_every(_calibration_cookie);
+        return;
     }
     if (_system_impl->has_autopilot()) {
         if (_system_impl->autopilot() == SystemImpl::Autopilot::ArduPilot) {
@@ -9,6 +9,9 @@
 #include "plugin_impl_base.h"
 #include "system.h"
 #include "callback_list.h"
+#include "converted_cache.h"
+#include "seqlock.h"
+#include "telemetry_history.h"
 
 namespace mavsdk {
 
@@ -75,12 +78,23 @@ public:
     void set_rate_odometry_async(double rate_hz, Telemetry::ResultCallback callback);
     void set_rate_distance_sensor_async(double rate_hz, Telemetry::ResultCallback callback);
     void set_rate_scaled_pressure_async(double rate_hz, Telemetry::ResultCallback callback);
+    void set_stream_profile_async(
+        const Telemetry::StreamProfile& stream_profile, Telemetry::ResultCallback callback);
+    Telemetry::Result set_stream_profile(const Telemetry::StreamProfile& stream_profile);
     void set_rate_unix_epoch_time_async(double rate_hz, Telemetry::ResultCallback callback);
     void set_rate_altitude_async(double rate_hz, Telemetry::ResultCallback callback);
 
     void get_gps_global_origin_async(const Telemetry::GetGpsGlobalOriginCallback callback);
     std::pair<Telemetry::Result, Telemetry::GpsGlobalOrigin> get_gps_global_origin();
 
+    Telemetry::Result set_history_enabled(bool enabled);
+    std::optional<Telemetry::Position> position_at(uint64_t time_us) const;
+    std::optional<Telemetry::Quaternion> attitude_quaternion_at(uint64_t time_us) const;
+    std::optional<Telemetry::VelocityNed> velocity_ned_at(uint64_t time_us) const;
+    std::optional<Telemetry::Odometry> odometry_at(uint64_t time_us) const;
+    uint64_t autopilot_time_us() const;
+    Telemetry::Snapshot snapshot() const;
+
     Telemetry::PositionVelocityNed position_velocity_ned() const;
     Telemetry::Position position() const;
     Telemetry::Position home() const;
@@ -116,92 +130,133 @@ public:
     Telemetry::Heading heading() const;
     Telemetry::Altitude altitude() const;
 
-    Telemetry::PositionVelocityNedHandle
-    subscribe_position_velocity_ned(const Telemetry::PositionVelocityNedCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::PositionVelocityNedHandle>
+    subscribe_position_velocity_ned(
+        const Telemetry::PositionVelocityNedCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_position_velocity_ned(Telemetry::PositionVelocityNedHandle handle);
-    Telemetry::PositionHandle subscribe_position(const Telemetry::PositionCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::PositionHandle> subscribe_position(
+        const Telemetry::PositionCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_position(Telemetry::PositionHandle handle);
-    Telemetry::HomeHandle subscribe_home(const Telemetry::PositionCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::HomeHandle> subscribe_home(
+        const Telemetry::PositionCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_home(Telemetry::HomeHandle handle);
-    Telemetry::InAirHandle subscribe_in_air(const Telemetry::InAirCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::InAirHandle> subscribe_in_air(
+        const Telemetry::InAirCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_in_air(Telemetry::InAirHandle handle);
-    Telemetry::StatusTextHandle
-    subscribe_status_text(const Telemetry::StatusTextCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::StatusTextHandle> subscribe_status_text(
+        const Telemetry::StatusTextCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_status_text(Telemetry::StatusTextHandle handle);
-    Telemetry::ArmedHandle subscribe_armed(const Telemetry::ArmedCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::ArmedHandle> subscribe_armed(
+        const Telemetry::ArmedCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_armed(Telemetry::ArmedHandle handle);
-    Telemetry::AttitudeQuaternionHandle
-    subscribe_attitude_quaternion(const Telemetry::AttitudeQuaternionCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::AttitudeQuaternionHandle> subscribe_attitude_quaternion(
+        const Telemetry::AttitudeQuaternionCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_attitude_quaternion(Telemetry::AttitudeQuaternionHandle handle);
-    Telemetry::AttitudeEulerHandle
-    subscribe_attitude_euler(const Telemetry::AttitudeEulerCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::AttitudeEulerHandle> subscribe_attitude_euler(
+        const Telemetry::AttitudeEulerCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_attitude_euler(Telemetry::AttitudeEulerHandle handle);
-    Telemetry::AttitudeAngularVelocityBodyHandle subscribe_attitude_angular_velocity_body(
-        const Telemetry::AttitudeAngularVelocityBodyCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::AttitudeAngularVelocityBodyHandle>
+    subscribe_attitude_angular_velocity_body(
+        const Telemetry::AttitudeAngularVelocityBodyCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void
     unsubscribe_attitude_angular_velocity_body(Telemetry::AttitudeAngularVelocityBodyHandle handle);
-    Telemetry::FixedwingMetricsHandle
-    subscribe_fixedwing_metrics(const Telemetry::FixedwingMetricsCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::FixedwingMetricsHandle> subscribe_fixedwing_metrics(
+        const Telemetry::FixedwingMetricsCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_fixedwing_metrics(Telemetry::FixedwingMetricsHandle handle);
-    Telemetry::GroundTruthHandle
-    subscribe_ground_truth(const Telemetry::GroundTruthCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::GroundTruthHandle> subscribe_ground_truth(
+        const Telemetry::GroundTruthCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_ground_truth(Telemetry::GroundTruthHandle handle);
-    Telemetry::AttitudeQuaternionHandle
-    subscribe_camera_attitude_quaternion(const Telemetry::AttitudeQuaternionCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::AttitudeQuaternionHandle>
+    subscribe_camera_attitude_quaternion(
+        const Telemetry::AttitudeQuaternionCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_camera_attitude_quaternion(Telemetry::AttitudeQuaternionHandle handle);
-    Telemetry::AttitudeEulerHandle
-    subscribe_camera_attitude_euler(const Telemetry::AttitudeEulerCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::AttitudeEulerHandle> subscribe_camera_attitude_euler(
+        const Telemetry::AttitudeEulerCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_camera_attitude_euler(Telemetry::AttitudeEulerHandle handle);
-    Telemetry::VelocityNedHandle
-    subscribe_velocity_ned(const Telemetry::VelocityNedCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::VelocityNedHandle> subscribe_velocity_ned(
+        const Telemetry::VelocityNedCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_velocity_ned(Telemetry::VelocityNedHandle handle);
-    Telemetry::ImuHandle subscribe_imu(const Telemetry::ImuCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::ImuHandle> subscribe_imu(
+        const Telemetry::ImuCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_imu(Telemetry::ImuHandle handle);
-    Telemetry::ScaledImuHandle subscribe_scaled_imu(const Telemetry::ScaledImuCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::ScaledImuHandle> subscribe_scaled_imu(
+        const Telemetry::ScaledImuCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_scaled_imu(Telemetry::ScaledImuHandle handle);
-    Telemetry::RawImuHandle subscribe_raw_imu(const Telemetry::RawImuCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::RawImuHandle> subscribe_raw_imu(
+        const Telemetry::RawImuCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_raw_imu(Telemetry::RawImuHandle handle);
-    Telemetry::GpsInfoHandle subscribe_gps_info(const Telemetry::GpsInfoCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::GpsInfoHandle> subscribe_gps_info(
+        const Telemetry::GpsInfoCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_gps_info(Telemetry::GpsInfoHandle handle);
-    Telemetry::RawGpsHandle subscribe_raw_gps(const Telemetry::RawGpsCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::RawGpsHandle> subscribe_raw_gps(
+        const Telemetry::RawGpsCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_raw_gps(Telemetry::RawGpsHandle handle);
-    Telemetry::BatteryHandle subscribe_battery(const Telemetry::BatteryCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::BatteryHandle> subscribe_battery(
+        const Telemetry::BatteryCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_battery(Telemetry::BatteryHandle handle);
-    Telemetry::FlightModeHandle
-    subscribe_flight_mode(const Telemetry::FlightModeCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::FlightModeHandle> subscribe_flight_mode(
+        const Telemetry::FlightModeCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_flight_mode(Telemetry::FlightModeHandle handle);
-    Telemetry::HealthHandle subscribe_health(const Telemetry::HealthCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::HealthHandle> subscribe_health(
+        const Telemetry::HealthCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_health(Telemetry::HealthHandle handle);
-    Telemetry::HealthAllOkHandle
-    subscribe_health_all_ok(const Telemetry::HealthAllOkCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::HealthAllOkHandle> subscribe_health_all_ok(
+        const Telemetry::HealthAllOkCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_health_all_ok(Telemetry::HealthAllOkHandle handle);
-    Telemetry::VtolStateHandle subscribe_vtol_state(const Telemetry::VtolStateCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::VtolStateHandle> subscribe_vtol_state(
+        const Telemetry::VtolStateCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_vtol_state(Telemetry::VtolStateHandle handle);
-    Telemetry::LandedStateHandle
-    subscribe_landed_state(const Telemetry::LandedStateCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::LandedStateHandle> subscribe_landed_state(
+        const Telemetry::LandedStateCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_landed_state(Telemetry::LandedStateHandle handle);
-    Telemetry::RcStatusHandle subscribe_rc_status(const Telemetry::RcStatusCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::RcStatusHandle> subscribe_rc_status(
+        const Telemetry::RcStatusCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_rc_status(Telemetry::RcStatusHandle handle);
-    Telemetry::UnixEpochTimeHandle
-    subscribe_unix_epoch_time(const Telemetry::UnixEpochTimeCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::UnixEpochTimeHandle> subscribe_unix_epoch_time(
+        const Telemetry::UnixEpochTimeCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_unix_epoch_time(Telemetry::UnixEpochTimeHandle handle);
-    Telemetry::ActuatorControlTargetHandle
-    subscribe_actuator_control_target(const Telemetry::ActuatorControlTargetCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::ActuatorControlTargetHandle>
+    subscribe_actuator_control_target(
+        const Telemetry::ActuatorControlTargetCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_actuator_control_target(Telemetry::ActuatorControlTargetHandle handle);
-    Telemetry::ActuatorOutputStatusHandle
-    subscribe_actuator_output_status(const Telemetry::ActuatorOutputStatusCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::ActuatorOutputStatusHandle>
+    subscribe_actuator_output_status(
+        const Telemetry::ActuatorOutputStatusCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_actuator_output_status(Telemetry::ActuatorOutputStatusHandle handle);
-    Telemetry::OdometryHandle subscribe_odometry(const Telemetry::OdometryCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::OdometryHandle> subscribe_odometry(
+        const Telemetry::OdometryCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_odometry(Telemetry::OdometryHandle handle);
-    Telemetry::DistanceSensorHandle
-    subscribe_distance_sensor(const Telemetry::DistanceSensorCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::DistanceSensorHandle> subscribe_distance_sensor(
+        const Telemetry::DistanceSensorCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_distance_sensor(Telemetry::DistanceSensorHandle handle);
-    Telemetry::ScaledPressureHandle
-    subscribe_scaled_pressure(const Telemetry::ScaledPressureCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::ScaledPressureHandle> subscribe_scaled_pressure(
+        const Telemetry::ScaledPressureCallback& callback,
+        const Telemetry::SubscriptionOptions& options);
     void unsubscribe_scaled_pressure(Telemetry::ScaledPressureHandle handle);
-    Telemetry::HeadingHandle subscribe_heading(const Telemetry::HeadingCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::HeadingHandle> subscribe_heading(
+        const Telemetry::HeadingCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_heading(Telemetry::HeadingHandle handle);
-    Telemetry::AltitudeHandle subscribe_altitude(const Telemetry::AltitudeCallback& callback);
+    std::pair<Telemetry::Result, Telemetry::AltitudeHandle> subscribe_altitude(
+        const Telemetry::AltitudeCallback& callback, const Telemetry::SubscriptionOptions& options);
     void unsubscribe_altitude(Telemetry::AltitudeHandle handle);
 
     TelemetryImpl(const TelemetryImpl&) = delete;
@@ -237,9 +292,6 @@ private:
     void set_health_armable(bool ok);
     void set_rc_status(std::optional<bool> available, std::optional<float> signal_strength_percent);
     void set_unix_epoch_time_us(uint64_t time_us);
-    void set_actuator_control_target(uint8_t group, const std::vector<float>& controls);
-    void set_actuator_output_status(uint32_t active, const std::vector<float>& actuators);
-    void set_odometry(Telemetry::Odometry& odometry);
     void set_distance_sensor(Telemetry::DistanceSensor& distance_sensor);
     void set_scaled_pressure(Telemetry::ScaledPressure& scaled_pressure);
     void set_heading(Telemetry::Heading heading);
@@ -270,6 +322,13 @@ private:
     void process_distance_sensor(const mavlink_message_t& message);
     void process_scaled_pressure(const mavlink_message_t& message);
     void process_altitude(const mavlink_message_t& message);
+
+    static Telemetry::ActuatorControlTarget
+    actuator_control_target_from_mavlink(const mavlink_set_actuator_control_target_t& target);
+    static Telemetry::ActuatorOutputStatus
+    actuator_output_status_from_mavlink(const mavlink_actuator_output_status_t& status);
+    static Telemetry::Odometry odometry_from_mavlink(const mavlink_odometry_t& odometry_msg);
+
     void receive_param_cal_gyro(MavlinkParameterClient::Result result, int value);
     void receive_param_cal_accel(MavlinkParameterClient::Result result, int value);
     void receive_param_cal_mag(MavlinkParameterClient::Result result, int value);
@@ -312,20 +371,22 @@ private:
 
     static Telemetry::FlightMode telemetry_flight_mode_from_flight_mode(FlightMode flight_mode);
 
-    // Make all fields thread-safe using mutexs
-    // The mutexs are mutable so that the lock can get aqcuired in
-    // methods marked const.
-    mutable std::mutex _position_mutex{};
-    Telemetry::Position _position{};
-
-    mutable std::mutex _heading_mutex{};
-    Telemetry::Heading _heading{};
+    static CallbackQueueMode queue_mode(const Telemetry::SubscriptionOptions& options);
 
-    mutable std::mutex _position_velocity_ned_mutex{};
-    Telemetry::PositionVelocityNed _position_velocity_ned{};
+    template<typename T>
+    std::pair<Telemetry::Result, Handle<T>> subscribe_with_options(
+        CallbackList<T>& subscriptions,
+        const std::function<void(T)>& callback,
+        const Telemetry::SubscriptionOptions& options);
 
-    mutable std::mutex _home_position_mutex{};
-    Telemetry::Position _home_position{};
+    // The latest values are kept in seqlocks so that polling them never blocks
+    // the receive thread, and vice versa. Fields which are not trivially
+    // copyable (strings, vectors) still use a mutex. The mutexs are mutable so
+    // that the lock can get aqcuired in methods marked const.
+    Seqlock<Telemetry::Position> _position{};
+    Seqlock<Telemetry::Heading> _heading{};
+    Seqlock<Telemetry::PositionVelocityNed> _position_velocity_ned{};
+    Seqlock<Telemetry::Position> _home_position{};
 
     // If possible, just use atomic instead of a mutex.
     std::atomic_bool _in_air{false};
@@ -334,79 +395,63 @@ private:
     mutable std::mutex _status_text_mutex{};
     Telemetry::StatusText _status_text{};
 
-    mutable std::mutex _attitude_quaternion_mutex{};
-    Telemetry::Quaternion _attitude_quaternion{};
-
-    mutable std::mutex _camera_attitude_euler_angle_mutex{};
-    Telemetry::EulerAngle _camera_attitude_euler_angle{};
-
-    mutable std::mutex _attitude_angular_velocity_body_mutex{};
-    Telemetry::AngularVelocityBody _attitude_angular_velocity_body{};
-
-    mutable std::mutex _ground_truth_mutex{};
-    Telemetry::GroundTruth _ground_truth{};
-
-    mutable std::mutex _fixedwing_metrics_mutex{};
-    Telemetry::FixedwingMetrics _fixedwing_metrics{};
-
-    mutable std::mutex _velocity_ned_mutex{};
-    Telemetry::VelocityNed _velocity_ned{};
-
-    mutable std::mutex _imu_reading_ned_mutex{};
-    Telemetry::Imu _imu_reading_ned{};
-
-    mutable std::mutex _scaled_imu_mutex{};
-    Telemetry::Imu _scaled_imu{};
-
-    mutable std::mutex _raw_imu_mutex{};
-    Telemetry::Imu _raw_imu{};
-
-    mutable std::mutex _gps_info_mutex{};
-    Telemetry::GpsInfo _gps_info{};
-
-    mutable std::mutex _raw_gps_mutex{};
-    Telemetry::RawGps _raw_gps{};
-
-    mutable std::mutex _battery_mutex{};
-    Telemetry::Battery _battery{};
-
-    mutable std::mutex _health_mutex{};
-    Telemetry::Health _health{};
-
-    mutable std::mutex _vtol_state_mutex{};
-    Telemetry::VtolState _vtol_state{Telemetry::VtolState::Undefined};
-
-    mutable std::mutex _landed_state_mutex{};
-    Telemetry::LandedState _landed_state{Telemetry::LandedState::Unknown};
-
-    mutable std::mutex _rc_status_mutex{};
-    Telemetry::RcStatus _rc_status{};
-
-    mutable std::mutex _unix_epoch_time_mutex{};
-    uint64_t _unix_epoch_time_us{};
-
-    mutable std::mutex _actuator_control_target_mutex{};
-    Telemetry::ActuatorControlTarget _actuator_control_target{};
-
-    mutable std::mutex _actuator_output_status_mutex{};
-    Telemetry::ActuatorOutputStatus _actuator_output_status{};
-
-    mutable std::mutex _odometry_mutex{};
-    Telemetry::Odometry _odometry{};
-
-    mutable std::mutex _distance_sensor_mutex{};
-    Telemetry::DistanceSensor _distance_sensor{};
-
-    mutable std::mutex _scaled_pressure_mutex{};
-    Telemetry::ScaledPressure _scaled_pressure{};
-
-    mutable std::mutex _altitude_mutex{};
-    Telemetry::Altitude _altitude{};
+    Seqlock<Telemetry::Quaternion> _attitude_quaternion{};
+    Seqlock<Telemetry::EulerAngle> _camera_attitude_euler_angle{};
+    Seqlock<Telemetry::AngularVelocityBody> _attitude_angular_velocity_body{};
+    Seqlock<Telemetry::GroundTruth> _ground_truth{};
+    Seqlock<Telemetry::FixedwingMetrics> _fixedwing_metrics{};
+    Seqlock<Telemetry::VelocityNed> _velocity_ned{};
+    Seqlock<Telemetry::Imu> _imu_reading_ned{};
+    Seqlock<Telemetry::Imu> _scaled_imu{};
+    Seqlock<Telemetry::Imu> _raw_imu{};
+    Seqlock<Telemetry::GpsInfo> _gps_info{};
+    Seqlock<Telemetry::RawGps> _raw_gps{};
+    Seqlock<Telemetry::Battery> _battery{};
+    Seqlock<Telemetry::Health> _health{};
+    Seqlock<Telemetry::VtolState> _vtol_state{Telemetry::VtolState::Undefined};
+    Seqlock<Telemetry::LandedState> _landed_state{Telemetry::LandedState::Unknown};
+    Seqlock<Telemetry::RcStatus> _rc_status{};
+    Seqlock<uint64_t> _unix_epoch_time_us{};
+
+    // These contain vectors, so the raw message is only converted when it is
+    // first read, or when there are subscribers for it.
+    ConvertedCache<mavlink_set_actuator_control_target_t, Telemetry::ActuatorControlTarget>
+        _actuator_control_target{};
+    ConvertedCache<mavlink_actuator_output_status_t, Telemetry::ActuatorOutputStatus>
+        _actuator_output_status{};
+    ConvertedCache<mavlink_odometry_t, Telemetry::Odometry> _odometry{};
+
+    Seqlock<Telemetry::DistanceSensor> _distance_sensor{};
+    Seqlock<Telemetry::ScaledPressure> _scaled_pressure{};
+    Seqlock<Telemetry::Altitude> _altitude{};
 
     mutable std::mutex _request_home_position_mutex{};
 
     std::atomic<bool> _hitl_enabled{false};
 
+    // About 5 seconds at 50 Hz.
+    static constexpr std::size_t HISTORY_LENGTH = 256;
+    struct History {
+        TelemetryHistory<Telemetry::Position, HISTORY_LENGTH> position{};
+        TelemetryHistory<Telemetry::Quaternion, HISTORY_LENGTH> attitude_quaternion{};
+        TelemetryHistory<Telemetry::VelocityNed, HISTORY_LENGTH> velocity_ned{};
+        TelemetryHistory<Telemetry::Odometry, HISTORY_LENGTH> odometry{};
+    };
+    template<typename AddFunc>
+    void add_to_history(std::chrono::microseconds time_since_boot, const AddFunc& add_func);
+
+    // All of the above again in one block, so they can be read consistently.
+    Seqlock<Telemetry::Snapshot> _snapshot{};
+    template<typename T>
+    void update_snapshot(
+        T Telemetry::Snapshot::*field, uint64_t Telemetry::Snapshot::*time_field, const T& value);
+    void update_health(bool Telemetry::Health::*field, bool ok);
+
+    // Only allocated once enabled.
+    mutable std::mutex _history_mutex{};
+    std::unique_ptr<History> _history{};
+    std::atomic<bool> _history_enabled{false};
+
     std::mutex _subscription_mutex{};
     CallbackList<Telemetry::PositionVelocityNed> _position_velocity_ned_subscriptions{};
     CallbackList<Telemetry::Position> _position_subscriptions{};
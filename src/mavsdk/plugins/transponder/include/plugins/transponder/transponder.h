@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -213,6 +214,22 @@ public:
      */
     Result set_rate_transponder(double rate_hz) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Set rate to 'transponder' updates.
+     *
+     * This function can be awaited. See 'set_rate_transponder_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> set_rate_transponder_awaitable(double rate_hz)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            set_rate_transponder_async(rate_hz, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Copy constructor.
      */
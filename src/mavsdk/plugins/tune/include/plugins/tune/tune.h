@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -156,6 +157,22 @@ public:
      */
     Result play_tune(TuneDescription tune_description) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Send a tune to be played by the system.
+     *
+     * This function can be awaited. See 'play_tune_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> play_tune_awaitable(TuneDescription tune_description)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            play_tune_async(tune_description, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Copy constructor.
      */
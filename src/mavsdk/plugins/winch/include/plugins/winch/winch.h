@@ -16,6 +16,7 @@
 #include "plugin_base.h"
 
 #include "handle.h"
+#include "awaitable.h"
 
 namespace mavsdk {
 
@@ -225,6 +226,20 @@ public:
      */
     Result relax(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Allow motor to freewheel.
+     *
+     * This function can be awaited. See 'relax_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> relax_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) { relax_async(instance, callback); });
+    }
+#endif
+
     /**
      * @brief Wind or unwind specified length of line, optionally using specified rate.
      *
@@ -243,6 +258,24 @@ public:
      */
     Result relative_length_control(uint32_t instance, float length_m, float rate_m_s) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Wind or unwind specified length of line, optionally using specified rate.
+     *
+     * This function can be awaited. See 'relative_length_control_async' for the callback
+     * counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> relative_length_control_awaitable(
+        uint32_t instance, float length_m, float rate_m_s)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            relative_length_control_async(instance, length_m, rate_m_s, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Wind or unwind line at specified rate.
      *
@@ -259,6 +292,22 @@ public:
      */
     Result rate_control(uint32_t instance, float rate_m_s) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Wind or unwind line at specified rate.
+     *
+     * This function can be awaited. See 'rate_control_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> rate_control_awaitable(uint32_t instance, float rate_m_s)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            rate_control_async(instance, rate_m_s, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Perform the locking sequence to relieve motor while in the fully retracted position.
      *
@@ -275,6 +324,20 @@ public:
      */
     Result lock(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Perform the locking sequence to relieve motor while in the fully retracted position.
+     *
+     * This function can be awaited. See 'lock_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> lock_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) { lock_async(instance, callback); });
+    }
+#endif
+
     /**
      * @brief Sequence of drop, slow down, touch down, reel up, lock.
      *
@@ -291,6 +354,20 @@ public:
      */
     Result deliver(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Sequence of drop, slow down, touch down, reel up, lock.
+     *
+     * This function can be awaited. See 'deliver_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> deliver_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) { deliver_async(instance, callback); });
+    }
+#endif
+
     /**
      * @brief Engage motor and hold current position.
      *
@@ -307,6 +384,20 @@ public:
      */
     Result hold(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Engage motor and hold current position.
+     *
+     * This function can be awaited. See 'hold_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> hold_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) { hold_async(instance, callback); });
+    }
+#endif
+
     /**
      * @brief Return the reel to the fully retracted position.
      *
@@ -323,6 +414,20 @@ public:
      */
     Result retract(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Return the reel to the fully retracted position.
+     *
+     * This function can be awaited. See 'retract_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> retract_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) { retract_async(instance, callback); });
+    }
+#endif
+
     /**
      * @brief Load the reel with line.
      *
@@ -345,6 +450,23 @@ public:
      */
     Result load_line(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Load the reel with line.
+     *
+     * The winch will calculate the total loaded length and stop when the tension exceeds a
+     * threshold.
+     *
+     * This function can be awaited. See 'load_line_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> load_line_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) { load_line_async(instance, callback); });
+    }
+#endif
+
     /**
      * @brief Spool out the entire length of the line.
      *
@@ -361,6 +483,22 @@ public:
      */
     Result abandon_line(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Spool out the entire length of the line.
+     *
+     * This function can be awaited. See 'abandon_line_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> abandon_line_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            abandon_line_async(instance, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Spools out just enough to present the hook to the user to load the payload.
      *
@@ -377,6 +515,22 @@ public:
      */
     Result load_payload(uint32_t instance) const;
 
+#ifdef MAVSDK_HAS_COROUTINES
+    /**
+     * @brief Spools out just enough to present the hook to the user to load the payload.
+     *
+     * This function can be awaited. See 'load_payload_async' for the callback counterpart.
+     *
+     * @return Awaitable result of request.
+     */
+    Awaitable<Result> load_payload_awaitable(uint32_t instance)
+    {
+        return Awaitable<Result>([=, this](auto callback) {
+            load_payload_async(instance, callback);
+        });
+    }
+#endif
+
     /**
      * @brief Copy constructor.
      */
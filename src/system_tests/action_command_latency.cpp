@@ -0,0 +1,99 @@
+#include "log.h"
+#include "mavsdk.h"
+#include "plugins/action/action.h"
+#include "plugins/action_server/action_server.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(SystemTest, ActionCommandLatency)
+{
+    // What the autopilot was asked to do, declared first to outlive the
+    // callbacks.
+    std::mutex arm_requests_mutex;
+    std::vector<bool> arm_requests;
+
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+
+    ASSERT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    ASSERT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17000"), ConnectionResult::Success);
+
+    auto action_server = ActionServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    ASSERT_TRUE(maybe_system);
+    auto system = maybe_system.value();
+
+    ASSERT_TRUE(system->has_autopilot());
+
+    auto action = Action{system};
+
+    EXPECT_EQ(action_server.set_armable(true, true), ActionServer::Result::Success);
+    EXPECT_EQ(action_server.set_disarmable(true, true), ActionServer::Result::Success);
+
+    action_server.subscribe_arm_disarm(
+        [&](ActionServer::Result result, ActionServer::ArmDisarm arm_disarm) {
+            EXPECT_EQ(result, ActionServer::Result::Success);
+            std::lock_guard<std::mutex> lock(arm_requests_mutex);
+            // A command sent again because its ack was late arrives twice.
+            if (arm_requests.empty() || arm_requests.back() != arm_disarm.arm) {
+                arm_requests.push_back(arm_disarm.arm);
+            }
+        });
+
+    // Every command goes through the system thread, so this measures how quickly
+    // it picks up queued work in addition to the actual round trip.
+    constexpr unsigned num_commands = 100;
+    std::vector<double> latencies_ms;
+    latencies_ms.reserve(num_commands);
+
+    for (unsigned i = 0; i < num_commands; ++i) {
+        const auto before = std::chrono::steady_clock::now();
+        const auto result = (i % 2 == 0) ? action.arm() : action.disarm();
+        const auto after = std::chrono::steady_clock::now();
+        ASSERT_EQ(result, Action::Result::Success);
+
+        latencies_ms.push_back(std::chrono::duration<double, std::milli>(after - before).count());
+    }
+
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    const double mean_ms =
+        std::accumulate(latencies_ms.begin(), latencies_ms.end(), 0.0) / latencies_ms.size();
+    const double median_ms = latencies_ms[latencies_ms.size() / 2];
+    const double max_ms = latencies_ms.back();
+
+    // Only reported, the round trip depends too much on the machine to be
+    // checked. Locally it is well below a millisecond.
+    LogInfo() << "Command round trip: mean " << mean_ms << " ms, median " << median_ms
+              << " ms, max " << max_ms << " ms";
+
+    // Each command arrived, in order.
+    for (unsigned i = 0; i < 100; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(arm_requests_mutex);
+            if (arm_requests.size() == num_commands) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::lock_guard<std::mutex> lock(arm_requests_mutex);
+    ASSERT_EQ(arm_requests.size(), num_commands);
+    for (unsigned i = 0; i < num_commands; ++i) {
+        EXPECT_EQ(arm_requests[i], i % 2 == 0) << i;
+    }
+}
@@ -0,0 +1,146 @@
+#include "log.h"
+#include "mavsdk.h"
+#include "plugins/action/action.h"
+#include "plugins/action_server/action_server.h"
+#include "plugin_impl_base.h"
+#include "udp_delay_relay.h"
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+#ifndef WINDOWS
+
+// Gives access to the timeouts of a system, which are not part of the API.
+class TimeoutProbe : public PluginImplBase {
+public:
+    explicit TimeoutProbe(std::shared_ptr<System> system) : PluginImplBase(std::move(system)) {}
+
+    void init() override {}
+    void deinit() override {}
+    void enable() override {}
+    void disable() override {}
+
+    std::optional<double> smoothed_rtt_s() const
+    {
+        return _system_impl->rtt_estimator().smoothed_rtt_s();
+    }
+
+    double timeout_s() const { return _system_impl->timeout_s(); }
+    double timeout_s(double initial_timeout_s) const
+    {
+        return _system_impl->timeout_s(initial_timeout_s);
+    }
+
+    bool wait_for_rtt(std::chrono::seconds max_wait) const
+    {
+        const auto deadline = std::chrono::steady_clock::now() + max_wait;
+        while (!smoothed_rtt_s()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return true;
+    }
+};
+
+TEST(SystemTest, AdaptiveTimeoutHighLatency)
+{
+    // A round trip of 700 ms is longer than the default timeout of 500 ms, so
+    // without adapting to it every command would be sent twice.
+    constexpr auto one_way_delay = std::chrono::milliseconds(350);
+    UdpDelayRelay relay{17001, 17000, one_way_delay};
+
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+
+    ASSERT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    ASSERT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17001"), ConnectionResult::Success);
+
+    auto action_server = ActionServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+
+    EXPECT_EQ(action_server.set_armable(true, true), ActionServer::Result::Success);
+    EXPECT_EQ(action_server.set_disarmable(true, true), ActionServer::Result::Success);
+
+    std::atomic<unsigned> num_received{0};
+    mavsdk_autopilot.intercept_incoming_messages_async([&](mavlink_message_t& message) {
+        if (message.msgid == MAVLINK_MSG_ID_COMMAND_LONG &&
+            mavlink_msg_command_long_get_command(&message) == MAV_CMD_COMPONENT_ARM_DISARM) {
+            ++num_received;
+        }
+        return true;
+    });
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    ASSERT_TRUE(maybe_system);
+    auto system = maybe_system.value();
+
+    ASSERT_TRUE(system->has_autopilot());
+
+    auto action = Action{system};
+
+    // The commands should only go out once the round trip is measured.
+    TimeoutProbe probe{system};
+    ASSERT_TRUE(probe.wait_for_rtt(std::chrono::seconds(10)));
+    EXPECT_GT(probe.timeout_s(), 2 * std::chrono::duration<double>(one_way_delay).count());
+
+    constexpr unsigned num_commands = 6;
+    for (unsigned i = 0; i < num_commands; ++i) {
+        const auto before = std::chrono::steady_clock::now();
+        const auto result = (i % 2 == 0) ? action.arm() : action.disarm();
+        const auto after = std::chrono::steady_clock::now();
+        ASSERT_EQ(result, Action::Result::Success);
+
+        LogInfo() << "Command round trip: "
+                  << std::chrono::duration<double, std::milli>(after - before).count() << " ms";
+    }
+
+    // A command sent again went out before its ack came back, so it arrives
+    // at most one delay after that. Wait for it, with some margin.
+    std::this_thread::sleep_for(2 * one_way_delay);
+
+    EXPECT_EQ(num_received, num_commands);
+}
+
+TEST(SystemTest, AdaptiveTimeoutFixedBySetTimeout)
+{
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+    mavsdk_groundstation.set_timeout_s(1.5);
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+
+    ASSERT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    ASSERT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17000"), ConnectionResult::Success);
+
+    auto action_server = ActionServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    ASSERT_TRUE(maybe_system);
+    auto system = maybe_system.value();
+
+    // Even with the round trip measured, the timeout set is used, also by
+    // protocols with their own initial timeout such as FTP and log files.
+    TimeoutProbe probe{system};
+    ASSERT_TRUE(probe.wait_for_rtt(std::chrono::seconds(10)));
+    EXPECT_DOUBLE_EQ(probe.timeout_s(), 1.5);
+    EXPECT_DOUBLE_EQ(probe.timeout_s(0.1), 1.5);
+}
+
+#endif // WINDOWS
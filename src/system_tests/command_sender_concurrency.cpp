@@ -0,0 +1,135 @@
+#include "log.h"
+#include "mavsdk.h"
+#include "plugins/mavlink_passthrough/mavlink_passthrough.h"
+#include "plugins/telemetry_server/telemetry_server.h"
+#include "udp_delay_relay.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+#ifndef WINDOWS
+
+TEST(SystemTest, CommandSenderConcurrency)
+{
+    // 50 ms in each direction, so roughly what an LTE link looks like.
+    constexpr auto one_way_delay = std::chrono::milliseconds(50);
+    UdpDelayRelay relay{17001, 17000, one_way_delay};
+
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+
+    ASSERT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    ASSERT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17001"), ConnectionResult::Success);
+
+    // Acks SET_MESSAGE_INTERVAL for any message ID.
+    auto telemetry_server = TelemetryServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    ASSERT_TRUE(maybe_system);
+    auto system = maybe_system.value();
+
+    ASSERT_TRUE(system->has_autopilot());
+
+    auto mavlink_passthrough = MavlinkPassthrough{system};
+
+    constexpr unsigned num_commands = 50;
+    constexpr unsigned first_message_id = 1000; // Unused message IDs
+
+    // Acks are dropped until every command has been sent at least once, so
+    // how many are in flight at once doesn't depend on how quickly they are
+    // sent compared to the round trip time. Dropped ones are retransmitted.
+    std::mutex mutex;
+    std::set<unsigned> sent_message_ids;
+    unsigned num_acks_passed = 0;
+    unsigned max_in_flight = 0;
+
+    mavsdk_groundstation.intercept_outgoing_messages_async([&](mavlink_message_t& message) {
+        if (message.msgid != MAVLINK_MSG_ID_COMMAND_LONG) {
+            return true;
+        }
+        mavlink_command_long_t command_long;
+        mavlink_msg_command_long_decode(&message, &command_long);
+        if (command_long.command == MAV_CMD_SET_MESSAGE_INTERVAL) {
+            std::lock_guard<std::mutex> lock(mutex);
+            sent_message_ids.insert(static_cast<unsigned>(command_long.param1));
+            max_in_flight = std::max(
+                max_in_flight, static_cast<unsigned>(sent_message_ids.size()) - num_acks_passed);
+        }
+        return true;
+    });
+
+    mavsdk_groundstation.intercept_incoming_messages_async([&](mavlink_message_t& message) {
+        if (message.msgid != MAVLINK_MSG_ID_COMMAND_ACK) {
+            return true;
+        }
+        mavlink_command_ack_t command_ack;
+        mavlink_msg_command_ack_decode(&message, &command_ack);
+        if (command_ack.command != MAV_CMD_SET_MESSAGE_INTERVAL) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (sent_message_ids.size() < num_commands) {
+            return false;
+        }
+        ++num_acks_passed;
+        return true;
+    });
+
+    // The commands only differ in param1. Setting an interval is idempotent
+    // and the acks come back in order, so they should all be in flight at
+    // the same time rather than one round trip after the other.
+    std::atomic<unsigned> num_success{0};
+    std::vector<std::thread> senders;
+
+    const auto before = std::chrono::steady_clock::now();
+
+    for (unsigned i = 0; i < num_commands; ++i) {
+        senders.emplace_back([&, i]() {
+            MavlinkPassthrough::CommandLong command{};
+            command.target_sysid = system->get_system_id();
+            command.target_compid = MAV_COMP_ID_AUTOPILOT1;
+            command.command = MAV_CMD_SET_MESSAGE_INTERVAL;
+            command.param1 = static_cast<float>(first_message_id + i);
+            command.param2 = 1000000.0f; // 1 Hz
+            if (mavlink_passthrough.send_command_long(command) ==
+                MavlinkPassthrough::Result::Success) {
+                ++num_success;
+            }
+        });
+    }
+
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    const auto after = std::chrono::steady_clock::now();
+    const double total_ms = std::chrono::duration<double, std::milli>(after - before).count();
+
+    // Before going out of scope, we need to make sure to no longer access the
+    // local variables from the callbacks.
+    mavsdk_groundstation.intercept_outgoing_messages_async(nullptr);
+    mavsdk_groundstation.intercept_incoming_messages_async(nullptr);
+
+    LogInfo() << "Sent " << num_commands << " commands with " << 2 * one_way_delay.count()
+              << " ms round trip in " << total_ms << " ms, at most " << max_in_flight
+              << " in flight";
+
+    EXPECT_EQ(num_success, num_commands);
+    EXPECT_EQ(max_in_flight, num_commands);
+}
+
+#endif // WINDOWS
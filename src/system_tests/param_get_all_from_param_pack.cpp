@@ -0,0 +1,227 @@
+#include "log.h"
+#include "mavsdk.h"
+#include "plugins/ftp/ftp.h"
+#include "plugins/param/param.h"
+#include "plugins/param_server/param_server.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+static constexpr unsigned num_params = 300;
+
+static std::map<std::string, float> generate_params()
+{
+    std::map<std::string, float> params;
+    for (unsigned i = 0; i < num_params; ++i) {
+        const auto id = std::string("TEST_PACK") + std::to_string(i);
+        params[id] = 42.0f + static_cast<float>(i);
+    }
+    return params;
+}
+
+// Packs float params the way ArduPilot serves them over MAVLink FTP, but
+// without sharing name prefixes between params.
+static std::vector<char> pack_params(const std::map<std::string, float>& params)
+{
+    std::vector<char> data;
+    const auto add_u16 = [&](uint16_t value) {
+        data.push_back(static_cast<char>(value & 0xff));
+        data.push_back(static_cast<char>(value >> 8));
+    };
+    add_u16(0x671b);
+    add_u16(static_cast<uint16_t>(params.size()));
+    add_u16(static_cast<uint16_t>(params.size()));
+
+    for (const auto& [name, value] : params) {
+        char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+
+        data.push_back(4); // float
+        data.push_back(static_cast<char>((name.size() - 1) << 4));
+        data.insert(data.end(), name.begin(), name.end());
+        data.insert(data.end(), std::begin(bytes), std::end(bytes));
+    }
+    return data;
+}
+
+static unsigned num_param_download_directories()
+{
+    unsigned num = 0;
+    for (const auto& entry :
+         std::filesystem::directory_iterator(std::filesystem::temp_directory_path())) {
+        if (entry.path().filename().string().rfind("mavsdk-param-download", 0) == 0) {
+            ++num;
+        }
+    }
+    return num;
+}
+
+struct ParamPackDownload {
+    Param::AllParams all_params{};
+    unsigned num_list_requests{0};
+    unsigned num_ftp_requests{0};
+    double duration_s{0.0};
+};
+
+// Gets all params from an autopilot that serves the files in root_directory
+// over MAVLink FTP.
+static ParamPackDownload get_all_params_with_ftp(const std::string& root_directory)
+{
+    ParamPackDownload download;
+
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+
+    // The autopilot server component doesn't announce MAVLink FTP, so we add
+    // it to the capabilities as they arrive.
+    std::atomic<bool> ftp_announced{false};
+    mavsdk_groundstation.intercept_incoming_messages_async([&](mavlink_message_t& message) {
+        if (message.msgid == MAVLINK_MSG_ID_AUTOPILOT_VERSION) {
+            mavlink_autopilot_version_t autopilot_version;
+            mavlink_msg_autopilot_version_decode(&message, &autopilot_version);
+            autopilot_version.capabilities |= MAV_PROTOCOL_CAPABILITY_FTP;
+            mavlink_msg_autopilot_version_encode(
+                message.sysid, message.compid, &message, &autopilot_version);
+            ftp_announced = true;
+        }
+        return true;
+    });
+
+    std::atomic<unsigned> num_list_requests{0};
+    std::atomic<unsigned> num_ftp_requests{0};
+    mavsdk_groundstation.intercept_outgoing_messages_async([&](mavlink_message_t& message) {
+        if (message.msgid == MAVLINK_MSG_ID_PARAM_REQUEST_LIST) {
+            ++num_list_requests;
+        } else if (message.msgid == MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL) {
+            ++num_ftp_requests;
+        }
+        return true;
+    });
+
+    EXPECT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    EXPECT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17000"), ConnectionResult::Success);
+
+    auto param_server = ParamServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+    for (const auto& [key, value] : generate_params()) {
+        EXPECT_EQ(param_server.provide_param_float(key, value), ParamServer::Result::Success);
+    }
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    EXPECT_TRUE(maybe_system);
+    if (!maybe_system) {
+        return download;
+    }
+    auto system = maybe_system.value();
+
+    // The autopilot serves FTP to the groundstation through the system it
+    // has for it.
+    for (unsigned i = 0; i < 100 && mavsdk_autopilot.systems().empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_FALSE(mavsdk_autopilot.systems().empty());
+    if (mavsdk_autopilot.systems().empty()) {
+        return download;
+    }
+    auto ftp_server = Ftp{mavsdk_autopilot.systems().front()};
+    EXPECT_EQ(ftp_server.set_root_directory(root_directory), Ftp::Result::Success);
+
+    for (unsigned i = 0; i < 100 && !ftp_announced; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(ftp_announced);
+
+    auto param = Param{system};
+    // The param pack is only tried with the non-extended protocol.
+    param.select_component(1, Param::ProtocolVersion::V1);
+
+    const auto start = std::chrono::steady_clock::now();
+    download.all_params = param.get_all_params();
+    download.duration_s =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    download.num_list_requests = num_list_requests;
+    download.num_ftp_requests = num_ftp_requests;
+
+    // The callbacks access locals, so they need to go before they do.
+    mavsdk_groundstation.intercept_incoming_messages_async(nullptr);
+    mavsdk_groundstation.intercept_outgoing_messages_async(nullptr);
+
+    return download;
+}
+
+static void expect_all_params(const Param::AllParams& all_params)
+{
+    const auto params = generate_params();
+    EXPECT_EQ(all_params.float_params.size(), params.size());
+    for (const auto& param : all_params.float_params) {
+        const auto it = params.find(param.name);
+        ASSERT_NE(it, params.end()) << param.name;
+        EXPECT_EQ(param.value, it->second);
+    }
+}
+
+TEST(SystemTest, ParamGetAllFromParamPack)
+{
+    auto root_directory = std::filesystem::temp_directory_path() / "mavsdk-param-pack-test";
+    std::filesystem::remove_all(root_directory);
+    ASSERT_TRUE(std::filesystem::create_directories(root_directory / "@PARAM"));
+    {
+        const auto pack = pack_params(generate_params());
+        std::ofstream file(root_directory / "@PARAM" / "param.pck", std::ios::binary);
+        file.write(pack.data(), static_cast<std::streamsize>(pack.size()));
+    }
+
+    const auto num_directories_before = num_param_download_directories();
+
+    const auto packed = get_all_params_with_ftp(root_directory.string());
+
+    LogInfo() << "Downloading " << num_params << " params over MAVLink FTP took "
+              << packed.duration_s << " s";
+
+    expect_all_params(packed.all_params);
+    EXPECT_GT(packed.num_ftp_requests, 0u);
+    EXPECT_EQ(packed.num_list_requests, 0u);
+
+    // The downloaded file is only needed until it is decoded.
+    EXPECT_EQ(num_param_download_directories(), num_directories_before);
+
+    std::filesystem::remove_all(root_directory);
+}
+
+TEST(SystemTest, ParamGetAllFallsBackWithoutParamPack)
+{
+    // Nothing is served, like on PX4.
+    auto root_directory = std::filesystem::temp_directory_path() / "mavsdk-param-pack-test";
+    std::filesystem::remove_all(root_directory);
+    ASSERT_TRUE(std::filesystem::create_directories(root_directory));
+
+    const auto num_directories_before = num_param_download_directories();
+
+    const auto classic = get_all_params_with_ftp(root_directory.string());
+
+    LogInfo() << "Downloading " << num_params << " params one by one took "
+              << classic.duration_s << " s";
+
+    expect_all_params(classic.all_params);
+    EXPECT_GT(classic.num_ftp_requests, 0u);
+    EXPECT_GE(classic.num_list_requests, 1u);
+
+    EXPECT_EQ(num_param_download_directories(), num_directories_before);
+
+    std::filesystem::remove_all(root_directory);
+}
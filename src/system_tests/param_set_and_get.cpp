@@ -3,6 +3,7 @@
 #include "plugins/param/param.h"
 #include "plugins/param_server/param_server.h"
 #include <chrono>
+#include <future>
 #include <gtest/gtest.h>
 
 using namespace mavsdk;
@@ -182,3 +183,72 @@ TEST(SystemTest, ParamSetAndGetLossy)
     mavsdk_groundstation.intercept_incoming_messages_async(nullptr);
     mavsdk_groundstation.intercept_incoming_messages_async(nullptr);
 }
+
+TEST(SystemTest, ParamSetAndGetAsync)
+{
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+    mavsdk_groundstation.set_timeout_s(reduced_timeout_s);
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+    mavsdk_autopilot.set_timeout_s(reduced_timeout_s);
+
+    ASSERT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    ASSERT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17000"), ConnectionResult::Success);
+
+    auto param_server = ParamServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    ASSERT_TRUE(maybe_system);
+    auto system = maybe_system.value();
+
+    auto param = Param{system};
+
+    EXPECT_EQ(
+        param_server.provide_param_float(param_name_float, param_value_float),
+        ParamServer::Result::Success);
+    EXPECT_EQ(
+        param_server.provide_param_int(param_name_int, param_value_int),
+        ParamServer::Result::Success);
+
+    // Both requests are in flight at the same time.
+    auto float_prom = std::promise<std::pair<Param::Result, float>>{};
+    auto float_fut = float_prom.get_future();
+    param.get_param_float_async(param_name_float, [&](Param::Result result, float value) {
+        float_prom.set_value({result, value});
+    });
+
+    auto int_prom = std::promise<std::pair<Param::Result, int32_t>>{};
+    auto int_fut = int_prom.get_future();
+    param.get_param_int_async(param_name_int, [&](Param::Result result, int32_t value) {
+        int_prom.set_value({result, value});
+    });
+
+    ASSERT_EQ(float_fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    auto float_result = float_fut.get();
+    EXPECT_EQ(float_result.first, Param::Result::Success);
+    EXPECT_EQ(float_result.second, param_value_float);
+
+    ASSERT_EQ(int_fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    auto int_result = int_fut.get();
+    EXPECT_EQ(int_result.first, Param::Result::Success);
+    EXPECT_EQ(int_result.second, param_value_int);
+
+    auto set_prom = std::promise<Param::Result>{};
+    auto set_fut = set_prom.get_future();
+    param.set_param_int_async(param_name_int, param_value_int + 1, [&](Param::Result result) {
+        set_prom.set_value(result);
+    });
+
+    ASSERT_EQ(set_fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(set_fut.get(), Param::Result::Success);
+
+    auto server_result_pair = param_server.retrieve_param_int(param_name_int);
+    EXPECT_EQ(server_result_pair.first, ParamServer::Result::Success);
+    EXPECT_EQ(server_result_pair.second, param_value_int + 1);
+}
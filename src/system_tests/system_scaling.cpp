@@ -0,0 +1,219 @@
+#include "log.h"
+#include "mavsdk.h"
+#include "mavlink_include.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace mavsdk;
+
+#if defined(__linux__)
+
+namespace {
+
+// Reads a field such as "Threads" or "VmRSS" from /proc/self/status.
+unsigned long read_proc_status(const std::string& field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind(field + ":", 0) == 0) {
+            return std::stoul(line.substr(field.size() + 1));
+        }
+    }
+    return 0;
+}
+
+std::set<std::string> thread_ids()
+{
+    std::set<std::string> ids;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task")) {
+        ids.insert(entry.path().filename().string());
+    }
+    return ids;
+}
+
+std::set<std::string> without(const std::set<std::string>& ids, const std::set<std::string>& other)
+{
+    std::set<std::string> result;
+    std::set_difference(
+        ids.begin(),
+        ids.end(),
+        other.begin(),
+        other.end(),
+        std::inserter(result, result.begin()));
+    return result;
+}
+
+// CPU time used by the given threads so far, as far as they still exist.
+double cpu_time_s(const std::set<std::string>& ids)
+{
+    unsigned long ticks = 0;
+    for (const auto& id : ids) {
+        std::ifstream stat("/proc/self/task/" + id + "/stat");
+        std::string line;
+        if (!std::getline(stat, line)) {
+            continue;
+        }
+        // The name in parentheses can contain spaces, utime and stime are
+        // the 12th and 13th field after it.
+        std::istringstream fields(line.substr(line.rfind(')') + 2));
+        std::string field;
+        for (unsigned i = 0; i < 11; ++i) {
+            fields >> field;
+        }
+        unsigned long utime = 0;
+        unsigned long stime = 0;
+        fields >> utime >> stime;
+        ticks += utime + stime;
+    }
+    return static_cast<double>(ticks) / static_cast<double>(sysconf(_SC_CLK_TCK));
+}
+
+void send_heartbeats(int fd, const sockaddr_in& addr, unsigned num_systems)
+{
+    for (unsigned i = 1; i <= num_systems; ++i) {
+        mavlink_message_t message;
+        mavlink_msg_heartbeat_pack(
+            static_cast<uint8_t>(i),
+            MAV_COMP_ID_AUTOPILOT1,
+            &message,
+            MAV_TYPE_QUADROTOR,
+            MAV_AUTOPILOT_PX4,
+            0,
+            0,
+            MAV_STATE_STANDBY);
+
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const auto len = mavlink_msg_to_send_buffer(buffer, &message);
+        sendto(
+            fd,
+            reinterpret_cast<const char*>(buffer),
+            len,
+            0,
+            reinterpret_cast<const sockaddr*>(&addr),
+            sizeof(addr));
+    }
+}
+
+struct Groundstation {
+    std::unique_ptr<Mavsdk> mavsdk{};
+    sockaddr_in addr{};
+    // Threads started by this instance.
+    std::set<std::string> threads{};
+    unsigned long rss_kb{0};
+};
+
+// Connects num_systems fake vehicles to a new groundstation listening on port.
+// The threads and memory it needs are the difference to before.
+void connect_groundstation(
+    Groundstation& groundstation,
+    int fd,
+    unsigned port,
+    unsigned num_systems,
+    std::optional<unsigned> num_worker_threads)
+{
+    const auto threads_before = thread_ids();
+    const auto rss_before_kb = read_proc_status("VmRSS");
+
+    groundstation.mavsdk = std::make_unique<Mavsdk>();
+    groundstation.mavsdk->set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+    if (num_worker_threads) {
+        groundstation.mavsdk->set_num_system_worker_threads(num_worker_threads.value());
+    }
+
+    ASSERT_EQ(
+        groundstation.mavsdk->add_any_connection("udp://:" + std::to_string(port)),
+        ConnectionResult::Success);
+
+    groundstation.addr.sin_family = AF_INET;
+    groundstation.addr.sin_port = htons(port);
+    groundstation.addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    for (unsigned i = 0; i < 50 && groundstation.mavsdk->systems().size() < num_systems; ++i) {
+        send_heartbeats(fd, groundstation.addr, num_systems);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ASSERT_EQ(groundstation.mavsdk->systems().size(), num_systems);
+
+    groundstation.threads = without(thread_ids(), threads_before);
+    groundstation.rss_kb = read_proc_status("VmRSS") - rss_before_kb;
+}
+
+} // namespace
+
+// Compares the shared worker pool with a thread per system, which is what it
+// replaced. Both groundstations run side by side, so that neither gets to
+// reuse memory the other has freed.
+TEST(SystemTest, SystemScaling)
+{
+    constexpr unsigned num_systems = 100;
+
+    // The worker pool has a thread per core by default.
+    const unsigned num_cores = std::max(std::thread::hardware_concurrency(), 1u);
+    if (num_cores >= num_systems) {
+        GTEST_SKIP() << "As many cores as systems, the pool has a thread per system as well";
+    }
+
+    // Fake vehicles that only send heartbeats.
+    const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(fd, 0);
+
+    Groundstation per_thread;
+    ASSERT_NO_FATAL_FAILURE(connect_groundstation(per_thread, fd, 17000, num_systems, num_systems));
+    Groundstation pooled;
+    ASSERT_NO_FATAL_FAILURE(connect_groundstation(pooled, fd, 17001, num_systems, std::nullopt));
+
+    // Keep them connected for a while to see what the steady state costs.
+    const auto per_thread_cpu_before_s = cpu_time_s(per_thread.threads);
+    const auto pooled_cpu_before_s = cpu_time_s(pooled.threads);
+    constexpr unsigned duration_s = 5;
+    for (unsigned i = 0; i < duration_s; ++i) {
+        send_heartbeats(fd, per_thread.addr, num_systems);
+        send_heartbeats(fd, pooled.addr, num_systems);
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    const auto per_thread_cpu_s = cpu_time_s(per_thread.threads) - per_thread_cpu_before_s;
+    const auto pooled_cpu_s = cpu_time_s(pooled.threads) - pooled_cpu_before_s;
+
+    close(fd);
+
+    LogInfo() << num_systems << " systems with a thread each: " << per_thread.threads.size()
+              << " threads, RSS +" << per_thread.rss_kb << " kB, CPU "
+              << (per_thread_cpu_s / duration_s * 100.0) << " %";
+    LogInfo() << num_systems << " systems on the worker pool: " << pooled.threads.size()
+              << " threads, RSS +" << pooled.rss_kb << " kB, CPU "
+              << (pooled_cpu_s / duration_s * 100.0) << " %";
+
+    // The number of threads must not depend on the number of systems, with a
+    // little slack for unrelated short-lived threads.
+    EXPECT_LE(
+        pooled.threads.size() + num_systems, per_thread.threads.size() + num_cores + 2);
+
+    // Not having a thread per system saves their stacks.
+    EXPECT_LT(pooled.rss_kb, per_thread.rss_kb);
+
+    // Waking the pool's threads for all systems must not cost more than
+    // waking a thread per system, give or take 1 % of a core.
+    EXPECT_LE(pooled_cpu_s, per_thread_cpu_s + 0.01 * duration_s);
+}
+
+#endif
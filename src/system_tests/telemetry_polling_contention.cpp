@@ -0,0 +1,134 @@
+#include "log.h"
+#include "mavsdk.h"
+#include "plugins/telemetry/telemetry.h"
+#include "plugins/telemetry_server/telemetry_server.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(SystemTest, TelemetryPollingContention)
+{
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+
+    ASSERT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    ASSERT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17000"), ConnectionResult::Success);
+
+    auto telemetry_server = TelemetryServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    ASSERT_TRUE(maybe_system);
+    auto system = maybe_system.value();
+
+    ASSERT_TRUE(system->has_autopilot());
+
+    auto telemetry = Telemetry{system};
+
+    std::atomic<bool> done{false};
+
+    // Latitude and longitude are always published equal, so a reader seeing
+    // a mix of two messages would notice.
+    std::thread publisher([&]() {
+        unsigned i = 0;
+        while (!done) {
+            const double value = 1.0 + 0.0001 * (i++ % 10000);
+            telemetry_server.publish_position(
+                TelemetryServer::Position{value, value, 10.0f, 5.0f},
+                TelemetryServer::VelocityNed{0.0f, 0.0f, 0.0f},
+                TelemetryServer::Heading{0.0});
+            std::this_thread::sleep_for(std::chrono::milliseconds(4));
+        }
+    });
+
+    constexpr unsigned num_readers = 4;
+    constexpr auto duration = std::chrono::seconds(2);
+
+    std::atomic<unsigned> num_torn{0};
+    std::atomic<unsigned> num_readers_seeing_updates{0};
+    std::vector<std::vector<double>> latencies_us(num_readers);
+    std::vector<std::thread> readers;
+
+    for (unsigned reader = 0; reader < num_readers; ++reader) {
+        readers.emplace_back([&, reader]() {
+            auto& latencies = latencies_us[reader];
+            latencies.reserve(3000);
+
+            double first_latitude_deg = std::nan("");
+            bool seen_update = false;
+
+            const auto start = std::chrono::steady_clock::now();
+            auto next = start;
+            while (std::chrono::steady_clock::now() - start < duration) {
+                const auto before = std::chrono::steady_clock::now();
+                const auto position = telemetry.position();
+                const auto after = std::chrono::steady_clock::now();
+
+                latencies.push_back(
+                    std::chrono::duration<double, std::micro>(after - before).count());
+                // Nothing received yet is NaN for both.
+                if (!std::isnan(position.latitude_deg) &&
+                    position.latitude_deg != position.longitude_deg) {
+                    ++num_torn;
+                }
+                if (std::isnan(first_latitude_deg)) {
+                    first_latitude_deg = position.latitude_deg;
+                } else if (!std::isnan(position.latitude_deg)) {
+                    seen_update = seen_update || position.latitude_deg != first_latitude_deg;
+                }
+
+                // Poll at 1 kHz.
+                next += std::chrono::milliseconds(1);
+                std::this_thread::sleep_until(next);
+            }
+
+            if (seen_update) {
+                ++num_readers_seeing_updates;
+            }
+        });
+    }
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    done = true;
+    publisher.join();
+
+    std::vector<double> all_latencies_us;
+    for (const auto& latencies : latencies_us) {
+        all_latencies_us.insert(all_latencies_us.end(), latencies.begin(), latencies.end());
+    }
+    ASSERT_FALSE(all_latencies_us.empty());
+
+    std::sort(all_latencies_us.begin(), all_latencies_us.end());
+    const double median_us = all_latencies_us[all_latencies_us.size() / 2];
+    const double p99_us = all_latencies_us[all_latencies_us.size() * 99 / 100];
+    const double max_us = all_latencies_us.back();
+
+    // Only reported, how long a read takes depends too much on the machine
+    // to be checked. Reading the cached value is a copy of a few words, so
+    // this is typically well below a microsecond.
+    LogInfo() << "Polled position " << all_latencies_us.size() << " times: median " << median_us
+              << " us, p99 " << p99_us << " us, max " << max_us << " us";
+
+    EXPECT_EQ(num_torn, 0u);
+    EXPECT_FALSE(std::isnan(telemetry.position().latitude_deg));
+
+    // Polling must not get in the way of new positions arriving.
+    for (const auto& latencies : latencies_us) {
+        EXPECT_FALSE(latencies.empty());
+    }
+    EXPECT_EQ(num_readers_seeing_updates, num_readers);
+}
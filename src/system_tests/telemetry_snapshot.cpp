@@ -0,0 +1,75 @@
+#include "log.h"
+#include "mavsdk.h"
+#include "plugins/telemetry/telemetry.h"
+#include "plugins/telemetry_server/telemetry_server.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(SystemTest, TelemetrySnapshot)
+{
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+
+    ASSERT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    ASSERT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17000"), ConnectionResult::Success);
+
+    auto telemetry_server = TelemetryServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    ASSERT_TRUE(maybe_system);
+    auto system = maybe_system.value();
+
+    ASSERT_TRUE(system->has_autopilot());
+
+    auto telemetry = Telemetry{system};
+
+    // Nothing received yet.
+    EXPECT_EQ(telemetry.snapshot().position_time_us, 0u);
+
+    const uint64_t before_us = telemetry.autopilot_time_us();
+
+    EXPECT_EQ(
+        telemetry_server.publish_position(
+            TelemetryServer::Position{47.3, 8.5, 500.0f, 10.0f},
+            TelemetryServer::VelocityNed{1.0f, 2.0f, 3.0f},
+            TelemetryServer::Heading{90.0}),
+        TelemetryServer::Result::Success);
+
+    Telemetry::Snapshot snapshot;
+    for (unsigned i = 0; i < 100; ++i) {
+        snapshot = telemetry.snapshot();
+        if (snapshot.position_time_us != 0) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    LogInfo() << snapshot;
+
+    ASSERT_NE(snapshot.position_time_us, 0u);
+    EXPECT_GE(snapshot.position_time_us, before_us);
+    EXPECT_LE(snapshot.position_time_us, telemetry.autopilot_time_us());
+    EXPECT_NEAR(snapshot.position.latitude_deg, 47.3, 1e-6);
+    EXPECT_NEAR(snapshot.position.longitude_deg, 8.5, 1e-6);
+    EXPECT_EQ(snapshot.position, telemetry.position());
+
+    // Position, velocity and heading are sent in the same message.
+    EXPECT_EQ(snapshot.velocity_ned_time_us, snapshot.position_time_us);
+    EXPECT_FLOAT_EQ(snapshot.velocity_ned.north_m_s, 1.0f);
+    EXPECT_EQ(snapshot.heading_time_us, snapshot.position_time_us);
+    EXPECT_NEAR(snapshot.heading.heading_deg, 90.0, 0.1);
+
+    // Never sent.
+    EXPECT_EQ(snapshot.distance_sensor_time_us, 0u);
+}
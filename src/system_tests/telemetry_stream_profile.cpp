@@ -0,0 +1,198 @@
+#include "log.h"
+#include "mavsdk.h"
+#include "plugins/telemetry/telemetry.h"
+#include "plugins/telemetry_server/telemetry_server.h"
+#include "udp_delay_relay.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+#ifndef WINDOWS
+
+TEST(SystemTest, TelemetryStreamProfile)
+{
+    // Roughly an LTE link, so the commands have time to be in flight together.
+    constexpr auto one_way_delay = std::chrono::milliseconds(50);
+    UdpDelayRelay relay{17001, 17000, one_way_delay};
+
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+
+    ASSERT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    ASSERT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17001"), ConnectionResult::Success);
+
+    // Handles the message interval commands.
+    auto telemetry_server = TelemetryServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+
+    // The intervals the autopilot was asked for, by message ID.
+    std::mutex intervals_mutex;
+    bool record_intervals{false};
+    std::map<uint32_t, std::vector<float>> intervals_us;
+
+    mavsdk_autopilot.intercept_incoming_messages_async([&](mavlink_message_t& message) {
+        if (message.msgid == MAVLINK_MSG_ID_COMMAND_LONG &&
+            mavlink_msg_command_long_get_command(&message) == MAV_CMD_SET_MESSAGE_INTERVAL) {
+            std::lock_guard<std::mutex> lock(intervals_mutex);
+            if (record_intervals) {
+                const auto message_id =
+                    static_cast<uint32_t>(mavlink_msg_command_long_get_param1(&message));
+                intervals_us[message_id].push_back(
+                    mavlink_msg_command_long_get_param2(&message));
+            }
+        }
+        return true;
+    });
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    ASSERT_TRUE(maybe_system);
+    auto system = maybe_system.value();
+
+    ASSERT_TRUE(system->has_autopilot());
+
+    auto telemetry = Telemetry{system};
+
+    // Acks are dropped until all interval commands of the profile have been
+    // sent, so how many are in flight at once doesn't depend on how quickly
+    // they are sent. Dropped ones are retransmitted.
+    constexpr unsigned num_profile_commands = 10;
+    std::mutex in_flight_mutex;
+    std::set<uint32_t> sent_message_ids;
+    unsigned num_acks_passed = 0;
+    unsigned max_in_flight = 0;
+
+    mavsdk_groundstation.intercept_outgoing_messages_async([&](mavlink_message_t& message) {
+        if (message.msgid == MAVLINK_MSG_ID_COMMAND_LONG &&
+            mavlink_msg_command_long_get_command(&message) == MAV_CMD_SET_MESSAGE_INTERVAL) {
+            std::lock_guard<std::mutex> lock(in_flight_mutex);
+            sent_message_ids.insert(
+                static_cast<uint32_t>(mavlink_msg_command_long_get_param1(&message)));
+            max_in_flight = std::max(
+                max_in_flight, static_cast<unsigned>(sent_message_ids.size()) - num_acks_passed);
+        }
+        return true;
+    });
+
+    mavsdk_groundstation.intercept_incoming_messages_async([&](mavlink_message_t& message) {
+        if (message.msgid == MAVLINK_MSG_ID_COMMAND_ACK &&
+            mavlink_msg_command_ack_get_command(&message) == MAV_CMD_SET_MESSAGE_INTERVAL) {
+            std::lock_guard<std::mutex> lock(in_flight_mutex);
+            if (sent_message_ids.size() < num_profile_commands) {
+                return false;
+            }
+            ++num_acks_passed;
+        }
+        return true;
+    });
+
+    Telemetry::StreamProfile stream_profile;
+    stream_profile.stream_rates = {
+        {Telemetry::Stream::Position, 10.0},
+        {Telemetry::Stream::VelocityNed, 20.0},
+        {Telemetry::Stream::Home, 1.0},
+        {Telemetry::Stream::InAir, 2.0},
+        {Telemetry::Stream::LandedState, 2.0},
+        {Telemetry::Stream::AttitudeQuaternion, 50.0},
+        {Telemetry::Stream::AttitudeEuler, 5.0},
+        {Telemetry::Stream::Imu, 50.0},
+        {Telemetry::Stream::GpsInfo, 1.0},
+        {Telemetry::Stream::Battery, 1.0},
+        {Telemetry::Stream::Odometry, 30.0},
+        {Telemetry::Stream::DistanceSensor, 10.0},
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(intervals_mutex);
+        record_intervals = true;
+    }
+
+    const auto before_profile = std::chrono::steady_clock::now();
+    EXPECT_EQ(telemetry.set_stream_profile(stream_profile), Telemetry::Result::Success);
+    const auto after_profile = std::chrono::steady_clock::now();
+
+    mavsdk_groundstation.intercept_outgoing_messages_async(nullptr);
+    mavsdk_groundstation.intercept_incoming_messages_async(nullptr);
+
+    {
+        // All interval commands of the profile are in flight at the same time
+        // rather than one round trip after the other.
+        std::lock_guard<std::mutex> lock(in_flight_mutex);
+        EXPECT_EQ(sent_message_ids.size(), num_profile_commands);
+        EXPECT_EQ(max_in_flight, num_profile_commands);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(intervals_mutex);
+        record_intervals = false;
+
+        // Streams from the same message are merged and use the highest
+        // rate, e.g. position and velocity both come from GLOBAL_POSITION_INT.
+        const std::map<uint32_t, double> expected_rates_hz{
+            {MAVLINK_MSG_ID_GLOBAL_POSITION_INT, 20.0},
+            {MAVLINK_MSG_ID_HOME_POSITION, 1.0},
+            {MAVLINK_MSG_ID_EXTENDED_SYS_STATE, 2.0},
+            {MAVLINK_MSG_ID_ATTITUDE_QUATERNION, 50.0},
+            {MAVLINK_MSG_ID_ATTITUDE, 5.0},
+            {MAVLINK_MSG_ID_HIGHRES_IMU, 50.0},
+            {MAVLINK_MSG_ID_GPS_RAW_INT, 1.0},
+            {MAVLINK_MSG_ID_BATTERY_STATUS, 1.0},
+            {MAVLINK_MSG_ID_ODOMETRY, 30.0},
+            {MAVLINK_MSG_ID_DISTANCE_SENSOR, 10.0},
+        };
+
+        ASSERT_EQ(expected_rates_hz.size(), num_profile_commands);
+        EXPECT_EQ(intervals_us.size(), expected_rates_hz.size());
+        for (const auto& [message_id, rate_hz] : expected_rates_hz) {
+            const auto it = intervals_us.find(message_id);
+            ASSERT_NE(it, intervals_us.end()) << "No interval set for message " << message_id;
+            // Retransmissions of the same command are expected, as the
+            // first acks were dropped, but all at the same rate.
+            ASSERT_FALSE(it->second.empty());
+            for (const auto interval_us : it->second) {
+                EXPECT_NEAR(1e6 / static_cast<double>(interval_us), rate_hz, 0.01)
+                    << "Wrong rate for message " << message_id;
+            }
+        }
+    }
+
+    // The same streams one by one, for comparison.
+    const auto before_single = std::chrono::steady_clock::now();
+    EXPECT_EQ(telemetry.set_rate_position(10.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_velocity_ned(20.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_home(1.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_in_air(2.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_landed_state(2.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_attitude_quaternion(50.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_attitude_euler(5.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_imu(50.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_gps_info(1.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_battery(1.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_odometry(30.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry.set_rate_distance_sensor(10.0), Telemetry::Result::Success);
+    const auto after_single = std::chrono::steady_clock::now();
+
+    const double profile_ms =
+        std::chrono::duration<double, std::milli>(after_profile - before_profile).count();
+    const double single_ms =
+        std::chrono::duration<double, std::milli>(after_single - before_single).count();
+
+    LogInfo() << "Setting " << stream_profile.stream_rates.size() << " rates took " << profile_ms
+              << " ms as a profile and " << single_ms << " ms one by one";
+
+    // An empty profile has nothing to wait for.
+    EXPECT_EQ(telemetry.set_stream_profile({}), Telemetry::Result::Success);
+}
+
+#endif // WINDOWS
@@ -2,7 +2,9 @@
 #include "mavsdk.h"
 #include "plugins/telemetry/telemetry.h"
 #include "plugins/telemetry_server/telemetry_server.h"
+#include <atomic>
 #include <future>
+#include <limits>
 #include <gtest/gtest.h>
 
 using namespace mavsdk;
@@ -75,3 +77,77 @@ TEST(SystemTest, TelemetrySubscription)
     EXPECT_EQ(num_subscription1_called, 2);
     EXPECT_EQ(num_subscription2_called, 3);
 }
+
+TEST(SystemTest, TelemetrySubscriptionOptions)
+{
+    Mavsdk mavsdk_groundstation;
+    mavsdk_groundstation.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::GroundStation});
+
+    Mavsdk mavsdk_autopilot;
+    mavsdk_autopilot.set_configuration(
+        Mavsdk::Configuration{Mavsdk::Configuration::UsageType::Autopilot});
+
+    ASSERT_EQ(mavsdk_groundstation.add_any_connection("udp://:17000"), ConnectionResult::Success);
+    ASSERT_EQ(
+        mavsdk_autopilot.add_any_connection("udp://127.0.0.1:17000"), ConnectionResult::Success);
+
+    auto telemetry_server = TelemetryServer{
+        mavsdk_autopilot.server_component_by_type(Mavsdk::ServerComponentType::Autopilot)};
+
+    auto maybe_system = mavsdk_groundstation.first_autopilot(10.0);
+    ASSERT_TRUE(maybe_system);
+    auto system = maybe_system.value();
+
+    auto telemetry = Telemetry{system};
+
+    auto callback = [](const Telemetry::StatusText&) {};
+
+    Telemetry::SubscriptionOptions negative_rate{};
+    negative_rate.max_rate_hz = -1.0;
+    EXPECT_EQ(
+        telemetry.subscribe_status_text(callback, negative_rate).first,
+        Telemetry::Result::InvalidArgument);
+
+    Telemetry::SubscriptionOptions nan_rate{};
+    nan_rate.max_rate_hz = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(
+        telemetry.subscribe_status_text(callback, nan_rate).first,
+        Telemetry::Result::InvalidArgument);
+
+    Telemetry::SubscriptionOptions tiny_rate{};
+    tiny_rate.max_rate_hz = std::numeric_limits<double>::denorm_min();
+    EXPECT_EQ(
+        telemetry.subscribe_status_text(callback, tiny_rate).first,
+        Telemetry::Result::InvalidArgument);
+
+    // The limit of one subscription does not affect the other one.
+    std::atomic<unsigned> num_limited_called{0};
+    Telemetry::SubscriptionOptions limited{};
+    limited.max_rate_hz = 1.0;
+    auto limited_result = telemetry.subscribe_status_text(
+        [&](const Telemetry::StatusText&) { ++num_limited_called; }, limited);
+    EXPECT_EQ(limited_result.first, Telemetry::Result::Success);
+
+    auto prom = std::promise<void>{};
+    auto fut = prom.get_future();
+    unsigned num_unlimited_called = 0;
+    auto unlimited_result = telemetry.subscribe_status_text(
+        [&](const Telemetry::StatusText&) {
+            if (++num_unlimited_called == 3) {
+                prom.set_value();
+            }
+        },
+        Telemetry::SubscriptionOptions{});
+    EXPECT_EQ(unlimited_result.first, Telemetry::Result::Success);
+
+    telemetry_server.publish_status_text({TelemetryServer::StatusTextType::Info, "One"});
+    telemetry_server.publish_status_text({TelemetryServer::StatusTextType::Info, "Two"});
+    telemetry_server.publish_status_text({TelemetryServer::StatusTextType::Info, "Three"});
+
+    EXPECT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(num_limited_called, 1);
+
+    telemetry.unsubscribe_status_text(limited_result.second);
+    telemetry.unsubscribe_status_text(unlimited_result.second);
+}
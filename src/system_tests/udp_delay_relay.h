@@ -0,0 +1,177 @@
+#pragma once
+
+#ifndef WINDOWS
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mavsdk {
+
+// Forwards UDP datagrams between a client sending to 127.0.0.1:listen_port
+// and a server listening on 127.0.0.1:target_port, delaying them by the given
+// time in each direction. This simulates a link with a round trip time of
+// twice the delay in-process, e.g. to test how protocols cope with LTE links.
+class UdpDelayRelay {
+public:
+    UdpDelayRelay(int listen_port, int target_port, std::chrono::milliseconds one_way_delay) :
+        _one_way_delay(one_way_delay)
+    {
+        _client_socket = open_socket(listen_port);
+        _server_socket = open_socket(0);
+
+        _target_address.sin_family = AF_INET;
+        _target_address.sin_port = htons(static_cast<uint16_t>(target_port));
+        inet_pton(AF_INET, "127.0.0.1", &_target_address.sin_addr);
+
+        _receive_thread = std::thread([this]() { receive(); });
+        _send_thread = std::thread([this]() { send(); });
+    }
+
+    ~UdpDelayRelay()
+    {
+        _should_exit = true;
+        _packets_cv.notify_all();
+        _receive_thread.join();
+        _send_thread.join();
+        close(_client_socket);
+        close(_server_socket);
+    }
+
+    UdpDelayRelay(const UdpDelayRelay&) = delete;
+    UdpDelayRelay& operator=(const UdpDelayRelay&) = delete;
+
+private:
+    struct Packet {
+        std::chrono::steady_clock::time_point send_at;
+        bool to_server;
+        std::vector<uint8_t> data;
+    };
+
+    static int open_socket(int port)
+    {
+        const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        return fd;
+    }
+
+    void receive()
+    {
+        pollfd fds[2]{{_client_socket, POLLIN, 0}, {_server_socket, POLLIN, 0}};
+        std::vector<uint8_t> buffer(2048);
+
+        while (!_should_exit) {
+            if (poll(fds, 2, 10) <= 0) {
+                continue;
+            }
+
+            for (const auto& fd : fds) {
+                if ((fd.revents & POLLIN) == 0) {
+                    continue;
+                }
+
+                sockaddr_in from{};
+                socklen_t from_len = sizeof(from);
+                const auto len = recvfrom(
+                    fd.fd,
+                    buffer.data(),
+                    buffer.size(),
+                    0,
+                    reinterpret_cast<sockaddr*>(&from),
+                    &from_len);
+                if (len <= 0) {
+                    continue;
+                }
+
+                const bool to_server = fd.fd == _client_socket;
+                if (to_server) {
+                    std::lock_guard<std::mutex> lock(_packets_mutex);
+                    _client_address = from;
+                    _client_known = true;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(_packets_mutex);
+                    _packets.push_back(Packet{
+                        std::chrono::steady_clock::now() + _one_way_delay,
+                        to_server,
+                        std::vector<uint8_t>(buffer.begin(), buffer.begin() + len)});
+                }
+                _packets_cv.notify_all();
+            }
+        }
+    }
+
+    void send()
+    {
+        std::unique_lock<std::mutex> lock(_packets_mutex);
+        while (!_should_exit) {
+            if (_packets.empty()) {
+                _packets_cv.wait_for(lock, std::chrono::milliseconds(10));
+                continue;
+            }
+
+            // All packets have the same delay, so the front one is due first.
+            if (std::chrono::steady_clock::now() < _packets.front().send_at) {
+                _packets_cv.wait_until(lock, _packets.front().send_at);
+                continue;
+            }
+
+            const Packet packet = std::move(_packets.front());
+            _packets.pop_front();
+
+            if (packet.to_server) {
+                sendto(
+                    _server_socket,
+                    packet.data.data(),
+                    packet.data.size(),
+                    0,
+                    reinterpret_cast<const sockaddr*>(&_target_address),
+                    sizeof(_target_address));
+            } else if (_client_known) {
+                sendto(
+                    _client_socket,
+                    packet.data.data(),
+                    packet.data.size(),
+                    0,
+                    reinterpret_cast<const sockaddr*>(&_client_address),
+                    sizeof(_client_address));
+            }
+        }
+    }
+
+    const std::chrono::milliseconds _one_way_delay;
+
+    int _client_socket{-1};
+    int _server_socket{-1};
+    sockaddr_in _target_address{};
+
+    std::mutex _packets_mutex{};
+    std::condition_variable _packets_cv{};
+    std::deque<Packet> _packets{};
+    sockaddr_in _client_address{};
+    bool _client_known{false};
+
+    std::atomic<bool> _should_exit{false};
+    std::thread _receive_thread{};
+    std::thread _send_thread{};
+};
+
+} // namespace mavsdk
+
+#endif // WINDOWS